@@ -27,6 +27,7 @@ namespace Mikoto {
         bool WantYAxisRotation{ true };
         bool VerticalSyncEnabled{ true };
         bool RenderWireframeMode{ false };
+        bool RenderDepthPrepass{ true };
 
         SceneCamera* EditorCamera{ nullptr };
     };
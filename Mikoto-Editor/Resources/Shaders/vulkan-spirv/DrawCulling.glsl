@@ -0,0 +1,166 @@
+/**************************************************
+    GPU driven draw culling. Every invocation tests
+    one meshlet of a draw instance, its bounding
+    sphere against the view frustum and optionally
+    its normal cone against the camera, and appends
+    the indirect draw commands of the visible ones,
+    which are consumed by vkCmdDrawIndexedIndirectCount.
+
+    Stage: Compute
+    Version: GLSL 4.5.0
+**************************************************/
+
+#version 450
+
+// Must match VulkanRenderer::DRAW_CULLING_GROUP_SIZE
+#define CULLING_GROUP_SIZE 64
+
+// Must match VulkanRenderer::VERTEX_FORMAT_COUNT
+#define VERTEX_FORMAT_COUNT 2
+
+// Matches VulkanRenderer::DrawInstanceData
+struct DrawInstance {
+    mat4 Transform;
+
+    // xyz=center in object space, w=radius
+    vec4 BoundingSphere;
+
+    // x=index count, y=first index, z=vertex offset, w=positions vertex offset
+    ivec4 Geometry;
+
+    // x=material index, y=vertex format, z=1 if the transform keeps the normal cones of the meshlets
+    uvec4 Material;
+
+    // Dequantization of the vertices, identity for 32-bit float vertices. w unused
+    vec4 PositionScale;
+    vec4 PositionOffset;
+
+    // xy=texture coordinates scale, zw=texture coordinates offset
+    vec4 TexCoordTransform;
+};
+
+// Matches VulkanRenderer::DrawMeshletData
+struct DrawMeshlet {
+    // xyz=center in object space, w=radius
+    vec4 BoundingSphere;
+
+    // xyz=axis in object space, w=cutoff
+    vec4 Cone;
+
+    // x=draw instance index, y=index count, z=first index
+    uvec4 Geometry;
+};
+
+// Same layout as VkDrawIndexedIndirectCommand
+struct DrawCommand {
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int VertexOffset;
+    uint FirstInstance;
+};
+
+layout(local_size_x = CULLING_GROUP_SIZE) in;
+
+// Scene set, bound as the first set by the compute pipelines (see VulkanRenderer::CreateSceneLightsBuffers)
+layout(std430, set = 0, binding = 4) readonly buffer DrawInstancesBuffer {
+    DrawInstance Instances[];
+} DrawInstances;
+
+// Commands of the main pass, they address the interleaved vertices.
+// The commands of each vertex format start at a multiple of Culling.BatchCapacity
+layout(std430, set = 0, binding = 5) writeonly buffer DrawCommandsBuffer {
+    DrawCommand Commands[];
+} DrawCommands;
+
+// Commands of the depth pre-pass, they address the positions stream
+layout(std430, set = 0, binding = 6) writeonly buffer DepthPrepassDrawCommandsBuffer {
+    DrawCommand Commands[];
+} DepthPrepassDrawCommands;
+
+// Cleared to zero before the dispatch, one count per vertex format
+layout(std430, set = 0, binding = 7) buffer DrawCountBuffer {
+    uint Counts[VERTEX_FORMAT_COUNT];
+} DrawCount;
+
+layout(std430, set = 0, binding = 8) readonly buffer DrawMeshletsBuffer {
+    DrawMeshlet Meshlets[];
+} DrawMeshlets;
+
+// See VulkanRenderer::DrawCullingPushConstants
+layout(push_constant) uniform CullingData {
+    // World space planes, xyz=normal pointing inside, w=distance
+    vec4 FrustumPlanes[6];
+
+    // xyz=world space position of the camera
+    vec4 CameraPosition;
+
+    uint MeshletCount;
+    uint BatchCapacity;
+
+    // 1 to cull the meshlets facing away from the camera
+    uint ConeCulling;
+} Culling;
+
+bool IsSphereVisible(vec3 center, float radius) {
+    for (int plane = 0; plane < 6; ++plane) {
+        if (dot(Culling.FrustumPlanes[plane].xyz, center) + Culling.FrustumPlanes[plane].w < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Every triangle of the meshlet faces away from the camera. A cutoff of 1 never passes
+bool IsConeBackfacing(vec3 center, float radius, vec3 axis, float cutoff) {
+    const vec3 offset = center - Culling.CameraPosition.xyz;
+
+    return dot(offset, axis) >= cutoff * length(offset) + radius;
+}
+
+void main() {
+    const uint meshletIndex = gl_GlobalInvocationID.x;
+
+    if (meshletIndex >= Culling.MeshletCount) {
+        return;
+    }
+
+    const DrawMeshlet meshlet = DrawMeshlets.Meshlets[meshletIndex];
+    const uint instanceIndex = meshlet.Geometry.x;
+    const DrawInstance instance = DrawInstances.Instances[instanceIndex];
+
+    // The radius grows with the largest scale of the transform
+    const vec3 center = (instance.Transform * vec4(meshlet.BoundingSphere.xyz, 1.0)).xyz;
+    const float scale = max(length(instance.Transform[0].xyz), max(length(instance.Transform[1].xyz), length(instance.Transform[2].xyz)));
+    const float radius = meshlet.BoundingSphere.w * scale;
+
+    if (!IsSphereVisible(center, radius)) {
+        return;
+    }
+
+    if (Culling.ConeCulling != 0 && instance.Material.z != 0) {
+        const vec3 axis = normalize(mat3(instance.Transform) * meshlet.Cone.xyz);
+
+        if (IsConeBackfacing(center, radius, axis, meshlet.Cone.w)) {
+            return;
+        }
+    }
+
+    // Each vertex format is drawn by its own pipeline, see VulkanRenderer::RecordIndirectDraws
+    const uint format = instance.Material.y;
+    const uint drawIndex = format * Culling.BatchCapacity + atomicAdd(DrawCount.Counts[format], 1);
+
+    // The first instance is the index of the instance data, read back with gl_InstanceIndex
+    DrawCommand command;
+    command.IndexCount = meshlet.Geometry.y;
+    command.InstanceCount = 1;
+    command.FirstIndex = meshlet.Geometry.z;
+    command.VertexOffset = instance.Geometry.z;
+    command.FirstInstance = instanceIndex;
+
+    DrawCommands.Commands[drawIndex] = command;
+
+    command.VertexOffset = instance.Geometry.w;
+    DepthPrepassDrawCommands.Commands[drawIndex] = command;
+}
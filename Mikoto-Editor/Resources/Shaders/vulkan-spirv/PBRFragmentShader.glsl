@@ -9,41 +9,36 @@
 
 #version 450
 
-layout (location = 0) in vec3 fragmentPos;
-layout (location = 1) in vec4 inColor;
-layout (location = 2) in vec3 inNormals;
-layout (location = 3) in vec2 inTexCoord;
-layout (location = 4) in vec2 inVertexColor;
+#extension GL_EXT_nonuniform_qualifier : require
 
-// Output variables
-layout (location = 0) out vec4 outColor;
+const float PI = 3.14159265359;
 
-/**  Constants */
+#define MAX_LIGHTS 4096
+#define MAX_DIRECTIONAL_LIGHTS 16
 
-#define MAX_LIGHTS 200
-#define LIGHT_HAS_SPECULAR_MAP      1
-#define LIGHT_HAS_NO_SPECULAR_MAP   0
+#define MKT_SHADER_TRUE 1
+#define MKT_SHADER_FALSE 0
 
-#define LIGHT_HAS_DIFFUSE_MAP       1
-#define LIGHT_HAS_NO_DIFFUSE_MAP    0
+#define DISPLAY_NORMAL 1
+#define DISPLAY_COLOR 2
+#define DISPLAY_METAL 3
+#define DISPLAY_AO 4
+#define DISPLAY_ROUGH 5
 
-#define C_PI                        3.14159265
-
-/**  Structures */
+// Baked into each pipeline variant, see VulkanPipelineVariantCache
+// The branches below are resolved when the pipeline is built, not per fragment
+layout(constant_id = 0) const int RENDER_MODE = DISPLAY_COLOR;
+layout(constant_id = 1) const bool WIREFRAME = false;
 
 struct PointLight {
-    vec4 position;
+    vec4 Position;
 
     vec4 ambient;
-    vec4 diffuse;
+    vec4 Diffuse;
     vec4 specular;
 
-    // x=constant, y=linear, z=quadratic, w=radius
-    // Used for now for simplicity for proper aligment
-    vec4 components;
+    vec4 AttenuationParams;
 
-    // x=ambient, rest unused for now
-    vec4 intensity;
 };
 
 struct DirectionalLight {
@@ -63,263 +58,402 @@ struct SpotLight {
     vec4 Diffuse;
     vec4 Specular;
 
-    // cutoff
-    // x=cutOff, y=outerCutOff (both angles in radians)
+// cutoff
+// x=cutOff, y=outerCutOff (both angles in radians),  z = intensity, w = radius
     vec4 CutOffValues;
-
-    // Components
-    // x=constant, y=linear, z=quadratic, w=unused
-    // Used for now for simplicity for proper aligment
-    vec4 Components;
 };
 
-layout(set = 0, binding = 1) uniform sampler2D diffuseSampler;
-layout(set = 0, binding = 2) uniform sampler2D specularSampler;
 
-layout(set = 0, binding = 3) uniform UniformBufferObject {
-    SpotLight SpotLights[MAX_LIGHTS];
-    PointLight PointLights[MAX_LIGHTS];
-    DirectionalLight DirectionalLights[MAX_LIGHTS];
+// Input variables
+layout (location = 0) in vec3 inFragmentPos;
+layout (location = 1) in vec3 inNormals;
+layout (location = 2) in vec2 inTexCoord;
+layout (location = 3) in vec2 inVertexColor;
+
+// Index in the bindless materials buffer, see VulkanRenderer::DrawInstanceData
+layout (location = 4) flat in uint inMaterialIndex;
+
+// Output variables
+layout (location = 0) out vec4 outColor;
+
+// Every registered texture, materials reference them by index (see VulkanBindlessManager)
+layout(set = 0, binding = 0) uniform sampler2D Textures[];
 
+struct MaterialData {
+    vec4 Albedo;
+
+    // x=metallic, y=roughness, z=ambient occlusion
+    vec4 Factors;
+
+    // Indices in Textures. x=albedo, y=normal, z=metallic, w=roughness
+    uvec4 TextureIndices;
+
+    // x=ambient occlusion
+    uvec4 AuxTextureIndices;
+
+    // x=albedo, y=normal, z=metallic, w=roughness
+    ivec4 HasMaps;
+
+    // x=ambient occlusion
+    ivec4 AuxHasMaps;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer MaterialsBuffer {
+    MaterialData Materials[];
+} MaterialsData;
+
+// Camera and render settings, written once per frame by the renderer
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
+    mat4 View;
+    mat4 Projection;
     vec4 ViewPosition;
 
-    // Stores x=lights count, y=has diffuse, z=has specular, w=shininess
-    vec4 ObjectLightInfo;
+    // x=display mode, y=wireframe, unused by the PBR shaders which get them as specialization constants
+    ivec4 RenderSettings;
+} FrameData;
 
-    // holds count of each type of light
-    // x=dir, y=point, z=spot
-    vec4 LightTypesCount;
+// Lights of the scene, written once per frame by the renderer and shared by every material
+layout(std430, set = 1, binding = 0) readonly buffer SceneLightsBuffer {
+    // x=directional, y=point, z=spot, w=unused
+    ivec4 LightCounts;
 
-} UniformBufferData;
+    // xyz=clusters per axis, w=max lights per cluster
+    uvec4 ClusterGridSize;
 
+    // x=near, y=far, z=depth slice scale, w=depth slice bias
+    vec4 ClusterDepthParams;
 
-vec4 CalcDirLight(DirectionalLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    const float shininess = UniformBufferData.ObjectLightInfo.w;
+    // xy=render target size, zw=cluster tile size (in pixels)
+    vec4 ScreenSize;
 
-    vec3 lightDir;
-    // careful for floating point errors
-    if (light.Direction.w == 1.0f) {
-        // Directional light with taking vector as a position vector
-        lightDir = normalize(light.Position.rgb - fragPos);
-    }
-    else {
-        // Directional light with taking vector as a direction vector
-        lightDir = normalize(-light.Direction.rgb);
-    }
+    mat4 View;
+    mat4 InverseProjection;
 
-    // diffuse shading
-    const float diff = max(dot(normal, lightDir), 0.0);
+    DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS];
+    PointLight PointLights[MAX_LIGHTS];
+    SpotLight SpotLights[MAX_LIGHTS];
+} SceneLights;
 
-    // specular shading
-    const vec3 reflectDir = reflect(-lightDir, normal);
-    const float spec = pow(max(dot(viewDir, reflectDir), 0.0), UniformBufferData.ObjectLightInfo.w);
+// Written by the light culling pass. x=offset in the indices list, y=point lights count, z=spot lights count
+layout(std430, set = 1, binding = 1) readonly buffer ClusterGridBuffer {
+    uvec4 Clusters[];
+} ClusterGrid;
 
-    // combine results
-    vec4 ambient;
-    vec4 diffuse;
-
-    const int hasDiffuse = int(UniformBufferData.ObjectLightInfo.y);
-    switch (hasDiffuse) {
-        case LIGHT_HAS_DIFFUSE_MAP:
-        ambient = light.Ambient * texture(diffuseSampler, inTexCoord);
-        diffuse = light.Diffuse * diff * texture(diffuseSampler, inTexCoord);
-        break;
-
-        case LIGHT_HAS_NO_DIFFUSE_MAP:
-        ambient = light.Ambient * inColor;
-        diffuse = light.Diffuse * diff * inColor;
-        break;
-    }
+layout(std430, set = 1, binding = 2) readonly buffer ClusterLightIndicesBuffer {
+    uint Indices[];
+} ClusterLightIndices;
 
-    vec4 specular;
-    const int hasSpecular = int( UniformBufferData.ObjectLightInfo.z );
-    const float energyConservation = ( 8.0 + shininess ) / ( 8.0 * C_PI );
-    switch (hasSpecular) {
-        case LIGHT_HAS_SPECULAR_MAP:
-        specular = light.Specular * spec * texture(specularSampler, inTexCoord);
-        break;
-
-        case LIGHT_HAS_NO_SPECULAR_MAP:
-        specular = light.Specular * spec * inColor;
-        break;
-    }
+// Cluster of the froxel containing this fragment
+uvec4 GetFragmentCluster(vec3 worldPosition) {
+    const uvec3 gridSize = SceneLights.ClusterGridSize.xyz;
+    const float viewDepth = -(SceneLights.View * vec4(worldPosition, 1.0)).z;
+
+    const uint slice = min(uint(max(log(viewDepth) * SceneLights.ClusterDepthParams.z - SceneLights.ClusterDepthParams.w, 0.0)), gridSize.z - 1);
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / SceneLights.ScreenSize.zw), gridSize.xy - 1);
 
-    return (ambient + diffuse + specular);
+    return ClusterGrid.Clusters[tile.x + tile.y * gridSize.x + slice * gridSize.x * gridSize.y];
 }
 
-// calculates the color when using a spot light.
-vec4 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    const vec3 lightDir = normalize(light.Position.rgb - fragPos);
+// ----------------------------------------------------------------------------
+vec3 GetNormalFromMap(uint normalMapIndex)
+{
+    // Z is rebuilt from XY, cooked normal maps are two channel BC5 (see TextureCooker)
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(Textures[normalMapIndex], inTexCoord).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
+
+    vec3 Q1  = dFdx(inFragmentPos);
+    vec3 Q2  = dFdy(inFragmentPos);
+    vec2 st1 = dFdx(inTexCoord);
+    vec2 st2 = dFdy(inTexCoord);
+
+    vec3 N   = normalize(inNormals);
+    vec3 T  = normalize(Q1*st2.t - Q2*st1.t);
+    vec3 B  = -normalize(cross(N, T));
+    mat3 TBN = mat3(T, B, N);
+
+    return normalize(TBN * tangentNormal);
+}
 
-    // Diffuse shading
-    const float diff = max(dot(normal, lightDir), 0.0);
+// ----------------------------------------------------------------------------
+float DistributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness*roughness;
+    float a2 = a*a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH*NdotH;
 
-    // Specular shading
-    const vec3 reflectDir = reflect(-lightDir, normal);
-    const float spec = pow(max(dot(viewDir, reflectDir), 0.0), UniformBufferData.ObjectLightInfo.w);
+    float nom   = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
 
-    // Attenuation
-    const float distance = length(light.Position.rgb - fragPos);
-    const float attenuation = 1.0 / (light.Components.x + light.Components.y * distance + light.Components.z * (distance * distance));
+    return nom / denom;
+}
 
-    // spotlight intensity
-    const float theta = dot(lightDir, normalize(-light.Direction.rgb));
-    const float epsilon = light.CutOffValues.x - light.CutOffValues.y;
-    const float intensity = clamp((theta - light.CutOffValues.y) / epsilon, 0.0, 1.0);
+// ----------------------------------------------------------------------------
+float GeometrySchlickGGX(float NdotV, float roughness)
+{
+    float r = (roughness + 1.0);
+    float k = (r*r) / 8.0;
 
-    // [Combine results]
-    vec4 ambient;
-    vec4 diffuse;
-
-    const int hasDiffuse = int(UniformBufferData.ObjectLightInfo.y);
-    switch (hasDiffuse) {
-        case LIGHT_HAS_DIFFUSE_MAP:
-        ambient = light.Ambient * texture(diffuseSampler, inTexCoord);
-        diffuse = light.Diffuse * diff * texture(diffuseSampler, inTexCoord);
-        break;
-
-        case LIGHT_HAS_NO_DIFFUSE_MAP:
-        ambient = light.Ambient * inColor;
-        diffuse = light.Diffuse * diff * inColor;
-        break;
-    }
+    float nom   = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
 
-    vec4 specular;
-    const int hasSpecular = int( UniformBufferData.ObjectLightInfo.z );
-    switch (hasSpecular) {
-        case LIGHT_HAS_SPECULAR_MAP:
-        specular = light.Specular * spec * texture(specularSampler, inTexCoord);
-        break;
-
-        case LIGHT_HAS_NO_SPECULAR_MAP:
-        specular = light.Specular * spec * inColor;
-        break;
-    }
+    return nom / denom;
+}
 
-    ambient *= attenuation * intensity;
-    diffuse *= attenuation * intensity;
-    specular *= attenuation * intensity;
+// ----------------------------------------------------------------------------
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
 
-    return (ambient + diffuse + specular);
+    return ggx1 * ggx2;
 }
 
-/**
- * Caclculates the color for a fragment using a point light.
- *
- * @param light point light ingotmation.
- * @param normal the normal vector.
- * @param fragPos the fragment's position.
- * @vec3 viewDir the camera's view direction.
- * */
-vec4 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    // the shininess is a property of the object, not from the light
-    const float shininess = UniformBufferData.ObjectLightInfo.w;
-    const vec3 lightDir = normalize(light.position.rgb - fragPos);
-
-    // [Diffuse shading]
-    float diff = max(dot(normal, lightDir), 0.0);
-
-    // [Specular shading]
-    vec3 reflectDir = reflect(-lightDir, normal);
-    vec3 halfwayDir = normalize(lightDir + viewDir);
-
-    // [Phong]
-    // float spec = pow(max(dot(viewDir, reflectDir), 0.0), UniformBufferData.ObjectLightInfo.w);
-
-    // [Blin-Phong]
-    float spec = pow(max(dot(viewDir, halfwayDir), 0.0), UniformBufferData.ObjectLightInfo.w);
-
-    // [Attenuation]
-    float distance = length(light.position.rgb - fragPos);
-    float attenuation = 5.0 / (light.components.x + light.components.y * distance + light.components.z * (distance * distance));
-
-    // [Combine results]
-    vec4 ambient;
-    vec4 diffuse;
-
-    const int hasDiffuse = int(UniformBufferData.ObjectLightInfo.y);
-    switch (hasDiffuse) {
-        case LIGHT_HAS_DIFFUSE_MAP:
-        ambient = light.ambient * texture(diffuseSampler, inTexCoord);
-        diffuse = light.diffuse * diff * texture(diffuseSampler, inTexCoord);
-        break;
-
-        case LIGHT_HAS_NO_DIFFUSE_MAP:
-        ambient = light.ambient * inColor;
-        diffuse = light.diffuse * diff * inColor;
-        break;
-    }
+// ----------------------------------------------------------------------------
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
 
-    vec4 specular;
-    const int hasSpecular = int( UniformBufferData.ObjectLightInfo.z );
-    const float energyConservation = ( 8.0 + shininess ) / ( 8.0 * C_PI );
-    switch (hasSpecular) {
-        case LIGHT_HAS_SPECULAR_MAP:
-            specular = light.specular * spec * texture(specularSampler, inTexCoord);
-            break;
+float ComputeAttenuation(float distance) {
+    return 1.0 / (distance * distance);  // Physically correct attenuation
+}
 
-        case LIGHT_HAS_NO_SPECULAR_MAP:
-            specular = light.specular * spec * inColor;
-            break;
-    }
+float ComputeAttenuation(float distance, float radius) {
+    //return 1.0 / (distance * distance);  // Physically correct attenuation
+    return pow(max(1.0 - pow(distance / radius, 4.0), 0.0), 2.0) / (distance * distance + 1.0);
+}
 
-    // [Apply attenuation]
-    ambient *= attenuation;
-    diffuse *= attenuation;
-    specular *= attenuation;
+// Custom attenuation
+float ComputeAttenuation(vec4 components, float distance) {
+    // x=constant, y=linear, z=quadratic, w=unused
+    float constant = components.x;
+    float linear = components.y;
+    float quadratic = components.z;
 
-    return (ambient + diffuse + specular);
+    return 1.0 / (constant + linear * distance +
+    quadratic * (distance * distance));
 }
 
-void main() {
-    // Avoid warning meshes generally have this attribute but not used rn
-    // as we pass the color via a uniform buffer
-    inVertexColor;
-
-    // [Constant properties]
-    const vec3 norm = normalize(inNormals);
-    const vec3 viewDir = normalize(vec3(UniformBufferData.ViewPosition) - fragmentPos);
-    const float defaulAmbientIntensity = 0.4;
-
-    // Final output result, acumulates the
-    // contributions from lights.
-    vec4 result;
-
-    // [Compute base values, when there are no lights]
-    const int hasDiffuse = int(UniformBufferData.ObjectLightInfo.y);
-    switch (hasDiffuse) {
-    case LIGHT_HAS_DIFFUSE_MAP:
-        const vec4 resultTextureSampling = texture(diffuseSampler, inTexCoord);
-        result = vec4(resultTextureSampling.rgb * defaulAmbientIntensity, resultTextureSampling.a);
-        break;
-
-    case LIGHT_HAS_NO_DIFFUSE_MAP:
-        result = vec4(inColor.rgb * defaulAmbientIntensity, inColor.a);
-        break;
-    }
+vec3 ComputePointLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
+    vec3 Lo = vec3(0.0);
+
+    // Only the point lights overlapping the cluster of this fragment
+    const uvec4 cluster = GetFragmentCluster(inFragmentPos);
+
+    for(uint clusterLight = 0; clusterLight < cluster.y; ++clusterLight)
+    {
+        const uint i = ClusterLightIndices.Indices[cluster.x + clusterLight];
+
+        // calculate per-light radiance
+        vec3 L = normalize(SceneLights.PointLights[i].Position.xyz - inFragmentPos);
+        vec3 H = normalize(V + L);
+        float distance = length(SceneLights.PointLights[i].Position.xyz - inFragmentPos);
+        float attenuation = ComputeAttenuation(distance, SceneLights.PointLights[i].AttenuationParams.y);
+
+        vec3 radiance = SceneLights.PointLights[i].Diffuse.xyz * attenuation * SceneLights.PointLights[i].AttenuationParams.x;
 
+        // Cook-Torrance BRDF
+        float NDF = DistributionGGX(N, H, roughness);
+        float G   = GeometrySmith(N, V, L, roughness);
+        vec3 F    = fresnelSchlick(clamp(dot(H, V), 0.0, 1.0), F0);
 
-    // [1. Compute directional lights contribution]
-    const int limitDirectionalLights = int(UniformBufferData.LightTypesCount.x);
-    for (int index = 0; index < limitDirectionalLights; ++index) {
-        result += CalcDirLight(UniformBufferData.DirectionalLights[index], norm, fragmentPos, viewDir);
+        vec3 numerator    = NDF * G * F;
+        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001; // + 0.0001 to prevent divide by zero
+        vec3 specular = numerator / denominator;
+
+        // kS is equal to Fresnel
+        vec3 kS = F;
+
+        // for energy conservation, the diffuse and specular light can't
+        // be above 1.0 (unless the surface emits light); to preserve this
+        // relationship the diffuse component (kD) should equal 1.0 - kS.
+        vec3 kD = vec3(1.0) - kS;
+
+        // multiply kD by the inverse metalness such that only non-metals
+        // have diffuse lighting, or a linear blend if partly metal (pure metals
+        // have no diffuse light).
+        kD *= 1.0 - metallic;
+
+        // scale light by NdotL
+        float NdotL = max(dot(N, L), 0.0);
+
+        // add to outgoing radiance Lo
+        // note that we already multiplied the BRDF by the Fresnel (kS) so we won't multiply by kS again
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
     }
 
-    // [2. Compute point lights]
-    const int limitPointLights = int(UniformBufferData.LightTypesCount.y);
+    return Lo;
+}
+
+vec3 ComputeDirectionalLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
+    vec3 Lo = vec3(0.0);
+
+    for(int i = 0; i < SceneLights.LightCounts.x; ++i)
+    {
+        // calculate per-light radiance
+        vec3 L = normalize(-vec3(SceneLights.DirectionalLights[i].Position.xyz));
+        vec3 H = normalize(V + L);
+
+        // This vec 3 should be the light color, we assume it is full white for now
+        vec3 radiance = SceneLights.DirectionalLights[i].Diffuse.xyz;
+
+        // Cook-Torrance BRDF
+        float NDF = DistributionGGX(N, H, roughness);
+        float G   = GeometrySmith(N, V, L, roughness);
+        vec3 F    = fresnelSchlick(clamp(dot(H, V), 0.0, 1.0), F0);
+
+        vec3 numerator    = NDF * G * F;
+        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001; // + 0.0001 to prevent divide by zero
+        vec3 specular = numerator / denominator;
+
+        // kS is equal to Fresnel
+        vec3 kS = F;
+
+        // for energy conservation, the diffuse and specular light can't
+        // be above 1.0 (unless the surface emits light); to preserve this
+        // relationship the diffuse component (kD) should equal 1.0 - kS.
+        vec3 kD = vec3(1.0) - kS;
+
+        // multiply kD by the inverse metalness such that only non-metals
+        // have diffuse lighting, or a linear blend if partly metal (pure metals
+        // have no diffuse light).
+        kD *= 1.0 - metallic;
 
-    for (int index = 0; index < limitPointLights; ++index) {
-        result += CalcPointLight(UniformBufferData.PointLights[index], norm, fragmentPos, viewDir);
+        // scale light by NdotL
+        float NdotL = max(dot(N, L), 0.0);
+
+        // add to outgoing radiance Lo
+        // note that we already multiplied the BRDF by the Fresnel (kS) so we won't multiply by kS again
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
     }
 
-    // [2. Compute spot lights contribution]
-    const int limitSpotLights = int(UniformBufferData.LightTypesCount.z);
+    return Lo;
+}
+
+vec3 ComputeSpotLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
+    vec3 Lo = vec3(0.0);
+
+    // Spot light indices are stored right after the point lights of the cluster
+    const uvec4 cluster = GetFragmentCluster(inFragmentPos);
+
+    for(uint clusterLight = 0; clusterLight < cluster.z; ++clusterLight)
+    {
+        const uint i = ClusterLightIndices.Indices[cluster.x + cluster.y + clusterLight];
+
+        // calculate per-light radiance
+        vec3 L = normalize(SceneLights.SpotLights[i].Position.xyz - inFragmentPos);
+        float distance = length(SceneLights.SpotLights[i].Position.xyz - inFragmentPos);
+        float attenuation = ComputeAttenuation(distance, SceneLights.SpotLights[i].CutOffValues.w);
+        // This vec 3 should be the light color, we assume it is full white for now
+        vec3 radiance = SceneLights.SpotLights[i].Diffuse.xyz * attenuation;
+
+        // Spotlight intensity based on angle
+        float theta = dot(L, normalize(-vec3(SceneLights.SpotLights[i].Direction.xyz)));
+        float epsilon = SceneLights.SpotLights[i].CutOffValues.x - SceneLights.SpotLights[i].CutOffValues.y;
+        float intensity = clamp((theta - SceneLights.SpotLights[i].CutOffValues.y) / epsilon, 0.0, 1.0) * SceneLights.SpotLights[i].CutOffValues.z;
+        radiance *= intensity;
+
+        vec3 H = normalize(V + L);
+
+        // Cook-Torrance BRDF
+        float NDF = DistributionGGX(N, H, roughness);
+        float G   = GeometrySmith(N, V, L, roughness);
+        vec3 F    = fresnelSchlick(clamp(dot(H, V), 0.0, 1.0), F0);
+
+        vec3 numerator    = NDF * G * F;
+        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001; // + 0.0001 to prevent divide by zero
+        vec3 specular = numerator / denominator;
+
+        // kS is equal to Fresnel
+        vec3 kS = F;
+
+        // for energy conservation, the diffuse and specular light can't
+        // be above 1.0 (unless the surface emits light); to preserve this
+        // relationship the diffuse component (kD) should equal 1.0 - kS.
+        vec3 kD = vec3(1.0) - kS;
+
+        // multiply kD by the inverse metalness such that only non-metals
+        // have diffuse lighting, or a linear blend if partly metal (pure metals
+        // have no diffuse light).
+        kD *= 1.0 - metallic;
 
-    for (int index = 0; index < limitSpotLights; ++index) {
-        result += CalcSpotLight(UniformBufferData.SpotLights[index], norm, fragmentPos, viewDir);
+        // scale light by NdotL
+        float NdotL = max(dot(N, L), 0.0);
+
+        // add to outgoing radiance Lo
+        // note that we already multiplied the BRDF by the Fresnel (kS) so we won't multiply by kS again
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
     }
 
-    // [Final pixel output color]
-    const int hasSpecular = int( UniformBufferData.ObjectLightInfo.z );
-    outColor = result;
+    return Lo;
+}
+
+void main() {
+    // The material index comes from the instance data of the draw, it is the same for the whole draw
+    const MaterialData material = MaterialsData.Materials[inMaterialIndex];
+
+    vec3 albedo     = material.HasMaps.x == 1 ? pow(texture(Textures[material.TextureIndices.x], inTexCoord).rgb, vec3(2.2)) : material.Albedo.xyz;
+    float metallic  = material.HasMaps.z == 1 ? texture(Textures[material.TextureIndices.z], inTexCoord).r : material.Factors.x;
+    float roughness = material.HasMaps.w == 1 ? texture(Textures[material.TextureIndices.w], inTexCoord).r : material.Factors.y;
+    float ao        = material.AuxHasMaps.x == 1 ? texture(Textures[material.AuxTextureIndices.x], inTexCoord).r : material.Factors.z;
+
+    vec3 N = material.HasMaps.y == 1 ? GetNormalFromMap(material.TextureIndices.y) : normalize(inNormals);
+
+    vec3 V = normalize(FrameData.ViewPosition.xyz - inFragmentPos);
+
+    // calculate reflectance at normal incidence; if dia-electric (like plastic) use F0
+    // of 0.04 and if it's a metal, use the albedo color as F0 (metallic workflow)
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+
+    // reflectance equation
+    vec3 Lo = vec3(0.0);
+
+    Lo += ComputeDirectionalLightContribution(N, V, F0, roughness, metallic, albedo);
+    Lo += ComputePointLightContribution(N, V, F0, roughness, metallic, albedo);
+    Lo += ComputeSpotLightContribution(N, V, F0, roughness, metallic, albedo);
+
+    // ambient lighting (note that the next IBL tutorial will replace
+    // this ambient lighting with environment lighting).
+    vec3 ambient = vec3(0.03) * albedo * ao;
+
+    vec3 color = ambient + Lo;
+
+    // HDR tonemapping
+    color = color / (color + vec3(1.0));
+
+    // gamma correct
+    color = pow(color, vec3(1.0/2.2));
+
+
+    if (!WIREFRAME) {
+        switch (RENDER_MODE) {
+            case DISPLAY_COLOR:
+            outColor = vec4(color , 1.0);
+            break;
+
+            case DISPLAY_NORMAL:
+            outColor = vec4(N , 1.0);
+            break;
+
+            case DISPLAY_METAL:
+            outColor = vec4(metallic, metallic, metallic , 1.0);
+            break;
+
+            case DISPLAY_AO:
+            outColor = vec4(ao, ao, ao , 1.0);
+            break;
+
+            case DISPLAY_ROUGH:
+            outColor = vec4(roughness, roughness, roughness , 1.0);
+            break;
+        }
+    } else {
+        outColor = vec4(0.0f, 0.0f, 0.0f , 1.0);
+    }
 }
\ No newline at end of file
@@ -20,7 +20,8 @@ layout (location = 0) out vec4 outColor;
 
 /**  Constants */
 
-#define MAX_LIGHTS 200
+#define MAX_LIGHTS 4096
+#define MAX_DIRECTIONAL_LIGHTS 16
 #define LIGHT_HAS_SPECULAR_MAP      1
 #define LIGHT_HAS_NO_SPECULAR_MAP   0
 
@@ -31,6 +32,7 @@ layout (location = 0) out vec4 outColor;
 
 /**  Structures */
 
+// Light structures match the ones in Models/LightData.hh
 struct PointLight {
     vec4 position;
 
@@ -38,12 +40,8 @@ struct PointLight {
     vec4 diffuse;
     vec4 specular;
 
-    // x=constant, y=linear, z=quadratic, w=radius
-    // Used for now for simplicity for proper aligment
-    vec4 components;
-
-    // x=ambient, rest unused for now
-    vec4 intensity;
+    // x=intensity, y=radius
+    vec4 attenuationParams;
 };
 
 struct DirectionalLight {
@@ -64,32 +62,74 @@ struct SpotLight {
     vec4 Specular;
 
     // cutoff
-    // x=cutOff, y=outerCutOff (both angles in radians)
+    // x=cutOff, y=outerCutOff (both angles in radians), z=intensity, w=radius
     vec4 CutOffValues;
-
-    // Components
-    // x=constant, y=linear, z=quadratic, w=unused
-    // Used for now for simplicity for proper aligment
-    vec4 Components;
 };
 
 layout(set = 0, binding = 1) uniform sampler2D diffuseSampler;
 layout(set = 0, binding = 2) uniform sampler2D specularSampler;
 layout(set = 0, binding = 3) uniform UniformBufferObject {
-    SpotLight SpotLights[MAX_LIGHTS];
+    // Stores x=unused, y=has diffuse, z=has specular, w=shininess
+    vec4 ObjectLightInfo;
+
+} UniformBufferData;
+
+// Lights of the scene, written once per frame by the renderer and shared by every material
+layout(std430, set = 1, binding = 0) readonly buffer SceneLightsBuffer {
+    // x=directional, y=point, z=spot, w=unused
+    ivec4 LightCounts;
+
+    // xyz=clusters per axis, w=max lights per cluster
+    uvec4 ClusterGridSize;
+
+    // x=near, y=far, z=depth slice scale, w=depth slice bias
+    vec4 ClusterDepthParams;
+
+    // xy=render target size, zw=cluster tile size (in pixels)
+    vec4 ScreenSize;
+
+    mat4 View;
+    mat4 InverseProjection;
+
+    DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS];
     PointLight PointLights[MAX_LIGHTS];
-    DirectionalLight DirectionalLights[MAX_LIGHTS];
+    SpotLight SpotLights[MAX_LIGHTS];
+} SceneLights;
+
+// Written by the light culling pass. x=offset in the indices list, y=point lights count, z=spot lights count
+layout(std430, set = 1, binding = 1) readonly buffer ClusterGridBuffer {
+    uvec4 Clusters[];
+} ClusterGrid;
 
+layout(std430, set = 1, binding = 2) readonly buffer ClusterLightIndicesBuffer {
+    uint Indices[];
+} ClusterLightIndices;
+
+// Camera of the frame, shared by every draw (see VulkanRenderer::FrameUniformData)
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
+    mat4 View;
+    mat4 Projection;
     vec4 ViewPosition;
 
-    // Stores x=lights count, y=has diffuse, z=has specular, w=shininess
-    vec4 ObjectLightInfo;
+    // x=display mode, y=wireframe
+    ivec4 RenderSettings;
+} FrameData;
 
-    // holds count of each type of light
-    // x=dir, y=point, z=spot
-    vec4 LightTypesCount;
+// Cluster of the froxel containing this fragment
+uvec4 GetFragmentCluster(vec3 worldPosition) {
+    const uvec3 gridSize = SceneLights.ClusterGridSize.xyz;
+    const float viewDepth = -(SceneLights.View * vec4(worldPosition, 1.0)).z;
 
-} UniformBufferData;
+    const uint slice = min(uint(max(log(viewDepth) * SceneLights.ClusterDepthParams.z - SceneLights.ClusterDepthParams.w, 0.0)), gridSize.z - 1);
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / SceneLights.ScreenSize.zw), gridSize.xy - 1);
+
+    return ClusterGrid.Clusters[tile.x + tile.y * gridSize.x + slice * gridSize.x * gridSize.y];
+}
+
+// Smooth falloff reaching zero at the light's radius
+float ComputeAttenuation(float distance, float radius) {
+    return pow(max(1.0 - pow(distance / radius, 4.0), 0.0), 2.0) / (distance * distance + 1.0);
+}
 
 
 vec4 CalcDirLight(DirectionalLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
@@ -159,12 +199,12 @@ vec4 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
 
     // Attenuation
     const float distance = length(light.Position.rgb - fragPos);
-    const float attenuation = 1.0 / (light.Components.x + light.Components.y * distance + light.Components.z * (distance * distance));
+    const float attenuation = ComputeAttenuation(distance, light.CutOffValues.w);
 
     // spotlight intensity
     const float theta = dot(lightDir, normalize(-light.Direction.rgb));
     const float epsilon = light.CutOffValues.x - light.CutOffValues.y;
-    const float intensity = clamp((theta - light.CutOffValues.y) / epsilon, 0.0, 1.0);
+    const float intensity = clamp((theta - light.CutOffValues.y) / epsilon, 0.0, 1.0) * light.CutOffValues.z;
 
     // [Combine results]
     vec4 ambient;
@@ -230,7 +270,7 @@ vec4 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
 
     // [Attenuation]
     float distance = length(light.position.rgb - fragPos);
-    float attenuation = 5.0 / (light.components.x + light.components.y * distance + light.components.z * (distance * distance));
+    float attenuation = ComputeAttenuation(distance, light.attenuationParams.y) * light.attenuationParams.x;
 
     // [Combine results]
     vec4 ambient;
@@ -277,7 +317,7 @@ void main() {
 
     // [Constant properties]
     const vec3 norm = normalize(inNormals);
-    const vec3 viewDir = normalize(vec3(UniformBufferData.ViewPosition) - fragmentPos);
+    const vec3 viewDir = normalize(vec3(FrameData.ViewPosition) - fragmentPos);
     const float defaulAmbientIntensity = 0.4;
 
     // Final output result, acumulates the
@@ -299,23 +339,24 @@ void main() {
 
 
     // [1. Compute directional lights contribution]
-    const int limitDirectionalLights = int(UniformBufferData.LightTypesCount.x);
+    const int limitDirectionalLights = SceneLights.LightCounts.x;
     for (int index = 0; index < limitDirectionalLights; ++index) {
-        result += CalcDirLight(UniformBufferData.DirectionalLights[index], norm, fragmentPos, viewDir);
+        result += CalcDirLight(SceneLights.DirectionalLights[index], norm, fragmentPos, viewDir);
     }
 
     // [2. Compute point lights]
-    const int limitPointLights = int(UniformBufferData.LightTypesCount.y);
+    // Only the lights overlapping the cluster of this fragment, point light indices come first
+    const uvec4 cluster = GetFragmentCluster(fragmentPos);
 
-    for (int index = 0; index < limitPointLights; ++index) {
-        result += CalcPointLight(UniformBufferData.PointLights[index], norm, fragmentPos, viewDir);
+    for (uint index = 0; index < cluster.y; ++index) {
+        const uint lightIndex = ClusterLightIndices.Indices[cluster.x + index];
+        result += CalcPointLight(SceneLights.PointLights[lightIndex], norm, fragmentPos, viewDir);
     }
 
     // [2. Compute spot lights contribution]
-    const int limitSpotLights = int(UniformBufferData.LightTypesCount.z);
-
-    for (int index = 0; index < limitSpotLights; ++index) {
-        result += CalcSpotLight(UniformBufferData.SpotLights[index], norm, fragmentPos, viewDir);
+    for (uint index = 0; index < cluster.z; ++index) {
+        const uint lightIndex = ClusterLightIndices.Indices[cluster.x + cluster.y + index];
+        result += CalcSpotLight(SceneLights.SpotLights[lightIndex], norm, fragmentPos, viewDir);
     }
 
     // [Final pixel output color]
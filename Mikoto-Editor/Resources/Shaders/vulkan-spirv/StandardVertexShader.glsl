@@ -11,11 +11,24 @@
 
 // [Uniform buffer elements]
 layout(set = 0, binding = 0) uniform UniformBufferObject {
+    vec4 Color;
+} UniformBufferData;
+
+// Camera of the frame, shared by every draw (scene set, see VulkanRenderer::FrameUniformData)
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
     mat4 View;
     mat4 Projection;
+    vec4 ViewPosition;
+
+    // x=display mode, y=wireframe
+    ivec4 RenderSettings;
+} FrameData;
+
+// Per draw data, see VulkanRenderer::DrawPushConstants. The material index is unused
+layout(push_constant) uniform DrawData {
     mat4 Transform;
-    vec4 Color;
-} UniformBufferData;
+    uint MaterialIndex;
+} Draw;
 
 // [Vertex Buffer elements]
 layout(location = 0) in vec3 a_Position;
@@ -38,7 +51,7 @@ void main() {
     out_VertexTexCoord = a_TextureCoordinates;
     out_ObjectsColor = UniformBufferData.Color;
     out_VertexColor = a_Color;
-    out_FragmentPos = vec3(UniformBufferData.Transform * vec4(a_Position, 1.0));
+    out_FragmentPos = vec3(Draw.Transform * vec4(a_Position, 1.0));
 
-    gl_Position = UniformBufferData.Projection * UniformBufferData.View * UniformBufferData.Transform * vec4(a_Position, 1.0);
+    gl_Position = FrameData.Projection * FrameData.View * Draw.Transform * vec4(a_Position, 1.0);
 }
\ No newline at end of file
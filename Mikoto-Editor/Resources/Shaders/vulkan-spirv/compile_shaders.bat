@@ -3,4 +3,7 @@ glslc -O -fshader-stage="fragment" StandardFragmentShader.glsl -o StandardFragme
 glslc -O -fshader-stage="fragment" WireframeFragmentShader.glsl -o WireframeFragmentShader.sprv
 
 glslc -O -fshader-stage="fragment" PBRFragmentShader.glsl -o PBRFragmentShader.sprv
-glslc -O -fshader-stage="vertex" PBRVertexShader.glsl -o PBRVertexShader.sprv
\ No newline at end of file
+glslc -O -fshader-stage="vertex" PBRVertexShader.glsl -o PBRVertexShader.sprv
+glslc -O -fshader-stage="compute" ClusteredLightCulling.glsl -o ClusteredLightCulling.sprv
+glslc -O -fshader-stage="vertex" DepthPrepassVertexShader.glsl -o DepthPrepassVertexShader.sprv
+glslc -O -fshader-stage="compute" DrawCulling.glsl -o DrawCulling.sprv
\ No newline at end of file
@@ -6,11 +6,14 @@
 // C++ Standard Library
 #include <stdexcept>
 #include <cstdlib>
+#include <span>
+#include <string_view>
 #include <utility>
 
 // Project headers
 #include <Common/Constants.hh>
 #include <Core/Engine.hh>
+#include <Core/Events/AssetEvents.hh>
 #include <Core/System/EventSystem.hh>
 #include <Core/System/InputSystem.hh>
 #include <Core/System/TaskSystem.hh>
@@ -18,6 +21,8 @@
 #include <EditorApp.hh>
 #include <Layers/EditorLayer.hh>
 #include <Library/Filesystem/PathBuilder.hh>
+#include <Library/String/String.hh>
+#include <Material/Texture/TextureCooker.hh>
 #include <Profiling/Timer.hh>
 #include <Core/Logging/StackTrace.hh>
 
@@ -28,20 +33,65 @@ namespace Mikoto {
             return "Displays the help menu.";
         }
 
+        if ( command == "--cook-textures" ) {
+            return "Cooks the textures of the given models to block compressed KTX2 files and exits.";
+        }
+
         return "Unknown command.";
     }
 
+    static auto CookTextures( const std::span<char*> modelPaths ) -> Int32_T {
+        TextureCookReport total{};
+
+        for ( const char* modelPath : modelPaths ) {
+            try {
+                const TextureCookReport report{ TextureCooker::CookModelTextures( modelPath ) };
+
+                MKT_COLOR_PRINT_FORMATTED( MKT_FMT_COLOR_AQUA, "{}: {} cooked, {} up-to-date, {} failed\n",
+                    modelPath, report.CookedCount, report.SkippedCount, report.FailedCount );
+
+                total.CookedCount += report.CookedCount;
+                total.SkippedCount += report.SkippedCount;
+                total.FailedCount += report.FailedCount;
+                total.UncompressedBytes += report.UncompressedBytes;
+                total.CookedBytes += report.CookedBytes;
+            } catch ( const std::exception& exception ) {
+                MKT_COLOR_STYLE_PRINT_FORMATTED( MKT_FMT_COLOR_RED, MKT_FMT_STYLE_BOLD, "{}\n", exception.what() );
+                ++total.FailedCount;
+            }
+        }
+
+        constexpr double bytesPerMegabyte{ 1024.0 * 1024.0 };
+
+        MKT_COLOR_PRINT_FORMATTED( MKT_FMT_COLOR_GREEN, "Cooked {} textures: {:.2f} MB uncompressed, {:.2f} MB cooked\n",
+            total.CookedCount, static_cast<double>( total.UncompressedBytes ) / bytesPerMegabyte, static_cast<double>( total.CookedBytes ) / bytesPerMegabyte );
+
+        return total.FailedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     auto EditorApp::Run( const Int32_T argc, char **argv ) -> Int32_T {
+        // Offline cooking needs neither the window nor the engine systems
+        if ( argc > 2 && std::string_view{ argv[1] } == "--cook-textures" ) {
+            return CookTextures( std::span{ argv + 2, static_cast<Size_T>( argc - 2 ) } );
+        }
+
         Int32_T exitCode{ EXIT_SUCCESS };
 
         ParseCommandLineArgs( argc, argv );
 
         try {
+            const Timer startupTimer{ "EditorApp::Run - Measuring time to first frame." };
+            bool isFirstFrame{ true };
 
             Init();
 
             while ( IsRunning() ) {
                 UpdateState();
+
+                if ( isFirstFrame ) {
+                    MKT_APP_LOGGER_INFO( "EditorApp::Run - Time to first frame {:.2f} ms", startupTimer.GetCurrentProgress( TimeUnit::MILLISECONDS ) );
+                    isFirstFrame = false;
+                }
             }
 
             Shutdown();
@@ -132,6 +182,20 @@ namespace Mikoto {
                                     MKT_APP_LOGGER_WARN("EditorApp::EventManager - Handled Window Resize Event");
                                     return false;
                                 });
+
+        eventManager.Subscribe(m_Guid.Get(),
+                                EventType::MODEL_LOAD_EVENT,
+                                [](Event &event) -> bool {
+                                    const ModelLoadHandle& handle{ static_cast<ModelLoadEvent&>(event).GetHandle() };
+
+                                    if (handle.IsReady()) {
+                                        MKT_APP_LOGGER_INFO("EditorApp::EventManager - Model [{}] loaded", handle.GetPath().string());
+                                    } else {
+                                        MKT_APP_LOGGER_ERROR("EditorApp::EventManager - Model [{}] failed to load", handle.GetPath().string());
+                                    }
+
+                                    return false;
+                                });
     }
 
     auto EditorApp::Shutdown() -> void {
@@ -118,6 +118,7 @@ namespace Mikoto {
         // Setup renderer
         m_EditorRenderer->SetClearColor( settingsPanel.GetData().ClearColor );
         m_EditorRenderer->EnableWireframe( settingsPanel.GetData().RenderWireframeMode );
+        m_EditorRenderer->EnableDepthPrepass( settingsPanel.GetData().RenderDepthPrepass );
 
         // Setup scene
         m_ActiveScene->SetCamera( *m_EditorCamera );
@@ -332,12 +332,14 @@ namespace Mikoto {
                     .WantTextures = true,
                 };
 
-                const Model* model{ assetsSystem.LoadModel( modelLoadInfo ) };
+                // The entity stays empty until the model is ready, the editor keeps running meanwhile
+                const ModelLoadHandle modelHandle{ assetsSystem.LoadModelAsync( modelLoadInfo ) };
 
                 const EntityCreateInfo entityCreateInfo{
                     .Name = path.stem().string(),
                     .Root = nullptr,
-                    .ModelMesh = model,
+                    .ModelMesh = nullptr,
+                    .ModelHandle = modelHandle,
                 };
 
                 m_TargetScene->CreateEntity( entityCreateInfo );
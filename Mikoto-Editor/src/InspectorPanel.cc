@@ -1231,12 +1231,14 @@ namespace Mikoto {
                     .WantTextures = true,
                 };
 
-                const Model* model{ assetsSystem.LoadModel( modelLoadInfo ) };
+                // The entity stays empty until the model is ready, the editor keeps running meanwhile
+                const ModelLoadHandle modelHandle{ assetsSystem.LoadModelAsync( modelLoadInfo ) };
 
                 const EntityCreateInfo entityCreateInfo{
                     .Name = path.stem().string(),
                     .Root = std::addressof( entity ),
-                    .ModelMesh = model,
+                    .ModelMesh = nullptr,
+                    .ModelHandle = modelHandle,
                 };
 
                 scene->CreateEntity( entityCreateInfo );
@@ -166,6 +166,9 @@ namespace Mikoto {
                 ImGui::Spacing();
                 ImGuiUtils::CheckBox("Wireframe render", m_Data.RenderWireframeMode);
 
+                ImGui::Spacing();
+                ImGuiUtils::CheckBox("Depth pre-pass", m_Data.RenderDepthPrepass);
+
                 ImGui::TreePop();
             }
 
@@ -14,6 +14,7 @@
 
 // Project Libraries
 #include <Common/Common.hh>
+#include <Library/Mesh/MeshOptimizer.hh>
 #include <Material/Core/Material.hh>
 #include <Material/Texture/Texture2D.hh>
 #include <Renderer/Buffer/IndexBuffer.hh>
@@ -21,6 +22,24 @@
 
 namespace Mikoto {
 
+    // Levels of detail a mesh can have, the full one included
+    constexpr Size_T MAX_MESH_LODS{ 4 };
+
+    /**
+     * Range of the index buffer of a mesh that draws it at one level of detail. Every level uses the same vertices
+     * */
+    struct MeshLod {
+        UInt32_T FirstIndex{};
+        UInt32_T IndexCount{};
+
+        // Object space distance the surface may be off from the full mesh, zero for the full mesh
+        float Error{};
+
+        // Meshlets splitting the range, culled one by one. None if the mesh was built without them
+        UInt32_T FirstMeshlet{};
+        UInt32_T MeshletCount{};
+    };
+
     class Mesh final {
     public:
         /**
@@ -31,8 +50,12 @@ namespace Mikoto {
         /**
         * Initializes this mesh from the parameter data.
         * @param data contains the required data to initialize this mesh
+        * @param lods levels of detail, finest first. The whole index buffer is the only level if empty
+        * @param meshlets meshlets of every level of detail, their index ranges are relative to the index buffer
+        * The buffers may be shared with other meshes of the same geometry, see AssetsSystem::LoadMeshBuffers()
         * */
-        explicit Mesh( std::string_view name, Scope_T<VertexBuffer>&& vertices, Scope_T<IndexBuffer>&& indices, std::vector<Texture2D*>&& textures, const Path_T& path );
+        explicit Mesh( std::string_view name, Ref_T<VertexBuffer> vertices, Ref_T<IndexBuffer> indices, std::vector<Texture2D*>&& textures, const Path_T& path,
+                       std::vector<MeshLod>&& lods = {}, std::vector<MeshOptimizer::Meshlet>&& meshlets = {} );
 
 
         /**
@@ -70,6 +93,19 @@ namespace Mikoto {
         MKT_NODISCARD auto GetIndexBuffer() const -> const IndexBuffer* { return m_Indices.get(); }
 
 
+        /**
+         * Returns the levels of detail of this mesh, the first one is the full mesh
+         * @returns index ranges of the levels of detail, finest first
+         * */
+        MKT_NODISCARD auto GetLods() const -> const std::vector<MeshLod>& { return m_Lods; }
+
+        /**
+         * Returns the meshlets of this mesh, each level of detail says which ones are its own
+         * @returns meshlets of every level of detail
+         * */
+        MKT_NODISCARD auto GetMeshlets() const -> const std::vector<MeshOptimizer::Meshlet>& { return m_Meshlets; }
+
+
         /**
          * Returns the set of textures of this mesh
          * @returns set of textures
@@ -91,8 +127,10 @@ namespace Mikoto {
         Path_T m_ModelAbsolutePath{};
 
         std::string m_Name{};
-        Scope_T<VertexBuffer> m_Vertices{};
-        Scope_T<IndexBuffer> m_Indices{};
+        Ref_T<VertexBuffer> m_Vertices{};
+        Ref_T<IndexBuffer> m_Indices{};
+        std::vector<MeshLod> m_Lods{};
+        std::vector<MeshOptimizer::Meshlet> m_Meshlets{};
         std::vector<Texture2D*> m_Textures{};
     };
 }// namespace Mikoto
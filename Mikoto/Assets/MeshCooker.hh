@@ -0,0 +1,43 @@
+/**
+ * MeshCooker.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_MESH_COOKER_HH
+#define MIKOTO_MESH_COOKER_HH
+
+// Project Headers
+#include <Assets/Model.hh>
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+    /**
+     * @class MeshCooker
+     * @brief Binary cache of imported models, stored in .mktmesh files next to their source.
+     * A file holds the interleaved vertices of every mesh in the layout of its vertex format, their
+     * indices for every level of detail, their meshlets, the submesh table with names, bounds and level
+     * of detail ranges, and the textures of their materials.
+     * It is memory mapped when loaded, the meshes read their data from the mapping.
+     * */
+    class MeshCooker final {
+    public:
+        MKT_NODISCARD static auto GetCookedPath( const Path_T& source ) -> Path_T;
+
+        /**
+         * @brief Writes the cooked file of an imported model, throws if it cannot be written.
+         * @returns size of the file in bytes
+         * */
+        static auto Write( const ModelData& data ) -> Size_T;
+
+        /**
+         * @brief Maps the cooked file of a model. The vertices and indices of the meshes point into the mapping,
+         * which is kept alive by the returned data. Safe to call from any thread.
+         * @returns the model, null if the file is missing, older than its source or was cooked with other options
+         * */
+        MKT_NODISCARD static auto Load( const ModelLoadInfo& info ) -> Scope_T<ModelData>;
+    };
+}
+
+#endif // MIKOTO_MESH_COOKER_HH
@@ -9,25 +9,90 @@
 // C++ Standard Library
 #include <cstdint>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 // Third Party Libraries
 #include <assimp/scene.h>
 
 #include <assimp/Importer.hpp>
+#include <glm/glm.hpp>
 
 // Project Libraries
 #include <Assets/Mesh.hh>
 #include <Common/Common.hh>
+#include <Library/Filesystem/MappedFile.hh>
+#include <Library/Mesh/MeshOptimizer.hh>
 #include <Material/Texture/Texture2D.hh>
+#include <Renderer/Buffer/VertexBuffer.hh>
 
 namespace Mikoto {
     struct ModelLoadInfo {
         Path_T Path{};
         bool InvertedY{};// Y down (for vulkan)
         bool WantTextures{ true };
+
+        // Layout of the vertices of the meshes, see VertexFormat
+        VertexFormat Format{ VertexFormat::COMPACT };
+    };
+
+    /**
+     * Vertices and indices of one mesh as imported, before any GPU buffer is created
+     * */
+    struct ModelMeshData {
+        std::string Name{};
+
+        // Follow the layout of ModelLoadInfo::Format, see Model::ProcessMesh()
+        std::vector<UInt8_T> Vertices{};
+
+        // Indices of every level of detail, one after another
+        std::vector<UInt32_T> Indices{};
+
+        // Used instead of the vectors when the model comes from its cooked file, they point into ModelData::CookedFile
+        std::span<const UInt8_T> MappedVertices{};
+        std::span<const UInt32_T> MappedIndices{};
+
+        // Ranges the compact vertices were quantized to
+        VertexDequantization Dequantization{};
+
+        // Levels of detail in Indices, the full mesh first
+        std::vector<MeshLod> Lods{};
+
+        // Meshlets of every level of detail, see MeshLod::FirstMeshlet
+        std::vector<MeshOptimizer::Meshlet> Meshlets{};
+
+        // Object space bounding box
+        glm::vec3 BoundsMin{};
+        glm::vec3 BoundsMax{};
+
+        // Indices into ModelData::Textures, in the order the textures are added to the mesh
+        std::vector<Size_T> TextureIndices{};
+
+        MKT_NODISCARD auto GetVertices() const -> std::span<const UInt8_T> { return Vertices.empty() ? MappedVertices : std::span<const UInt8_T>{ Vertices }; }
+        MKT_NODISCARD auto GetIndices() const -> std::span<const UInt32_T> { return Indices.empty() ? MappedIndices : std::span<const UInt32_T>{ Indices }; }
+    };
+
+    /**
+     * CPU side result of importing a model file. Produced by Model::Import(),
+     * which does not touch the engine systems, and turned into a Model on the main thread.
+     * */
+    struct ModelData {
+        ModelLoadInfo Info{};
+
+        std::vector<ModelMeshData> Meshes{};
+
+        // Textures referenced by the meshes, each one once. Listed even if the textures are not wanted
+        std::vector<TextureLoadInfo> Textures{};
+
+        // Matches Textures when they were decoded at import, null for the ones that failed.
+        // Empty otherwise, the textures are then decoded when the model is created
+        std::vector<Scope_T<Texture2DData>> DecodedTextures{};
+
+        // Mapping of the cooked file the meshes were read from, see MeshCooker
+        Scope_T<MappedFile> CookedFile{};
     };
 
     class Model final {
@@ -46,6 +111,25 @@ namespace Mikoto {
         explicit Model( const ModelLoadInfo &info );
 
 
+        /**
+         * Creates the GPU resources of a model imported beforehand with Import().
+         * Must be called from the main thread. The decoded textures are taken from the data.
+         * @param data imported model
+         * */
+        explicit Model( ModelData &data );
+
+
+        /**
+         * Reads the model from its cooked file, or imports the source file and cooks it. Does not create
+         * GPU resources, the only engine system it uses is the TaskSystem, so it can run on any thread.
+         * @param info Information to load model, see definition of ModelLoadInfo
+         * @param decodeTextures decode the textures of the materials too, only when info.WantTextures is set
+         * @returns the imported model
+         * @throws std::runtime_error if the file does not exist or the path is invalid
+         * */
+        MKT_NODISCARD static auto Import( const ModelLoadInfo &info, bool decodeTextures ) -> Scope_T<ModelData>;
+
+
         /**
          * Returns the list of meshes from this model
          * @returns non-mutable list of meshes
@@ -108,35 +192,52 @@ namespace Mikoto {
 
     private:
         /**
-         * Helper function to load model resources from given path
-         * @param wantLoadTextures tells whether we want to attempt to load this model's textures
+         * Imports the source file with Assimp and builds the vertices and indices of its meshes
+         * @param info Information to load model, see definition of ModelLoadInfo
+         * @returns the imported model, without decoded textures
          * @throws std::runtime_error if the file does not exist or the path is invalid
          * */
-        auto Load( bool wantLoadTextures = false ) -> void;
+        MKT_NODISCARD static auto ImportSource( const ModelLoadInfo &info ) -> Scope_T<ModelData>;
 
 
         /**
-         * Retrieves each one of the meshes contained within the scene
-         * into this Model. This process starts from the given node
-         * traversing all of its children nodes
+         * Creates the textures of the model, then the buffers of every mesh
+         * @param data imported model
+         * */
+        auto Load( ModelData &data ) -> void;
+
+
+        /**
+         * Gathers each one of the meshes contained within the scene, in the order the
+         * model lists them. This process starts from the given node traversing all of its children nodes
          * @param root contains components of the given scene
          * @param scene represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
-         * @param modelDirectory The model's directory
-         * @param wantLoadTextures tells whether we want to attempt to load this model's textures
+         * @param meshes receives the meshes
+         * */
+        static auto ProcessNode( const aiNode *root, const aiScene *scene, std::vector<const aiMesh *> &meshes ) -> void;
+
+
+        /**
+         * Retrieves the vertices and indices of the given mesh, optimizes their order for the vertex
+         * cache, overdraw and vertex fetch and builds its levels of detail and their meshlets. Only reads the mesh, so several can run at once
+         * @param mesh A mesh from the scene (for usage with Assimp)
+         * @param info Information the model is loaded with
+         * @param cacheBefore receives the vertex cache statistics of the imported order
+         * @param cacheAfter receives the vertex cache statistics of the optimized order, for the full level of detail
+         * @returns mesh containing the retrieved data, without textures
          * */
-        auto ProcessNode( const aiNode *root, const aiScene *scene, const Path_T &modelDirectory, bool wantLoadTextures ) -> void;
+        static auto ProcessMesh( const aiMesh *mesh, const ModelLoadInfo &info, MeshOptimizer::VertexCacheStatistics &cacheBefore, MeshOptimizer::VertexCacheStatistics &cacheAfter ) -> ModelMeshData;
 
 
         /**
-         * Retrieves the components of the Mesh contained within
-         * the given node from the given scene
-         * @param node A mesh node (for usage with Assimp)
+         * Retrieves the textures of the material of the given mesh
+         * @param mesh A mesh from the scene (for usage with Assimp)
          * @param scene Represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
          * @param modelDirectory The model's directory
-         * @param wantLoadTextures Tells whether we want to attempt to load this model's textures
-         * @returns mesh containing the retrieved data
+         * @param data Imported model, receives the textures not seen yet
+         * @param meshData Mesh the textures are added to
          * */
-        auto ProcessMesh( const aiMesh *node, const aiScene *scene, const Path_T &modelDirectory, bool wantLoadTextures ) const -> Scope_T<Mesh>;
+        static auto ProcessMaterial( const aiMesh *mesh, const aiScene *scene, const Path_T &modelDirectory, ModelData &data, ModelMeshData &meshData ) -> void;
 
 
         /**
@@ -146,9 +247,10 @@ namespace Mikoto {
          * @param tType Specifies the type of texture for the <b>kT::Texture</b> object
          * @param scene Represents a complete scene, which contains aiNodes and the associated meshes, materials, etc.
          * @param modelDirectory The model's directory
-         * @returns A list of textures from the given material of type
+         * @param data Imported model, receives the textures not seen yet
+         * @param meshData Mesh the textures are added to
          * */
-        static auto LoadTextures( const aiMaterial *mat, aiTextureType type, MapType tType, const aiScene *scene, const Path_T &modelDirectory ) -> std::vector<Texture2D*>;
+        static auto CollectTextures( const aiMaterial *mat, aiTextureType type, MapType tType, const aiScene *scene, const Path_T &modelDirectory, ModelData &data, ModelMeshData &meshData ) -> void;
 
     protected:
         Path_T m_ModelAbsolutePath{};
@@ -161,6 +263,54 @@ namespace Mikoto {
         /** Y points Down (suits vulkan coordinate system) */
         bool m_InvertedY{};
     };
+
+    enum class ModelLoadState {
+        PENDING,
+        READY,
+        FAILED,
+    };
+
+    /**
+     * Refers to a model requested with AssetsSystem::LoadModelAsync(). Copies share the
+     * same request. The state only changes on the main thread, in AssetsSystem::Update().
+     * */
+    class ModelLoadHandle final {
+    public:
+        explicit ModelLoadHandle() = default;
+
+        MKT_NODISCARD auto IsValid() const -> bool { return m_Request != nullptr; }
+
+        MKT_NODISCARD auto GetState() const -> ModelLoadState { return m_Request != nullptr ? m_Request->State : ModelLoadState::FAILED; }
+        MKT_NODISCARD auto IsPending() const -> bool { return GetState() == ModelLoadState::PENDING; }
+        MKT_NODISCARD auto IsReady() const -> bool { return GetState() == ModelLoadState::READY; }
+        MKT_NODISCARD auto IsFailed() const -> bool { return GetState() == ModelLoadState::FAILED; }
+
+        /**
+         * Returns the loaded model
+         * @returns the model, null until the handle is ready
+         * */
+        MKT_NODISCARD auto GetModel() const -> Model* { return m_Request != nullptr ? m_Request->Result : nullptr; }
+
+        MKT_NODISCARD auto GetPath() const -> const Path_T& { return m_Request->Path; }
+
+    private:
+        friend class AssetsSystem;
+
+        struct Request {
+            Path_T Path{};
+            ModelLoadState State{ ModelLoadState::PENDING };
+            Model* Result{};
+        };
+
+        explicit ModelLoadHandle( Ref_T<Request> request )
+            :   m_Request{ std::move( request ) }
+        {
+
+        }
+
+    private:
+        Ref_T<Request> m_Request{};
+    };
 }// namespace Mikoto
 
 #endif// MIKOTO_MODEL_HH
\ No newline at end of file
@@ -39,9 +39,11 @@ namespace Mikoto {
         Path_T ImGuiConfigDir{};
         Path_T IconsPath{};
         Path_T FontsPath{};
+        Path_T PipelineCachePath{};
 
         // Renderer
         bool EnableVSync{ };
+        UInt32_T FramesInFlight{ 2 };
         GraphicsAPI RendererAPI{ GraphicsAPI::VULKAN_API };
 
         // Application
@@ -95,8 +97,11 @@ namespace Mikoto {
                 .ImGuiConfigDir{ PathBuilder().WithPath(assetsRoot.string()).WithPath(paths->at("imgui_config").value_or("")).Build() },
                 .IconsPath{ PathBuilder().WithPath(assetsRoot.string()).WithPath(paths->at("icons").value_or("")).Build() },
                 .FontsPath{ PathBuilder().WithPath(assetsRoot.string()).WithPath(paths->at("fonts").value_or("")).Build() },
+                // Optional, pipelines are not persisted without it
+                .PipelineCachePath{ paths->contains("pipeline_cache") ? PathBuilder().WithPath(assetsRoot.string()).WithPath(paths->at("pipeline_cache").value_or("")).Build() : Path_T{} },
 
                 .EnableVSync{ renderer->at("vsync").value_or(false) },
+                .FramesInFlight{ renderer->at("frames_in_flight").value_or<UInt32_T>(2) },
                 .RendererAPI{ GraphicsAPI::VULKAN_API },
                 .WindowTitle{ application->at("title").value_or("") },
                 .WindowWidth{ application->at("width").value_or(0) },
@@ -0,0 +1,52 @@
+/**
+ * AssetEvents.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_ASSET_EVENTS_HH
+#define MIKOTO_ASSET_EVENTS_HH
+
+// C++ Standard Library
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Third-Party Libraries
+#include <fmt/core.h>
+
+// Project Headers
+#include <Assets/Model.hh>
+#include <Common/Common.hh>
+#include <Core/Events/Event.hh>
+
+namespace Mikoto {
+    /**
+     * Triggered once a model requested with AssetsSystem::LoadModelAsync() is ready or has failed to load
+     * */
+    class ModelLoadEvent final : public Event {
+    public:
+        explicit ModelLoadEvent( ModelLoadHandle handle )
+            :   Event{ GetStaticType(), GetCategoryFromType(GetStaticType()) }
+            ,   m_Handle{ std::move( handle ) }
+        {
+
+        }
+
+        MKT_NODISCARD auto GetHandle() const -> const ModelLoadHandle& { return m_Handle; }
+        MKT_NODISCARD auto GetType() const -> EventType override { return GetStaticType(); }
+
+        MKT_NODISCARD static auto GetStaticType() -> EventType { return EventType::MODEL_LOAD_EVENT; }
+
+        MKT_NODISCARD auto DisplayData() const -> std::string override {
+            return fmt::format("{}! Model [{}] {}", GetEventFormattedStr(GetType()).data(), m_Handle.GetPath().string(), m_Handle.IsReady() ? "ready" : "failed");
+        }
+
+    protected:
+        MKT_NODISCARD auto ToString() const -> std::string_view override { return GetEventFormattedStr(GetType()); }
+
+    private:
+        ModelLoadHandle m_Handle{};
+    };
+}
+
+#endif // MIKOTO_ASSET_EVENTS_HH
@@ -181,6 +181,8 @@ namespace Mikoto {
 
             case EventType::CAMERA_ENABLE_ROTATION: return PANEL_EVENT_CATEGORY;
 
+            case EventType::MODEL_LOAD_EVENT: return ASSET_EVENT_CATEGORY;
+
             default: return EMPTY_EVENT_CATEGORY;
         }
     }
@@ -228,6 +230,10 @@ namespace Mikoto {
             // Category [PANEL_EVENT_CATEGORY]
             case EventType::CAMERA_ENABLE_ROTATION: return "CAMERA_ENABLE_ROTATION";
 
+            // Asset events.
+            // Category [ASSET_EVENT_CATEGORY]
+            case EventType::MODEL_LOAD_EVENT: return "MODEL_LOAD_EVENT";
+
             default: return "EVENT_TYPE_COUNT";
         }
     }
@@ -5,17 +5,47 @@
 #ifndef ASSETSSYSTEM_HH
 #define ASSETSSYSTEM_HH
 
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 #include <Core/Engine.hh>
+#include <Core/System/TaskSystem.hh>
 #include <Common/Common.hh>
 #include <Library/Utility/Types.hh>
 #include <Assets/Model.hh>
+#include <Renderer/Buffer/IndexBuffer.hh>
+#include <Renderer/Buffer/VertexBuffer.hh>
 #include <Assets/Texture.hh>
 #include <Assets/Font.hh>
 
 namespace Mikoto {
+    /**
+     * Assets that resolved to one already loaded because their contents are the same,
+     * and the bytes of their files or buffers that were not decoded and uploaded again.
+     * */
+    struct AssetDeduplicationStats {
+        Size_T TextureCount{};
+        UInt64_T TextureBytes{};
+
+        Size_T MeshCount{};
+        UInt64_T MeshBytes{};
+    };
+
+    /**
+     * GPU buffers of a mesh, shared by the meshes with the same vertices and indices
+     * */
+    struct MeshBuffers {
+        Ref_T<VertexBuffer> Vertices{};
+        Ref_T<IndexBuffer> Indices{};
+    };
+
     class AssetsSystem final : public IEngineSystem {
     public:
         explicit AssetsSystem() = default;
@@ -32,22 +62,116 @@ namespace Mikoto {
         MKT_NODISCARD auto GetFont(std::string_view uri) -> Font*;
 
         MKT_NODISCARD auto LoadModel(const ModelLoadInfo& info) -> Model*;
+
+        /**
+         * Requests a model without blocking. The file is imported and its textures decoded on the
+         * TaskSystem workers, the GPU resources are created on the main thread in Update(), which then
+         * triggers a ModelLoadEvent. Requests for a model already loaded or pending share the handle.
+         * @returns handle to the request, failed if the path is not absolute
+         * */
+        MKT_NODISCARD auto LoadModelAsync(const ModelLoadInfo& info) -> ModelLoadHandle;
+
+        /**
+         * Loads a texture, files with the same contents as a texture already loaded share it.
+         * */
         MKT_NODISCARD auto LoadTexture(const TextureLoadInfo& info) -> Texture*;
+
+        /**
+         * Creates a 2D texture from texels decoded beforehand with Texture2D::Decode().
+         * The data is not used if the texture, or one with the same file contents, is already loaded.
+         * */
+        MKT_NODISCARD auto LoadTexture(const TextureLoadInfo& info, Texture2DData& data) -> Texture*;
+
+        /**
+         * Loads several textures at once. The files are decoded in parallel with DecodeTextures(),
+         * the GPU resources are created and uploaded on the calling thread afterwards.
+         * Must be called from the main thread.
+         * @returns the textures in the order of the infos, null for those that failed to load
+         * */
+        MKT_NODISCARD auto LoadTextures(std::span<const TextureLoadInfo> infos) -> std::vector<Texture*>;
+
+        /**
+         * Decodes the texture files in parallel on the TaskSystem workers, one job per file.
+         * Does not touch the loaded assets, safe to call from any thread.
+         * @returns the decoded texels in the order of the infos, null for those that failed to decode
+         * */
+        MKT_NODISCARD static auto DecodeTextures(std::span<const TextureLoadInfo> infos) -> std::vector<Scope_T<Texture2DData>>;
         MKT_NODISCARD auto LoadFont(const FontLoadInfo& info) -> Font*;
 
+        /**
+         * Creates the GPU buffers of an imported mesh, or returns those of a loaded mesh
+         * with the same vertices, indices and format. Must be called from the main thread.
+         * */
+        MKT_NODISCARD auto LoadMeshBuffers(const ModelMeshData& data, VertexFormat format) -> MeshBuffers;
+
+        MKT_NODISCARD auto GetDeduplicationStats() const -> const AssetDeduplicationStats& { return m_DeduplicationStats; }
+
         auto Shutdown() -> void override;
         auto Update() -> void override;
 
     private:
 
+        struct ModelLoadJob {
+            ModelLoadInfo Info{};
+            ModelLoadHandle Handle{};
+
+            // Null if the import failed
+            Scope_T<ModelData> Data{};
+        };
+
+        // Identifies the contents of an asset, the type is part of it since
+        // the same texels are not uploaded the same way for every map type
+        struct ContentKey {
+            UInt64_T Hash{};
+            UInt64_T Size{};
+            UInt32_T Type{};
+
+            auto operator==( const ContentKey& other ) const -> bool = default;
+        };
+
+        struct ContentKeyHasher {
+            auto operator()( const ContentKey& key ) const -> Size_T { return static_cast<Size_T>( key.Hash ^ ( key.Size << 1 ) ^ key.Type ); }
+        };
+
+        struct MeshBuffersEntry {
+            std::weak_ptr<VertexBuffer> Vertices{};
+            std::weak_ptr<IndexBuffer> Indices{};
+        };
+
+    private:
         static auto CreateTextureFromType( const TextureLoadInfo& info ) -> Texture*;
+        static auto GetTextureContentKey( const TextureLoadInfo& info ) -> ContentKey;
+
+        auto FindTextureByContent( const TextureLoadInfo& info, const ContentKey& key ) -> Texture*;
+        auto AddTexture( const TextureLoadInfo& info, const ContentKey& key, Scope_T<Texture>&& texture ) -> Texture*;
+
+        auto ImportModel( const ModelLoadInfo& info, const ModelLoadHandle& handle ) -> void;
+        auto FinishModelLoads() -> void;
 
     private:
         std::unordered_map<std::string, Scope_T<Model>> m_Models{};
-        std::unordered_map<std::string, Scope_T<Texture>> m_Textures{};
         std::unordered_map<std::string, Scope_T<Font>> m_Fonts{};
 
+        // Textures by path, several paths point to the same texture when their files have the same contents
+        std::unordered_map<std::string, Texture*> m_Textures{};
+        std::unordered_map<ContentKey, Scope_T<Texture>, ContentKeyHasher> m_TextureContents{};
+
+        // Not owned, they are released with the last mesh using them
+        std::unordered_map<ContentKey, MeshBuffersEntry, ContentKeyHasher> m_MeshBuffers{};
+
+        AssetDeduplicationStats m_DeduplicationStats{};
+
         FT_Library m_FreeTypeLibrary{};
+
+        // Requests not ready yet, by path
+        std::unordered_map<std::string, ModelLoadHandle> m_PendingModels{};
+
+        // Imports running on the TaskSystem, their results wait in m_ImportedModels for Update()
+        TaskSystem::JobCounter m_ModelImportJobs{};
+        std::vector<ModelLoadJob> m_ImportedModels{};
+        bool m_IsShuttingDown{};
+
+        std::mutex m_ModelLoadMutex{};
     };
 
 }
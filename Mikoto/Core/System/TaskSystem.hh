@@ -8,6 +8,7 @@
 
 // C++ Standard Library
 #include <thread>
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <functional>
@@ -44,15 +45,33 @@ namespace Mikoto {
             UInt32_T GroupIndex;
         };
 
+        /**
+         * Tracks the jobs submitted with it, Wait() on it only waits for those
+         * instead of every job in the system. Must outlive its jobs.
+         * */
+        struct JobCounter {
+            std::atomic<UInt32_T> Pending{};
+        };
+
+        /**
+         * Entry of the job queue
+         * */
+        struct QueuedJob {
+            std::function<void()> Function{};
+
+            // Null if the job is not tracked
+            JobCounter* Counter{};
+        };
+
         /**
          * Add job to job queue.
          * This helper exists because we are using a standard library container as job queue,
          * The standard library containers are not guaranteed to be thread safe, so function simply ensures
          * modifying the job queue is thread safe.
          * */
-        auto EnqueueJob(std::function<void()>&& func) -> bool {
+        auto EnqueueJob(std::function<void()>&& func, JobCounter* counter = nullptr) -> bool {
             std::scoped_lock scopedLock{ m_JobQueueLock };
-            m_JobQueue.emplace_back(func);
+            m_JobQueue.emplace_back(QueuedJob{ .Function{ std::move(func) }, .Counter{ counter } });
 
             return true;
         }
@@ -60,14 +79,14 @@ namespace Mikoto {
         /**
          * Remove job to job queue.
          * */
-        auto PopFrontJob(std::function<void()>& jobWrapper) -> void {
+        auto PopFrontJob(QueuedJob& jobWrapper) -> void {
             std::scoped_lock scopedLock{ m_JobQueueLock };
 
             if (m_JobQueue.empty()) {
                 return;
             }
             else {
-                jobWrapper = m_JobQueue.front();
+                jobWrapper = std::move(m_JobQueue.front());
                 m_JobQueue.pop_front();
             }
         }
@@ -77,7 +96,7 @@ namespace Mikoto {
             m_FinishedLabel.store(0);
 
             // Init state of execution of the main thread
-            m_CurrentLabel = 0;
+            m_CurrentLabel.store(0);
 
             m_ThreadCount = ComputeTotalWorkerThreads();
 
@@ -86,28 +105,24 @@ namespace Mikoto {
                 m_Workers.emplace_back([this]() -> void {
 
                     // the current job for the thread, it's empty at the start.
-                    std::function<void()> task{};
+                    QueuedJob task{};
 
                     // This is the infinite loop that a worker thread will do
                     while (!m_Done) {
-                        if (!m_JobQueue.empty()) {
-                            // It found a job, execute it
-                            PopFrontJob(task);
+                        // The queue is only read under its lock, jobs are submitted from several threads
+                        PopFrontJob(task);
 
-                            if (task)  {
-                                task();
-
-                                // update worker label state
-                                m_FinishedLabel.fetch_add(1);
+                        if (task.Function)  {
+                            // It found a job, execute it
+                            RunJob(task);
 
-                                // Clear container after finishing the task
-                                task = {};
-                            }
+                            // Clear container after finishing the task
+                            task = {};
                         }
                         else {
                             // no job, put thread to sleep
                             std::unique_lock<std::mutex> lock{ m_WakeMutex };
-                            m_WakeCondition.wait(lock);
+                            m_WakeCondition.wait(lock, [this]() -> bool { return m_Done || HasQueuedJobs(); });
                         }
                     }
 
@@ -116,7 +131,11 @@ namespace Mikoto {
         }
 
         auto Shutdown() -> void override {
-            m_Done.store(true);
+            {
+                // A worker checking whether to sleep cannot miss it
+                std::scoped_lock lock{ m_WakeMutex };
+                m_Done.store(true);
+            }
 
             // notify all threads we are shutting down
             m_WakeCondition.notify_all();
@@ -132,6 +151,7 @@ namespace Mikoto {
 
         /**
          * Add a job to execute asynchronously. Any worker (thread) idling will execute this task.
+         * Jobs may be submitted from any thread, the workers included.
          * @param function task to be scheduled
          * @param funcArgs function arguments
          * @tparam Args pack containing the function's arguments
@@ -149,7 +169,7 @@ namespace Mikoto {
             // The main thread label state is updated
             // one job is being submitted, so the Task Manager only becomes
             // idle when the worker label reached the same value
-            m_CurrentLabel += 1;
+            m_CurrentLabel.fetch_add(1);
 
             // Try to push a new job until it is pushed successfully:
             while (!EnqueueJob(job)) {
@@ -157,7 +177,7 @@ namespace Mikoto {
             }
 
             // wake one thread
-            m_WakeCondition.notify_one();
+            WakeWorker();
         }
 
         /**
@@ -168,6 +188,68 @@ namespace Mikoto {
          * @param job the job to be executed
          * */
         auto Dispatch(UInt32_T jobCount, UInt32_T groupSize, const std::function<void(JobDispatchArgs)>& job) -> void {
+            DispatchGroups(jobCount, groupSize, job, nullptr);
+        }
+
+        /**
+         * Same as Dispatch(), the jobs are tracked by the counter so the caller
+         * can wait for them alone with Wait()
+         * */
+        auto Dispatch(UInt32_T jobCount, UInt32_T groupSize, const std::function<void(JobDispatchArgs)>& job, JobCounter& counter) -> void {
+            DispatchGroups(jobCount, groupSize, job, std::addressof(counter));
+        }
+
+        /**
+         * Returns once every job tracked by the counter is done. The calling thread runs
+         * the ones still queued meanwhile, so a job can wait for the jobs it submitted.
+         * Other jobs are left to the workers, long ones would delay the caller
+         * */
+        auto Wait(JobCounter& counter) -> void {
+            while (counter.Pending.load() > 0) {
+                QueuedJob task{};
+
+                {
+                    std::scoped_lock scopedLock{ m_JobQueueLock };
+
+                    const auto it{ std::ranges::find(m_JobQueue, std::addressof(counter), &QueuedJob::Counter) };
+
+                    if (it != m_JobQueue.end()) {
+                        task = std::move(*it);
+                        m_JobQueue.erase(it);
+                    }
+                }
+
+                if (task.Function) {
+                    RunJob(task);
+                } else {
+                    Poll();
+                }
+            }
+        }
+
+        /**
+         * Returns true if there's thread executing any work, not necessarily idle.
+         * @returns true if there's at least one thread doing some work, false otherwise
+         * */
+        MKT_NODISCARD auto IsBusy() const -> bool {
+            // Whenever the main thread label is not reached by the workers,
+            // it indicates that some worker is still alive
+            return m_FinishedLabel.load() < m_CurrentLabel.load() || HasQueuedJobs();
+        }
+
+        /**
+         * Wait until all threads have finished doing their work
+         * */
+        auto WaitIdle() -> void {
+            while (IsBusy()) {
+                Poll();
+            }
+        }
+
+        MKT_NODISCARD auto GetWorkersCount() const -> UInt32_T { return m_Workers.size(); }
+
+    private:
+        auto DispatchGroups(UInt32_T jobCount, UInt32_T groupSize, const std::function<void(JobDispatchArgs)>& job, JobCounter* counter) -> void {
             if (jobCount == 0 || groupSize == 0) {
                 return;
             }
@@ -177,7 +259,11 @@ namespace Mikoto {
             const UInt32_T groupCount{ (jobCount + groupSize - 1) / groupSize };
 
             // The main thread label state is updated
-            m_CurrentLabel += groupCount;
+            m_CurrentLabel.fetch_add(groupCount);
+
+            if (counter != nullptr) {
+                counter->Pending.fetch_add(groupCount);
+            }
 
             for (UInt32_T groupIndex{}; groupIndex < groupCount; ++groupIndex) {
                 // For each group, generate one real job
@@ -199,36 +285,42 @@ namespace Mikoto {
                 };
 
                 // Try to push a new job until it is pushed successfully:
-                while (!EnqueueJob(jobGroup)) {
+                while (!EnqueueJob(jobGroup, counter)) {
                     Poll();
                 }
 
-                m_WakeCondition.notify_one();// wake one thread
+                WakeWorker();
             }
         }
 
-        /**
-         * Returns true if there's thread executing any work, not necessarily idle.
-         * @returns true if there's at least one thread doing some work, false otherwise
-         * */
-        MKT_NODISCARD auto IsBusy() const -> bool {
-            // Whenever the main thread label is not reached by the workers,
-            // it indicates that some worker is still alive
-            return m_FinishedLabel.load() < m_CurrentLabel || !m_JobQueue.empty();
+        MKT_NODISCARD auto HasQueuedJobs() const -> bool {
+            std::scoped_lock scopedLock{ m_JobQueueLock };
+            return !m_JobQueue.empty();
         }
 
         /**
-         * Wait until all threads have finished doing their work
+         * Wakes one sleeping worker. The wake mutex is taken first so a worker
+         * that just found the queue empty is already waiting and gets the notification
          * */
-        auto WaitIdle() -> void {
-            while (IsBusy()) {
-                Poll();
+        auto WakeWorker() -> void {
+            {
+                std::scoped_lock lock{ m_WakeMutex };
             }
+
+            m_WakeCondition.notify_one();
         }
 
-        MKT_NODISCARD auto GetWorkersCount() const -> UInt32_T { return m_Workers.size(); }
+        auto RunJob(QueuedJob& task) -> void {
+            task.Function();
 
-    private:
+            // The counter may be gone as soon as it reaches zero, it is not touched after
+            if (task.Counter != nullptr) {
+                task.Counter->Pending.fetch_sub(1);
+            }
+
+            // update worker label state
+            m_FinishedLabel.fetch_add(1);
+        }
 
         /**
          * Returns total working numCores for given hardware cores
@@ -258,10 +350,10 @@ namespace Mikoto {
         UInt32_T m_ThreadCount{};
 
         // Queue of pending jobs
-        std::deque<std::function<void()>> m_JobQueue{};
+        std::deque<QueuedJob> m_JobQueue{};
 
         // For enqueueing and removing jobs
-        std::mutex m_JobQueueLock{};
+        mutable std::mutex m_JobQueueLock{};
 
         // used in conjunction with the wakeMutex below. Worker threads
         // just sleep when there is no job, and the main thread can wake them up
@@ -270,8 +362,8 @@ namespace Mikoto {
         // used in conjunction with the wakeCondition above
         std::mutex m_WakeMutex{};
 
-        // tracks the state of execution of the main thread
-        UInt32_T m_CurrentLabel{};
+        // tracks the jobs submitted so far, from any thread
+        std::atomic<UInt64_T> m_CurrentLabel{};
 
         // track the state of execution across background worker threads
         std::atomic<UInt64_T> m_FinishedLabel{};
@@ -0,0 +1,201 @@
+/**
+ * OffsetAllocator.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_OFFSET_ALLOCATOR_HH
+#define MIKOTO_OFFSET_ALLOCATOR_HH
+
+// C++ Standard Library
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <optional>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+    /**
+     * @class OffsetAllocator
+     * @brief Hands out ranges of a linear block of memory it does not own.
+     * Free ranges are kept sorted by offset, a released range is merged with its
+     * free neighbours so the free list does not fragment over time. Allocation
+     * picks the smallest free range that fits (best fit).
+     * */
+    class OffsetAllocator final {
+    public:
+        struct Allocation {
+            UInt64_T Offset{};
+            UInt64_T Size{};
+        };
+
+        struct Stats {
+            UInt64_T Capacity{};
+            UInt64_T UsedSize{};
+            UInt64_T LargestFreeRange{};
+            UInt64_T FreeRangeCount{};
+            UInt64_T AllocationCount{};
+        };
+
+    public:
+        explicit OffsetAllocator() = default;
+        explicit OffsetAllocator( const UInt64_T capacity ) { Reset( capacity ); }
+
+        /**
+         * @brief Forgets every allocation, the whole capacity becomes one free range.
+         * */
+        auto Reset( const UInt64_T capacity ) -> void {
+            m_Capacity = capacity;
+            m_UsedSize = 0;
+            m_AllocationCount = 0;
+
+            m_FreeRanges.clear();
+
+            if ( capacity != 0 ) {
+                m_FreeRanges.emplace( 0, capacity );
+            }
+        }
+
+        /**
+         * @brief Makes room for more allocations, new space is appended at the end.
+         * Existing allocations keep their offsets.
+         * */
+        auto Grow( const UInt64_T newCapacity ) -> void {
+            if ( newCapacity <= m_Capacity ) {
+                return;
+            }
+
+            Release( m_Capacity, newCapacity - m_Capacity );
+            m_Capacity = newCapacity;
+        }
+
+        /**
+         * @brief Returns a range of at least size bytes whose offset is a multiple of alignment.
+         * Alignment does not need to be a power of two (vertex strides for example).
+         * */
+        MKT_NODISCARD auto Allocate( const UInt64_T size, const UInt64_T alignment = 1 ) -> std::optional<Allocation> {
+            if ( size == 0 ) {
+                return std::nullopt;
+            }
+
+            auto bestIt{ m_FreeRanges.end() };
+            UInt64_T bestWaste{};
+
+            for ( auto it{ m_FreeRanges.begin() }; it != m_FreeRanges.end(); ++it ) {
+                const auto& [offset, rangeSize]{ *it };
+                const UInt64_T alignedOffset{ AlignUp( offset, alignment ) };
+
+                if ( alignedOffset + size > offset + rangeSize ) {
+                    continue;
+                }
+
+                const UInt64_T waste{ rangeSize - size };
+
+                if ( bestIt == m_FreeRanges.end() || waste < bestWaste ) {
+                    bestIt = it;
+                    bestWaste = waste;
+
+                    // Can't do better than an exact fit
+                    if ( waste == 0 ) {
+                        break;
+                    }
+                }
+            }
+
+            if ( bestIt == m_FreeRanges.end() ) {
+                return std::nullopt;
+            }
+
+            const auto [rangeOffset, rangeSize]{ *bestIt };
+            m_FreeRanges.erase( bestIt );
+
+            const UInt64_T alignedOffset{ AlignUp( rangeOffset, alignment ) };
+            const UInt64_T rangeEnd{ rangeOffset + rangeSize };
+            const UInt64_T allocationEnd{ alignedOffset + size };
+
+            // Padding before the aligned offset and the tail go back to the free list
+            if ( alignedOffset > rangeOffset ) {
+                m_FreeRanges.emplace( rangeOffset, alignedOffset - rangeOffset );
+            }
+
+            if ( rangeEnd > allocationEnd ) {
+                m_FreeRanges.emplace( allocationEnd, rangeEnd - allocationEnd );
+            }
+
+            m_UsedSize += size;
+            ++m_AllocationCount;
+
+            return Allocation{ .Offset{ alignedOffset }, .Size{ size } };
+        }
+
+        auto Free( const Allocation& allocation ) -> void {
+            if ( allocation.Size == 0 ) {
+                return;
+            }
+
+            m_UsedSize -= allocation.Size;
+            --m_AllocationCount;
+
+            Release( allocation.Offset, allocation.Size );
+        }
+
+        MKT_NODISCARD auto GetCapacity() const -> UInt64_T { return m_Capacity; }
+
+        MKT_NODISCARD auto GetStats() const -> Stats {
+            Stats stats{
+                .Capacity{ m_Capacity },
+                .UsedSize{ m_UsedSize },
+                .LargestFreeRange{},
+                .FreeRangeCount{ m_FreeRanges.size() },
+                .AllocationCount{ m_AllocationCount },
+            };
+
+            for ( const auto& [offset, size] : m_FreeRanges ) {
+                stats.LargestFreeRange = std::max( stats.LargestFreeRange, size );
+            }
+
+            return stats;
+        }
+
+    private:
+        static auto AlignUp( const UInt64_T value, const UInt64_T alignment ) -> UInt64_T {
+            return alignment <= 1 ? value : ( value + alignment - 1 ) / alignment * alignment;
+        }
+
+        // Inserts the range and merges it with the free ranges right before and after it
+        auto Release( UInt64_T offset, UInt64_T size ) -> void {
+            auto nextIt{ m_FreeRanges.lower_bound( offset ) };
+
+            if ( nextIt != m_FreeRanges.begin() ) {
+                const auto previousIt{ std::prev( nextIt ) };
+
+                if ( previousIt->first + previousIt->second == offset ) {
+                    offset = previousIt->first;
+                    size += previousIt->second;
+
+                    m_FreeRanges.erase( previousIt );
+                }
+            }
+
+            if ( nextIt != m_FreeRanges.end() && offset + size == nextIt->first ) {
+                size += nextIt->second;
+                m_FreeRanges.erase( nextIt );
+            }
+
+            m_FreeRanges.emplace( offset, size );
+        }
+
+    private:
+        UInt64_T m_Capacity{};
+        UInt64_T m_UsedSize{};
+        UInt64_T m_AllocationCount{};
+
+        // offset -> size of every free range, sorted by offset so neighbours are easy to find
+        std::map<UInt64_T, UInt64_T> m_FreeRanges{};
+    };
+}
+
+#endif // MIKOTO_OFFSET_ALLOCATOR_HH
@@ -0,0 +1,56 @@
+/**
+ * MappedFile.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_MAPPED_FILE_HH
+#define MIKOTO_MAPPED_FILE_HH
+
+// C++ Standard Library
+#include <span>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+    /**
+     * @class MappedFile
+     * @brief Read only view of a whole file mapped in memory. The pages are read
+     * by the OS when they are first touched, nothing is copied to the heap.
+     * */
+    class MappedFile final {
+    public:
+        explicit MappedFile() = default;
+
+        /**
+         * @brief Maps the file, throws if it cannot be opened or is empty.
+         * */
+        explicit MappedFile( const Path_T& path );
+
+        MappedFile( MappedFile&& other ) noexcept;
+        auto operator=( MappedFile&& other ) noexcept -> MappedFile&;
+
+        ~MappedFile();
+
+        MKT_NODISCARD auto GetData() const -> std::span<const UInt8_T> { return { m_Data, m_Size }; }
+        MKT_NODISCARD auto IsMapped() const -> bool { return m_Data != nullptr; }
+
+    public:
+        DELETE_COPY_FOR( MappedFile );
+
+    private:
+        auto Unmap() -> void;
+
+    private:
+        const UInt8_T* m_Data{ nullptr };
+        Size_T m_Size{};
+
+#if defined(_WIN32) || defined(_WIN64)
+        void* m_FileHandle{ nullptr };
+        void* m_MappingHandle{ nullptr };
+#endif
+    };
+}
+
+#endif // MIKOTO_MAPPED_FILE_HH
@@ -0,0 +1,136 @@
+/**
+ * MeshOptimizer.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_MESH_OPTIMIZER_HH
+#define MIKOTO_MESH_OPTIMIZER_HH
+
+// C++ Standard Library
+#include <span>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+/**
+ * Reordering passes for indexed triangle lists. They do not change what is drawn, only the
+ * order the GPU fetches and shades it in. Meant to run once at import, in this order:
+ * OptimizeVertexCache(), OptimizeOverdraw(), then OptimizeVertexFetch(). SimplifyMesh() builds
+ * coarser index buffers over the same vertices, for the levels of detail, and BuildMeshlets() splits
+ * an index buffer in small clusters that can be culled on their own.
+ * */
+namespace Mikoto::MeshOptimizer {
+
+    // Entries of the FIFO post transform cache simulated by AnalyzeVertexCache(), close to current hardware
+    constexpr UInt32_T DEFAULT_VERTEX_CACHE_SIZE{ 16 };
+
+    // How much OptimizeOverdraw() may raise the ACMR to sort more clusters
+    constexpr float DEFAULT_OVERDRAW_THRESHOLD{ 1.05f };
+
+    // Limits of a meshlet, the ones recommended for mesh shaders so the clusters can be fed to them as they are
+    constexpr UInt32_T MAX_MESHLET_VERTICES{ 64 };
+    constexpr UInt32_T MAX_MESHLET_TRIANGLES{ 124 };
+
+    struct VertexCacheStatistics {
+        UInt64_T VerticesTransformed{};
+        UInt64_T TriangleCount{};
+
+        /**
+         * @brief Average cache miss ratio, vertices transformed per triangle. 0.5 is the best a regular grid can do, 3 the worst.
+         * */
+        MKT_NODISCARD auto GetACMR() const -> float { return TriangleCount != 0 ? static_cast<float>( VerticesTransformed ) / static_cast<float>( TriangleCount ) : 0.0f; }
+
+        auto operator+=( const VertexCacheStatistics& other ) -> VertexCacheStatistics& {
+            VerticesTransformed += other.VerticesTransformed;
+            TriangleCount += other.TriangleCount;
+
+            return *this;
+        }
+    };
+
+    /**
+     * Contiguous range of a triangle list using at most MAX_MESHLET_VERTICES vertices, with the bounds to cull it
+     * */
+    struct Meshlet {
+        UInt32_T FirstIndex{};
+        UInt32_T IndexCount{};
+        UInt32_T VertexCount{};
+
+        // xyz = center, w = radius
+        glm::vec4 BoundingSphere{};
+
+        // Normal cone, xyz = axis, w = cutoff. Every triangle faces away from a viewer at V when
+        // dot( normalize( center - V ), axis ) >= cutoff, plus a radius margin. The cutoff is 1 if the triangles spread too much
+        glm::vec4 Cone{};
+    };
+
+    /**
+     * @brief Simulates a FIFO post transform cache over the triangles.
+     * @param indices triangle list
+     * @param vertexCount vertices the indices refer to
+     * @param cacheSize entries of the simulated cache
+     * */
+    MKT_NODISCARD auto AnalyzeVertexCache( std::span<const UInt32_T> indices, Size_T vertexCount, UInt32_T cacheSize = DEFAULT_VERTEX_CACHE_SIZE ) -> VertexCacheStatistics;
+
+    /**
+     * @brief Reorders the triangles so their vertices are reused while they are still in the post
+     * transform cache. Tom Forsyth's linear speed algorithm, it does not depend on the exact cache size.
+     * @param indices triangle list, reordered in place
+     * @param vertexCount vertices the indices refer to
+     * */
+    auto OptimizeVertexCache( std::span<UInt32_T> indices, Size_T vertexCount ) -> void;
+
+    /**
+     * @brief Splits the cache optimized triangles in clusters and sorts them so the ones facing
+     * away from the center of the mesh come first, they are the most likely to occlude the rest.
+     * @param indices triangle list after OptimizeVertexCache(), reordered in place
+     * @param vertices interleaved vertices, each one starts with its position
+     * @param vertexStride floats per vertex
+     * @param threshold allowed ACMR increase over the cache optimized order, more means smaller clusters
+     * */
+    auto OptimizeOverdraw( std::span<UInt32_T> indices, std::span<const float> vertices, Size_T vertexStride, float threshold = DEFAULT_OVERDRAW_THRESHOLD ) -> void;
+
+    /**
+     * @brief Collapses edges onto one of their vertices, cheapest first by their quadric error (Garland and Heckbert),
+     * until the target is reached or the next collapse would move the surface further than allowed. Vertices on
+     * open borders and on attribute seams, where several vertices share a position, stay in place so the result does not crack.
+     * @param indices triangle list
+     * @param vertices interleaved vertices, each one starts with its position
+     * @param vertexStride floats per vertex
+     * @param targetIndexCount indices to stop at
+     * @param maxError object space distance the surface may move from the input
+     * @param resultError receives the distance the surface moved, estimated from the quadrics
+     * @returns triangle list of the simplified mesh, it uses the same vertices
+     * */
+    MKT_NODISCARD auto SimplifyMesh( std::span<const UInt32_T> indices, std::span<const float> vertices, Size_T vertexStride, Size_T targetIndexCount, float maxError, float& resultError ) -> std::vector<UInt32_T>;
+
+    /**
+     * @brief Splits the triangles in meshlets. Each one grows from a seed through the triangles sharing its vertices,
+     * preferring the ones adding the fewest new vertices and then the closest. Triangles not connected to it
+     * are taken in their order in the list once no connected one fits. The triangles of a meshlet keep their relative order.
+     * @param indices triangle list, reordered in place so each meshlet is a contiguous range of it
+     * @param vertices interleaved vertices, each one starts with its position
+     * @param vertexStride floats per vertex
+     * @param maxVertices most vertices a meshlet may use
+     * @param maxTriangles most triangles a meshlet may have
+     * @returns meshlets in the order of indices, their ranges cover all of it
+     * */
+    MKT_NODISCARD auto BuildMeshlets( std::span<UInt32_T> indices, std::span<const float> vertices, Size_T vertexStride, UInt32_T maxVertices = MAX_MESHLET_VERTICES, UInt32_T maxTriangles = MAX_MESHLET_TRIANGLES ) -> std::vector<Meshlet>;
+
+    /**
+     * @brief Moves the vertices in the order the triangles first use them, so the vertex fetch
+     * reads memory mostly forward. Vertices not used by any triangle are dropped.
+     * @param indices triangle list, remapped in place
+     * @param vertices interleaved vertices, reordered in place
+     * @param vertexStride floats per vertex
+     * @returns count of vertices left at the front of vertices
+     * */
+    MKT_NODISCARD auto OptimizeVertexFetch( std::span<UInt32_T> indices, std::span<float> vertices, Size_T vertexStride ) -> Size_T;
+}
+
+#endif // MIKOTO_MESH_OPTIMIZER_HH
@@ -0,0 +1,27 @@
+/**
+ * Hash.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_HASH_HH
+#define MIKOTO_HASH_HH
+
+// C++ Standard Library
+#include <span>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto::Hash {
+
+    /**
+     * @brief 64-bit xxHash (XXH64) of the bytes, same result as the reference implementation on little endian hosts.
+     * Fast enough to identify whole files by their content, not meant to resist collisions on purpose.
+     * @param bytes data to hash
+     * @param seed chains hashes of several buffers when it is the hash of the previous one
+     * */
+    MKT_NODISCARD auto ComputeXXHash64( std::span<const UInt8_T> bytes, UInt64_T seed = 0 ) -> UInt64_T;
+}
+
+#endif // MIKOTO_HASH_HH
@@ -9,6 +9,7 @@
 // C++ Standard Library
 #include <any>
 #include <memory>
+#include <optional>
 
 // Project Headers
 #include <Assets/Texture.hh>
@@ -16,10 +17,38 @@
 #include <Library/Filesystem/File.hh>
 #include <Library/Random/Random.hh>
 #include <Library/Utility/Types.hh>
+#include <Material/Texture/TextureCooker.hh>
 #include <Models/Enums.hh>
 
 namespace Mikoto {
 
+    /**
+     * @brief Texels of a 2D texture read from disk, without any GPU resource.
+     * Decoding does not touch the engine systems, so it can run on the workers.
+     * */
+    struct Texture2DData {
+        // File the texels come from, the cooked one or the source image
+        Path_T FilePath{};
+
+        Int32_T Width{};
+        Int32_T Height{};
+        Int32_T Channels{};
+
+        // RGBA8 texels of the source image, freed with the data unless a texture took them
+        UInt8_T* Texels{ nullptr };
+
+        // Block compressed version cooked by TextureCooker, preferred over the texels
+        std::optional<CookedTexture> Cooked{};
+
+        // Mips of the texels built on the CPU, only when the GPU cannot blit them
+        MipChain Levels{};
+
+        explicit Texture2DData() = default;
+        ~Texture2DData();
+
+        DELETE_COPY_FOR( Texture2DData );
+    };
+
     class Texture2D : public Texture {
     public:
         MKT_NODISCARD auto GetChannels() const -> Int32_T { return m_Channels; }
@@ -33,9 +62,17 @@ namespace Mikoto {
          * Creates a Texture2D based on the active graphics API (Vulkan or OpenGL) from the provided file path and MapType.
          * @param path The path to the texture file.
          * @param type The MapType for the texture.
+         * @param data Texels decoded ahead of time with Decode(), the file is decoded here if null.
          * @return A shared pointer to the created Texture2D. If creation fails, returns a null pointer.
          * */
-        MKT_NODISCARD static auto Create(const Path_T& path, MapType type) -> Scope_T<Texture2D>;
+        MKT_NODISCARD static auto Create(const Path_T& path, MapType type, Texture2DData* data = nullptr) -> Scope_T<Texture2D>;
+
+        /**
+         * @brief Reads and decodes the texture file, the result is handed to Create().
+         * Safe to call from any thread, throws if the file cannot be decoded.
+         * @param path The path to the texture file.
+         * */
+        MKT_NODISCARD static auto Decode(const Path_T& path) -> Scope_T<Texture2DData>;
 
         ~Texture2D() override = default;
 
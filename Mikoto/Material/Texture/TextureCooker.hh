@@ -0,0 +1,95 @@
+/**
+ * TextureCooker.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_TEXTURE_COOKER_HH
+#define MIKOTO_TEXTURE_COOKER_HH
+
+// C++ Standard Library
+#include <optional>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+#include <Models/Enums.hh>
+
+struct aiTexture;
+
+namespace Mikoto {
+
+    struct MipChain {
+        // Levels packed from the biggest to the smallest one
+        std::vector<UInt8_T> Data{};
+
+        // Offset of every level in Data
+        std::vector<UInt64_T> LevelOffsets{};
+    };
+
+    struct CookedTexture {
+        VkFormat Format{ VK_FORMAT_UNDEFINED };
+        UInt32_T Width{};
+        UInt32_T Height{};
+
+        MipChain Levels{};
+    };
+
+    struct TextureCookReport {
+        Size_T CookedCount{};
+        Size_T SkippedCount{};
+        Size_T FailedCount{};
+
+        // Size of the cooked textures as RGBA8 with their mips, what they would take in memory uncooked
+        Size_T UncompressedBytes{};
+        Size_T CookedBytes{};
+    };
+
+    /**
+     * @class TextureCooker
+     * @brief Offline encoding of textures to GPU block compressed formats, stored in KTX2 files.
+     * The format is picked by the map type: BC7 for color maps, BC5 for normal maps and BC4 for
+     * the single channel ones. Every file gets its whole mip chain, so nothing is decoded or
+     * filtered at load. Cooked files live next to their source, see GetCookedPath().
+     * */
+    class TextureCooker final {
+    public:
+        MKT_NODISCARD static auto GetCookedPath( const Path_T& source ) -> Path_T;
+        MKT_NODISCARD static auto GetCookedFormat( MapType type ) -> VkFormat;
+
+        // Number of levels down to 1x1
+        MKT_NODISCARD static auto GetMipLevelCount( UInt32_T width, UInt32_T height ) -> UInt32_T;
+
+        /**
+         * @brief Box filters RGBA8 texels down to 1x1. Color channels of sRGB data are averaged in linear space.
+         * */
+        MKT_NODISCARD static auto BuildMipChain( const UInt8_T* data, UInt32_T width, UInt32_T height, UInt32_T mipLevels, bool isSRGB ) -> MipChain;
+
+        /**
+         * @brief Encodes the source image and writes the KTX2 file, throws if it cannot be read or written.
+         * */
+        MKT_NODISCARD static auto Cook( const Path_T& source, MapType type ) -> TextureCookReport;
+
+        /**
+         * @brief Cooks the textures referenced by the materials of a model, those with an up-to-date cooked file are skipped.
+         * */
+        MKT_NODISCARD static auto CookModelTextures( const Path_T& modelPath ) -> TextureCookReport;
+
+        /**
+         * @brief Writes the compressed image of a texture embedded in a model file next to the model, named after the
+         * XXH64 of its bytes, so identical embedded textures resolve to the same file and are loaded once.
+         * Returns an empty path for uncompressed embedded texels or if the file cannot be written.
+         * */
+        MKT_NODISCARD static auto ExtractEmbedded( const aiTexture& texture, const Path_T& modelDirectory ) -> Path_T;
+
+        /**
+         * @brief Reads a cooked file. Returns nothing if it is missing, older than its source or not a KTX2 file we can sample.
+         * */
+        MKT_NODISCARD static auto LoadCooked( const Path_T& source ) -> std::optional<CookedTexture>;
+    };
+}
+
+#endif // MIKOTO_TEXTURE_COOKER_HH
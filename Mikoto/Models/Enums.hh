@@ -40,6 +40,11 @@ namespace Mikoto {
         MATERIAL_PASS_WIREFRAME = 3,
         MATERIAL_PASS_COMPUTE = 4,
         MATERIAL_PASS_OUTLINE = 5,
+        MATERIAL_PASS_LIGHT_CULLING = 6,
+        MATERIAL_PASS_DEPTH_PREPASS = 7,
+        MATERIAL_PASS_PBR_DEPTH_EQUAL = 8,
+        MATERIAL_PASS_DRAW_CULLING = 9,
+        MATERIAL_PASS_DEPTH_PREPASS_COMPACT = 10,
     };
 
     enum class FileType {
@@ -152,6 +157,10 @@ namespace Mikoto {
         // Category [PANEL_EVENT_CATEGORY]
         CAMERA_ENABLE_ROTATION,
 
+        // Asset events
+        // Category [ASSET_EVENT_CATEGORY]
+        MODEL_LOAD_EVENT,
+
         EVENT_TYPE_COUNT,
     };
 
@@ -173,6 +182,7 @@ namespace Mikoto {
         KEY_EVENT_CATEGORY = BIT_SET( 4 ),
         MOUSE_EVENT_CATEGORY = BIT_SET( 5 ),
         MOUSE_BUTTON_EVENT_CATEGORY = BIT_SET( 6 ),
+        ASSET_EVENT_CATEGORY = BIT_SET( 7 ),
         PANEL_EVENT_CATEGORY = BIT_SET( 8 ),
 
         EVENT_CATEGORY_COUNT = BIT_SET( 9 ),
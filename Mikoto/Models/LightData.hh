@@ -5,7 +5,10 @@
 #ifndef LIGHTRENDERDATA_HH
 #define LIGHTRENDERDATA_HH
 
-#define MAX_LIGHTS_PER_SCENE 50
+// Point and spot lights are assigned to clusters before shading,
+// so a scene can hold a lot more of them than directional lights
+#define MAX_LIGHTS_PER_SCENE 4096
+#define MAX_DIRECTIONAL_LIGHTS_PER_SCENE 16
 
 #include <glm/glm.hpp>
 
@@ -27,6 +27,12 @@ namespace Mikoto {
         INT3_TYPE,// Represents a three int data type
         INT4_TYPE,// Represents a four int data type
         BOOL_TYPE,// Represents a single boolean data type
+        HALF2_TYPE,// Represents two 16-bit floats
+        HALF4_TYPE,// Represents four 16-bit floats
+        SNORM16_2_TYPE,// Represents two 16-bit signed integers read as floats in [-1, 1]
+        SNORM16_4_TYPE,// Represents four 16-bit signed integers read as floats in [-1, 1]
+        UNORM16_2_TYPE,// Represents two 16-bit unsigned integers read as floats in [0, 1]
+        UNORM8_4_TYPE,// Represents four 8-bit unsigned integers read as floats in [0, 1]
         COUNT,
     };
 
@@ -62,6 +68,12 @@ namespace Mikoto {
         // Size in bytes for float
         static constexpr UInt32_T s_DefaultShaderFloatSize{ 4 };
 
+        // Size in bytes for half floats and 16-bit normalized integers
+        static constexpr UInt32_T s_DefaultShaderShortSize{ 2 };
+
+        // Size in bytes for half floats and 16-bit normalized integers
+        static constexpr UInt32_T s_DefaultShaderShortSize{ 2 };
+
         std::string     m_Name{};
         ShaderDataType  m_Type{};
         UInt32_T        m_Size{};
@@ -87,6 +99,12 @@ namespace Mikoto {
                 case ShaderDataType::INT3_TYPE:     return s_DefaultShaderIntSize * 3;
                 case ShaderDataType::INT4_TYPE:     return s_DefaultShaderIntSize * 4;
                 case ShaderDataType::BOOL_TYPE:     return 1;
+                case ShaderDataType::HALF2_TYPE:    return s_DefaultShaderShortSize * 2;
+                case ShaderDataType::HALF4_TYPE:    return s_DefaultShaderShortSize * 4;
+                case ShaderDataType::SNORM16_2_TYPE: return s_DefaultShaderShortSize * 2;
+                case ShaderDataType::SNORM16_4_TYPE: return s_DefaultShaderShortSize * 4;
+                case ShaderDataType::UNORM16_2_TYPE: return s_DefaultShaderShortSize * 2;
+                case ShaderDataType::UNORM8_4_TYPE: return 4;
 
                 case ShaderDataType::NONE:
                 case ShaderDataType::COUNT: [[fallthrough]];
@@ -116,6 +134,12 @@ namespace Mikoto {
                 case ShaderDataType::INT3_TYPE:     return 3;
                 case ShaderDataType::INT4_TYPE:     return 4;
                 case ShaderDataType::BOOL_TYPE:     return 1;
+                case ShaderDataType::HALF2_TYPE:    return 2;
+                case ShaderDataType::HALF4_TYPE:    return 4;
+                case ShaderDataType::SNORM16_2_TYPE: return 2;
+                case ShaderDataType::SNORM16_4_TYPE: return 4;
+                case ShaderDataType::UNORM16_2_TYPE: return 2;
+                case ShaderDataType::UNORM8_4_TYPE: return 4;
 
                 case ShaderDataType::NONE:
                 case ShaderDataType::COUNT: [[fallthrough]];
@@ -8,6 +8,7 @@
 
 // C++ Standard Library
 #include <memory>
+#include <span>
 
 // Project Headers
 #include <Common/Common.hh>
@@ -39,7 +40,7 @@ namespace Mikoto {
          * @param data index buffer indices
          * @returns a pointer to the newly created index buffer
          * */
-        MKT_NODISCARD static auto Create(const std::vector<UInt32_T>& data) -> Scope_T<IndexBuffer>;
+        MKT_NODISCARD static auto Create(std::span<const UInt32_T> data) -> Scope_T<IndexBuffer>;
 
     protected:
         /**
@@ -7,11 +7,15 @@
 
 // C++ Standard Library
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
 // Project Headers
 #include <Common/Common.hh>
 #include <Library/Utility/Types.hh>
@@ -20,9 +24,37 @@
 #include <Models/Enums.hh>
 
 namespace Mikoto {
+    /**
+     * Layouts the vertices of a mesh can be stored in, chosen when the model is imported
+     * */
+    enum class VertexFormat : UInt32_T {
+        // Default buffer layout, 32-bit floats only (44 bytes per vertex)
+        FLOAT32,
+
+        // Compact buffer layout (20 bytes per vertex). Positions and texture coordinates are quantized
+        // relative to the ranges of the mesh, normals are octahedral encoded, see VertexDequantization
+        COMPACT,
+
+        COUNT,
+    };
+
+    /**
+     * Brings the stored positions and texture coordinates back to their range in the mesh:
+     * value = stored * scale + offset. Identity for FLOAT32 vertices
+     * */
+    struct VertexDequantization {
+        glm::vec3 PositionScale{ 1.0f };
+        glm::vec3 PositionOffset{ 0.0f };
+
+        glm::vec2 TexCoordScale{ 1.0f };
+        glm::vec2 TexCoordOffset{ 0.0f };
+    };
+
     struct VertexBufferCreateInfo {
-        std::vector<float> Data{};
-        BufferLayout Layout{};
+        // Only read during creation, it is copied when retained
+        std::span<const UInt8_T> Data{};
+        VertexFormat Format{ VertexFormat::FLOAT32 };
+        VertexDequantization Dequantization{};
         bool RetainData{};
     };
 
@@ -43,6 +75,14 @@ namespace Mikoto {
          * */
         explicit VertexBuffer( BufferLayout layout ) : m_Layout{ std::move( layout ) } {}
 
+        /**
+         * Creates a vertex buffer with the layout of the given format
+         * @param format layout of the vertices
+         * @param dequantization ranges of the quantized attributes, identity for FLOAT32 vertices
+         * */
+        explicit VertexBuffer( const VertexFormat format, const VertexDequantization& dequantization )
+            :   m_Layout{ GetBufferLayout( format ) }, m_Format{ format }, m_Dequantization{ dequantization } {}
+
         /**
          * Returns the data layout of this vertex buffer
          * @returns buffer layout of the implicit parameter
@@ -55,6 +95,18 @@ namespace Mikoto {
          * */
         auto SetBufferLayout( const BufferLayout& layout ) -> void { m_Layout = layout; }
 
+        /**
+         * Returns the format the vertices of this buffer are stored in
+         * @returns vertex format of the implicit parameter
+         * */
+        MKT_NODISCARD auto GetFormat() const -> VertexFormat { return m_Format; }
+
+        /**
+         * Returns the ranges used to dequantize the vertices in the shaders
+         * @returns dequantization of the implicit parameter
+         * */
+        MKT_NODISCARD auto GetDequantization() const -> const VertexDequantization& { return m_Dequantization; }
+
         /**
          * Returns the total size in bytes of the contents of this Vertex buffer
          * @return total size in bytes of the vertices of this buffer
@@ -73,20 +125,27 @@ namespace Mikoto {
         MKT_NODISCARD auto IsEmpty() const -> bool { return m_Size == 0; }
 
         /**
-         * Creates a vertex buffer with the specified layout
+         * Creates a vertex buffer with the layout of the given format
+         * @param data vertices, laid out as GetBufferLayout( format )
+         * @param format layout of the vertices
+         * @param dequantization ranges of the quantized attributes, identity for FLOAT32 vertices
          * @returns pointer to the newly created buffer
          * */
-        MKT_NODISCARD static auto Create( const std::vector<float>& data, const BufferLayout& layout = GetDefaultBufferLayout() ) -> Scope_T<VertexBuffer>;
+        MKT_NODISCARD static auto Create( std::span<const UInt8_T> data, VertexFormat format = VertexFormat::FLOAT32, const VertexDequantization& dequantization = {} ) -> Scope_T<VertexBuffer>;
 
         MKT_NODISCARD static auto GetDefaultBufferLayout() -> const BufferLayout& { return s_DefaultBufferLayout; }
 
+        MKT_NODISCARD static auto GetBufferLayout( const VertexFormat format ) -> const BufferLayout& {
+            return format == VertexFormat::COMPACT ? s_CompactBufferLayout : s_DefaultBufferLayout;
+        }
+
         /**
          * Default destructor
          * */
         virtual ~VertexBuffer() = default;
 
     protected:
-        // Note: for now this will always be the same layout as the Models, see Model.hh
+        // Layouts of the vertices of the models, see Model::ProcessMesh()
         static inline BufferLayout s_DefaultBufferLayout{
             { ShaderDataType::FLOAT3_TYPE, "a_Position" },
             { ShaderDataType::FLOAT3_TYPE, "a_Normal" },
@@ -94,9 +153,21 @@ namespace Mikoto {
             { ShaderDataType::FLOAT2_TYPE, "a_TextureCoordinates" }
         };
 
+        // Same attributes and locations, the shaders read both layouts. The
+        // w of the position is unused, it keeps the attribute 4 byte aligned
+        static inline BufferLayout s_CompactBufferLayout{
+            { ShaderDataType::SNORM16_4_TYPE, "a_Position" },
+            { ShaderDataType::SNORM16_2_TYPE, "a_Normal" },
+            { ShaderDataType::UNORM8_4_TYPE, "a_Color" },
+            { ShaderDataType::UNORM16_2_TYPE, "a_TextureCoordinates" }
+        };
+
         UInt64_T m_Size{};
         UInt64_T m_Count{};
         BufferLayout m_Layout{};
+
+        VertexFormat m_Format{ VertexFormat::FLOAT32 };
+        VertexDequantization m_Dequantization{};
     };
 }
 
@@ -14,6 +14,8 @@ namespace Mikoto {
     struct RenderContextCreateInfo {
         const Window* TargetWindow{ nullptr };
         GraphicsAPI Backend{ GraphicsAPI::VULKAN_API };
+        UInt32_T FramesInFlight{ 2 };
+        Path_T PipelineCachePath{};
     };
 
     class RenderContext {
@@ -22,6 +24,10 @@ namespace Mikoto {
             const Window* TargetWindow{ nullptr };
 
             GraphicsAPI Backend{ GraphicsAPI::VULKAN_API };
+
+            UInt32_T FramesInFlight{ 2 };
+
+            Path_T PipelineCachePath{};
         };
 
     public:
@@ -47,7 +53,7 @@ namespace Mikoto {
         explicit RenderContext() = default;
 
         explicit RenderContext(const RenderContextCreateInfo& createInfo)
-            :   m_ContextData{ .TargetWindow{ createInfo.TargetWindow }, .Backend{ createInfo.Backend } }
+            :   m_ContextData{ .TargetWindow{ createInfo.TargetWindow }, .Backend{ createInfo.Backend }, .FramesInFlight{ createInfo.FramesInFlight }, .PipelineCachePath{ createInfo.PipelineCachePath } }
         { }
 
     protected:
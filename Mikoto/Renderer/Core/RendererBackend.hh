@@ -84,6 +84,9 @@ namespace Mikoto {
         // Post-processing effects
         virtual auto EnableWireframe( bool enable ) -> void = 0;
 
+        // Lays down the depth of opaque geometry before shading it
+        virtual auto EnableDepthPrepass( bool enable ) -> void = 0;
+
         template<typename... Args>
         auto SetClearColor( Args&&... args ) -> void {
             m_ClearColor = glm::vec4{ std::forward<Args>( args )... };
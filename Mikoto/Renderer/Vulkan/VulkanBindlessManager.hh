@@ -0,0 +1,149 @@
+/**
+ * VulkanBindlessManager.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_BINDLESS_MANAGER_HH
+#define MIKOTO_VULKAN_BINDLESS_MANAGER_HH
+
+// C++ Standard Library
+#include <mutex>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+#include <Renderer/Vulkan/VulkanBuffer.hh>
+
+namespace Mikoto {
+
+    // Matches the MaterialData structure (std430) in the shaders
+    struct BindlessMaterialData {
+        glm::vec4 Albedo{};
+
+        // x = metallic, y = roughness, z = ambient occlusion, w = unused
+        glm::vec4 Factors{};
+
+        // Indices in the bindless textures array
+        // x = albedo, y = normal, z = metallic, w = roughness
+        glm::uvec4 TextureIndices{};
+
+        // x = ambient occlusion, yzw = unused
+        glm::uvec4 AuxTextureIndices{};
+
+        // 1 if the material has the map, 0 otherwise
+        // x = albedo, y = normal, z = metallic, w = roughness
+        glm::ivec4 HasMaps{};
+
+        // x = ambient occlusion, yzw = unused
+        glm::ivec4 AuxHasMaps{};
+    };
+
+    struct VulkanBindlessManagerCreateInfo {
+        VkDescriptorSetLayout DescriptorSetLayout{};
+        UInt32_T FramesInFlight{};
+        UInt32_T TextureCapacity{};
+    };
+
+    /**
+     * @class VulkanBindlessManager
+     * @brief Owns the descriptor-indexed texture array and the material parameters buffer.
+     * Textures and materials get a slot on creation and are referenced by that index in the
+     * shaders. There is one descriptor set per frame in flight, bound once per frame, so adding a
+     * material or a texture never allocates descriptor sets. Released slots are recycled only once
+     * every frame that could have used them has finished on the GPU.
+     * */
+    class VulkanBindlessManager final {
+    public:
+        static constexpr UInt32_T MAX_TEXTURES{ 4096 };
+        static constexpr UInt32_T MAX_MATERIALS{ 4096 };
+        static constexpr UInt32_T INVALID_INDEX{ ~0u };
+
+        // Bindings of the bindless set, see DESCRIPTOR_SET_LAYOUT_BINDLESS
+        static constexpr UInt32_T TEXTURES_BINDING{ 0 };
+        static constexpr UInt32_T MATERIALS_BINDING{ 1 };
+
+    public:
+        auto Init( const VulkanBindlessManagerCreateInfo& createInfo ) -> void;
+        auto Shutdown() -> void;
+
+        /**
+         * @brief Returns the index of the texture in the bindless array.
+         * The descriptor is written to every frame set before the set is next used.
+         * */
+        MKT_NODISCARD auto RegisterTexture( VkImageView view, VkSampler sampler ) -> UInt32_T;
+        auto ReleaseTexture( UInt32_T index ) -> void;
+
+        MKT_NODISCARD auto AllocateMaterial() -> UInt32_T;
+        auto ReleaseMaterial( UInt32_T index ) -> void;
+
+        /**
+         * @brief Writes the material parameters into the buffer of the current frame in flight.
+         * */
+        auto WriteMaterial( UInt32_T index, const BindlessMaterialData& data ) const -> void;
+
+        /**
+         * @brief Applies pending descriptor writes and recycles released slots.
+         * Has to be called once per frame after the frame fence was waited on, before recording.
+         * */
+        auto BeginFrame() -> void;
+
+        auto Bind( VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, UInt32_T set ) const -> void;
+
+        MKT_NODISCARD auto GetTextureCapacity() const -> UInt32_T { return m_TextureCapacity; }
+
+    private:
+        struct PendingTextureWrite {
+            UInt32_T Index{};
+            VkImageView View{};
+            VkSampler Sampler{};
+        };
+
+        // Hands out indices, released ones wait until no frame in flight can reference them
+        struct SlotAllocator {
+            UInt32_T Capacity{};
+            UInt32_T NextIndex{};
+            std::vector<UInt32_T> FreeIndices{};
+
+            // Index and frame number it was released on
+            std::vector<std::pair<UInt32_T, UInt64_T>> RetiredIndices{};
+
+            auto Allocate() -> UInt32_T;
+            auto Retire( UInt32_T index, UInt64_T frameNumber ) -> void;
+            auto Recycle( UInt64_T completedFrameNumber ) -> void;
+        };
+
+    private:
+        auto CreateDescriptorPool() -> void;
+        auto CreateMaterialBuffers() -> void;
+        auto CreateDescriptorSets() -> void;
+
+    private:
+        VkDevice m_Device{};
+        VkDescriptorSetLayout m_DescriptorSetLayout{};
+        VkDescriptorPool m_DescriptorPool{};
+
+        UInt32_T m_FramesInFlight{};
+        UInt32_T m_TextureCapacity{};
+
+        // Number of frames started so far, used to know when a released slot can be reused
+        UInt64_T m_FrameNumber{};
+
+        // One of each per frame in flight
+        std::vector<VkDescriptorSet> m_DescriptorSets{};
+        std::vector<Scope_T<VulkanBuffer>> m_MaterialBuffers{};
+        std::vector<std::vector<PendingTextureWrite>> m_PendingTextureWrites{};
+
+        SlotAllocator m_TextureSlots{};
+        SlotAllocator m_MaterialSlots{};
+
+        // Textures may be created from the workers
+        mutable std::mutex m_Mutex{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_BINDLESS_MANAGER_HH
@@ -20,8 +20,13 @@
 #include <Renderer/Core/RenderContext.hh>
 #include <Renderer/Vulkan/VulkanDevice.hh>
 #include <Renderer/Vulkan/VulkanSwapChain.hh>
+#include <Renderer/Vulkan/VulkanTimeline.hh>
 
+#include <Renderer/Vulkan/VulkanBindlessManager.hh>
 #include <Renderer/Vulkan/VulkanDescriptorManager.hh>
+#include <Renderer/Vulkan/VulkanGeometryHeap.hh>
+#include <Renderer/Vulkan/VulkanPipelineCache.hh>
+#include <Renderer/Vulkan/VulkanUploadManager.hh>
 
 
 namespace Mikoto {
@@ -29,12 +34,13 @@ namespace Mikoto {
         DESCRIPTOR_SET_LAYOUT_BASE_SHADER,
         DESCRIPTOR_SET_LAYOUT_PBR_SHADER,
         DESCRIPTOR_SET_LAYOUT_BASE_SHADER_WIREFRAME,
-        DESCRIPTOR_SET_LAYOUT_COMPUTE_PIPELINE
+        DESCRIPTOR_SET_LAYOUT_COMPUTE_PIPELINE,
+        DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS,
+        DESCRIPTOR_SET_LAYOUT_BINDLESS
     };
 
     // Used for short-lived commands
     struct ImmediateSubmitContext {
-        VkFence UploadFence{};            // Notify the host a task has finished executing
         VkCommandBuffer CommandBuffer{};  // Command buffer to submit work to
         Scope_T<VulkanCommandPool> CommandPool{};// Command pool to allocate command buffer from
     };
@@ -80,6 +86,13 @@ namespace Mikoto {
         // [General getters]
         MKT_NODISCARD auto GetSurface() const -> const VkSurfaceKHR& { return m_VulkanData.Surface; }
         MKT_NODISCARD auto GetDescriptorAllocator() -> VulkanDescriptorAllocator& { return m_DescriptorAllocator; }
+        MKT_NODISCARD auto GetBindlessManager() -> VulkanBindlessManager& { return m_BindlessManager; }
+        MKT_NODISCARD auto GetGeometryHeap() -> VulkanGeometryHeap& { return m_GeometryHeap; }
+        MKT_NODISCARD auto GetUploadManager() -> VulkanUploadManager& { return m_UploadManager; }
+        MKT_NODISCARD auto GetPipelineCache() -> VulkanPipelineCache& { return m_PipelineCache; }
+        MKT_NODISCARD auto GetGraphicsTimeline() -> VulkanTimeline& { return m_GraphicsTimeline; }
+        MKT_NODISCARD auto GetComputeTimeline() -> VulkanTimeline& { return m_ComputeTimeline; }
+        MKT_NODISCARD auto GetTransferTimeline() -> VulkanTimeline& { return m_TransferTimeline; }
         MKT_NODISCARD auto GetInstance() const -> const VkInstance& { return m_VulkanData.Instance; }
         MKT_NODISCARD auto GetInstance() -> VkInstance& { return m_VulkanData.Instance; }
         MKT_NODISCARD auto GetDevice() -> VulkanDevice& { return *m_VulkanData.Device; }
@@ -89,6 +102,10 @@ namespace Mikoto {
         MKT_NODISCARD auto GetVmaFunctions() const -> const VmaVulkanFunctions& { return m_VulkanData.VulkanVMAFunctions; }
         MKT_NODISCARD auto GetCurrentRenderableImageIndex() const -> UInt32_T { return m_CurrentRenderableSwapChainImage; }
 
+        // [Frames in flight]
+        MKT_NODISCARD auto GetFramesInFlight() const -> UInt32_T { return m_FramesInFlight; }
+        MKT_NODISCARD auto GetCurrentFrameIndex() const -> UInt32_T { return m_CurrentFrameIndex; }
+
         MKT_NODISCARD auto GetDescriptorSetLayouts( const DescriptorSetLayoutType type ) -> const VkDescriptorSetLayout& { return m_DescriptorSetLayouts[type]; }
 
     private:
@@ -103,10 +120,12 @@ namespace Mikoto {
 
         auto CreateDefaultDescriptorLayouts() -> void;
         auto InitDescriptorAllocator() -> void;
+        auto InitBindlessManager() -> void;
 
         auto RecreateSwapChain( bool enableVsync = false ) -> void;
 
         auto CreateDevice() -> void;
+        auto CreateTimelines() -> void;
         auto CreateSurface() -> void;
         auto CreateInstance() -> void;
         auto CreateDebugMessenger() -> void;
@@ -118,11 +137,39 @@ namespace Mikoto {
         auto SwitchSyncMode( bool enable ) -> void;
         MKT_NODISCARD auto CheckValidationLayerSupport() const -> bool;
 
+    public:
+        /**
+         * Bounds for the number of frames the CPU is allowed to record
+         * ahead of the GPU. Each frame in flight owns its own command buffers,
+         * synchronization primitives and uniform buffer slices.
+         * */
+        static constexpr UInt32_T MIN_FRAMES_IN_FLIGHT{ 2 };
+        static constexpr UInt32_T MAX_FRAMES_IN_FLIGHT{ 3 };
+
     private:
         std::unordered_map<DescriptorSetLayoutType, VkDescriptorSetLayout> m_DescriptorSetLayouts{};
 
         VulkanDescriptorAllocator m_DescriptorAllocator{};
 
+        // Textures and material parameters indexed from the shaders
+        VulkanBindlessManager m_BindlessManager{};
+        UInt32_T m_BindlessTextureCapacity{};
+
+        // Progress of each queue, every submission signals the next value of its queue timeline.
+        // Without a dedicated transfer family the transfer timeline is signaled from the graphics queue
+        VulkanTimeline m_GraphicsTimeline{};
+        VulkanTimeline m_ComputeTimeline{};
+        VulkanTimeline m_TransferTimeline{};
+
+        // Every pipeline is created through it, persisted across runs
+        VulkanPipelineCache m_PipelineCache{};
+
+        // Host to device copies of buffers and textures
+        VulkanUploadManager m_UploadManager{};
+
+        // Vertices and indices of every mesh
+        VulkanGeometryHeap m_GeometryHeap{};
+
         VulkanContextData m_VulkanData{
             .Instance{},
             .Surface{},
@@ -145,7 +192,17 @@ namespace Mikoto {
         // Swapchain manipulation data
         Scope_T<VulkanSwapChain> m_SwapChain{};
         UInt32_T m_CurrentRenderableSwapChainImage{};
-        FrameSynchronizationPrimitives m_SwapChainSyncObjects{};
+
+        // Frames in flight data
+        UInt32_T m_FramesInFlight{ MIN_FRAMES_IN_FLIGHT };
+        UInt32_T m_CurrentFrameIndex{};
+        std::vector<FrameSynchronizationPrimitives> m_FrameSyncObjects{};
+
+        // Graphics timeline value of the last submission of each frame in flight
+        std::vector<UInt64_T> m_FrameTimelineValues{};
+
+        // Graphics timeline value of the frame that last used each swapchain image
+        std::vector<UInt64_T> m_ImagesInFlight{};
 
         // Required application extensions
         std::vector<const char *> m_DeviceRequestedExtensions{
@@ -19,6 +19,9 @@ namespace Mikoto {
      * This class allows for deferring the deletion of resources by pushing deletion tasks
      * into a queue and later executing these tasks to perform cleanup. The deletion tasks
      * can be flushed, ensuring older objects get deleted first.
+     *
+     * Objects released while the application runs are retired instead: their deletion waits
+     * until the GPU has finished every frame that could still be using them.
      * */
     class VulkanDeletionQueue final {
     public:
@@ -30,10 +33,28 @@ namespace Mikoto {
         static auto Push(std::function<void()>&& function, bool immediateFlush = false) -> void {
             std::scoped_lock lock{ s_PushMutex };
 
-            // TODO: Logic to delete elements whever Release is called no matter what
             s_DeleteTasks.emplace_back(function);
         }
 
+        /**
+         * @brief Defers a deletion task until the GPU is done with the work submitted so far.
+         * The task is tagged with the graphics value the frame being recorded signals and the compute
+         * value submitted so far, and runs from Collect() once both queues are done with that frame. Once the queue
+         * has been flushed the device is idle, so the task runs right away.
+         * @param function The deletion function to be deferred.
+         * */
+        static auto Retire(std::function<void()>&& function) -> void;
+
+        /**
+         * @brief Runs the retired tasks whose frames have completed on the GPU. Called once per frame.
+         * */
+        static auto Collect() -> void;
+
+        /**
+         * @brief Runs every retired task. Only valid right after waiting for the device to be idle.
+         * */
+        static auto CollectAll() -> void;
+
         /** TODO: redesign
          * @brief Registers a Vulkan object for deletion.
          * @param obj The Vulkan object to be registered for deletion.
@@ -57,13 +78,9 @@ namespace Mikoto {
          * @brief Flushes the deletion queue, executing deletion tasks.
          * Reversely iterates through the deletion queue to execute the deletion tasks,
          * ensuring older objects get deleted first. After execution, the queue is cleared.
+         * Retired tasks run first. The device must be idle.
          * */
-        static auto Flush() -> void {
-            for (auto it{ s_DeleteTasks.rbegin() }; it != s_DeleteTasks.rend(); it++) {
-                (*it)();
-            }
-            s_DeleteTasks.clear();
-        }
+        static auto Flush() -> void;
 
     private:
         /** Mutex for synchronized deletion task addition. */
@@ -72,6 +89,23 @@ namespace Mikoto {
         /** Queue of deletion tasks. */
         static inline std::deque<std::function<void()>> s_DeleteTasks{};
         static inline std::deque<Ref_T<VulkanObject>> s_Objects{};
+
+        struct RetiredTask {
+            UInt64_T GraphicsValue{};
+
+            // Submitted when the task was retired, the frame being recorded may add one more
+            UInt64_T ComputeValue{};
+            std::function<void()> Function{};
+        };
+
+        /** Mutex for the retired tasks, objects may be released from the workers. */
+        static inline std::mutex s_RetireMutex{};
+
+        /** Retired tasks in the order they were retired, their values never decrease. */
+        static inline std::deque<RetiredTask> s_RetiredTasks{};
+
+        /** Set once the queue has been flushed, there are no frames in flight after that. */
+        static inline bool s_IsFlushed{};
     };
 }
 
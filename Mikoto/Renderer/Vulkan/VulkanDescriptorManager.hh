@@ -24,17 +24,26 @@ namespace Mikoto {
 
         auto Clear() -> void;
         auto WithBinding( UInt32_T binding, VkDescriptorType type, VkShaderStageFlags shaderStages = VK_SHADER_STAGE_VERTEX_BIT ) -> DescriptorLayoutBuilder&;
+
+        // Array of descriptors, flags are one of VkDescriptorBindingFlagBits (i.e, partially bound)
+        auto WithBindingArray( UInt32_T binding, VkDescriptorType type, UInt32_T count, VkShaderStageFlags shaderStages, VkDescriptorBindingFlags flags = 0 ) -> DescriptorLayoutBuilder&;
+
         auto Build( VkDevice device, const void* pNext = nullptr, VkDescriptorSetLayoutCreateFlags flags = 0 ) const -> VkDescriptorSetLayout;
 
+        MKT_NODISCARD auto GetBindings() const -> std::span<const VkDescriptorSetLayoutBinding> { return m_Bindings; }
+
     private:
         std::vector<VkDescriptorSetLayoutBinding> m_Bindings{};
+
+        // One per binding, only passed to the layout if any of them is set
+        std::vector<VkDescriptorBindingFlags> m_BindingFlags{};
     };
 
     // Handles updating descriptor sets
     class VulkanDescriptorWriter final {
     public:
         auto WriteBuffer( UInt32_T binding, VkBuffer buffer, Size_T size, Size_T offset, VkDescriptorType type ) -> VulkanDescriptorWriter&;
-        auto WriteImage( UInt32_T binding, VkImageView image, VkSampler sampler, VkImageLayout layout, VkDescriptorType type ) -> VulkanDescriptorWriter&;
+        auto WriteImage( UInt32_T binding, VkImageView image, VkSampler sampler, VkImageLayout layout, VkDescriptorType type, UInt32_T arrayElement = 0 ) -> VulkanDescriptorWriter&;
 
         auto Clear() -> void;
         auto UpdateSet(VkDevice device, VkDescriptorSet set) -> void;
@@ -6,6 +6,8 @@
 #define VULKANDEVICE_HH
 
 #include <functional>
+#include <mutex>
+#include <span>
 #include <unordered_map>
 
 #include <vk_mem_alloc.h>
@@ -15,6 +17,7 @@
 #include <Renderer/Vulkan/VulkanCommandPool.hh>
 #include <Renderer/Vulkan/VulkanHelpers.hh>
 #include <Renderer/Vulkan/VulkanImage.hh>
+#include <Renderer/Vulkan/VulkanTimeline.hh>
 
 namespace Mikoto {
 
@@ -71,8 +74,16 @@ namespace Mikoto {
         auto RegisterComputeCommand( VkCommandBuffer cmd ) -> void;
 
         // Queues
-        auto SubmitCommandsGraphicsQueue(const FrameSynchronizationPrimitives& syncPrimitives ) -> void;
-        auto SubmitCommandsComputeQueue(const ComputeSynchronizationPrimitives& syncPrimitives ) -> void;
+        // Both return the value the queue timeline reaches once the submitted commands complete
+        auto SubmitCommandsGraphicsQueue(const FrameSynchronizationPrimitives& syncPrimitives, std::span<const TimelineWait> timelineWaits, VulkanTimeline& timeline ) -> UInt64_T;
+        auto SubmitCommandsComputeQueue(const ComputeSynchronizationPrimitives& syncPrimitives, VulkanTimeline& timeline ) -> UInt64_T;
+
+        /**
+         * Queues need external synchronization and uploads may be submitted from the workers.
+         * Every submission, present and wait on a queue of this device holds this lock while it calls Vulkan.
+         * Held for the call only, the lock is never taken while waiting on the GPU.
+         * */
+        MKT_NODISCARD auto LockQueues() const -> std::unique_lock<std::mutex> { return std::unique_lock{ m_QueueMutex }; }
 
         auto Release() -> void override;
 
@@ -85,6 +96,9 @@ namespace Mikoto {
             // Support for wireframe mode
             bool FillModeNonSolid{ true };
 
+            // Support for runtime sized and partially bound descriptor arrays (bindless textures)
+            bool DescriptorIndexing{ true };
+
             // Not null if we want the device to support presentation
             const VkSurfaceKHR* Surface{ nullptr };
 
@@ -122,6 +136,9 @@ namespace Mikoto {
         VkDevice m_LogicalDevice{};
         VkPhysicalDevice m_PhysicalDevice{};
 
+        // One lock for every queue, several of them may be the same VkQueue
+        mutable std::mutex m_QueueMutex{};
+
         PhysicalDeviceInfo m_PhysicalDeviceInfo{};
 
         std::vector<VkCommandBuffer> m_GraphicsSubmitCommands{};
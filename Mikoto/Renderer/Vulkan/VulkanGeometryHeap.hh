@@ -0,0 +1,102 @@
+/**
+ * VulkanGeometryHeap.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_GEOMETRY_HEAP_HH
+#define MIKOTO_VULKAN_GEOMETRY_HEAP_HH
+
+// C++ Standard Library
+#include <memory>
+#include <mutex>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Data/OffsetAllocator.hh>
+#include <Library/Utility/Types.hh>
+#include <Renderer/Vulkan/VulkanBuffer.hh>
+
+namespace Mikoto {
+
+    struct VulkanGeometryHeapCreateInfo {
+        VkDeviceSize VertexCapacity{};
+        VkDeviceSize IndexCapacity{};
+    };
+
+    /**
+     * @class VulkanGeometryHeap
+     * @brief Owns one device local buffer for all the vertices and one for all the indices.
+     * Meshes sub-allocate ranges from them and are drawn with firstIndex/vertexOffset,
+     * so the buffers are bound once per command buffer instead of once per draw. When a
+     * buffer runs out of space it is replaced by one twice as big and the old contents are
+     * copied over, allocations keep their offsets.
+     * */
+    class VulkanGeometryHeap final {
+    public:
+        static constexpr VkDeviceSize DEFAULT_VERTEX_CAPACITY{ 64 * 1024 * 1024 };
+        static constexpr VkDeviceSize DEFAULT_INDEX_CAPACITY{ 16 * 1024 * 1024 };
+
+        using Allocation = OffsetAllocator::Allocation;
+
+    public:
+        auto Init( const VulkanGeometryHeapCreateInfo& createInfo ) -> void;
+        auto Shutdown() -> void;
+
+        /**
+         * @brief Returns a range of the vertex buffer whose offset is a multiple of alignment.
+         * Aligning to the vertex stride makes the offset expressible as a vertexOffset.
+         * */
+        MKT_NODISCARD auto AllocateVertices( VkDeviceSize size, VkDeviceSize alignment ) -> Allocation;
+        MKT_NODISCARD auto AllocateIndices( VkDeviceSize size ) -> Allocation;
+
+        auto FreeVertices( const Allocation& allocation ) -> void;
+        auto FreeIndices( const Allocation& allocation ) -> void;
+
+        /**
+         * @brief Copies data into the range through the upload manager.
+         * The copy lands before the next frame submitted reads it.
+         * */
+        auto UploadVertices( const Allocation& allocation, const void* data, VkDeviceSize size ) -> void;
+        auto UploadIndices( const Allocation& allocation, const void* data, VkDeviceSize size ) -> void;
+
+        /**
+         * @brief Binds the vertex buffer at binding 0 and the index buffer.
+         * Draws then select their mesh with firstIndex and vertexOffset.
+         * */
+        auto Bind( VkCommandBuffer commandBuffer ) const -> void;
+
+        MKT_NODISCARD auto GetVertexBuffer() const -> VkBuffer { return m_Vertices.Buffer->Get(); }
+        MKT_NODISCARD auto GetIndexBuffer() const -> VkBuffer { return m_Indices.Buffer->Get(); }
+
+        MKT_NODISCARD auto GetVertexStats() const -> OffsetAllocator::Stats;
+        MKT_NODISCARD auto GetIndexStats() const -> OffsetAllocator::Stats;
+
+    private:
+        struct Region {
+            const char* Name{};
+            VkBufferUsageFlags Usage{};
+            Scope_T<VulkanBuffer> Buffer{};
+            OffsetAllocator Allocator{};
+        };
+
+    private:
+        MKT_NODISCARD static auto CreateBuffer( VkDeviceSize size, VkBufferUsageFlags usage ) -> Scope_T<VulkanBuffer>;
+
+        MKT_NODISCARD auto Allocate( Region& region, VkDeviceSize size, VkDeviceSize alignment ) -> Allocation;
+        auto Free( Region& region, const Allocation& allocation ) -> void;
+        auto Upload( const Region& region, const Allocation& allocation, const void* data, VkDeviceSize size ) -> void;
+        auto Grow( Region& region, VkDeviceSize requiredSize ) -> void;
+
+    private:
+        Region m_Vertices{};
+        Region m_Indices{};
+
+        // Meshes may be created from the workers
+        mutable std::mutex m_Mutex{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_GEOMETRY_HEAP_HH
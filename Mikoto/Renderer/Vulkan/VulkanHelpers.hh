@@ -46,12 +46,20 @@ namespace Mikoto {
         std::optional<VulkanQueueData> Present{};
         std::optional<VulkanQueueData> Graphics{};
         std::optional<VulkanQueueData> Compute{};
+
+        // Only set if the device has a transfer only family, uploads fall back to the graphics queue otherwise
+        std::optional<VulkanQueueData> Transfer{};
     };
 
     struct FrameSynchronizationPrimitives {
         VkSemaphore PresentSemaphore{ VK_NULL_HANDLE };
         VkSemaphore RenderSemaphore{ VK_NULL_HANDLE };
-        VkFence RenderFence{ VK_NULL_HANDLE };
+    };
+
+    // Makes a submission wait until a timeline semaphore reaches the value
+    struct TimelineWait {
+        VkSemaphore Semaphore{ VK_NULL_HANDLE };
+        UInt64_T Value{};
     };
 
     struct ComputeSynchronizationPrimitives {
@@ -73,6 +81,7 @@ namespace Mikoto::VulkanHelpers {
     MKT_NODISCARD auto GetVulkanAttributeDataType(ShaderDataType type) -> VkFormat;
     MKT_NODISCARD auto HasGraphicsQueue( const VkQueueFamilyProperties& queueFamily ) -> bool;
     MKT_NODISCARD auto HasComputeQueue( const VkQueueFamilyProperties& queueFamily ) -> bool;
+    MKT_NODISCARD auto HasDedicatedTransferQueue( const VkQueueFamilyProperties& queueFamily ) -> bool;
     MKT_NODISCARD auto HasPresentQueue( const VkPhysicalDevice& device, UInt32_T queueFamilyIndex, const VkSurfaceKHR& surface, const VkQueueFamilyProperties& queueFamilyProperties ) -> bool;
     MKT_NODISCARD auto GetVkStageFromShaderStage(ShaderStage stage) -> VkShaderStageFlagBits;
     MKT_NODISCARD auto GetUniformBufferPadding(VkDeviceSize bufferOriginalSize, VkDeviceSize deviceMinOffsetAlignment) -> VkDeviceSize;
@@ -284,6 +293,17 @@ namespace Mikoto::VulkanHelpers::Initializers {
         return ret;
     }
 
+    /**
+     * Returns a default initialized VkCommandBufferInheritanceInfo structure
+     * @returns default initialized VkCommandBufferInheritanceInfo
+     * */
+    inline auto CommandBufferInheritanceInfo() -> VkCommandBufferInheritanceInfo {
+        VkCommandBufferInheritanceInfo ret{};
+        ret.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+        return ret;
+    }
+
     /**
      * Returns a default initialized VkRenderPassBeginInfo structure
      * @returns default initialized VkRenderPassBeginInfo
@@ -448,6 +468,17 @@ namespace Mikoto::VulkanHelpers::Initializers {
         return ret;
     }
 
+    /**
+     * Returns a default initialized VkMemoryBarrier structure
+     * @returns default initialized VkMemoryBarrier
+     * */
+    inline auto MemoryBarrier() -> VkMemoryBarrier {
+        VkMemoryBarrier ret{};
+        ret.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+        return ret;
+    }
+
     /**
      * Returns a default initialized VkDescriptorSetAllocateInfo structure
      * @returns default initialized VkDescriptorSetAllocateInfo
@@ -470,6 +501,28 @@ namespace Mikoto::VulkanHelpers::Initializers {
         return ret;
     }
 
+    /**
+     * Returns a default initialized VkPhysicalDeviceVulkan12Features structure
+     * @returns default initialized VkPhysicalDeviceVulkan12Features
+     * */
+    inline auto PhysicalDeviceVulkan12Features() -> VkPhysicalDeviceVulkan12Features {
+        VkPhysicalDeviceVulkan12Features ret{};
+        ret.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        return ret;
+    }
+
+    /**
+     * Returns a default initialized VkDescriptorSetLayoutBindingFlagsCreateInfo structure
+     * @returns default initialized VkDescriptorSetLayoutBindingFlagsCreateInfo
+     * */
+    inline auto DescriptorSetLayoutBindingFlagsCreateInfo() -> VkDescriptorSetLayoutBindingFlagsCreateInfo {
+        VkDescriptorSetLayoutBindingFlagsCreateInfo ret{};
+        ret.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+
+        return ret;
+    }
+
     /**
      * Returns a default initialized VkPhysicalDeviceVulkan13Features structure
      * @returns default initialized VkPhysicalDeviceVulkan13Features
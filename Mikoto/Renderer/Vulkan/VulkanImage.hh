@@ -48,6 +48,9 @@ namespace Mikoto {
 
         auto LayoutTransition( VkImageLayout newLayout, VkCommandBuffer cmd ) -> void;
 
+        // For layouts reached through barriers recorded by the caller, i.e, one barrier per mip
+        auto SetCurrentLayout( const VkImageLayout layout ) -> void { m_CurrentLayout = layout; }
+
         MKT_NODISCARD static auto Create(const VulkanImageCreateInfo& createInfo) -> Scope_T<VulkanImage>;
 
         auto Release() -> void override;
@@ -19,7 +19,7 @@
 
 #include <Common/Common.hh>
 #include <Renderer/Vulkan/VulkanObject.hh>
-#include <Renderer/Vulkan/VulkanBuffer.hh>
+#include <Renderer/Vulkan/VulkanGeometryHeap.hh>
 
 namespace Mikoto {
     struct VulkanIndexBufferCreateInfo {
@@ -33,6 +33,12 @@ namespace Mikoto {
 
         auto Bind(VkCommandBuffer commandBuffer) const -> void;
 
+        /**
+         * Index of the first index of this buffer in the geometry heap, to be passed
+         * as the firstIndex of the draw when the whole heap is bound.
+         * */
+        MKT_NODISCARD auto GetFirstIndex() const -> UInt32_T { return static_cast<UInt32_T>( m_Allocation.Offset / sizeof( UInt32_T ) ); }
+
         auto Release() -> void override;
 
         ~VulkanIndexBuffer() override;
@@ -43,7 +49,7 @@ namespace Mikoto {
         auto LoadIndices(const std::span<const UInt32_T> &indices) -> void;
 
     private:
-        Scope_T<VulkanBuffer> m_Buffer{};
+        VulkanGeometryHeap::Allocation m_Allocation{};
     };
 }
 
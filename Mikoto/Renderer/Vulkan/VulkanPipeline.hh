@@ -43,6 +43,14 @@ namespace Mikoto {
 
         std::span<const VkDynamicState> DynamicStateEnables{};
         std::span<const VkPipelineShaderStageCreateInfo> ShaderStages{};
+
+        // Vertex input, the default vertex buffer layout is used when these are empty
+        std::span<const VkVertexInputBindingDescription> VertexBindings{};
+        std::span<const VkVertexInputAttributeDescription> VertexAttributes{};
+
+        // Interface of the vertex stage, when set only the attributes it consumes are kept
+        // and pipeline creation fails if one of its inputs has no compatible attribute
+        const VulkanShaderReflection* VertexStageReflection{};
     };
 
     class VulkanPipeline final : public VulkanObject {
@@ -0,0 +1,76 @@
+/**
+ * VulkanPipelineCache.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_PIPELINE_CACHE_HH
+#define MIKOTO_VULKAN_PIPELINE_CACHE_HH
+
+// C++ Standard Library
+#include <array>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+    struct VulkanPipelineCacheCreateInfo {
+        // File the cache is loaded from at init and saved to at shutdown, no persistence if empty
+        Path_T FilePath{};
+    };
+
+    /**
+     * @class VulkanPipelineCache
+     * @brief Pipeline cache persisted to disk across runs, every pipeline is created through it.
+     * The file starts with a header identifying the device and driver that produced the data,
+     * data from any other device or driver version is discarded and the cache starts empty.
+     * */
+    class VulkanPipelineCache final {
+    public:
+        auto Init( const VulkanPipelineCacheCreateInfo& createInfo ) -> void;
+
+        /**
+         * @brief Writes the cache to disk and destroys it.
+         * */
+        auto Shutdown() -> void;
+
+        MKT_NODISCARD auto Get() const -> VkPipelineCache { return m_PipelineCache; }
+
+        // True if valid data was loaded from disk at init
+        MKT_NODISCARD auto IsWarm() const -> bool { return m_IsWarm; }
+
+    private:
+        struct FileHeader {
+            UInt32_T Magic{};
+            UInt32_T Version{};
+            UInt32_T VendorID{};
+            UInt32_T DeviceID{};
+            UInt32_T DriverVersion{};
+            std::array<UInt8_T, VK_UUID_SIZE> DeviceUUID{};
+            std::array<UInt8_T, VK_UUID_SIZE> PipelineCacheUUID{};
+            UInt64_T DataSize{};
+        };
+
+        static constexpr UInt32_T FILE_MAGIC{ 0x43504B4D }; // "MKPC"
+        static constexpr UInt32_T FILE_VERSION{ 1 };
+
+    private:
+        MKT_NODISCARD auto GetCurrentHeader() const -> FileHeader;
+        MKT_NODISCARD auto LoadFromFile() const -> std::vector<UInt8_T>;
+        auto SaveToFile() const -> void;
+
+    private:
+        VkDevice m_Device{};
+        VkPipelineCache m_PipelineCache{};
+
+        Path_T m_FilePath{};
+        bool m_IsWarm{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_PIPELINE_CACHE_HH
@@ -0,0 +1,119 @@
+/**
+ * VulkanPipelineVariants.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_PIPELINE_VARIANTS_HH
+#define MIKOTO_VULKAN_PIPELINE_VARIANTS_HH
+
+// C++ Standard Library
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Core/System/TaskSystem.hh>
+#include <Library/Utility/Types.hh>
+#include <Renderer/Vulkan/VulkanPipeline.hh>
+
+namespace Mikoto {
+
+    // Features that change the code or the fixed function state of a variant
+    enum PipelineVariantFeatureFlagBits : UInt32_T {
+        PIPELINE_VARIANT_FEATURE_NONE = 0,
+        PIPELINE_VARIANT_FEATURE_WIREFRAME = 1 << 0,
+
+        // Reads the compact buffer layout, see VertexFormat
+        PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES = 1 << 1,
+
+        // Features the draws cannot do without, kept in the variant used while the requested one is built
+        PIPELINE_VARIANT_REQUIRED_FEATURES = PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES,
+    };
+
+    struct VulkanPipelineVariantKey {
+        Size_T Pass{};
+
+        // One of the DISPLAY_* modes, see RendererBackend.hh
+        UInt32_T RenderMode{};
+        UInt32_T Features{ PIPELINE_VARIANT_FEATURE_NONE };
+
+        auto operator==( const VulkanPipelineVariantKey& other ) const -> bool = default;
+    };
+
+    struct VulkanPipelineVariantKeyHash {
+        auto operator()( const VulkanPipelineVariantKey& key ) const noexcept -> Size_T {
+            return std::hash<UInt64_T>{}( ( static_cast<UInt64_T>( key.Pass ) << 40 ) ^ ( static_cast<UInt64_T>( key.RenderMode ) << 20 ) ^ key.Features );
+        }
+    };
+
+    /**
+     * @class VulkanPipelineVariantCache
+     * @brief Pipelines of a pass specialized for a render mode and a set of features.
+     * The render mode and the features are baked into the shaders as specialization constants,
+     * so the default shading path does not branch on debug views. The default variant of every
+     * pass is built when the pass is added, along with one for each vertex format. The others are built
+     * on the TaskSystem workers the first time they are requested, and the default variant reading the
+     * same vertex format is used in the meantime.
+     * */
+    class VulkanPipelineVariantCache final {
+    public:
+        // constant_id of the specialization constants in the shaders
+        static constexpr UInt32_T RENDER_MODE_CONSTANT_ID{ 0 };
+        static constexpr UInt32_T WIREFRAME_CONSTANT_ID{ 1 };
+        static constexpr UInt32_T COMPACT_VERTICES_CONSTANT_ID{ 2 };
+
+    public:
+        auto Init() -> void;
+        auto Shutdown() -> void;
+
+        /**
+         * @brief Registers the state every variant of the pass starts from and builds the default variant.
+         * The arrays referenced by the create info are copied.
+         * */
+        auto AddPass( Size_T pass, const VulkanPipelineCreateInfo& createInfo, UInt32_T defaultRenderMode ) -> void;
+
+        /**
+         * @brief Returns the variant, or the default variant of the pass with the same required features while it is being built.
+         * Resolve the variants of the frame before recording, the returned pipeline stays valid
+         * until the cache is shut down.
+         * */
+        MKT_NODISCARD auto Resolve( const VulkanPipelineVariantKey& key ) -> const VulkanPipeline*;
+
+    private:
+        struct PassState {
+            VulkanPipelineCreateInfo CreateInfo{};
+            VulkanPipelineVariantKey DefaultKey{};
+
+            // Storage for the spans of the create info
+            std::vector<VkPipelineShaderStageCreateInfo> ShaderStages{};
+            std::vector<VkVertexInputBindingDescription> VertexBindings{};
+            std::vector<VkVertexInputAttributeDescription> VertexAttributes{};
+            std::vector<VkDynamicState> DynamicStates{};
+        };
+
+    private:
+        MKT_NODISCARD static auto Build( const PassState& passState, const VulkanPipelineVariantKey& key ) -> Scope_T<VulkanPipeline>;
+
+        auto Compile( const VulkanPipelineVariantKey& key ) -> void;
+
+    private:
+        std::unordered_map<Size_T, Scope_T<PassState>> m_Passes{};
+
+        // Failed builds are kept as null so they are not attempted again
+        std::unordered_map<VulkanPipelineVariantKey, Scope_T<VulkanPipeline>, VulkanPipelineVariantKeyHash> m_Variants{};
+        std::unordered_set<VulkanPipelineVariantKey, VulkanPipelineVariantKeyHash> m_PendingVariants{};
+
+        // Builds in progress, the frames do not wait for them
+        TaskSystem::JobCounter m_CompileJobs{};
+        bool m_IsShuttingDown{};
+
+        std::mutex m_Mutex{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_PIPELINE_VARIANTS_HH
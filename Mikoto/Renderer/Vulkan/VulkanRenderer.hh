@@ -8,6 +8,7 @@
 
 // C++ Standard Library
 #include <array>
+#include <exception>
 #include <vector>
 #include <filesystem>
 #include <unordered_map>
@@ -21,10 +22,12 @@
 #include <Assets/Mesh.hh>
 #include <Material/Core/Material.hh>
 #include <Renderer/Core/RendererBackend.hh>
+#include <Renderer/Vulkan/VulkanBuffer.hh>
 #include <Renderer/Vulkan/VulkanCommandPool.hh>
 #include <Renderer/Vulkan/VulkanFrameBuffer.hh>
 #include <Renderer/Vulkan/VulkanImage.hh>
 #include <Renderer/Vulkan/VulkanPipeline.hh>
+#include <Renderer/Vulkan/VulkanPipelineVariants.hh>
 #include <Renderer/Vulkan/VulkanDevice.hh>
 #include <Renderer/Vulkan/VulkanTextureCubeMap.hh>
 
@@ -34,6 +37,61 @@ namespace Mikoto {
     };
 
     class VulkanRenderer final : public RendererBackend {
+    public:
+        /**
+         * Minimum amount of draws a recording task gets. Below this, recording
+         * inline on the render thread is cheaper than waking up the workers.
+         * */
+        static constexpr Size_T MIN_DRAWS_PER_RECORDING_TASK{ 256 };
+
+        /**
+         * Dimensions of the light clusters grid. The view frustum is split in
+         * screen space tiles and exponential depth slices, each cluster keeps a list
+         * of the point and spot lights overlapping it, written by the light culling pass.
+         * */
+        static constexpr UInt32_T CLUSTER_GRID_SIZE_X{ 16 };
+        static constexpr UInt32_T CLUSTER_GRID_SIZE_Y{ 9 };
+        static constexpr UInt32_T CLUSTER_GRID_SIZE_Z{ 24 };
+        static constexpr UInt32_T CLUSTER_COUNT{ CLUSTER_GRID_SIZE_X * CLUSTER_GRID_SIZE_Y * CLUSTER_GRID_SIZE_Z };
+        static constexpr UInt32_T MAX_LIGHTS_PER_CLUSTER{ 128 };
+
+        // Must match local_size_x in ClusteredLightCulling.glsl
+        static constexpr UInt32_T LIGHT_CULLING_GROUP_SIZE{ 128 };
+
+        /**
+         * Maximum number of PBR draws per frame. They are culled on the GPU and issued
+         * with one indirect draw per vertex format, the instance buffer is sized for it.
+         * */
+        static constexpr UInt32_T MAX_DRAW_INSTANCES{ 16384 };
+
+        /**
+         * Maximum number of meshlets the PBR draws of a frame can be split in. Every meshlet is culled
+         * on its own and becomes one indirect draw command, so the command buffers hold that many
+         * commands for each vertex format. Meshlets past it are dropped, which is logged the first time.
+         * */
+        static constexpr UInt32_T MAX_DRAW_MESHLETS{ 65536 };
+
+        /**
+         * Culls the meshlets whose triangles all face away from the camera, with their normal cones.
+         * Off, the PBR pipelines draw both faces of the triangles and the imported materials do not
+         * say which ones are single sided, so the test would drop back faces that are visible.
+         * */
+        static constexpr bool MESHLET_CONE_CULLING{ false };
+
+        // Meshes of each vertex format are drawn by their own pipeline, see RecordIndirectDraws()
+        static constexpr UInt32_T VERTEX_FORMAT_COUNT{ static_cast<UInt32_T>( VertexFormat::COUNT ) };
+
+        // Must match local_size_x in DrawCulling.glsl
+        static constexpr UInt32_T DRAW_CULLING_GROUP_SIZE{ 64 };
+
+        /**
+         * Meshes are drawn at the coarsest level of detail whose error covers at most this many
+         * pixels on screen. A mesh only switches levels once the error crosses the threshold by
+         * LOD_HYSTERESIS (relative to it), so meshes sitting at a boundary do not pop back and forth.
+         * */
+        static constexpr float LOD_ERROR_THRESHOLD_PIXELS{ 1.0f };
+        static constexpr float LOD_HYSTERESIS{ 0.25f };
+
     public:
         explicit VulkanRenderer(const VulkanRendererCreateInfo& createInfo);
 
@@ -44,6 +102,7 @@ namespace Mikoto {
         auto EndFrame() -> void override;
 
         auto EnableWireframe( bool enable ) -> void override;
+        auto EnableDepthPrepass( bool enable ) -> void override;
 
         auto RemoveFromDrawQueue( UInt64_T id ) -> bool override;
         auto AddToDrawQueue(  const EntityQueueInfo& queueInfo ) -> bool override;
@@ -70,6 +129,9 @@ namespace Mikoto {
 
             bool IsRendered{ false };
 
+            // Index into the levels of detail of the mesh, kept across frames for the hysteresis
+            UInt32_T LodIndex{};
+
             // For now, we assume the
             // mesh has only one material
             Material* MaterialData{};
@@ -80,31 +142,160 @@ namespace Mikoto {
             LightType ActiveType{};
         };
 
+        // Matches the SceneLightsBuffer storage block (std430) in the shaders
+        struct SceneLightsData {
+            // x = directional, y = point, z = spot, w = unused
+            glm::ivec4 LightCounts{};
+
+            // xyz = number of clusters per axis, w = max lights per cluster
+            glm::uvec4 ClusterGridSize{};
+
+            // x = near plane, y = far plane, z = depth slice scale, w = depth slice bias
+            glm::vec4 ClusterDepthParams{};
+
+            // xy = render target size, zw = cluster tile size (in pixels)
+            glm::vec4 ScreenSize{};
+
+            glm::mat4 View{};
+            glm::mat4 InverseProjection{};
+
+            DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS_PER_SCENE];
+            PointLight PointLights[MAX_LIGHTS_PER_SCENE];
+            SpotLight SpotLights[MAX_LIGHTS_PER_SCENE];
+        };
+
+        // Camera and render settings of the frame, matches FrameUniformBuffer in the shaders
+        struct FrameUniformData {
+            glm::mat4 View{};
+            glm::mat4 Projection{};
+            glm::vec4 ViewPosition{};
+
+            // x = display mode, y = wireframe
+            glm::ivec4 RenderSettings{};
+        };
+
+        // Per draw data of the PBR draws, matches DrawInstance in the shaders. Selected
+        // in the vertex shaders with gl_InstanceIndex, the first instance of the indirect draw
+        struct DrawInstanceData {
+            glm::mat4 Transform{};
+
+            // xyz = center in object space, w = radius
+            glm::vec4 BoundingSphere{};
+
+            // x = index count, y = first index, z = vertex offset, w = positions vertex offset
+            glm::ivec4 Geometry{};
+
+            // x = index in the bindless materials buffer, y = vertex format of the mesh,
+            // z = 1 if the transform keeps the normal cones of the meshlets (uniform scale, no mirroring)
+            glm::uvec4 Material{};
+
+            // Dequantization of the vertices, see VertexDequantization. w unused
+            glm::vec4 PositionScale{};
+            glm::vec4 PositionOffset{};
+
+            // xy = texture coordinates scale, zw = texture coordinates offset
+            glm::vec4 TexCoordTransform{};
+        };
+
+        // One meshlet of a PBR draw, culled on its own. Matches DrawMeshlet in DrawCulling.glsl
+        struct DrawMeshletData {
+            // xyz = center in object space, w = radius
+            glm::vec4 BoundingSphere{};
+
+            // xyz = axis in object space, w = cutoff, see MeshOptimizer::Meshlet
+            glm::vec4 Cone{};
+
+            // x = index of the draw instance, y = index count, z = first index, w unused
+            glm::uvec4 Geometry{};
+        };
+
+        // Pushed to the draw culling pipeline, matches CullingData in DrawCulling.glsl
+        struct DrawCullingPushConstants {
+            // World space planes pointing inside the frustum
+            glm::vec4 FrustumPlanes[6]{};
+
+            // xyz = world space position of the camera, w unused
+            glm::vec4 CameraPosition{};
+
+            UInt32_T MeshletCount{};
+
+            // Commands of each vertex format start at a multiple of it
+            UInt32_T BatchCapacity{};
+
+            // 1 to test the normal cones of the meshlets, see MESHLET_CONE_CULLING
+            UInt32_T ConeCulling{};
+            UInt32_T Padding{};
+        };
+
+        // Pushed for every draw of the standard (and outline) pipelines, matches DrawData in the shaders
+        struct DrawPushConstants {
+            glm::mat4 Transform{};
+
+            // Index in the bindless materials buffer
+            UInt32_T MaterialIndex{};
+            UInt32_T Padding[3]{};
+        };
+
+        // Used by a single recording task at a time, so the
+        // command pool does not need any external synchronization
+        struct SecondaryRecordingContext {
+            Scope_T<VulkanCommandPool> CommandPool{};
+            VkCommandBuffer CommandBuffer{};
+
+            // Exceptions can't cross the worker boundary, they are rethrown on the render thread
+            std::exception_ptr Error{};
+        };
+
     private:
         auto CreateCommandPools() -> void;
         auto CreateCommandBuffers() -> void;
-        auto SetupObjectOutline(const MeshRenderInfo& meshRenderInfo) -> void;
-
-        auto SetupPBRPass(const MeshRenderInfo& meshRenderInfo) -> void;
-        auto SetupDefaultPass(const MeshRenderInfo& meshRenderInfo) -> void;
+        auto CreateSecondaryCommandBuffers() -> void;
+        auto SetupObjectOutline( VkCommandBuffer cmd, const MeshRenderInfo& meshRenderInfo ) -> void;
+
+        auto CreateSceneLightsBuffers() -> void;
+        auto UploadSceneLights() -> void;
+        auto RecordLightCulling( VkCommandBuffer cmd ) -> void;
+        auto BindSceneLights( VkCommandBuffer cmd, VkPipelineLayout pipelineLayout ) const -> void;
+        auto UploadFrameUniforms() -> void;
+
+        auto BindPBRDescriptorSets( VkCommandBuffer cmd ) const -> void;
+        auto PushDrawConstants( VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, const MeshRenderInfo& meshRenderInfo ) const -> void;
+
+        auto SetupDefaultPass( VkCommandBuffer cmd, const MeshRenderInfo& meshRenderInfo ) -> void;
+
+        auto SelectLod( MeshRenderInfo& meshRenderInfo ) const -> void;
+        auto BuildDrawList() -> void;
+        auto UploadDrawInstances() -> void;
+        auto RecordDrawCulling( VkCommandBuffer cmd ) -> void;
+        auto RecordIndirectDraws( VkCommandBuffer cmd ) -> void;
+        auto UpdateMaterialUniforms() -> void;
+        auto RecordDepthPrepass( VkCommandBuffer cmd ) -> void;
+        auto RecordDrawRange( VkCommandBuffer cmd, Size_T first, Size_T last ) -> void;
+        auto ResolvePipelineVariants() -> void;
+        auto RecordSecondaryCommands( VkCommandBuffer primaryCmd ) -> void;
 
         auto RecordCommands() -> void;
         auto RecordComputeCommands() -> void;
         auto RecordComputeCommandsDEBUG() -> void;
         auto PrepareOffscreenRender() -> void;
 
-        auto CreateOffscreenRenderPass() -> void;
+        auto CreateOffscreenRenderPass( VkAttachmentLoadOp depthLoadOp ) -> VkRenderPass;
+        auto CreateDepthPrepassRenderPass() -> void;
         auto CreateOffscreenAttachments() -> void;
         auto CreateOffscreenFramebuffers() -> void;
 
-        auto InitializePBRWireFramePipeline() -> void;
         auto InitializeComputePipelines() -> void;
+        auto InitializeLightCullingPipeline() -> void;
+        auto InitializeDrawCullingPipeline() -> void;
 
         auto InitializeDefaultPipeline() -> void;
         auto InitializePBRPipeline() -> void;
+        auto InitializeDepthPrepassPipeline() -> void;
 
         auto InitializeOutlinePipeline() -> void;
 
+        auto CreatePBRPipelineLayout() -> void;
+
         auto CreateRendererPipelines() -> void;
 
         auto UpdateViewport(float x, float y, float width, float height) -> void;
@@ -117,6 +308,7 @@ namespace Mikoto {
 
     private:
         bool m_WireframeEnable{ false };
+        bool m_DepthPrepassEnable{ true };
 
         VulkanDevice* m_Device{};
 
@@ -125,6 +317,14 @@ namespace Mikoto {
         const VulkanTextureCubeMap* m_CubeMap{};
 
         VkRenderPass m_OffscreenMainRenderPass{};
+
+        // Same as the main render pass, but keeps the depth written by the depth pre-pass
+        VkRenderPass m_OffscreenMainLoadDepthRenderPass{};
+
+        // Depth only, renders into the offscreen depth attachment
+        VkRenderPass m_DepthPrepassRenderPass{};
+        Scope_T<VulkanFrameBuffer> m_DepthPrepassFrameBuffer{};
+
         Scope_T<VulkanImage> m_OffscreenColorAttachment{};
         Scope_T<VulkanImage> m_OffscreenDepthAttachment{};
         Scope_T<VulkanFrameBuffer> m_OffscreenFrameBuffer{};
@@ -137,15 +337,70 @@ namespace Mikoto {
 
         std::array<VkClearValue, 2> m_ClearValues{};
 
-        VkCommandBuffer m_DrawCommandBuffer{};
-        VkCommandBuffer m_ComputeCommandBuffer{};
+        // One per frame in flight, indexed by VulkanContext::GetCurrentFrameIndex()
+        std::vector<VkCommandBuffer> m_DrawCommandBuffers{};
+        std::vector<VkCommandBuffer> m_ComputeCommandBuffers{};
 
         Scope_T<VulkanCommandPool> m_GraphicsCommandPool{};
         Scope_T<VulkanCommandPool> m_ComputeCommandPool{};
 
+        // [frame in flight][recording task], one secondary command buffer each
+        std::vector<std::vector<SecondaryRecordingContext>> m_RecordingContexts{};
+
+        // Draw queue entries to be recorded this frame, sorted to minimize state changes
+        std::vector<const MeshRenderInfo*> m_DrawList{};
+
+        // PBR entries of the draw queue, culled on the GPU and drawn indirectly. Sorted by material
+        std::vector<const MeshRenderInfo*> m_IndirectDrawList{};
+
+        // Number of instances written to the draw instances buffer this frame
+        UInt32_T m_DrawInstanceCount{};
+
+        // Number of meshlets written to the draw meshlets buffer this frame, in total and for each vertex format
+        UInt32_T m_DrawMeshletCount{};
+        std::array<UInt32_T, VERTEX_FORMAT_COUNT> m_FormatDrawMeshletCounts{};
+
+        // Draws and meshlets past the capacity of the buffers are not drawn, reported the first time it happens
+        bool m_HasReportedDrawInstanceLimit{};
+        bool m_HasReportedDrawMeshletLimit{};
+
         std::unordered_map<UInt64_T, LightRenderInfo> m_Lights{};
 
+        // Lights are packed once per frame and shared by every draw, one buffer per frame in flight
+        std::vector<Scope_T<VulkanBuffer>> m_SceneLightsBuffers{};
+
+        // Written by the light culling pass, one of each per frame in flight
+        std::vector<Scope_T<VulkanBuffer>> m_ClusterGridBuffers{};
+        std::vector<Scope_T<VulkanBuffer>> m_ClusterLightIndicesBuffers{};
+
+        // Camera of the frame, read through the scene lights set. One per frame in flight
+        std::vector<Scope_T<VulkanBuffer>> m_FrameUniformBuffers{};
+
+        // Written by the host every frame, read by the draw culling and the PBR vertex shaders
+        std::vector<Scope_T<VulkanBuffer>> m_DrawInstanceBuffers{};
+
+        // Meshlets of the draw instances, written by the host every frame and read by the draw culling
+        std::vector<Scope_T<VulkanBuffer>> m_DrawMeshletBuffers{};
+
+        // Written by the draw culling pass and consumed by vkCmdDrawIndexedIndirectCount. The depth
+        // pre-pass gets its own commands, its vertices are addressed in the positions stream
+        std::vector<Scope_T<VulkanBuffer>> m_IndirectDrawBuffers{};
+        std::vector<Scope_T<VulkanBuffer>> m_DepthPrepassIndirectDrawBuffers{};
+        std::vector<Scope_T<VulkanBuffer>> m_IndirectDrawCountBuffers{};
+
+        std::vector<VkDescriptorSet> m_SceneLightsDescriptorSets{};
+
+        // Shared by every pipeline drawing PBR materials. Set 0 holds the bindless
+        // textures and materials, set 1 the scene lights and the draw instances
+        VkPipelineLayout m_PBRPipelineLayout{};
+
         std::unordered_map<Size_T, VulkanPipeline> m_Pipelines{};
+
+        // PBR passes, specialized for the render mode and wireframe
+        VulkanPipelineVariantCache m_PipelineVariants{};
+
+        // Variants used by the frame being recorded for each vertex format, resolved before recording starts
+        std::array<const VulkanPipeline*, VERTEX_FORMAT_COUNT> m_FramePipelineVariants{};
         std::unordered_map<UInt64_T, MeshRenderInfo> m_DrawQueue{};
 
         bool m_UseWireframe{};
@@ -18,6 +18,7 @@
 #include <Library/Utility/Types.hh>
 #include <Library/Filesystem/File.hh>
 #include <Renderer/Vulkan/VulkanObject.hh>
+#include <Renderer/Vulkan/VulkanShaderReflection.hh>
 
 namespace Mikoto {
 
@@ -33,6 +34,10 @@ namespace Mikoto {
         MKT_NODISCARD auto Get() const -> const VkShaderModule& { return m_Module; }
         MKT_NODISCARD auto GetPipelineStageCreateInfo() const -> const VkPipelineShaderStageCreateInfo& { return m_StageCreateInfo; }
 
+        // Interface of the module, read from its SPIR-V when it is loaded
+        MKT_NODISCARD auto GetReflection() const -> const VulkanShaderReflection& { return m_Reflection; }
+        MKT_NODISCARD auto GetFilePath() const -> const Path_T& { return m_FilePath; }
+
         auto Release() -> void override;
 
         ~VulkanShader() override;
@@ -42,11 +47,14 @@ namespace Mikoto {
 
     private:
         const File* m_File{ nullptr };
+        Path_T m_FilePath{};
 
         std::string m_Code{};
         std::string m_EntryPoint{};
         VkShaderModule m_Module{};
         VkPipelineShaderStageCreateInfo m_StageCreateInfo{};
+
+        VulkanShaderReflection m_Reflection{};
     };
 }
 
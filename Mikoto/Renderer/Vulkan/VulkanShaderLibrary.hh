@@ -5,12 +5,31 @@
 #ifndef SHADERLIBRARY_HH
 #define SHADERLIBRARY_HH
 
+#include <mutex>
+#include <span>
+#include <string>
 #include <unordered_map>
+#include <vector>
+
+#include <volk.h>
 
 #include <Material/Core/Shader.hh>
 #include <Renderer/Vulkan/VulkanShader.hh>
 
 namespace Mikoto {
+    struct VulkanPipelineLayoutCreateInfo {
+        // Stages of the pipeline, or of every pipeline sharing the layout
+        std::span<const VulkanShader* const> Shaders{};
+
+        // Layouts owned elsewhere indexed by set number (i.e, the bindless set). The bindings the
+        // shaders declare are validated against them, sets without one are created from the reflection
+        std::span<const VkDescriptorSetLayout> SharedSetLayouts{};
+
+        // Bytes and stages the renderer pushes, the block declared by the shaders has to fit in them
+        UInt32_T PushConstantSize{};
+        VkShaderStageFlags PushConstantStages{};
+    };
+
     class VulkanShaderLibrary {
     public:
         static auto Init() -> void;
@@ -19,8 +38,36 @@ namespace Mikoto {
         static auto GetShader( const Path_T &filePath ) -> VulkanShader *;
         static auto LoadShader( const VulkanShaderCreateInfo &loadInfo ) -> VulkanShader *;
 
+        /**
+         * @brief Makes the bindings of a layout created outside the library known,
+         * so it can be shared by pipeline layouts. The library does not take ownership of it.
+         * */
+        static auto RegisterSharedSetLayout( VkDescriptorSetLayout layout, std::span<const VkDescriptorSetLayoutBinding> bindings ) -> void;
+
+        /**
+         * @brief Returns the layout with these bindings, layouts are created once and deduplicated by their contents.
+         * */
+        static auto GetDescriptorSetLayout( std::span<const VkDescriptorSetLayoutBinding> bindings ) -> VkDescriptorSetLayout;
+
+        /**
+         * @brief Returns the pipeline layout matching the reflected interface of the shaders.
+         * Throws if the shaders do not agree with the shared set layouts or the push constants.
+         * */
+        static auto GetPipelineLayout( const VulkanPipelineLayoutCreateInfo &createInfo ) -> VkPipelineLayout;
+
+    private:
+        static auto ValidateSharedSetLayout( VkDescriptorSetLayout layout, std::span<const ShaderBindingReflection> bindings, const std::string &shaderNames ) -> void;
+
     private:
         inline static std::unordered_map<std::string, Scope_T<VulkanShader>> s_Shaders{};
+
+        // Keyed by a description of their contents, owned by the library
+        inline static std::unordered_map<std::string, VkDescriptorSetLayout> s_SetLayouts{};
+        inline static std::unordered_map<std::string, VkPipelineLayout> s_PipelineLayouts{};
+
+        inline static std::unordered_map<VkDescriptorSetLayout, std::vector<VkDescriptorSetLayoutBinding>> s_SetLayoutBindings{};
+
+        inline static std::mutex s_LayoutsMutex{};
     };
 
 }// namespace Mikoto
@@ -0,0 +1,97 @@
+/**
+ * VulkanShaderReflection.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_SHADER_REFLECTION_HH
+#define MIKOTO_VULKAN_SHADER_REFLECTION_HH
+
+// C++ Standard Library
+#include <span>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+    struct ShaderBindingReflection {
+        UInt32_T Set{};
+        UInt32_T Binding{};
+        VkDescriptorType Type{};
+
+        // Number of descriptors, zero for runtime sized arrays (i.e, bindless textures)
+        UInt32_T Count{};
+        VkShaderStageFlags Stages{};
+    };
+
+    enum class ShaderNumericType {
+        FLOAT,
+        SIGNED_INT,
+        UNSIGNED_INT,
+    };
+
+    struct ShaderVertexInputReflection {
+        UInt32_T Location{};
+        ShaderNumericType NumericType{};
+        UInt32_T ComponentCount{};
+
+        // 32 bit format with the same type and component count as the input
+        VkFormat Format{};
+    };
+
+    /**
+     * @class VulkanShaderReflection
+     * @brief Interface of one or more shader stages read back from their SPIR-V.
+     * Only the parts needed to build pipeline layouts and vertex input states are
+     * extracted: resource bindings, the push constant block and the vertex inputs.
+     * */
+    class VulkanShaderReflection final {
+    public:
+        /**
+         * @brief Parses the module, throws if the code is not valid SPIR-V.
+         * */
+        MKT_NODISCARD static auto Reflect( std::span<const UInt32_T> code, VkShaderStageFlagBits stage ) -> VulkanShaderReflection;
+
+        /**
+         * @brief Adds the interface of other to this one, as if both were stages of the same pipeline.
+         * Throws if a binding is declared with different types or counts by the stages.
+         * */
+        auto Merge( const VulkanShaderReflection& other ) -> void;
+
+        /**
+         * @brief Keeps the attributes consumed by the vertex inputs.
+         * Throws if an input has no attribute or the attribute format is not compatible with it.
+         * */
+        MKT_NODISCARD auto MatchVertexAttributes( std::span<const VkVertexInputAttributeDescription> attributes ) const -> std::vector<VkVertexInputAttributeDescription>;
+
+        MKT_NODISCARD auto GetStages() const -> VkShaderStageFlags { return m_Stages; }
+
+        // Sorted by set and binding
+        MKT_NODISCARD auto GetBindings() const -> const std::vector<ShaderBindingReflection>& { return m_Bindings; }
+
+        // Number of sets the pipeline layout needs, highest set used plus one
+        MKT_NODISCARD auto GetSetCount() const -> UInt32_T;
+
+        MKT_NODISCARD auto GetPushConstantSize() const -> UInt32_T { return m_PushConstantSize; }
+        MKT_NODISCARD auto GetPushConstantStages() const -> VkShaderStageFlags { return m_PushConstantStages; }
+
+        MKT_NODISCARD auto GetVertexInputs() const -> const std::vector<ShaderVertexInputReflection>& { return m_VertexInputs; }
+
+    private:
+        VkShaderStageFlags m_Stages{};
+
+        std::vector<ShaderBindingReflection> m_Bindings{};
+
+        UInt32_T m_PushConstantSize{};
+        VkShaderStageFlags m_PushConstantStages{};
+
+        std::vector<ShaderVertexInputReflection> m_VertexInputs{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_SHADER_REFLECTION_HH
@@ -10,6 +10,7 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <vector>
 
 // Third-Party Libraries
 #include "glm/glm.hpp"
@@ -30,55 +31,39 @@ namespace Mikoto {
 
         auto UpdateDescriptorSets() -> void;
 
-        auto SetView(const glm::mat4& mat) -> void { m_VertexUniformData.View = mat; }
-        auto SetProjection(const glm::mat4& mat) -> void { m_VertexUniformData.Projection = mat; }
-        auto SetTransform(const glm::mat4& transform) -> void { m_VertexUniformData.Transform = transform; }
-
+        /**
+         * Binds the set of the current frame. Only records commands, safe to call from the recording workers
+         * */
         auto BindDescriptorSet(const VkCommandBuffer &commandBuffer, const VkPipelineLayout &pipelineLayout ) -> void;
 
         MKT_NODISCARD auto GetPass() const -> MaterialPass { return m_MaterialPass; }
 
+        /**
+         * Writes the uniforms of the current frame and the textures changed since its set was last written.
+         * Must be called from the main thread before the draws using the material are recorded
+         * */
         auto UploadUniformBuffers() -> void;
 
-        auto ResetLights() -> void;
-        auto UpdateLightsInfo(const LightData& lightData, LightType type) -> void;
-
         auto SetTexture( Texture* map, MapType type ) -> void override;
         auto RemoveMap( MapType type ) -> void override;
 
-        auto SetViewPosition(const glm::vec3 viewPos ) -> void { m_FragmentUniformLightsData.ViewPosition = glm::vec4{ viewPos, 1.0f }; }
-
         DISABLE_COPY_AND_MOVE_FOR( VulkanStandardMaterial );
 
     private:
+        // Only what is shared by every draw using the material. The camera is read from the
+        // frame uniform buffer and the transform is pushed per draw, see VulkanRenderer::DrawPushConstants
         struct UniformBufferData {
-            // Camera
-            glm::mat4 View{};
-            glm::mat4 Projection{};
-
-            // Object
-            glm::mat4 Transform{};
             glm::vec4 Color{};
         };
 
-        struct LightsUniformData {
-            SpotLight SpotLights[MAX_LIGHTS_PER_SCENE];
-            PointLight PointLights[MAX_LIGHTS_PER_SCENE];
-            DirectionalLight DirectionalLights[MAX_LIGHTS_PER_SCENE];
-
-            glm::vec4 ViewPosition{};
-
-            // x = Total number of lights
+        // Lights are not part of the material, they are read
+        // from the scene lights storage buffer owned by the renderer
+        struct FragmentUniformBufferData {
+            // x = unused component
             // y = Has a diffuse map (1 if true, 0 if false)
             // z = Has a specular map (1 if true, 0 if false)
             // w = Shininess factor
             glm::vec4 LightMeta{};
-
-            // x = Number of directional lights
-            // y = Number of point lights
-            // z = Number of spotlights
-            // w = unused component
-            glm::vec4 LightTypesCount{};
         };
 
     private:
@@ -86,13 +71,9 @@ namespace Mikoto {
         auto CreateUniformBuffers() -> void;
         auto CreateDescriptorPool() -> void;
         auto CreateDescriptorSet() -> void;
+        auto UpdateDescriptorSet( UInt32_T frameIndex ) -> void;
 
     private:
-        Size_T m_LightsCount{};
-        Size_T m_DirLightIndex{};
-        Size_T m_SpotLightIndex{};
-        Size_T m_PointLightIndex{};
-
         VulkanDescriptorWriter m_DescriptorWriter{};
 
         MaterialPass m_MaterialPass{ MATERIAL_PASS_COLOR };
@@ -103,12 +84,14 @@ namespace Mikoto {
 
         // Fragment shader uniform buffer
         Scope_T<VulkanBuffer> m_FragmentUniformBuffer{};
-        LightsUniformData m_FragmentUniformLightsData{};
+        FragmentUniformBufferData m_FragmentUniformData{};
 
-        // Descriptors
-        VkDescriptorSet m_DescriptorSet{};
+        // Descriptors, one per frame in flight. Each set points to
+        // the slice of the uniform buffers owned by that frame
+        std::vector<VkDescriptorSet> m_DescriptorSets{};
 
-        bool m_WantDescriptorUpdate{ false };
+        // Per frame flag, a set can only be updated once its frame is no longer in flight
+        std::vector<bool> m_WantDescriptorUpdate{};
 
         Size_T m_UniformDataStructureSize{}; // size of the UniformBufferData structure, with required padding for the device
         Size_T m_FragmentUniformDataStructureSize{}; // size of the UniformBufferData structure, with required padding for the device for fragment shader
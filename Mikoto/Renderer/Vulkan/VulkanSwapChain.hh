@@ -43,7 +43,7 @@ namespace Mikoto {
         MKT_NODISCARD auto GetSwapChainKHR() const -> VkSwapchainKHR { return m_Swapchain; }
         MKT_NODISCARD auto GetExtent() const -> VkExtent2D { return m_Extent; }
         MKT_NODISCARD auto IsVsyncEnabled() const -> bool { return m_IsVsyncEnabled; }
-        MKT_NODISCARD auto GetNextRenderableImage(UInt32_T &imageIndex, VkFence fence = VK_NULL_HANDLE, VkSemaphore imageAvailable = VK_NULL_HANDLE ) const -> VkResult;
+        MKT_NODISCARD auto GetNextRenderableImage(UInt32_T &imageIndex, VkSemaphore imageAvailable = VK_NULL_HANDLE ) const -> VkResult;
 
         auto Release() -> void override;
 
@@ -67,12 +67,6 @@ namespace Mikoto {
         MKT_NODISCARD static auto CreateSwapchainImageViewCreateInfo(const VkImage& image, const VkFormat& format ) -> VkImageViewCreateInfo;
         MKT_NODISCARD static auto ChooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats) -> VkSurfaceFormatKHR;
 
-    private:
-        /**
-         * Maximum number of frames that can be processed concurrently.
-         * */
-        static constexpr Int32_T MAX_FRAMES_IN_FLIGHT{ 2 };
-
     private:
 
         VkExtent2D  m_Extent{};
@@ -84,8 +78,6 @@ namespace Mikoto {
         VkSurfaceKHR* m_Surface{ nullptr };
 
         bool m_IsVsyncEnabled{};
-
-        Size_T m_CurrentFrame{};
     };
 }
 
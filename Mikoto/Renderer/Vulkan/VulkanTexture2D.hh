@@ -16,10 +16,12 @@
 #include <Common/Common.hh>
 #include <Library/Utility/Types.hh>
 #include <Library/Filesystem/File.hh>
+#include <Renderer/Vulkan/VulkanBindlessManager.hh>
 #include <Renderer/Vulkan/VulkanHelpers.hh>
 #include <Renderer/Vulkan/VulkanImage.hh>
 #include <Renderer/Vulkan/VulkanObject.hh>
 #include <Material/Texture/Texture2D.hh>
+#include <Material/Texture/TextureCooker.hh>
 
 namespace Mikoto {
 
@@ -27,6 +29,9 @@ namespace Mikoto {
         Path_T Path{};
         MapType Type{};
         bool RetainFileData{ false };
+
+        // Decoded ahead of time, see Decode(). The texture takes its texels
+        Texture2DData* Data{ nullptr };
     };
 
     /**
@@ -35,6 +40,7 @@ namespace Mikoto {
      *
      * Extends the Texture2D class for Vulkan-specific texture functionality. It manages loading and handling
      * 2D textures for Vulkan rendering, including creating images, image views, samplers, and descriptor sets.
+     * A block compressed version cooked by TextureCooker is preferred over the source image when it is up-to-date.
      * */
     class VulkanTexture2D final : public VulkanObject, public Texture2D {
     public:
@@ -45,6 +51,7 @@ namespace Mikoto {
         MKT_NODISCARD auto GetImage() -> VulkanImage& { return *m_Image; }
         MKT_NODISCARD auto GetImage() const -> const VulkanImage& { return *m_Image; }
         MKT_NODISCARD auto GetSampler() const -> const VkSampler& { return m_Sampler; }
+        MKT_NODISCARD auto GetBindlessIndex() const -> UInt32_T { return m_BindlessIndex; }
 
         auto Release() -> void override;
 
@@ -52,10 +59,22 @@ namespace Mikoto {
 
         static auto Create(const VulkanTexture2DCreateInfo& data) -> Scope_T<VulkanTexture2D>;
 
+        /**
+         * @brief Reads the cooked file of the texture if there is an up-to-date one, decodes the source image otherwise.
+         * Does not create any Vulkan object, safe to call from the workers.
+         * */
+        MKT_NODISCARD static auto Decode( const Path_T& path, bool retainFileData ) -> Scope_T<Texture2DData>;
+
     private:
-        auto CreateImage() -> void;
+        auto CreateImage( VkFormat format, UInt32_T mipLevels ) -> void;
         auto CreateSampler() -> void;
-        auto LoadImageData(const Path_T& path) -> void;
+
+        /**
+         * @brief Uploads the decoded texels. Mips built on the CPU are uploaded as they are,
+         * otherwise they are blitted on the GPU when the format and queue allow it.
+         * */
+        auto UploadImageData( const MipChain& levels ) -> void;
+        auto UploadCookedData( const CookedTexture& cookedTexture ) -> void;
 
     private:
         Size_T m_BufferSize{ 0 };
@@ -63,10 +82,10 @@ namespace Mikoto {
 
         VkSampler m_Sampler{ VK_NULL_HANDLE };
 
-        Scope_T<VulkanImage> m_Image{ nullptr };
+        // Index in the bindless textures array, see VulkanBindlessManager
+        UInt32_T m_BindlessIndex{ VulkanBindlessManager::INVALID_INDEX };
 
-        // Made private if need to defer the destruction or need a host visible block of memory
-        Scope_T<VulkanBuffer> m_StagingBuffer{ nullptr };
+        Scope_T<VulkanImage> m_Image{ nullptr };
     };
 }
 
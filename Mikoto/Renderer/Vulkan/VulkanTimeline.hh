@@ -0,0 +1,62 @@
+/**
+ * VulkanTimeline.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_TIMELINE_HH
+#define MIKOTO_VULKAN_TIMELINE_HH
+
+// C++ Standard Library
+#include <atomic>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+    /**
+     * @class VulkanTimeline
+     * @brief Timeline semaphore of a queue, every submission to the queue signals the next value.
+     * Work done on the host can be tagged with the value of the submission that uses it and
+     * be retired once the GPU has reached it, without waiting for the whole device.
+     * */
+    class VulkanTimeline final {
+    public:
+        auto Init( VkDevice device ) -> void;
+        auto Shutdown() -> void;
+
+        /**
+         * @brief Returns the value the next submission has to signal.
+         * Has to be called exactly once per submission, right before submitting.
+         * */
+        MKT_NODISCARD auto Advance() -> UInt64_T { return ++m_SubmittedValue; }
+
+        // Value signaled by the latest submission, it may not have been reached yet
+        MKT_NODISCARD auto GetSubmittedValue() const -> UInt64_T { return m_SubmittedValue; }
+
+        // Value the GPU has reached so far
+        MKT_NODISCARD auto GetCompletedValue() const -> UInt64_T;
+
+        MKT_NODISCARD auto HasReached( const UInt64_T value ) const -> bool { return value <= GetCompletedValue(); }
+
+        /**
+         * @brief Blocks until the GPU reaches the value.
+         * */
+        auto Wait( UInt64_T value ) const -> void;
+
+        MKT_NODISCARD auto GetSemaphore() const -> VkSemaphore { return m_Semaphore; }
+
+    private:
+        VkDevice m_Device{};
+        VkSemaphore m_Semaphore{};
+
+        // Submissions may come from the workers (uploads)
+        std::atomic<UInt64_T> m_SubmittedValue{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_TIMELINE_HH
@@ -0,0 +1,156 @@
+/**
+ * VulkanUploadManager.hh
+ * Created by kate on 10/18/2026.
+ * */
+
+#ifndef MIKOTO_VULKAN_UPLOAD_MANAGER_HH
+#define MIKOTO_VULKAN_UPLOAD_MANAGER_HH
+
+// C++ Standard Library
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Types.hh>
+#include <Renderer/Vulkan/VulkanBuffer.hh>
+#include <Renderer/Vulkan/VulkanCommandPool.hh>
+#include <Renderer/Vulkan/VulkanImage.hh>
+#include <Renderer/Vulkan/VulkanTimeline.hh>
+
+namespace Mikoto {
+
+    struct VulkanUploadManagerCreateInfo {
+        VkDeviceSize StagingCapacity{};
+
+        // Signaled by every batch, owned by the context
+        VulkanTimeline* Timeline{};
+    };
+
+    /**
+     * @class VulkanUploadManager
+     * @brief Batches the copies from the host to device local buffers and images.
+     * Source data is written to a persistently mapped staging ring and the copies are recorded
+     * into the command buffer of the current batch. Flush() submits the batch, on the dedicated
+     * transfer queue when the device has one, and signals the transfer timeline the graphics
+     * submission waits on. Staging memory of a batch is reclaimed once the GPU reached its value.
+     * */
+    class VulkanUploadManager final {
+    public:
+        static constexpr VkDeviceSize DEFAULT_STAGING_CAPACITY{ 64 * 1024 * 1024 };
+
+        // Satisfies the buffer offset requirements of vkCmdCopyBufferToImage for every format we use
+        static constexpr VkDeviceSize STAGING_ALIGNMENT{ 16 };
+
+    public:
+        auto Init( const VulkanUploadManagerCreateInfo& createInfo ) -> void;
+        auto Shutdown() -> void;
+
+        auto UploadBuffer( VkBuffer destination, VkDeviceSize destinationOffset, const void* data, VkDeviceSize size ) -> void;
+
+        /**
+         * @brief Copies the texels to the image and leaves it ready to be sampled.
+         * levelOffsets has the offset in data of every mip to copy, from the biggest one. They must be multiples
+         * of the texel block size. An empty span copies the first mip from the start of the data.
+         * */
+        auto UploadImage( VulkanImage& image, const void* data, VkDeviceSize size, VkExtent3D extent, std::span<const VkDeviceSize> levelOffsets = {} ) -> void;
+
+        /**
+         * @brief Copies the texels to the first mip and fills the other ones with a chain of linear blits.
+         * Requires SupportsBlits() and a format with linear filtering for blits, see VulkanTexture2D.
+         * */
+        auto UploadImageAndGenerateMips( VulkanImage& image, const void* data, VkDeviceSize size, VkExtent3D extent, UInt32_T mipLevels ) -> void;
+
+        /**
+         * @brief Records arbitrary transfer commands in the current batch, after every upload issued so far.
+         * The retained buffer is kept alive until the batch has completed on the GPU.
+         * */
+        auto Record( const std::function<void( VkCommandBuffer )>& commands, std::shared_ptr<VulkanBuffer> retained = nullptr ) -> void;
+
+        /**
+         * @brief Submits the pending uploads and reclaims the staging memory of the completed batches.
+         * Called once per frame before the graphics submission.
+         * */
+        auto Flush() -> void;
+
+        /**
+         * @brief Resources created for uploads from this manager must be shared with the transfer queue.
+         * These set the sharing mode accordingly, the queue family indices outlive the create infos.
+         * */
+        auto ConfigureSharingMode( VkBufferCreateInfo& createInfo ) const -> void;
+        auto ConfigureSharingMode( VkImageCreateInfo& createInfo ) const -> void;
+
+        MKT_NODISCARD auto UsesDedicatedTransferQueue() const -> bool { return m_UsesDedicatedQueue; }
+
+        // Transfer only queues cannot record vkCmdBlitImage
+        MKT_NODISCARD auto SupportsBlits() const -> bool { return !m_UsesDedicatedQueue; }
+
+        MKT_NODISCARD static auto GetMipExtent( VkExtent3D extent, UInt32_T level ) -> VkExtent3D;
+
+    private:
+        struct Batch {
+            Scope_T<VulkanCommandPool> CommandPool{};
+            VkCommandBuffer CommandBuffer{};
+
+            // Value the timeline semaphore reaches once the batch has completed
+            UInt64_T TimelineValue{};
+
+            // Bytes of the staging ring consumed by this batch, padding included
+            VkDeviceSize StagingBytes{};
+
+            // Staging buffers for uploads bigger than the ring and buffers retained by Record()
+            std::vector<std::shared_ptr<VulkanBuffer>> RetainedBuffers{};
+        };
+
+        struct StagingAllocation {
+            VkBuffer Buffer{};
+            VkDeviceSize Offset{};
+        };
+
+    private:
+        auto CreateStagingRing( VkDeviceSize capacity ) -> void;
+
+        MKT_NODISCARD auto GetCurrentBatch() -> Batch&;
+        MKT_NODISCARD auto WriteStaging( const void* data, VkDeviceSize size ) -> StagingAllocation;
+        MKT_NODISCARD auto TryAllocateStaging( VkDeviceSize size, VkDeviceSize& offset ) -> bool;
+
+        auto SubmitCurrentBatch() -> void;
+        auto WaitForOldestBatch() -> void;
+        auto ReclaimCompletedBatches( UInt64_T completedValue ) -> void;
+
+    private:
+        VkDevice m_Device{};
+        VkQueue m_Queue{};
+        UInt32_T m_QueueFamilyIndex{};
+        bool m_UsesDedicatedQueue{};
+
+        // Graphics and transfer families, referenced by the concurrent sharing mode
+        std::array<UInt32_T, 2> m_SharingQueueFamilies{};
+
+        VulkanTimeline* m_Timeline{};
+
+        // The ring hands out memory at the head and gets it back at the tail,
+        // in the order the batches complete
+        Scope_T<VulkanBuffer> m_StagingRing{};
+        VkDeviceSize m_StagingHead{};
+        VkDeviceSize m_StagingTail{};
+        VkDeviceSize m_StagingUsed{};
+
+        Scope_T<Batch> m_CurrentBatch{};
+        std::deque<Scope_T<Batch>> m_InFlightBatches{};
+        std::vector<Scope_T<Batch>> m_FreeBatches{};
+
+        // Assets may be loaded from the workers
+        mutable std::mutex m_Mutex{};
+    };
+}
+
+#endif // MIKOTO_VULKAN_UPLOAD_MANAGER_HH
@@ -8,15 +8,17 @@
 
 // C++ Standard Library
 #include <memory>
+#include <span>
 #include <vector>
 
 // Third-Party Libraries
 #include <volk.h>
+#include <glm/glm.hpp>
 
 // Project Headers
 #include <Common/Common.hh>
 #include <Renderer/Vulkan/VulkanObject.hh>
-#include <Renderer/Vulkan/VulkanBuffer.hh>
+#include <Renderer/Vulkan/VulkanGeometryHeap.hh>
 #include <Renderer/Buffer/VertexBuffer.hh>
 
 namespace Mikoto {
@@ -25,11 +27,42 @@ namespace Mikoto {
     public:
         explicit VulkanVertexBuffer(const VertexBufferCreateInfo& createInfo);
 
+        /**
+         * Binds the geometry heap at the start of this buffer's vertices. Draws recorded
+         * after VulkanGeometryHeap::Bind use GetVertexOffset() instead.
+         * */
         auto Bind(VkCommandBuffer commandBuffer) const -> void;
 
+        /**
+         * Binds the position only stream of this buffer. Used by passes that
+         * only need the vertices positions, like the depth pre-pass.
+         * */
+        auto BindPositions(VkCommandBuffer commandBuffer) const -> void;
+
+        /**
+         * Index of the first vertex of this buffer in the geometry heap, to be passed
+         * as the vertexOffset of the draw when the whole heap is bound.
+         * */
+        MKT_NODISCARD auto GetVertexOffset() const -> Int32_T;
+
+        /**
+         * Same as GetVertexOffset() for the position only stream.
+         * */
+        MKT_NODISCARD auto GetPositionsVertexOffset() const -> Int32_T;
+
+        /**
+         * Sphere enclosing the vertices in object space, xyz is the center and w the radius.
+         * Used by the GPU culling of the draws.
+         * */
+        MKT_NODISCARD auto GetBoundingSphere() const -> const glm::vec4& { return m_BoundingSphere; }
+
         MKT_NODISCARD static auto GetDefaultBindingDescriptions(const BufferLayout& layout = GetDefaultBufferLayout()) -> std::vector<VkVertexInputBindingDescription>;
         MKT_NODISCARD static auto GetDefaultAttributeDescriptions(const BufferLayout& layout = GetDefaultBufferLayout()) -> std::vector<VkVertexInputAttributeDescription>;
 
+        // The position stream holds the first attribute of the layout, in the same format
+        MKT_NODISCARD static auto GetPositionBindingDescriptions(const BufferLayout& layout = GetDefaultBufferLayout()) -> std::vector<VkVertexInputBindingDescription>;
+        MKT_NODISCARD static auto GetPositionAttributeDescriptions(const BufferLayout& layout = GetDefaultBufferLayout()) -> std::vector<VkVertexInputAttributeDescription>;
+
         MKT_NODISCARD static auto Create(const VertexBufferCreateInfo& createInfo) -> Scope_T<VulkanVertexBuffer>;
 
         auto Release() -> void override;
@@ -39,12 +72,16 @@ namespace Mikoto {
         DISABLE_COPY_AND_MOVE_FOR(VulkanVertexBuffer);
 
     private:
-        auto SetVertexData(const std::vector<float>& vertices) -> void;
+        auto SetVertexData(std::span<const UInt8_T> vertices) -> void;
+
+        // Ranges of the geometry heap holding the interleaved vertices
+        // and a tightly packed copy of their positions
+        VulkanGeometryHeap::Allocation m_VerticesAllocation{};
+        VulkanGeometryHeap::Allocation m_PositionsAllocation{};
 
-        Scope_T<VulkanBuffer> m_Buffer{};
-        Scope_T<VulkanBuffer> m_StagingBuffer{};
+        glm::vec4 m_BoundingSphere{};
 
-        std::vector<float> m_RetainedData{};
+        std::vector<UInt8_T> m_RetainedData{};
     };
 }
 
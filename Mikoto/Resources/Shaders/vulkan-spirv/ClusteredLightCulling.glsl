@@ -0,0 +1,216 @@
+/**************************************************
+    Clustered light culling. The view frustum is
+    split in screen tiles and exponential depth
+    slices, every invocation builds the AABB of one
+    cluster and stores the point and spot lights
+    whose volume overlaps it.
+
+    Stage: Compute
+    Version: GLSL 4.5.0
+**************************************************/
+
+#version 450
+
+#define MAX_LIGHTS 4096
+#define MAX_DIRECTIONAL_LIGHTS 16
+
+// Must match VulkanRenderer::LIGHT_CULLING_GROUP_SIZE
+#define CULLING_GROUP_SIZE 128
+
+// Light structures match the ones in Models/LightData.hh
+struct PointLight {
+    vec4 Position;
+
+    vec4 Ambient;
+    vec4 Diffuse;
+    vec4 Specular;
+
+    // x=intensity, y=radius
+    vec4 AttenuationParams;
+};
+
+struct DirectionalLight {
+    vec4 Direction;
+    vec4 Position;
+
+    vec4 Ambient;
+    vec4 Diffuse;
+    vec4 Specular;
+};
+
+struct SpotLight {
+    vec4 Position;
+    vec4 Direction;
+
+    vec4 Ambient;
+    vec4 Diffuse;
+    vec4 Specular;
+
+    // x=cutOff, y=outerCutOff (both angles in radians), z=intensity, w=radius
+    vec4 CutOffValues;
+};
+
+layout(local_size_x = CULLING_GROUP_SIZE) in;
+
+layout(std430, set = 0, binding = 0) readonly buffer SceneLightsBuffer {
+    // x=directional, y=point, z=spot, w=unused
+    ivec4 LightCounts;
+
+    // xyz=clusters per axis, w=max lights per cluster
+    uvec4 ClusterGridSize;
+
+    // x=near, y=far, z=depth slice scale, w=depth slice bias
+    vec4 ClusterDepthParams;
+
+    // xy=render target size, zw=cluster tile size (in pixels)
+    vec4 ScreenSize;
+
+    mat4 View;
+    mat4 InverseProjection;
+
+    DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS];
+    PointLight PointLights[MAX_LIGHTS];
+    SpotLight SpotLights[MAX_LIGHTS];
+} SceneLights;
+
+// x=offset in the indices list, y=point lights count, z=spot lights count, w=unused
+layout(std430, set = 0, binding = 1) writeonly buffer ClusterGridBuffer {
+    uvec4 Clusters[];
+} ClusterGrid;
+
+// Point light indices of a cluster first, followed by its spot light indices
+layout(std430, set = 0, binding = 2) writeonly buffer ClusterLightIndicesBuffer {
+    uint Indices[];
+} ClusterLightIndices;
+
+// Bounding spheres of the batch of lights being tested, in view space (xyz=center, w=radius)
+shared vec4 s_LightSpheres[CULLING_GROUP_SIZE];
+
+vec3 ScreenToView(vec2 screenPosition) {
+    const vec2 ndc = screenPosition / SceneLights.ScreenSize.xy * 2.0 - 1.0;
+    const vec4 viewPosition = SceneLights.InverseProjection * vec4(ndc, 1.0, 1.0);
+
+    return viewPosition.xyz / viewPosition.w;
+}
+
+// Point where the ray from the eye going through point crosses the plane z = depth
+vec3 IntersectDepthPlane(vec3 point, float depth) {
+    return point * (depth / point.z);
+}
+
+bool SphereIntersectsAABB(vec4 sphere, vec3 aabbMin, vec3 aabbMax) {
+    const vec3 closest = clamp(sphere.xyz, aabbMin, aabbMax);
+    const vec3 delta = closest - sphere.xyz;
+
+    return dot(delta, delta) <= sphere.w * sphere.w;
+}
+
+void main() {
+    const uvec3 gridSize = SceneLights.ClusterGridSize.xyz;
+    const uint maxLightsPerCluster = SceneLights.ClusterGridSize.w;
+
+    const uint clusterIndex = gl_GlobalInvocationID.x;
+    const bool isValidCluster = clusterIndex < gridSize.x * gridSize.y * gridSize.z;
+
+    // [Cluster bounds in view space]
+    vec3 aabbMin = vec3(0.0);
+    vec3 aabbMax = vec3(0.0);
+
+    if (isValidCluster) {
+        const uvec3 cluster = uvec3(clusterIndex % gridSize.x,
+                                    (clusterIndex / gridSize.x) % gridSize.y,
+                                    clusterIndex / (gridSize.x * gridSize.y));
+
+        // Exponential slices, more resolution close to the camera
+        const float nearPlane = SceneLights.ClusterDepthParams.x;
+        const float farPlane = SceneLights.ClusterDepthParams.y;
+        const float sliceNear = -nearPlane * pow(farPlane / nearPlane, float(cluster.z) / float(gridSize.z));
+        const float sliceFar = -nearPlane * pow(farPlane / nearPlane, float(cluster.z + 1) / float(gridSize.z));
+
+        const vec2 tileMin = vec2(cluster.xy) * SceneLights.ScreenSize.zw;
+        const vec2 tileMax = min(tileMin + SceneLights.ScreenSize.zw, SceneLights.ScreenSize.xy);
+
+        const vec3 corners[4] = vec3[](
+            ScreenToView(tileMin),
+            ScreenToView(vec2(tileMax.x, tileMin.y)),
+            ScreenToView(vec2(tileMin.x, tileMax.y)),
+            ScreenToView(tileMax)
+        );
+
+        aabbMin = vec3(3.402823466e+38);
+        aabbMax = vec3(-3.402823466e+38);
+
+        for (int i = 0; i < 4; ++i) {
+            const vec3 nearCorner = IntersectDepthPlane(corners[i], sliceNear);
+            const vec3 farCorner = IntersectDepthPlane(corners[i], sliceFar);
+
+            aabbMin = min(aabbMin, min(nearCorner, farCorner));
+            aabbMax = max(aabbMax, max(nearCorner, farCorner));
+        }
+    }
+
+    const uint offset = clusterIndex * maxLightsPerCluster;
+    uint pointLightCount = 0;
+    uint spotLightCount = 0;
+
+    // [Point lights] Tested in batches, each invocation of the group loads one light to shared memory
+    const int scenePointLights = SceneLights.LightCounts.y;
+
+    for (int batchStart = 0; batchStart < scenePointLights; batchStart += CULLING_GROUP_SIZE) {
+        const int lightIndex = batchStart + int(gl_LocalInvocationIndex);
+
+        if (lightIndex < scenePointLights) {
+            const PointLight light = SceneLights.PointLights[lightIndex];
+            s_LightSpheres[gl_LocalInvocationIndex] = vec4((SceneLights.View * vec4(light.Position.xyz, 1.0)).xyz, light.AttenuationParams.y);
+        }
+
+        memoryBarrierShared();
+        barrier();
+
+        const int batchSize = min(CULLING_GROUP_SIZE, scenePointLights - batchStart);
+
+        if (isValidCluster) {
+            for (int i = 0; i < batchSize; ++i) {
+                if (pointLightCount < maxLightsPerCluster && SphereIntersectsAABB(s_LightSpheres[i], aabbMin, aabbMax)) {
+                    ClusterLightIndices.Indices[offset + pointLightCount] = uint(batchStart + i);
+                    ++pointLightCount;
+                }
+            }
+        }
+
+        // The next batch overwrites the shared lights
+        barrier();
+    }
+
+    // [Spot lights] Culled with the bounding sphere of their range
+    const int sceneSpotLights = SceneLights.LightCounts.z;
+
+    for (int batchStart = 0; batchStart < sceneSpotLights; batchStart += CULLING_GROUP_SIZE) {
+        const int lightIndex = batchStart + int(gl_LocalInvocationIndex);
+
+        if (lightIndex < sceneSpotLights) {
+            const SpotLight light = SceneLights.SpotLights[lightIndex];
+            s_LightSpheres[gl_LocalInvocationIndex] = vec4((SceneLights.View * vec4(light.Position.xyz, 1.0)).xyz, light.CutOffValues.w);
+        }
+
+        memoryBarrierShared();
+        barrier();
+
+        const int batchSize = min(CULLING_GROUP_SIZE, sceneSpotLights - batchStart);
+
+        if (isValidCluster) {
+            for (int i = 0; i < batchSize; ++i) {
+                if (pointLightCount + spotLightCount < maxLightsPerCluster && SphereIntersectsAABB(s_LightSpheres[i], aabbMin, aabbMax)) {
+                    ClusterLightIndices.Indices[offset + pointLightCount + spotLightCount] = uint(batchStart + i);
+                    ++spotLightCount;
+                }
+            }
+        }
+
+        barrier();
+    }
+
+    if (isValidCluster) {
+        ClusterGrid.Clusters[clusterIndex] = uvec4(offset, pointLightCount, spotLightCount, 0);
+    }
+}
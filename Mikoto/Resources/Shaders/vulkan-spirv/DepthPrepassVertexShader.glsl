@@ -0,0 +1,62 @@
+/**************************************************
+    Depth pre-pass shader. Only reads the vertex
+    positions stream, the depth has to match the
+    one produced by PBRVertexShader exactly so the
+    main pass can use an EQUAL depth test.
+
+    Stage: Vertex
+    Version: GLSL 4.5.0
+**************************************************/
+
+#version 450
+
+// Same blocks as the PBR material vertex shader
+// Camera of the frame, shared by every draw (scene set, see VulkanRenderer::FrameUniformData)
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
+    mat4 View;
+    mat4 Projection;
+    vec4 ViewPosition;
+
+    // x=display mode, y=wireframe
+    ivec4 RenderSettings;
+} FrameData;
+
+// Per draw data, written by the renderer and selected by the first instance
+// of the indirect draw commands (see VulkanRenderer::DrawInstanceData)
+struct DrawInstance {
+    mat4 Transform;
+
+    // xyz=center in object space, w=radius
+    vec4 BoundingSphere;
+
+    // x=index count, y=first index, z=vertex offset, w=positions vertex offset
+    ivec4 Geometry;
+
+    // x=material index, y=vertex format, z=1 if the transform keeps the normal cones of the meshlets
+    uvec4 Material;
+
+    // Dequantization of the vertices, identity for 32-bit float vertices. w unused
+    vec4 PositionScale;
+    vec4 PositionOffset;
+
+    // xy=texture coordinates scale, zw=texture coordinates offset
+    vec4 TexCoordTransform;
+};
+
+layout(std430, set = 1, binding = 4) readonly buffer DrawInstancesBuffer {
+    DrawInstance Instances[];
+} DrawInstances;
+
+// [Vertex Buffer elements]
+// The positions stream keeps the format of the vertices, there is one pipeline per vertex format
+layout(location = 0) in vec4 a_Position;
+
+// Same operations in the same order as PBRVertexShader
+invariant gl_Position;
+
+void main() {
+    const mat4 transform = DrawInstances.Instances[gl_InstanceIndex].Transform;
+    const vec3 position = a_Position.xyz * DrawInstances.Instances[gl_InstanceIndex].PositionScale.xyz + DrawInstances.Instances[gl_InstanceIndex].PositionOffset.xyz;
+
+    gl_Position = FrameData.Projection * FrameData.View * transform * vec4(position, 1.0);
+}
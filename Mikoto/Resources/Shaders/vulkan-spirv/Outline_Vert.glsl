@@ -9,12 +9,21 @@
 
 #version 450
 
-// [Uniform buffer elements]
-layout(set = 0, binding = 0) uniform UniformBufferObject {
+// Camera of the frame, shared by every draw (scene set, see VulkanRenderer::FrameUniformData)
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
     mat4 View;
     mat4 Projection;
+    vec4 ViewPosition;
+
+    // x=display mode, y=wireframe
+    ivec4 RenderSettings;
+} FrameData;
+
+// Per draw data, see VulkanRenderer::DrawPushConstants
+layout(push_constant) uniform DrawData {
     mat4 Transform;
-} UniformBufferData;
+    uint MaterialIndex;
+} Draw;
 
 // [Vertex Buffer elements]
 layout(location = 0) in vec3 a_Position;
@@ -35,5 +44,5 @@ void main() {
     outVertexColor = a_Color;
     outVertexTexCoord = a_TextureCoordinates;
 
-    gl_Position = UniformBufferData.Projection * UniformBufferData.View * UniformBufferData.Transform * vec4(a_Position, 1.0);
+    gl_Position = FrameData.Projection * FrameData.View * Draw.Transform * vec4(a_Position, 1.0);
 }
@@ -9,9 +9,12 @@
 
 #version 450
 
+#extension GL_EXT_nonuniform_qualifier : require
+
 const float PI = 3.14159265359;
 
-#define MAX_LIGHTS 50
+#define MAX_LIGHTS 4096
+#define MAX_DIRECTIONAL_LIGHTS 16
 
 #define MKT_SHADER_TRUE 1
 #define MKT_SHADER_FALSE 0
@@ -22,6 +25,11 @@ const float PI = 3.14159265359;
 #define DISPLAY_AO 4
 #define DISPLAY_ROUGH 5
 
+// Baked into each pipeline variant, see VulkanPipelineVariantCache
+// The branches below are resolved when the pipeline is built, not per fragment
+layout(constant_id = 0) const int RENDER_MODE = DISPLAY_COLOR;
+layout(constant_id = 1) const bool WIREFRAME = false;
+
 struct PointLight {
     vec4 Position;
 
@@ -62,46 +70,97 @@ layout (location = 1) in vec3 inNormals;
 layout (location = 2) in vec2 inTexCoord;
 layout (location = 3) in vec2 inVertexColor;
 
+// Index in the bindless materials buffer, see VulkanRenderer::DrawInstanceData
+layout (location = 4) flat in uint inMaterialIndex;
+
 // Output variables
 layout (location = 0) out vec4 outColor;
 
-layout(set = 0, binding = 1) uniform sampler2D albedoSampler;
-layout(set = 0, binding = 2) uniform sampler2D normalSampler;
-layout(set = 0, binding = 3) uniform sampler2D metallicSampler;
-layout(set = 0, binding = 4) uniform sampler2D roughnessSampler;
-layout(set = 0, binding = 5) uniform sampler2D ambientOcclusionSampler;
+// Every registered texture, materials reference them by index (see VulkanBindlessManager)
+layout(set = 0, binding = 0) uniform sampler2D Textures[];
 
-layout(set = 0, binding = 6) uniform UniformBuffer {
-    SpotLight SpotLights[MAX_LIGHTS];
-    PointLight PointLights[MAX_LIGHTS];
-    DirectionalLight DirectionalLights[MAX_LIGHTS];
+struct MaterialData {
+    vec4 Albedo;
+
+    // x=metallic, y=roughness, z=ambient occlusion
+    vec4 Factors;
 
+    // Indices in Textures. x=albedo, y=normal, z=metallic, w=roughness
+    uvec4 TextureIndices;
+
+    // x=ambient occlusion
+    uvec4 AuxTextureIndices;
+
+    // x=albedo, y=normal, z=metallic, w=roughness
+    ivec4 HasMaps;
+
+    // x=ambient occlusion
+    ivec4 AuxHasMaps;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer MaterialsBuffer {
+    MaterialData Materials[];
+} MaterialsData;
+
+// Camera and render settings, written once per frame by the renderer
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
+    mat4 View;
+    mat4 Projection;
     vec4 ViewPosition;
 
-    vec4 Albedo;
-    vec4 Factors;
-// metallic, rough, ao
+    // x=display mode, y=wireframe, unused by the PBR shaders which get them as specialization constants
+    ivec4 RenderSettings;
+} FrameData;
+
+// Lights of the scene, written once per frame by the renderer and shared by every material
+layout(std430, set = 1, binding = 0) readonly buffer SceneLightsBuffer {
+    // x=directional, y=point, z=spot, w=unused
+    ivec4 LightCounts;
+
+    // xyz=clusters per axis, w=max lights per cluster
+    uvec4 ClusterGridSize;
+
+    // x=near, y=far, z=depth slice scale, w=depth slice bias
+    vec4 ClusterDepthParams;
+
+    // xy=render target size, zw=cluster tile size (in pixels)
+    vec4 ScreenSize;
+
+    mat4 View;
+    mat4 InverseProjection;
+
+    DirectionalLight DirectionalLights[MAX_DIRECTIONAL_LIGHTS];
+    PointLight PointLights[MAX_LIGHTS];
+    SpotLight SpotLights[MAX_LIGHTS];
+} SceneLights;
 
-    int HasAlbedo;
-    int HasNormal;
-    int HasMetallic;
-    int HasAmbientOcc;
-    int HasRoughness;
+// Written by the light culling pass. x=offset in the indices list, y=point lights count, z=spot lights count
+layout(std430, set = 1, binding = 1) readonly buffer ClusterGridBuffer {
+    uvec4 Clusters[];
+} ClusterGrid;
 
-    int DirectionalLightCount;
-    int PointLightCount;
-    int SpotLightCount;
+layout(std430, set = 1, binding = 2) readonly buffer ClusterLightIndicesBuffer {
+    uint Indices[];
+} ClusterLightIndices;
 
-    int DisplayMode;
+// Cluster of the froxel containing this fragment
+uvec4 GetFragmentCluster(vec3 worldPosition) {
+    const uvec3 gridSize = SceneLights.ClusterGridSize.xyz;
+    const float viewDepth = -(SceneLights.View * vec4(worldPosition, 1.0)).z;
 
-    int Wireframe;
+    const uint slice = min(uint(max(log(viewDepth) * SceneLights.ClusterDepthParams.z - SceneLights.ClusterDepthParams.w, 0.0)), gridSize.z - 1);
+    const uvec2 tile = min(uvec2(gl_FragCoord.xy / SceneLights.ScreenSize.zw), gridSize.xy - 1);
 
-} BufferData;
+    return ClusterGrid.Clusters[tile.x + tile.y * gridSize.x + slice * gridSize.x * gridSize.y];
+}
 
 // ----------------------------------------------------------------------------
-vec3 GetNormalFromMap()
+vec3 GetNormalFromMap(uint normalMapIndex)
 {
-    vec3 tangentNormal = texture(normalSampler, inTexCoord).xyz * 2.0 - 1.0;
+    // Z is rebuilt from XY, cooked normal maps are two channel BC5 (see TextureCooker)
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(Textures[normalMapIndex], inTexCoord).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 
     vec3 Q1  = dFdx(inFragmentPos);
     vec3 Q2  = dFdy(inFragmentPos);
@@ -183,15 +242,20 @@ float ComputeAttenuation(vec4 components, float distance) {
 vec3 ComputePointLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
     vec3 Lo = vec3(0.0);
 
-    for(int i = 0; i < BufferData.PointLightCount; ++i)
+    // Only the point lights overlapping the cluster of this fragment
+    const uvec4 cluster = GetFragmentCluster(inFragmentPos);
+
+    for(uint clusterLight = 0; clusterLight < cluster.y; ++clusterLight)
     {
+        const uint i = ClusterLightIndices.Indices[cluster.x + clusterLight];
+
         // calculate per-light radiance
-        vec3 L = normalize(BufferData.PointLights[i].Position.xyz - inFragmentPos);
+        vec3 L = normalize(SceneLights.PointLights[i].Position.xyz - inFragmentPos);
         vec3 H = normalize(V + L);
-        float distance = length(BufferData.PointLights[i].Position.xyz - inFragmentPos);
-        float attenuation = ComputeAttenuation(distance, BufferData.PointLights[i].AttenuationParams.y);
+        float distance = length(SceneLights.PointLights[i].Position.xyz - inFragmentPos);
+        float attenuation = ComputeAttenuation(distance, SceneLights.PointLights[i].AttenuationParams.y);
 
-        vec3 radiance = BufferData.PointLights[i].Diffuse.xyz * attenuation * BufferData.PointLights[i].AttenuationParams.x;
+        vec3 radiance = SceneLights.PointLights[i].Diffuse.xyz * attenuation * SceneLights.PointLights[i].AttenuationParams.x;
 
         // Cook-Torrance BRDF
         float NDF = DistributionGGX(N, H, roughness);
@@ -229,14 +293,14 @@ vec3 ComputePointLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, flo
 vec3 ComputeDirectionalLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
     vec3 Lo = vec3(0.0);
 
-    for(int i = 0; i < BufferData.DirectionalLightCount; ++i)
+    for(int i = 0; i < SceneLights.LightCounts.x; ++i)
     {
         // calculate per-light radiance
-        vec3 L = normalize(-vec3(BufferData.DirectionalLights[i].Position.xyz));
+        vec3 L = normalize(-vec3(SceneLights.DirectionalLights[i].Position.xyz));
         vec3 H = normalize(V + L);
 
         // This vec 3 should be the light color, we assume it is full white for now
-        vec3 radiance = BufferData.DirectionalLights[i].Diffuse.xyz;
+        vec3 radiance = SceneLights.DirectionalLights[i].Diffuse.xyz;
 
         // Cook-Torrance BRDF
         float NDF = DistributionGGX(N, H, roughness);
@@ -274,19 +338,24 @@ vec3 ComputeDirectionalLightContribution(vec3 N, vec3 V, vec3 F0, float roughnes
 vec3 ComputeSpotLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, float metallic, vec3 albedo) {
     vec3 Lo = vec3(0.0);
 
-    for(int i = 0; i < BufferData.SpotLightCount; ++i)
+    // Spot light indices are stored right after the point lights of the cluster
+    const uvec4 cluster = GetFragmentCluster(inFragmentPos);
+
+    for(uint clusterLight = 0; clusterLight < cluster.z; ++clusterLight)
     {
+        const uint i = ClusterLightIndices.Indices[cluster.x + cluster.y + clusterLight];
+
         // calculate per-light radiance
-        vec3 L = normalize(BufferData.SpotLights[i].Position.xyz - inFragmentPos);
-        float distance = length(BufferData.SpotLights[i].Position.xyz - inFragmentPos);
-        float attenuation = ComputeAttenuation(distance, BufferData.SpotLights[i].CutOffValues.w);
+        vec3 L = normalize(SceneLights.SpotLights[i].Position.xyz - inFragmentPos);
+        float distance = length(SceneLights.SpotLights[i].Position.xyz - inFragmentPos);
+        float attenuation = ComputeAttenuation(distance, SceneLights.SpotLights[i].CutOffValues.w);
         // This vec 3 should be the light color, we assume it is full white for now
-        vec3 radiance = BufferData.SpotLights[i].Diffuse.xyz * attenuation;
+        vec3 radiance = SceneLights.SpotLights[i].Diffuse.xyz * attenuation;
 
         // Spotlight intensity based on angle
-        float theta = dot(L, normalize(-vec3(BufferData.SpotLights[i].Direction.xyz)));
-        float epsilon = BufferData.SpotLights[i].CutOffValues.x - BufferData.SpotLights[i].CutOffValues.y;
-        float intensity = clamp((theta - BufferData.SpotLights[i].CutOffValues.y) / epsilon, 0.0, 1.0) * BufferData.SpotLights[i].CutOffValues.z;
+        float theta = dot(L, normalize(-vec3(SceneLights.SpotLights[i].Direction.xyz)));
+        float epsilon = SceneLights.SpotLights[i].CutOffValues.x - SceneLights.SpotLights[i].CutOffValues.y;
+        float intensity = clamp((theta - SceneLights.SpotLights[i].CutOffValues.y) / epsilon, 0.0, 1.0) * SceneLights.SpotLights[i].CutOffValues.z;
         radiance *= intensity;
 
         vec3 H = normalize(V + L);
@@ -325,15 +394,17 @@ vec3 ComputeSpotLightContribution(vec3 N, vec3 V, vec3 F0, float roughness, floa
 }
 
 void main() {
+    // The material index comes from the instance data of the draw, it is the same for the whole draw
+    const MaterialData material = MaterialsData.Materials[inMaterialIndex];
 
-    vec3 albedo     = BufferData.HasAlbedo == 1 ? pow(texture(albedoSampler, inTexCoord).rgb, vec3(2.2)) : BufferData.Albedo.xyz;
-    float metallic  = BufferData.HasMetallic  == 1 ? texture(metallicSampler, inTexCoord).r : BufferData.Factors.x;
-    float roughness = BufferData.HasRoughness == 1 ? texture(roughnessSampler, inTexCoord).r : BufferData.Factors.y;
-    float ao        = BufferData.HasAmbientOcc == 1 ? texture(ambientOcclusionSampler, inTexCoord).r : BufferData.Factors.z;
+    vec3 albedo     = material.HasMaps.x == 1 ? pow(texture(Textures[material.TextureIndices.x], inTexCoord).rgb, vec3(2.2)) : material.Albedo.xyz;
+    float metallic  = material.HasMaps.z == 1 ? texture(Textures[material.TextureIndices.z], inTexCoord).r : material.Factors.x;
+    float roughness = material.HasMaps.w == 1 ? texture(Textures[material.TextureIndices.w], inTexCoord).r : material.Factors.y;
+    float ao        = material.AuxHasMaps.x == 1 ? texture(Textures[material.AuxTextureIndices.x], inTexCoord).r : material.Factors.z;
 
-    vec3 N = BufferData.HasNormal == 1 ? GetNormalFromMap() : normalize(inNormals);
+    vec3 N = material.HasMaps.y == 1 ? GetNormalFromMap(material.TextureIndices.y) : normalize(inNormals);
 
-    vec3 V = normalize(BufferData.ViewPosition.xyz - inFragmentPos);
+    vec3 V = normalize(FrameData.ViewPosition.xyz - inFragmentPos);
 
     // calculate reflectance at normal incidence; if dia-electric (like plastic) use F0
     // of 0.04 and if it's a metal, use the albedo color as F0 (metallic workflow)
@@ -360,8 +431,8 @@ void main() {
     color = pow(color, vec3(1.0/2.2));
 
 
-    if (BufferData.Wireframe != MKT_SHADER_TRUE) {
-        switch (BufferData.DisplayMode) {
+    if (!WIREFRAME) {
+        switch (RENDER_MODE) {
             case DISPLAY_COLOR:
             outColor = vec4(color , 1.0);
             break;
@@ -9,17 +9,51 @@
 
 #version 450
 
-// [Uniform buffer elements]
-layout(set = 0, binding = 0) uniform UniformBufferObject {
+// Set for the variants reading the compact buffer layout (see VertexFormat),
+// normals are then octahedral encoded in xy
+layout(constant_id = 2) const bool COMPACT_VERTICES = false;
+
+// Camera of the frame, shared by every draw (scene set, see VulkanRenderer::FrameUniformData)
+layout(set = 1, binding = 3) uniform FrameUniformBuffer {
     mat4 View;
     mat4 Projection;
+    vec4 ViewPosition;
+
+    // x=display mode, y=wireframe
+    ivec4 RenderSettings;
+} FrameData;
+
+// Per draw data, written by the renderer and selected by the first instance
+// of the indirect draw commands (see VulkanRenderer::DrawInstanceData)
+struct DrawInstance {
     mat4 Transform;
-} UniformBufferData;
+
+    // xyz=center in object space, w=radius
+    vec4 BoundingSphere;
+
+    // x=index count, y=first index, z=vertex offset, w=positions vertex offset
+    ivec4 Geometry;
+
+    // x=material index, y=vertex format, z=1 if the transform keeps the normal cones of the meshlets
+    uvec4 Material;
+
+    // Dequantization of the vertices, identity for 32-bit float vertices. w unused
+    vec4 PositionScale;
+    vec4 PositionOffset;
+
+    // xy=texture coordinates scale, zw=texture coordinates offset
+    vec4 TexCoordTransform;
+};
+
+layout(std430, set = 1, binding = 4) readonly buffer DrawInstancesBuffer {
+    DrawInstance Instances[];
+} DrawInstances;
 
 // [Vertex Buffer elements]
-layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec3 a_Normal;
-layout(location = 2) in vec3 a_Color;
+// Read from either layout, missing components default to 0 (1 for w)
+layout(location = 0) in vec4 a_Position;
+layout(location = 1) in vec4 a_Normal;
+layout(location = 2) in vec4 a_Color;
 layout(location = 3) in vec2 a_TextureCoordinates;
 
 // [Output data]
@@ -29,14 +63,37 @@ layout(location = 0) out vec3 outFragmentPos;
 layout(location = 1) out vec3 outVertexNormals;
 layout(location = 2) out vec2 outVertexTexCoord;
 layout(location = 3) out vec3 outVertexColor;
+layout(location = 4) flat out uint outMaterialIndex;
+
+// Must produce the same depth as DepthPrepassVertexShader
+invariant gl_Position;
+
+vec3 DecodeOctahedral(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+    // Unfold the lower hemisphere
+    const float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+
+    return normalize(normal);
+}
 
 void main() {
+    const mat4 transform = DrawInstances.Instances[gl_InstanceIndex].Transform;
+    const vec4 texCoordTransform = DrawInstances.Instances[gl_InstanceIndex].TexCoordTransform;
+
+    // Must match DepthPrepassVertexShader
+    const vec3 position = a_Position.xyz * DrawInstances.Instances[gl_InstanceIndex].PositionScale.xyz + DrawInstances.Instances[gl_InstanceIndex].PositionOffset.xyz;
+    const vec3 normal = COMPACT_VERTICES ? DecodeOctahedral(a_Normal.xy) : a_Normal.xyz;
+
     // Setup frament shader expected data
-    outVertexTexCoord = a_TextureCoordinates;
-    outVertexColor = a_Color;
+    outMaterialIndex = DrawInstances.Instances[gl_InstanceIndex].Material.x;
+    outVertexTexCoord = a_TextureCoordinates * texCoordTransform.xy + texCoordTransform.zw;
+    outVertexColor = a_Color.rgb;
 
-    outVertexNormals = mat3(UniformBufferData.Transform) * a_Normal;
-    outFragmentPos = vec3(UniformBufferData.Transform * vec4(a_Position, 1.0));
+    outVertexNormals = mat3(transform) * normal;
+    outFragmentPos = vec3(transform * vec4(position, 1.0));
 
-    gl_Position = UniformBufferData.Projection * UniformBufferData.View * UniformBufferData.Transform * vec4(a_Position, 1.0);
+    gl_Position = FrameData.Projection * FrameData.View * transform * vec4(position, 1.0);
 }
\ No newline at end of file
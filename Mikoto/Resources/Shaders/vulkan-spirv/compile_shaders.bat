@@ -9,4 +9,7 @@ glslc -O -fshader-stage="fragment" Outline_Frag.glsl -o Outline_Frag.sprv
 glslc -O -fshader-stage="vertex" Outline_Vert.glsl -o Outline_Vert.sprv
 
 glslc -O -fshader-stage="compute" Compute_Shader_Test.glsl -o Compute_Shader_Test.sprv
-glslc -O -fshader-stage="compute" Compute_Shader.glsl -o Compute_Shader.sprv
\ No newline at end of file
+glslc -O -fshader-stage="compute" Compute_Shader.glsl -o Compute_Shader.sprv
+glslc -O -fshader-stage="compute" ClusteredLightCulling.glsl -o ClusteredLightCulling.sprv
+glslc -O -fshader-stage="vertex" DepthPrepassVertexShader.glsl -o DepthPrepassVertexShader.sprv
+glslc -O -fshader-stage="compute" DrawCulling.glsl -o DrawCulling.sprv
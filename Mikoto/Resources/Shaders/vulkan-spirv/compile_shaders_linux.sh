@@ -8,3 +8,7 @@ glslc -O -fshader-stage='fragment' WireframeFragmentShader.glsl -o WireframeFrag
 
 glslc -O -fshader-stage='fragment' PBRFragmentShader.glsl -o PBRFragmentShader.sprv
 glslc -O -fshader-stage='vertex' PBRVertexShader.glsl -o PBRVertexShader.sprv
+
+glslc -O -fshader-stage='compute' ClusteredLightCulling.glsl -o ClusteredLightCulling.sprv
+glslc -O -fshader-stage='vertex' DepthPrepassVertexShader.glsl -o DepthPrepassVertexShader.sprv
+glslc -O -fshader-stage='compute' DrawCulling.glsl -o DrawCulling.sprv
@@ -8,7 +8,9 @@
 
 // C++ Standard Library
 #include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
 // Third-Party Libraries
 #include <entt/entt.hpp>
@@ -28,6 +30,13 @@ namespace Mikoto {
         std::string Name{};
         const Entity* Root{};
         const Model* ModelMesh{};
+
+        // Used when ModelMesh is null. While the model is pending the entity
+        // is created empty, its meshes are added once the model is ready
+        ModelLoadHandle ModelHandle{};
+
+        // When set only this mesh of the model is added, to the entity itself
+        std::string MeshName{};
     };
 
     class Scene final {
@@ -66,6 +75,11 @@ namespace Mikoto {
 
         auto AddEmptyEntity(std::string_view tagName, const Entity *root) -> Entity*;
 
+        auto AddMesh( Entity& entity, const Mesh& mesh ) -> void;
+        auto AddModelMeshes( Entity& root, const Model& model, bool meshOnRoot, std::string_view meshName ) -> void;
+
+        auto AddPendingModels() -> void;
+
         auto RemoveFromLights( UInt64_T uniqueID ) -> void;
         auto RemoveFromEntities( UInt64_T uniqueID ) -> Scope_T<Entity>;
         auto RemoveFromHierarchy( Entity& target ) -> void;
@@ -86,6 +100,16 @@ namespace Mikoto {
         // And remove them when we see fit.
         std::vector<UInt64_T> m_ToRemoveEntities{};
 
+        struct PendingModelEntity {
+            UInt64_T EntityID{};
+            bool MeshOnRoot{};
+            std::string MeshName{};
+            ModelLoadHandle ModelHandle{};
+        };
+
+        // Entities created while their model was loading
+        std::vector<PendingModelEntity> m_PendingModelEntities{};
+
         std::vector<Entity*> m_Lights{};
         std::vector<Scope_T<Entity>> m_Entities{};
 
@@ -2,23 +2,37 @@
 // Created by zanet on 1/26/2025.
 //
 
+#include <exception>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <filesystem>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <Common/Common.hh>
 #include <Core/Logging/Logger.hh>
 #include <Core/Logging/Assert.hh>
+#include <Core/Events/AssetEvents.hh>
+#include <Core/System/EventSystem.hh>
+#include <Library/Filesystem/MappedFile.hh>
+#include <Library/Utility/Hash.hh>
 #include <Library/Utility/Types.hh>
 #include <Core/System/AssetsSystem.hh>
+#include <Core/System/TaskSystem.hh>
 #include <Assets/Model.hh>
 #include <Assets/Texture.hh>
+#include <Material/Texture/Texture2D.hh>
 #include <Material/Texture/TextureCubeMap.hh>
 
 
 namespace Mikoto {
 
     auto AssetsSystem::Init( ) -> void {
+        m_IsShuttingDown = false;
 
         // Init Free Ttype Library
         const auto FTInit_Result{ FT_Init_FreeType(std::addressof( m_FreeTypeLibrary )) };
@@ -31,6 +45,7 @@ namespace Mikoto {
     }
 
     auto AssetsSystem::Update() -> void {
+        FinishModelLoads();
     }
 
     auto AssetsSystem::CreateTextureFromType( const TextureLoadInfo& info ) -> Texture* {
@@ -45,13 +60,104 @@ namespace Mikoto {
         return nullptr;
     }
 
+    auto AssetsSystem::GetTextureContentKey( const TextureLoadInfo& info ) -> ContentKey {
+        try {
+            const MappedFile file{ info.Path };
+            const std::span<const UInt8_T> bytes{ file.GetData() };
+
+            return ContentKey{ .Hash{ Hash::ComputeXXHash64( bytes ) }, .Size{ bytes.size() }, .Type{ static_cast<UInt32_T>( info.Type ) } };
+        } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+            MKT_CORE_LOGGER_WARN( "AssetsSystem::GetTextureContentKey - Could not hash [{}], it is not deduplicated. {}", info.Path.string(), exception.what() );
+        }
+
+        // Empty files are never mapped, a zero size keeps the path from matching any contents
+        const std::string path{ info.Path.string() };
+        return ContentKey{ .Hash{ Hash::ComputeXXHash64( { reinterpret_cast<const UInt8_T*>( path.data() ), path.size() } ) }, .Size{ 0 }, .Type{ static_cast<UInt32_T>( info.Type ) } };
+    }
+
+    auto AssetsSystem::FindTextureByContent( const TextureLoadInfo& info, const ContentKey& key ) -> Texture* {
+        const auto it{ m_TextureContents.find( key ) };
+
+        if ( it == m_TextureContents.end() ) {
+            return nullptr;
+        }
+
+        m_Textures.try_emplace( info.Path.string(), it->second.get() );
+
+        ++m_DeduplicationStats.TextureCount;
+        m_DeduplicationStats.TextureBytes += key.Size;
+
+        MKT_CORE_LOGGER_INFO( "AssetsSystem::FindTextureByContent - [{}] has the same contents as a loaded texture, sharing it. Saved {} bytes, {} in total",
+            info.Path.string(), key.Size, m_DeduplicationStats.TextureBytes );
+
+        return it->second.get();
+    }
+
+    auto AssetsSystem::AddTexture( const TextureLoadInfo& info, const ContentKey& key, Scope_T<Texture>&& texture ) -> Texture* {
+        Texture* result{ m_TextureContents.try_emplace( key, std::move( texture ) ).first->second.get() };
+        m_Textures.try_emplace( info.Path.string(), result );
+
+        return result;
+    }
+
+    auto AssetsSystem::LoadMeshBuffers( const ModelMeshData& data, const VertexFormat format ) -> MeshBuffers {
+        const std::span<const UInt8_T> vertices{ data.GetVertices() };
+        const std::span<const UInt32_T> indices{ data.GetIndices() };
+        const std::span<const UInt8_T> indexBytes{ reinterpret_cast<const UInt8_T*>( indices.data() ), indices.size_bytes() };
+
+        // Compact vertices are only the same if they were quantized to the same ranges
+        UInt64_T hash{ Hash::ComputeXXHash64( { reinterpret_cast<const UInt8_T*>( std::addressof( data.Dequantization ) ), sizeof( data.Dequantization ) } ) };
+        hash = Hash::ComputeXXHash64( vertices, hash );
+        hash = Hash::ComputeXXHash64( indexBytes, hash );
+
+        const ContentKey key{ .Hash{ hash }, .Size{ vertices.size() + indexBytes.size() }, .Type{ static_cast<UInt32_T>( format ) } };
+
+        if ( const auto it{ m_MeshBuffers.find( key ) }; it != m_MeshBuffers.end() ) {
+            MeshBuffers result{ .Vertices{ it->second.Vertices.lock() }, .Indices{ it->second.Indices.lock() } };
+
+            if ( result.Vertices != nullptr && result.Indices != nullptr ) {
+                ++m_DeduplicationStats.MeshCount;
+                m_DeduplicationStats.MeshBytes += key.Size;
+
+                MKT_CORE_LOGGER_INFO( "AssetsSystem::LoadMeshBuffers - Mesh [{}] has the same geometry as a loaded mesh, sharing its buffers. Saved {} bytes, {} in total",
+                    data.Name, key.Size, m_DeduplicationStats.MeshBytes );
+
+                return result;
+            }
+        }
+
+        // Entries of released meshes are dropped here instead of when the buffers are destroyed
+        std::erase_if( m_MeshBuffers, []( const auto& entry ) -> bool { return entry.second.Vertices.expired() || entry.second.Indices.expired(); } );
+
+        MeshBuffers result{ .Vertices{ VertexBuffer::Create( vertices, format, data.Dequantization ) }, .Indices{ IndexBuffer::Create( indices ) } };
+        m_MeshBuffers.insert_or_assign( key, MeshBuffersEntry{ .Vertices{ result.Vertices }, .Indices{ result.Indices } } );
+
+        return result;
+    }
+
     auto AssetsSystem::Shutdown() -> void {
+        {
+            std::scoped_lock lock{ m_ModelLoadMutex };
+            m_IsShuttingDown = true;
+        }
+
+        // Imports not started yet return right away
+        Engine::GetSystem<TaskSystem>().Wait( m_ModelImportJobs );
+
+        m_ImportedModels.clear();
+        m_PendingModels.clear();
+
         if (FT_Done_FreeType(m_FreeTypeLibrary) != 0) {
             MKT_CORE_LOGGER_ERROR( "AssetsSystem::Shutdown - Failed to destroy free type library" );
         }
 
+        MKT_CORE_LOGGER_INFO( "AssetsSystem::Shutdown - Deduplication shared {} textures ({} bytes) and {} meshes ({} bytes)",
+            m_DeduplicationStats.TextureCount, m_DeduplicationStats.TextureBytes, m_DeduplicationStats.MeshCount, m_DeduplicationStats.MeshBytes );
+
         m_Models.clear();
+        m_MeshBuffers.clear();
         m_Textures.clear();
+        m_TextureContents.clear();
     }
 
     auto AssetsSystem::GetModel( const std::string_view uri) -> Model* {
@@ -67,7 +173,7 @@ namespace Mikoto {
     auto AssetsSystem::GetTexture( const std::string_view uri ) -> Texture* {
         const std::string key{ uri };
         if ( const auto it{ m_Textures.find( key ) }; it != m_Textures.end() ) {
-            return it->second.get();
+            return it->second;
         }
 
         return nullptr;
@@ -126,31 +232,231 @@ namespace Mikoto {
         return result;
     }
 
-    auto AssetsSystem::LoadTexture(const TextureLoadInfo& info) -> Texture* {
-        Texture* result{ nullptr };
+    auto AssetsSystem::LoadModelAsync( const ModelLoadInfo& info ) -> ModelLoadHandle {
+        ModelLoadHandle handle{ CreateRef<ModelLoadHandle::Request>( ModelLoadHandle::Request{ .Path{ info.Path } } ) };
 
-        if (!info.Path.is_absolute()) {
-            return result;
+        if ( !info.Path.is_absolute() ) {
+            handle.m_Request->State = ModelLoadState::FAILED;
+            return handle;
         }
 
-        auto itFind{ m_Textures.find( info.Path.string() ) };
-        if ( itFind == m_Textures.end() ) {
-            const std::string key{ info.Path.string() };
+        const std::string key{ info.Path.string() };
+
+        if ( const auto it{ m_Models.find( key ) }; it != m_Models.end() ) {
+            handle.m_Request->State = ModelLoadState::READY;
+            handle.m_Request->Result = it->second.get();
+
+            return handle;
+        }
+
+        if ( const auto it{ m_PendingModels.find( key ) }; it != m_PendingModels.end() ) {
+            return it->second;
+        }
+
+        m_PendingModels.try_emplace( key, handle );
+
+        Engine::GetSystem<TaskSystem>().Dispatch( 1, 1, [this, info, handle]( MKT_UNUSED_VAR const TaskSystem::JobDispatchArgs args ) -> void {
+            ImportModel( info, handle );
+        }, m_ModelImportJobs );
+
+        return handle;
+    }
+
+    auto AssetsSystem::ImportModel( const ModelLoadInfo& info, const ModelLoadHandle& handle ) -> void {
+        {
+            std::scoped_lock lock{ m_ModelLoadMutex };
+
+            if ( m_IsShuttingDown ) {
+                return;
+            }
+        }
+
+        ModelLoadJob job{ .Info{ info }, .Handle{ handle } };
+
+        try {
+            // Its meshes and textures are processed in parallel as well, this job waits for them
+            job.Data = Model::Import( job.Info, true );
+        } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+            MKT_CORE_LOGGER_ERROR( "AssetsSystem::ImportModel - Failed to import model [{}]. {}", job.Info.Path.string(), exception.what() );
+        }
+
+        std::scoped_lock lock{ m_ModelLoadMutex };
+        m_ImportedModels.emplace_back( std::move( job ) );
+    }
+
+    auto AssetsSystem::FinishModelLoads() -> void {
+        std::vector<ModelLoadJob> importedModels{};
+
+        {
+            std::scoped_lock lock{ m_ModelLoadMutex };
+            importedModels.swap( m_ImportedModels );
+        }
+
+        EventSystem& eventSystem{ Engine::GetSystem<EventSystem>() };
 
-            Texture* createTextureResult{ CreateTextureFromType(info) };
+        for ( ModelLoadJob& job : importedModels ) {
+            const std::string key{ job.Info.Path.string() };
+            ModelLoadHandle::Request& request{ *job.Handle.m_Request };
 
-            if (createTextureResult) {
-                auto [insertIt, insertSuccess]{ m_Textures.try_emplace( key, createTextureResult ) };
+            request.State = ModelLoadState::FAILED;
 
-                if ( insertSuccess ) {
-                    result = insertIt->second.get();
+            if ( job.Data != nullptr ) {
+                try {
+                    // It may have been loaded synchronously in the meantime
+                    auto it{ m_Models.find( key ) };
+                    if ( it == m_Models.end() ) {
+                        it = m_Models.try_emplace( key, CreateScope<Model>( *job.Data ) ).first;
+                    }
+
+                    request.Result = it->second.get();
+                    request.State = ModelLoadState::READY;
+                } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+                    MKT_CORE_LOGGER_ERROR( "AssetsSystem::FinishModelLoads - Failed to create model [{}]. {}", key, exception.what() );
                 }
             }
-        } else {
-            result = itFind->second.get();
+
+            m_PendingModels.erase( key );
+            eventSystem.Trigger<ModelLoadEvent>( job.Handle );
         }
+    }
 
-        return result;
+    auto AssetsSystem::LoadTexture(const TextureLoadInfo& info) -> Texture* {
+        if (!info.Path.is_absolute()) {
+            return nullptr;
+        }
+
+        if ( const auto it{ m_Textures.find( info.Path.string() ) }; it != m_Textures.end() ) {
+            return it->second;
+        }
+
+        const ContentKey key{ GetTextureContentKey( info ) };
+
+        if ( Texture* texture{ FindTextureByContent( info, key ) }; texture != nullptr ) {
+            return texture;
+        }
+
+        Scope_T<Texture> texture{ CreateTextureFromType( info ) };
+
+        if ( texture == nullptr ) {
+            return nullptr;
+        }
+
+        return AddTexture( info, key, std::move( texture ) );
+    }
+
+    auto AssetsSystem::LoadTexture( const TextureLoadInfo& info, Texture2DData& data ) -> Texture* {
+        if ( const auto it{ m_Textures.find( info.Path.string() ) }; it != m_Textures.end() ) {
+            return it->second;
+        }
+
+        const ContentKey key{ GetTextureContentKey( info ) };
+
+        if ( Texture* texture{ FindTextureByContent( info, key ) }; texture != nullptr ) {
+            return texture;
+        }
+
+        Scope_T<Texture2D> texture{ Texture2D::Create( info.Path, info.Type, std::addressof( data ) ) };
+
+        if ( texture == nullptr ) {
+            return nullptr;
+        }
+
+        return AddTexture( info, key, std::move( texture ) );
     }
 
+    auto AssetsSystem::DecodeTextures( const std::span<const TextureLoadInfo> infos ) -> std::vector<Scope_T<Texture2DData>> {
+        std::vector<Scope_T<Texture2DData>> decoded( infos.size() );
+
+        TaskSystem& taskSystem{ Engine::GetSystem<TaskSystem>() };
+        TaskSystem::JobCounter decodeJobs{};
+
+        // One texture per job, their decode times vary too much to group them
+        taskSystem.Dispatch( static_cast<UInt32_T>( infos.size() ), 1, [&infos, &decoded]( const TaskSystem::JobDispatchArgs args ) -> void {
+            try {
+                decoded[args.JobIndex] = Texture2D::Decode( infos[args.JobIndex].Path );
+            } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+                MKT_CORE_LOGGER_ERROR( "AssetsSystem::DecodeTextures - Failed to decode texture [{}]. {}", infos[args.JobIndex].Path.string(), exception.what() );
+            }
+        }, decodeJobs );
+
+        taskSystem.Wait( decodeJobs );
+
+        return decoded;
+    }
+
+    auto AssetsSystem::LoadTextures( const std::span<const TextureLoadInfo> infos ) -> std::vector<Texture*> {
+        // 2D textures not loaded yet, each path once even if several infos reference it
+        std::vector<const TextureLoadInfo*> pending{};
+        std::unordered_set<std::string> pendingPaths{};
+
+        for ( const TextureLoadInfo& info : infos ) {
+            if ( info.Path.is_absolute() && info.Type != MapType::TEXTURE_CUBE &&
+                 !m_Textures.contains( info.Path.string() ) && pendingPaths.insert( info.Path.string() ).second ) {
+                pending.emplace_back( std::addressof( info ) );
+            }
+        }
+
+        std::vector<ContentKey> keys( pending.size() );
+
+        TaskSystem& taskSystem{ Engine::GetSystem<TaskSystem>() };
+        TaskSystem::JobCounter hashJobs{};
+
+        // Hashing reads the whole files, it is spread on the workers like the decodes
+        taskSystem.Dispatch( static_cast<UInt32_T>( pending.size() ), 1, [&pending, &keys]( const TaskSystem::JobDispatchArgs args ) -> void {
+            keys[args.JobIndex] = GetTextureContentKey( *pending[args.JobIndex] );
+        }, hashJobs );
+
+        taskSystem.Wait( hashJobs );
+
+        // Files with the same contents as a loaded texture or as another pending one are not decoded
+        std::vector<Size_T> unique{};
+        std::vector<TextureLoadInfo> uniqueInfos{};
+        std::vector<Size_T> duplicates{};
+        std::unordered_map<ContentKey, Size_T, ContentKeyHasher> firstPending{};
+
+        for ( Size_T index{}; index < pending.size(); ++index ) {
+            if ( FindTextureByContent( *pending[index], keys[index] ) != nullptr ) {
+                continue;
+            }
+
+            if ( firstPending.try_emplace( keys[index], index ).second ) {
+                unique.emplace_back( index );
+                uniqueInfos.emplace_back( *pending[index] );
+            } else {
+                duplicates.emplace_back( index );
+            }
+        }
+
+        std::vector<Scope_T<Texture2DData>> decoded{ DecodeTextures( uniqueInfos ) };
+
+        // GPU resources and uploads are recorded here, the upload manager batches them
+        for ( Size_T index{}; index < unique.size(); ++index ) {
+            if ( decoded[index] == nullptr ) {
+                continue;
+            }
+
+            const TextureLoadInfo& info{ *pending[unique[index]] };
+            Scope_T<Texture2D> texture{ Texture2D::Create( info.Path, info.Type, decoded[index].get() ) };
+
+            if ( texture != nullptr ) {
+                MKT_UNUSED_VAR Texture* result{ AddTexture( info, keys[unique[index]], std::move( texture ) ) };
+            }
+        }
+
+        // Resolve to the texture created for their contents, if it did not fail
+        for ( const Size_T index : duplicates ) {
+            MKT_UNUSED_VAR Texture* texture{ FindTextureByContent( *pending[index], keys[index] ) };
+        }
+
+        std::vector<Texture*> result{};
+        result.reserve( infos.size() );
+
+        for ( const TextureLoadInfo& info : infos ) {
+            // Failed decodes are not attempted again here, they stay null
+            const auto it{ m_Textures.find( info.Path.string() ) };
+            result.emplace_back( it != m_Textures.end() ? it->second : info.Type == MapType::TEXTURE_CUBE ? LoadTexture( info ) : nullptr );
+        }
+
+        return result;
+    }
 }
\ No newline at end of file
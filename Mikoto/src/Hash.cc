@@ -0,0 +1,111 @@
+/**
+ * Hash.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <bit>
+#include <cstring>
+#include <span>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Utility/Hash.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto::Hash {
+
+    // See https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+    constexpr UInt64_T XXH_PRIME64_1{ 0x9E3779B185EBCA87ULL };
+    constexpr UInt64_T XXH_PRIME64_2{ 0xC2B2AE3D27D4EB4FULL };
+    constexpr UInt64_T XXH_PRIME64_3{ 0x165667B19E3779F9ULL };
+    constexpr UInt64_T XXH_PRIME64_4{ 0x85EBCA77C2B2AE63ULL };
+    constexpr UInt64_T XXH_PRIME64_5{ 0x27D4EB2F165667C5ULL };
+
+    // Bytes consumed per iteration of the main loop, one lane for each accumulator
+    constexpr Size_T XXH_STRIPE_SIZE{ 32 };
+
+    static auto Read64( const UInt8_T* data ) -> UInt64_T {
+        UInt64_T value{};
+        std::memcpy( std::addressof( value ), data, sizeof( UInt64_T ) );
+
+        return value;
+    }
+
+    static auto Read32( const UInt8_T* data ) -> UInt32_T {
+        UInt32_T value{};
+        std::memcpy( std::addressof( value ), data, sizeof( UInt32_T ) );
+
+        return value;
+    }
+
+    static auto Round( UInt64_T accumulator, const UInt64_T lane ) -> UInt64_T {
+        accumulator += lane * XXH_PRIME64_2;
+        accumulator = std::rotl( accumulator, 31 );
+
+        return accumulator * XXH_PRIME64_1;
+    }
+
+    static auto MergeAccumulator( const UInt64_T hash, const UInt64_T accumulator ) -> UInt64_T {
+        return ( hash ^ Round( 0, accumulator ) ) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+
+    auto ComputeXXHash64( const std::span<const UInt8_T> bytes, const UInt64_T seed ) -> UInt64_T {
+        const UInt8_T* data{ bytes.data() };
+        const UInt8_T* const end{ bytes.data() + bytes.size() };
+
+        UInt64_T hash{};
+
+        if ( bytes.size() >= XXH_STRIPE_SIZE ) {
+            UInt64_T accumulator1{ seed + XXH_PRIME64_1 + XXH_PRIME64_2 };
+            UInt64_T accumulator2{ seed + XXH_PRIME64_2 };
+            UInt64_T accumulator3{ seed };
+            UInt64_T accumulator4{ seed - XXH_PRIME64_1 };
+
+            const UInt8_T* const lastStripe{ end - XXH_STRIPE_SIZE };
+
+            for ( ; data <= lastStripe; data += XXH_STRIPE_SIZE ) {
+                accumulator1 = Round( accumulator1, Read64( data ) );
+                accumulator2 = Round( accumulator2, Read64( data + 8 ) );
+                accumulator3 = Round( accumulator3, Read64( data + 16 ) );
+                accumulator4 = Round( accumulator4, Read64( data + 24 ) );
+            }
+
+            hash = std::rotl( accumulator1, 1 ) + std::rotl( accumulator2, 7 ) + std::rotl( accumulator3, 12 ) + std::rotl( accumulator4, 18 );
+            hash = MergeAccumulator( hash, accumulator1 );
+            hash = MergeAccumulator( hash, accumulator2 );
+            hash = MergeAccumulator( hash, accumulator3 );
+            hash = MergeAccumulator( hash, accumulator4 );
+        } else {
+            hash = seed + XXH_PRIME64_5;
+        }
+
+        hash += static_cast<UInt64_T>( bytes.size() );
+
+        // Tail shorter than a stripe
+        for ( ; data + sizeof( UInt64_T ) <= end; data += sizeof( UInt64_T ) ) {
+            hash ^= Round( 0, Read64( data ) );
+            hash = std::rotl( hash, 27 ) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        }
+
+        if ( data + sizeof( UInt32_T ) <= end ) {
+            hash ^= static_cast<UInt64_T>( Read32( data ) ) * XXH_PRIME64_1;
+            hash = std::rotl( hash, 23 ) * XXH_PRIME64_2 + XXH_PRIME64_3;
+            data += sizeof( UInt32_T );
+        }
+
+        for ( ; data < end; ++data ) {
+            hash ^= static_cast<UInt64_T>( *data ) * XXH_PRIME64_5;
+            hash = std::rotl( hash, 11 ) * XXH_PRIME64_1;
+        }
+
+        // Avalanche
+        hash ^= hash >> 33;
+        hash *= XXH_PRIME64_2;
+        hash ^= hash >> 29;
+        hash *= XXH_PRIME64_3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+}
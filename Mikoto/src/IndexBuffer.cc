@@ -2,6 +2,9 @@
 // Created by zanet on 2/16/2025.
 //
 
+// C++ Standard Library
+#include <span>
+
 // Project Headers
 #include <Core/Logging/Logger.hh>
 #include <Core/System/RenderSystem.hh>
@@ -10,7 +13,7 @@
 
 namespace Mikoto {
 
-    auto IndexBuffer::Create( const std::vector<UInt32_T>& data ) -> Scope_T<IndexBuffer> {
+    auto IndexBuffer::Create( const std::span<const UInt32_T> data ) -> Scope_T<IndexBuffer> {
         auto& renderSystem{ Engine::GetSystem<RenderSystem>() };
 
         VulkanIndexBufferCreateInfo createInfo{
@@ -0,0 +1,147 @@
+/**
+ * MappedFile.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <memory>
+#include <utility>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Filesystem/MappedFile.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto {
+
+#if defined(_WIN32) || defined(_WIN64)
+    MappedFile::MappedFile( const Path_T& path ) {
+        m_FileHandle = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+
+        if ( m_FileHandle == INVALID_HANDLE_VALUE ) {
+            m_FileHandle = nullptr;
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - Failed to open [{}].", path.string() ) );
+        }
+
+        LARGE_INTEGER size{};
+        if ( GetFileSizeEx( m_FileHandle, std::addressof( size ) ) == 0 || size.QuadPart == 0 ) {
+            Unmap();
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - File [{}] is empty.", path.string() ) );
+        }
+
+        m_MappingHandle = CreateFileMappingW( m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+        if ( m_MappingHandle != nullptr ) {
+            m_Data = static_cast<const UInt8_T*>( MapViewOfFile( m_MappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+        }
+
+        if ( m_Data == nullptr ) {
+            Unmap();
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - Failed to map [{}].", path.string() ) );
+        }
+
+        m_Size = static_cast<Size_T>( size.QuadPart );
+    }
+
+    auto MappedFile::Unmap() -> void {
+        if ( m_Data != nullptr ) {
+            UnmapViewOfFile( m_Data );
+        }
+
+        if ( m_MappingHandle != nullptr ) {
+            CloseHandle( m_MappingHandle );
+        }
+
+        if ( m_FileHandle != nullptr ) {
+            CloseHandle( m_FileHandle );
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_MappingHandle = nullptr;
+        m_FileHandle = nullptr;
+    }
+#else
+    MappedFile::MappedFile( const Path_T& path ) {
+        const int descriptor{ open( path.c_str(), O_RDONLY ) };
+
+        if ( descriptor == -1 ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - Failed to open [{}].", path.string() ) );
+        }
+
+        struct stat status{};
+        if ( fstat( descriptor, std::addressof( status ) ) == -1 || status.st_size == 0 ) {
+            close( descriptor );
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - File [{}] is empty.", path.string() ) );
+        }
+
+        const Size_T size{ static_cast<Size_T>( status.st_size ) };
+        void* data{ mmap( nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0 ) };
+
+        // The mapping keeps its own reference to the file
+        close( descriptor );
+
+        if ( data == MAP_FAILED ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MappedFile::MappedFile - Failed to map [{}].", path.string() ) );
+        }
+
+        // The whole file is read right after mapping it, start reading it ahead
+        madvise( data, size, MADV_WILLNEED );
+
+        m_Data = static_cast<const UInt8_T*>( data );
+        m_Size = size;
+    }
+
+    auto MappedFile::Unmap() -> void {
+        if ( m_Data != nullptr ) {
+            munmap( const_cast<UInt8_T*>( m_Data ), m_Size );
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+
+    MappedFile::MappedFile( MappedFile&& other ) noexcept
+        :   m_Data{ std::exchange( other.m_Data, nullptr ) }
+        ,   m_Size{ std::exchange( other.m_Size, 0 ) }
+#if defined(_WIN32) || defined(_WIN64)
+        ,   m_FileHandle{ std::exchange( other.m_FileHandle, nullptr ) }
+        ,   m_MappingHandle{ std::exchange( other.m_MappingHandle, nullptr ) }
+#endif
+    {
+
+    }
+
+    auto MappedFile::operator=( MappedFile&& other ) noexcept -> MappedFile& {
+        if ( this != std::addressof( other ) ) {
+            Unmap();
+
+            m_Data = std::exchange( other.m_Data, nullptr );
+            m_Size = std::exchange( other.m_Size, 0 );
+
+#if defined(_WIN32) || defined(_WIN64)
+            m_FileHandle = std::exchange( other.m_FileHandle, nullptr );
+            m_MappingHandle = std::exchange( other.m_MappingHandle, nullptr );
+#endif
+        }
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        Unmap();
+    }
+}
@@ -10,8 +10,13 @@
 #include <utility>
 
 namespace Mikoto {
-    Mesh::Mesh( const std::string_view name, Scope_T<VertexBuffer>&& vertices, Scope_T<IndexBuffer>&& indices, std::vector<Texture2D*>&& textures, const Path_T& path )
-        : m_Name{ name }, m_Vertices{ std::move( vertices ) }, m_Indices{ std::move( indices ) }, m_Textures{ std::move( textures ) }, m_ModelAbsolutePath{ path } {}
+    Mesh::Mesh( const std::string_view name, Ref_T<VertexBuffer> vertices, Ref_T<IndexBuffer> indices, std::vector<Texture2D*>&& textures, const Path_T& path, std::vector<MeshLod>&& lods, std::vector<MeshOptimizer::Meshlet>&& meshlets )
+        : m_Name{ name }, m_Vertices{ std::move( vertices ) }, m_Indices{ std::move( indices ) }, m_Lods{ std::move( lods ) }, m_Meshlets{ std::move( meshlets ) }, m_Textures{ std::move( textures ) }, m_ModelAbsolutePath{ path }
+    {
+        if ( m_Lods.empty() && m_Indices != nullptr ) {
+            m_Lods.emplace_back( MeshLod{ .FirstIndex{ 0 }, .IndexCount{ static_cast<UInt32_T>( m_Indices->GetCount() ) } } );
+        }
+    }
 
     Mesh::~Mesh() {
         m_Textures.clear();
@@ -0,0 +1,470 @@
+/**
+ * MeshCooker.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Headers
+#include <Assets/MeshCooker.hh>
+#include <Assets/Model.hh>
+#include <Common/Common.hh>
+#include <Core/Logging/Logger.hh>
+#include <Library/Filesystem/MappedFile.hh>
+#include <Library/Filesystem/PathBuilder.hh>
+#include <Library/Utility/Types.hh>
+#include <Renderer/Buffer/VertexBuffer.hh>
+
+namespace Mikoto {
+
+    constexpr std::array<char, 8> MESH_FILE_MAGIC{ 'M', 'K', 'T', 'M', 'E', 'S', 'H', '\0' };
+
+    // Bump when the layout of the file or the vertices produced by Model::ProcessMesh change
+    constexpr UInt32_T MESH_FILE_VERSION{ 5 };
+
+    // Vertices and indices start at multiples of this, so they can be read in place from the mapping
+    constexpr UInt64_T MESH_FILE_DATA_ALIGNMENT{ 16 };
+
+    enum MeshFileFlagBits : UInt32_T {
+        MESH_FILE_FLAG_NONE = 0,
+        MESH_FILE_FLAG_INVERTED_Y = 1 << 0,
+        MESH_FILE_FLAG_COMPACT_VERTICES = 1 << 1,
+    };
+
+    // Start of the file, offsets are relative to it
+    struct MeshFileHeader {
+        std::array<char, 8> Magic{};
+        UInt32_T Version{};
+        UInt32_T Flags{};
+
+        // Bytes per vertex, the layout is the one of the vertex format in the flags
+        UInt32_T VertexStride{};
+
+        UInt32_T SubmeshCount{};
+        UInt32_T TextureCount{};
+        UInt32_T TextureIndexCount{};
+
+        UInt64_T SubmeshTableOffset{};
+        UInt64_T TextureTableOffset{};
+        UInt64_T TextureIndexTableOffset{};
+        UInt64_T StringTableOffset{};
+        UInt64_T StringTableSize{};
+        UInt64_T FileSize{};
+    };
+
+    // See MeshLod
+    struct MeshFileLod {
+        UInt32_T FirstIndex{};
+        UInt32_T IndexCount{};
+        UInt32_T FirstMeshlet{};
+        UInt32_T MeshletCount{};
+        float Error{};
+        UInt32_T Reserved{};
+    };
+
+    // See MeshOptimizer::Meshlet
+    struct MeshFileMeshlet {
+        UInt32_T FirstIndex{};
+        UInt32_T IndexCount{};
+        UInt32_T VertexCount{};
+        UInt32_T Reserved{};
+        std::array<float, 4> BoundingSphere{};
+        std::array<float, 4> Cone{};
+    };
+
+    struct MeshFileSubmesh {
+        UInt64_T VertexOffset{};
+        UInt64_T VertexSize{};
+        UInt64_T IndexOffset{};
+        UInt64_T IndexCount{};
+        UInt64_T MeshletOffset{};
+        UInt64_T MeshletCount{};
+
+        // Into the string table
+        UInt32_T NameOffset{};
+        UInt32_T NameLength{};
+
+        // Into the texture index table
+        UInt32_T FirstTextureIndex{};
+        UInt32_T TextureIndexCount{};
+
+        std::array<float, 3> BoundsMin{};
+        std::array<float, 3> BoundsMax{};
+
+        // See VertexDequantization
+        std::array<float, 3> PositionScale{};
+        std::array<float, 3> PositionOffset{};
+        std::array<float, 2> TexCoordScale{};
+        std::array<float, 2> TexCoordOffset{};
+
+        // Ranges of the indices, the full mesh first
+        UInt32_T LodCount{};
+        UInt32_T Reserved{};
+        std::array<MeshFileLod, MAX_MESH_LODS> Lods{};
+    };
+
+    struct MeshFileTexture {
+        // Into the string table, relative to the directory of the model
+        UInt32_T PathOffset{};
+        UInt32_T PathLength{};
+
+        UInt32_T Type{};
+        UInt32_T Reserved{};
+    };
+
+    static_assert( sizeof( MeshFileHeader ) == 80, "MeshFileHeader must match the layout of the file." );
+    static_assert( sizeof( MeshFileLod ) == 24, "MeshFileLod must match the layout of the file." );
+    static_assert( sizeof( MeshFileMeshlet ) == 48, "MeshFileMeshlet must match the layout of the file." );
+    static_assert( sizeof( MeshFileSubmesh ) == 232, "MeshFileSubmesh must match the layout of the file." );
+    static_assert( sizeof( MeshFileTexture ) == 16, "MeshFileTexture must match the layout of the file." );
+
+    static auto AlignUp( const UInt64_T value, const UInt64_T alignment ) -> UInt64_T {
+        return ( value + alignment - 1 ) / alignment * alignment;
+    }
+
+    static auto GetFlags( const ModelLoadInfo& info ) -> UInt32_T {
+        UInt32_T flags{ info.InvertedY ? MESH_FILE_FLAG_INVERTED_Y : MESH_FILE_FLAG_NONE };
+
+        if ( info.Format == VertexFormat::COMPACT ) {
+            flags |= MESH_FILE_FLAG_COMPACT_VERTICES;
+        }
+
+        return flags;
+    }
+
+    static auto IsCookedFileUpToDate( const Path_T& source, const Path_T& cooked ) -> bool {
+        std::error_code error{};
+
+        const auto cookedTime{ std::filesystem::last_write_time( cooked, error ) };
+        if ( error ) {
+            return false;
+        }
+
+        // Projects may ship the cooked files only
+        const auto sourceTime{ std::filesystem::last_write_time( source, error ) };
+
+        return error || cookedTime >= sourceTime;
+    }
+
+    // True if the range [offset, offset + size) is inside a file of fileSize bytes
+    static auto IsInFile( const UInt64_T offset, const UInt64_T size, const UInt64_T fileSize ) -> bool {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    auto MeshCooker::GetCookedPath( const Path_T& source ) -> Path_T {
+        Path_T result{ source };
+        result.replace_extension( ".mktmesh" );
+
+        return result;
+    }
+
+    auto MeshCooker::Write( const ModelData& data ) -> Size_T {
+        const Path_T modelDirectory{ data.Info.Path.parent_path() };
+
+        std::string stringTable{};
+        const auto addString{ [&stringTable]( const std::string_view value ) -> std::pair<UInt32_T, UInt32_T> {
+            const auto offset{ static_cast<UInt32_T>( stringTable.size() ) };
+            stringTable.append( value );
+
+            return { offset, static_cast<UInt32_T>( value.size() ) };
+        } };
+
+        std::vector<MeshFileTexture> textures{};
+        textures.reserve( data.Textures.size() );
+
+        for ( const TextureLoadInfo& texture : data.Textures ) {
+            const auto [pathOffset, pathLength]{ addString( texture.Path.lexically_relative( modelDirectory ).generic_string() ) };
+
+            textures.emplace_back( MeshFileTexture{
+                .PathOffset{ pathOffset },
+                .PathLength{ pathLength },
+                .Type{ static_cast<UInt32_T>( texture.Type ) },
+            } );
+        }
+
+        std::vector<MeshFileSubmesh> submeshes{};
+        std::vector<UInt32_T> textureIndices{};
+        submeshes.reserve( data.Meshes.size() );
+
+        for ( const ModelMeshData& mesh : data.Meshes ) {
+            const auto [nameOffset, nameLength]{ addString( mesh.Name ) };
+            const VertexDequantization& dequantization{ mesh.Dequantization };
+
+            MeshFileSubmesh& submesh{ submeshes.emplace_back( MeshFileSubmesh{
+                .VertexSize{ mesh.GetVertices().size() },
+                .IndexCount{ mesh.GetIndices().size() },
+                .MeshletCount{ mesh.Meshlets.size() },
+                .NameOffset{ nameOffset },
+                .NameLength{ nameLength },
+                .FirstTextureIndex{ static_cast<UInt32_T>( textureIndices.size() ) },
+                .TextureIndexCount{ static_cast<UInt32_T>( mesh.TextureIndices.size() ) },
+                .BoundsMin{ mesh.BoundsMin.x, mesh.BoundsMin.y, mesh.BoundsMin.z },
+                .BoundsMax{ mesh.BoundsMax.x, mesh.BoundsMax.y, mesh.BoundsMax.z },
+                .PositionScale{ dequantization.PositionScale.x, dequantization.PositionScale.y, dequantization.PositionScale.z },
+                .PositionOffset{ dequantization.PositionOffset.x, dequantization.PositionOffset.y, dequantization.PositionOffset.z },
+                .TexCoordScale{ dequantization.TexCoordScale.x, dequantization.TexCoordScale.y },
+                .TexCoordOffset{ dequantization.TexCoordOffset.x, dequantization.TexCoordOffset.y },
+                .LodCount{ static_cast<UInt32_T>( std::min( mesh.Lods.size(), MAX_MESH_LODS ) ) },
+            } ) };
+
+            for ( UInt32_T lod{}; lod < submesh.LodCount; ++lod ) {
+                submesh.Lods[lod] = MeshFileLod{
+                    .FirstIndex{ mesh.Lods[lod].FirstIndex },
+                    .IndexCount{ mesh.Lods[lod].IndexCount },
+                    .FirstMeshlet{ mesh.Lods[lod].FirstMeshlet },
+                    .MeshletCount{ mesh.Lods[lod].MeshletCount },
+                    .Error{ mesh.Lods[lod].Error },
+                };
+            }
+
+            for ( const Size_T textureIndex : mesh.TextureIndices ) {
+                textureIndices.emplace_back( static_cast<UInt32_T>( textureIndex ) );
+            }
+        }
+
+        MeshFileHeader header{};
+        header.Magic = MESH_FILE_MAGIC;
+        header.Version = MESH_FILE_VERSION;
+        header.Flags = GetFlags( data.Info );
+        header.VertexStride = VertexBuffer::GetBufferLayout( data.Info.Format ).GetStride();
+        header.SubmeshCount = static_cast<UInt32_T>( submeshes.size() );
+        header.TextureCount = static_cast<UInt32_T>( textures.size() );
+        header.TextureIndexCount = static_cast<UInt32_T>( textureIndices.size() );
+
+        header.SubmeshTableOffset = sizeof( MeshFileHeader );
+        header.TextureTableOffset = header.SubmeshTableOffset + submeshes.size() * sizeof( MeshFileSubmesh );
+        header.TextureIndexTableOffset = header.TextureTableOffset + textures.size() * sizeof( MeshFileTexture );
+        header.StringTableOffset = header.TextureIndexTableOffset + textureIndices.size() * sizeof( UInt32_T );
+        header.StringTableSize = stringTable.size();
+
+        UInt64_T offset{ header.StringTableOffset + header.StringTableSize };
+
+        for ( Size_T index{}; index < submeshes.size(); ++index ) {
+            offset = AlignUp( offset, MESH_FILE_DATA_ALIGNMENT );
+            submeshes[index].VertexOffset = offset;
+            offset += submeshes[index].VertexSize;
+
+            offset = AlignUp( offset, MESH_FILE_DATA_ALIGNMENT );
+            submeshes[index].IndexOffset = offset;
+            offset += submeshes[index].IndexCount * sizeof( UInt32_T );
+
+            offset = AlignUp( offset, MESH_FILE_DATA_ALIGNMENT );
+            submeshes[index].MeshletOffset = offset;
+            offset += submeshes[index].MeshletCount * sizeof( MeshFileMeshlet );
+        }
+
+        header.FileSize = offset;
+
+        std::vector<UInt8_T> file( header.FileSize );
+        std::memcpy( file.data(), std::addressof( header ), sizeof( MeshFileHeader ) );
+        std::memcpy( file.data() + header.SubmeshTableOffset, submeshes.data(), submeshes.size() * sizeof( MeshFileSubmesh ) );
+        std::memcpy( file.data() + header.TextureTableOffset, textures.data(), textures.size() * sizeof( MeshFileTexture ) );
+        std::memcpy( file.data() + header.TextureIndexTableOffset, textureIndices.data(), textureIndices.size() * sizeof( UInt32_T ) );
+        std::memcpy( file.data() + header.StringTableOffset, stringTable.data(), stringTable.size() );
+
+        for ( Size_T index{}; index < submeshes.size(); ++index ) {
+            const std::span<const UInt8_T> vertices{ data.Meshes[index].GetVertices() };
+            const std::span<const UInt32_T> indices{ data.Meshes[index].GetIndices() };
+
+            std::memcpy( file.data() + submeshes[index].VertexOffset, vertices.data(), vertices.size_bytes() );
+            std::memcpy( file.data() + submeshes[index].IndexOffset, indices.data(), indices.size_bytes() );
+
+            for ( Size_T meshletIndex{}; meshletIndex < data.Meshes[index].Meshlets.size(); ++meshletIndex ) {
+                const MeshOptimizer::Meshlet& meshlet{ data.Meshes[index].Meshlets[meshletIndex] };
+
+                const MeshFileMeshlet fileMeshlet{
+                    .FirstIndex{ meshlet.FirstIndex },
+                    .IndexCount{ meshlet.IndexCount },
+                    .VertexCount{ meshlet.VertexCount },
+                    .BoundingSphere{ meshlet.BoundingSphere.x, meshlet.BoundingSphere.y, meshlet.BoundingSphere.z, meshlet.BoundingSphere.w },
+                    .Cone{ meshlet.Cone.x, meshlet.Cone.y, meshlet.Cone.z, meshlet.Cone.w },
+                };
+
+                std::memcpy( file.data() + submeshes[index].MeshletOffset + meshletIndex * sizeof( MeshFileMeshlet ), std::addressof( fileMeshlet ), sizeof( MeshFileMeshlet ) );
+            }
+        }
+
+        // Written aside and renamed, a loader never maps a partially written file
+        const Path_T cookedPath{ GetCookedPath( data.Info.Path ) };
+        Path_T temporaryPath{ cookedPath };
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream stream{ temporaryPath, std::ios::binary | std::ios::trunc };
+            if ( !stream.write( reinterpret_cast<const char*>( file.data() ), static_cast<std::streamsize>( file.size() ) ) ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "MeshCooker::Write - Failed to write cooked mesh [{}].", cookedPath.string() ) );
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename( temporaryPath, cookedPath, error );
+
+        if ( error ) {
+            std::filesystem::remove( temporaryPath, error );
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "MeshCooker::Write - Failed to replace cooked mesh [{}].", cookedPath.string() ) );
+        }
+
+        return file.size();
+    }
+
+    auto MeshCooker::Load( const ModelLoadInfo& info ) -> Scope_T<ModelData> {
+        const Path_T cookedPath{ GetCookedPath( info.Path ) };
+
+        if ( !IsCookedFileUpToDate( info.Path, cookedPath ) ) {
+            return nullptr;
+        }
+
+        Scope_T<MappedFile> file{};
+
+        try {
+            file = CreateScope<MappedFile>( cookedPath );
+        } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+            MKT_CORE_LOGGER_WARN( "MeshCooker::Load - Could not map cooked mesh. {}", exception.what() );
+            return nullptr;
+        }
+
+        const std::span<const UInt8_T> bytes{ file->GetData() };
+
+        if ( bytes.size() < sizeof( MeshFileHeader ) ) {
+            return nullptr;
+        }
+
+        MeshFileHeader header{};
+        std::memcpy( std::addressof( header ), bytes.data(), sizeof( MeshFileHeader ) );
+
+        // Files from another version or cooked with other options are cooked again
+        if ( header.Magic != MESH_FILE_MAGIC || header.Version != MESH_FILE_VERSION || header.Flags != GetFlags( info ) ||
+             header.VertexStride != VertexBuffer::GetBufferLayout( info.Format ).GetStride() || header.FileSize != bytes.size() ) {
+            return nullptr;
+        }
+
+        if ( !IsInFile( header.SubmeshTableOffset, static_cast<UInt64_T>( header.SubmeshCount ) * sizeof( MeshFileSubmesh ), header.FileSize ) ||
+             !IsInFile( header.TextureTableOffset, static_cast<UInt64_T>( header.TextureCount ) * sizeof( MeshFileTexture ), header.FileSize ) ||
+             !IsInFile( header.TextureIndexTableOffset, static_cast<UInt64_T>( header.TextureIndexCount ) * sizeof( UInt32_T ), header.FileSize ) ||
+             !IsInFile( header.StringTableOffset, header.StringTableSize, header.FileSize ) ) {
+            MKT_CORE_LOGGER_WARN( "MeshCooker::Load - Cooked mesh [{}] is corrupted.", cookedPath.string() );
+            return nullptr;
+        }
+
+        const std::string_view stringTable{ reinterpret_cast<const char*>( bytes.data() + header.StringTableOffset ), header.StringTableSize };
+        const auto getString{ [&stringTable]( const UInt32_T offset, const UInt32_T length ) -> std::string_view {
+            return offset <= stringTable.size() ? stringTable.substr( offset, length ) : std::string_view{};
+        } };
+
+        auto data{ CreateScope<ModelData>() };
+        data->Info = info;
+        data->Textures.reserve( header.TextureCount );
+        data->Meshes.reserve( header.SubmeshCount );
+
+        const Path_T modelDirectory{ info.Path.parent_path() };
+
+        for ( UInt32_T index{}; index < header.TextureCount; ++index ) {
+            MeshFileTexture texture{};
+            std::memcpy( std::addressof( texture ), bytes.data() + header.TextureTableOffset + index * sizeof( MeshFileTexture ), sizeof( MeshFileTexture ) );
+
+            data->Textures.emplace_back( TextureLoadInfo{
+                .Path{ PathBuilder().WithPath( modelDirectory.string() ).WithPath( getString( texture.PathOffset, texture.PathLength ) ).Build() },
+                .Type{ static_cast<MapType>( texture.Type ) },
+            } );
+        }
+
+        std::vector<UInt32_T> textureIndices( header.TextureIndexCount );
+        std::memcpy( textureIndices.data(), bytes.data() + header.TextureIndexTableOffset, textureIndices.size() * sizeof( UInt32_T ) );
+
+        for ( UInt32_T index{}; index < header.SubmeshCount; ++index ) {
+            MeshFileSubmesh submesh{};
+            std::memcpy( std::addressof( submesh ), bytes.data() + header.SubmeshTableOffset + index * sizeof( MeshFileSubmesh ), sizeof( MeshFileSubmesh ) );
+
+            const bool isValid{ submesh.VertexOffset % alignof( float ) == 0 && submesh.IndexOffset % alignof( UInt32_T ) == 0 &&
+                                submesh.VertexSize % header.VertexStride == 0 && submesh.IndexCount <= header.FileSize / sizeof( UInt32_T ) &&
+                                IsInFile( submesh.VertexOffset, submesh.VertexSize, header.FileSize ) &&
+                                IsInFile( submesh.IndexOffset, submesh.IndexCount * sizeof( UInt32_T ), header.FileSize ) &&
+                                submesh.MeshletCount <= header.FileSize / sizeof( MeshFileMeshlet ) &&
+                                IsInFile( submesh.MeshletOffset, submesh.MeshletCount * sizeof( MeshFileMeshlet ), header.FileSize ) &&
+                                static_cast<UInt64_T>( submesh.FirstTextureIndex ) + submesh.TextureIndexCount <= textureIndices.size() &&
+                                submesh.LodCount >= 1 && submesh.LodCount <= MAX_MESH_LODS &&
+                                std::all_of( submesh.Lods.begin(), submesh.Lods.begin() + submesh.LodCount, [&submesh]( const MeshFileLod& lod ) -> bool {
+                                    return static_cast<UInt64_T>( lod.FirstIndex ) + lod.IndexCount <= submesh.IndexCount &&
+                                           static_cast<UInt64_T>( lod.FirstMeshlet ) + lod.MeshletCount <= submesh.MeshletCount;
+                                } ) };
+
+            if ( !isValid ) {
+                MKT_CORE_LOGGER_WARN( "MeshCooker::Load - Cooked mesh [{}] is corrupted.", cookedPath.string() );
+                return nullptr;
+            }
+
+            // The data is aligned in the file and the mapping starts at a page boundary
+            ModelMeshData& mesh{ data->Meshes.emplace_back( ModelMeshData{
+                .Name{ getString( submesh.NameOffset, submesh.NameLength ) },
+                .MappedVertices{ bytes.subspan( submesh.VertexOffset, submesh.VertexSize ) },
+                .MappedIndices{ reinterpret_cast<const UInt32_T*>( bytes.data() + submesh.IndexOffset ), submesh.IndexCount },
+                .Dequantization{
+                    .PositionScale{ submesh.PositionScale[0], submesh.PositionScale[1], submesh.PositionScale[2] },
+                    .PositionOffset{ submesh.PositionOffset[0], submesh.PositionOffset[1], submesh.PositionOffset[2] },
+                    .TexCoordScale{ submesh.TexCoordScale[0], submesh.TexCoordScale[1] },
+                    .TexCoordOffset{ submesh.TexCoordOffset[0], submesh.TexCoordOffset[1] },
+                },
+                .BoundsMin{ submesh.BoundsMin[0], submesh.BoundsMin[1], submesh.BoundsMin[2] },
+                .BoundsMax{ submesh.BoundsMax[0], submesh.BoundsMax[1], submesh.BoundsMax[2] },
+            } ) };
+
+            for ( UInt32_T lod{}; lod < submesh.LodCount; ++lod ) {
+                mesh.Lods.emplace_back( MeshLod{
+                    .FirstIndex{ submesh.Lods[lod].FirstIndex },
+                    .IndexCount{ submesh.Lods[lod].IndexCount },
+                    .Error{ submesh.Lods[lod].Error },
+                    .FirstMeshlet{ submesh.Lods[lod].FirstMeshlet },
+                    .MeshletCount{ submesh.Lods[lod].MeshletCount },
+                } );
+            }
+
+            // Small enough to be copied, the renderer reads them on the host every frame
+            mesh.Meshlets.reserve( submesh.MeshletCount );
+
+            for ( UInt64_T meshletIndex{}; meshletIndex < submesh.MeshletCount; ++meshletIndex ) {
+                MeshFileMeshlet meshlet{};
+                std::memcpy( std::addressof( meshlet ), bytes.data() + submesh.MeshletOffset + meshletIndex * sizeof( MeshFileMeshlet ), sizeof( MeshFileMeshlet ) );
+
+                if ( static_cast<UInt64_T>( meshlet.FirstIndex ) + meshlet.IndexCount > submesh.IndexCount ) {
+                    MKT_CORE_LOGGER_WARN( "MeshCooker::Load - Cooked mesh [{}] is corrupted.", cookedPath.string() );
+                    return nullptr;
+                }
+
+                mesh.Meshlets.emplace_back( MeshOptimizer::Meshlet{
+                    .FirstIndex{ meshlet.FirstIndex },
+                    .IndexCount{ meshlet.IndexCount },
+                    .VertexCount{ meshlet.VertexCount },
+                    .BoundingSphere{ meshlet.BoundingSphere[0], meshlet.BoundingSphere[1], meshlet.BoundingSphere[2], meshlet.BoundingSphere[3] },
+                    .Cone{ meshlet.Cone[0], meshlet.Cone[1], meshlet.Cone[2], meshlet.Cone[3] },
+                } );
+            }
+
+            for ( UInt32_T textureIndex{}; textureIndex < submesh.TextureIndexCount; ++textureIndex ) {
+                const UInt32_T modelTextureIndex{ textureIndices[submesh.FirstTextureIndex + textureIndex] };
+
+                if ( modelTextureIndex < data->Textures.size() ) {
+                    mesh.TextureIndices.emplace_back( modelTextureIndex );
+                }
+            }
+        }
+
+        data->CookedFile = std::move( file );
+
+        return data;
+    }
+}
@@ -0,0 +1,894 @@
+/**
+ * MeshOptimizer.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <vector>
+
+// Third-Party Libraries
+#include <glm/glm.hpp>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Library/Mesh/MeshOptimizer.hh>
+#include <Library/Utility/Types.hh>
+
+namespace Mikoto::MeshOptimizer {
+
+    // Forsyth's constants, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+    // The LRU cache it simulates is bigger than the hardware one on purpose, its scores only need to rank the vertices
+    constexpr UInt32_T FORSYTH_CACHE_SIZE{ 32 };
+    constexpr float FORSYTH_CACHE_DECAY_POWER{ 1.5f };
+    constexpr float FORSYTH_LAST_TRIANGLE_SCORE{ 0.75f };
+    constexpr float FORSYTH_VALENCE_BOOST_SCALE{ 2.0f };
+    constexpr float FORSYTH_VALENCE_BOOST_POWER{ 0.5f };
+
+    constexpr UInt32_T INVALID_INDEX{ std::numeric_limits<UInt32_T>::max() };
+
+    static auto GetVertexScore( const Int32_T cachePosition, const UInt32_T remainingTriangles ) -> float {
+        // Nothing left to draw with it
+        if ( remainingTriangles == 0 ) {
+            return -1.0f;
+        }
+
+        float score{};
+
+        if ( cachePosition >= 0 ) {
+            // The vertices of the last triangle get a fixed score, so the next one does not strip along them
+            if ( cachePosition < 3 ) {
+                score = FORSYTH_LAST_TRIANGLE_SCORE;
+            } else {
+                const float scale{ 1.0f / static_cast<float>( FORSYTH_CACHE_SIZE - 3 ) };
+                score = std::pow( 1.0f - static_cast<float>( cachePosition - 3 ) * scale, FORSYTH_CACHE_DECAY_POWER );
+            }
+        }
+
+        // Vertices with few triangles left are finished first, they would cost a whole transform later
+        return score + FORSYTH_VALENCE_BOOST_SCALE * std::pow( static_cast<float>( remainingTriangles ), -FORSYTH_VALENCE_BOOST_POWER );
+    }
+
+    static auto GetPosition( const std::span<const float> vertices, const Size_T vertexStride, const UInt32_T index ) -> glm::vec3 {
+        const float* position{ vertices.data() + index * vertexStride };
+        return glm::vec3{ position[0], position[1], position[2] };
+    }
+
+    /**
+     * Lists the triangles using every vertex, a triangle using a vertex twice is listed twice
+     * @param offsets receives vertexCount + 1 entries, the triangles of a vertex are in [offsets[vertex], offsets[vertex + 1])
+     * @param triangles receives the triangle indices
+     * */
+    static auto BuildTriangleAdjacency( const std::span<const UInt32_T> indices, const Size_T vertexCount, std::vector<UInt32_T>& offsets, std::vector<UInt32_T>& triangles ) -> void {
+        std::vector<UInt32_T> counts( vertexCount, 0 );
+
+        for ( const UInt32_T index : indices ) {
+            ++counts[index];
+        }
+
+        offsets.assign( vertexCount + 1, 0 );
+        std::exclusive_scan( counts.begin(), counts.end(), offsets.begin(), 0u );
+        offsets[vertexCount] = static_cast<UInt32_T>( indices.size() );
+
+        triangles.resize( indices.size() );
+        std::vector<UInt32_T> fill( offsets.begin(), offsets.end() - 1 );
+
+        for ( Size_T index{}; index < indices.size(); ++index ) {
+            triangles[fill[indices[index]]++] = static_cast<UInt32_T>( index / 3 );
+        }
+    }
+
+    namespace {
+        // Sum of squared distances to a set of planes, weighted by the area of their triangles (Garland and Heckbert).
+        // Upper triangle of the symmetric 4x4 matrix, in double so large meshes far from the origin keep their precision
+        struct Quadric {
+            double A00{}, A01{}, A02{}, A03{};
+            double A11{}, A12{}, A13{};
+            double A22{}, A23{};
+            double A33{};
+
+            double Weight{};
+
+            auto operator+=( const Quadric& other ) -> Quadric& {
+                A00 += other.A00; A01 += other.A01; A02 += other.A02; A03 += other.A03;
+                A11 += other.A11; A12 += other.A12; A13 += other.A13;
+                A22 += other.A22; A23 += other.A23;
+                A33 += other.A33;
+                Weight += other.Weight;
+
+                return *this;
+            }
+        };
+
+        // Half edge collapse, moves From onto To
+        struct EdgeCollapse {
+            UInt32_T From{};
+            UInt32_T To{};
+            float Cost{};
+        };
+    }
+
+    static auto MakePlaneQuadric( const glm::vec3& normal, const float distance, const float weight ) -> Quadric {
+        const double a{ normal.x };
+        const double b{ normal.y };
+        const double c{ normal.z };
+        const double d{ distance };
+        const double w{ weight };
+
+        return Quadric{
+            .A00{ w * a * a }, .A01{ w * a * b }, .A02{ w * a * c }, .A03{ w * a * d },
+            .A11{ w * b * b }, .A12{ w * b * c }, .A13{ w * b * d },
+            .A22{ w * c * c }, .A23{ w * c * d },
+            .A33{ w * d * d },
+            .Weight{ w },
+        };
+    }
+
+    // Mean squared distance from the point to the planes of the quadric
+    static auto EvaluateQuadric( const Quadric& quadric, const glm::vec3& point ) -> float {
+        if ( quadric.Weight <= 0.0 ) {
+            return 0.0f;
+        }
+
+        const double x{ point.x };
+        const double y{ point.y };
+        const double z{ point.z };
+
+        const double error{
+            quadric.A00 * x * x + 2.0 * quadric.A01 * x * y + 2.0 * quadric.A02 * x * z + 2.0 * quadric.A03 * x +
+            quadric.A11 * y * y + 2.0 * quadric.A12 * y * z + 2.0 * quadric.A13 * y +
+            quadric.A22 * z * z + 2.0 * quadric.A23 * z +
+            quadric.A33 };
+
+        return static_cast<float>( std::max( error, 0.0 ) / quadric.Weight );
+    }
+
+    /**
+     * Bounding sphere and normal cone of the triangles of a meshlet
+     * @param triangles triangles of the meshlet, as indices into the triangle list
+     * @param meshletVertices vertices the meshlet uses
+     * */
+    static auto ComputeMeshletBounds( const std::span<const UInt32_T> indices, const std::span<const float> vertices, const Size_T vertexStride,
+                                      const std::span<const UInt32_T> triangles, const std::span<const UInt32_T> meshletVertices, Meshlet& meshlet ) -> void {
+        glm::vec3 boundsMin{ std::numeric_limits<float>::max() };
+        glm::vec3 boundsMax{ std::numeric_limits<float>::lowest() };
+
+        for ( const UInt32_T vertex : meshletVertices ) {
+            boundsMin = glm::min( boundsMin, GetPosition( vertices, vertexStride, vertex ) );
+            boundsMax = glm::max( boundsMax, GetPosition( vertices, vertexStride, vertex ) );
+        }
+
+        const glm::vec3 center{ ( boundsMin + boundsMax ) * 0.5f };
+        float radius{};
+
+        for ( const UInt32_T vertex : meshletVertices ) {
+            radius = std::max( radius, glm::length( GetPosition( vertices, vertexStride, vertex ) - center ) );
+        }
+
+        meshlet.BoundingSphere = glm::vec4{ center, radius };
+
+        std::vector<glm::vec3> normals{};
+        normals.reserve( triangles.size() );
+
+        glm::vec3 axis{};
+
+        for ( const UInt32_T triangle : triangles ) {
+            const glm::vec3 p0{ GetPosition( vertices, vertexStride, indices[triangle * 3 + 0] ) };
+            const glm::vec3 p1{ GetPosition( vertices, vertexStride, indices[triangle * 3 + 1] ) };
+            const glm::vec3 p2{ GetPosition( vertices, vertexStride, indices[triangle * 3 + 2] ) };
+
+            const glm::vec3 normal{ glm::cross( p1 - p0, p2 - p0 ) };
+            const float length{ glm::length( normal ) };
+
+            // Degenerate triangles are never rasterized, they do not widen the cone
+            if ( length > 0.0f ) {
+                normals.emplace_back( normal / length );
+                axis += normals.back();
+            }
+        }
+
+        // Never culled unless every normal is less than 90 degrees away from the axis
+        meshlet.Cone = glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+        const float axisLength{ glm::length( axis ) };
+
+        if ( axisLength == 0.0f ) {
+            return;
+        }
+
+        axis /= axisLength;
+
+        float minDot{ 1.0f };
+
+        for ( const glm::vec3& normal : normals ) {
+            minDot = std::min( minDot, glm::dot( normal, axis ) );
+        }
+
+        if ( minDot > 0.0f ) {
+            // Sine of the cone angle, viewers within 90 degrees minus that angle of the axis see every triangle from behind
+            meshlet.Cone = glm::vec4{ axis, std::sqrt( 1.0f - minDot * minDot ) };
+        } else {
+            meshlet.Cone = glm::vec4{ axis, 1.0f };
+        }
+    }
+
+    auto AnalyzeVertexCache( const std::span<const UInt32_T> indices, const Size_T vertexCount, const UInt32_T cacheSize ) -> VertexCacheStatistics {
+        VertexCacheStatistics result{ .TriangleCount{ indices.size() / 3 } };
+
+        // A vertex is in the FIFO while fewer than cacheSize vertices were transformed after it
+        std::vector<UInt32_T> timestamps( vertexCount, 0 );
+        UInt32_T timestamp{ cacheSize + 1 };
+
+        for ( const UInt32_T index : indices ) {
+            if ( timestamp - timestamps[index] > cacheSize ) {
+                timestamps[index] = timestamp++;
+                ++result.VerticesTransformed;
+            }
+        }
+
+        return result;
+    }
+
+    auto OptimizeVertexCache( const std::span<UInt32_T> indices, const Size_T vertexCount ) -> void {
+        const Size_T triangleCount{ indices.size() / 3 };
+
+        if ( triangleCount == 0 ) {
+            return;
+        }
+
+        // Triangles using every vertex, the ones still to emit are kept at the front of each range
+        std::vector<UInt32_T> adjacencyOffsets{};
+        std::vector<UInt32_T> adjacency{};
+
+        BuildTriangleAdjacency( indices, vertexCount, adjacencyOffsets, adjacency );
+
+        std::vector<UInt32_T> remainingTriangles( vertexCount );
+
+        for ( Size_T vertex{}; vertex < vertexCount; ++vertex ) {
+            remainingTriangles[vertex] = adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+        }
+
+        std::vector<Int32_T> cachePositions( vertexCount, -1 );
+        std::vector<float> vertexScores( vertexCount );
+
+        for ( Size_T vertex{}; vertex < vertexCount; ++vertex ) {
+            vertexScores[vertex] = GetVertexScore( -1, remainingTriangles[vertex] );
+        }
+
+        std::vector<float> triangleScores( triangleCount );
+        std::vector<bool> emitted( triangleCount, false );
+
+        for ( Size_T triangle{}; triangle < triangleCount; ++triangle ) {
+            triangleScores[triangle] = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+        }
+
+        std::vector<UInt32_T> result( indices.size() );
+
+        // Three extra entries for the vertices pushed out by the last triangle
+        std::array<UInt32_T, FORSYTH_CACHE_SIZE + 3> cache{};
+        std::array<UInt32_T, FORSYTH_CACHE_SIZE + 3> nextCache{};
+        Size_T cacheCount{};
+
+        UInt32_T bestTriangle{ static_cast<UInt32_T>( std::distance( triangleScores.begin(), std::ranges::max_element( triangleScores ) ) ) };
+        Size_T deadEndCursor{};
+
+        for ( Size_T emittedCount{}; emittedCount < triangleCount; ++emittedCount ) {
+            // No triangle touches the cache, continue from the first one not emitted yet. Cheaper than
+            // searching the best score of the whole mesh and close enough in practice
+            if ( bestTriangle == INVALID_INDEX ) {
+                while ( emitted[deadEndCursor] ) {
+                    ++deadEndCursor;
+                }
+
+                bestTriangle = static_cast<UInt32_T>( deadEndCursor );
+            }
+
+            const std::span<const UInt32_T> triangle{ indices.subspan( bestTriangle * 3, 3 ) };
+
+            std::ranges::copy( triangle, result.begin() + static_cast<std::ptrdiff_t>( emittedCount * 3 ) );
+            emitted[bestTriangle] = true;
+
+            for ( const UInt32_T vertex : triangle ) {
+                const auto begin{ adjacency.begin() + adjacencyOffsets[vertex] };
+                const auto end{ begin + remainingTriangles[vertex] };
+
+                std::iter_swap( std::find( begin, end, bestTriangle ), end - 1 );
+                --remainingTriangles[vertex];
+            }
+
+            // The vertices of the triangle move to the front, the rest keep their order behind them
+            Size_T nextCacheCount{};
+
+            for ( const UInt32_T vertex : triangle ) {
+                if ( std::find( nextCache.begin(), nextCache.begin() + nextCacheCount, vertex ) == nextCache.begin() + nextCacheCount ) {
+                    nextCache[nextCacheCount++] = vertex;
+                }
+            }
+
+            for ( Size_T entry{}; entry < cacheCount; ++entry ) {
+                if ( std::ranges::find( triangle, cache[entry] ) == triangle.end() ) {
+                    nextCache[nextCacheCount++] = cache[entry];
+                }
+            }
+
+            // Rescore the vertices that moved or left the cache, along with the triangles using them
+            for ( Size_T entry{}; entry < nextCacheCount; ++entry ) {
+                const UInt32_T vertex{ nextCache[entry] };
+
+                cachePositions[vertex] = entry < FORSYTH_CACHE_SIZE ? static_cast<Int32_T>( entry ) : -1;
+
+                const float score{ GetVertexScore( cachePositions[vertex], remainingTriangles[vertex] ) };
+                const float scoreDelta{ score - vertexScores[vertex] };
+
+                vertexScores[vertex] = score;
+
+                for ( UInt32_T adjacent{ adjacencyOffsets[vertex] }; adjacent < adjacencyOffsets[vertex] + remainingTriangles[vertex]; ++adjacent ) {
+                    triangleScores[adjacency[adjacent]] += scoreDelta;
+                }
+            }
+
+            cacheCount = std::min<Size_T>( nextCacheCount, FORSYTH_CACHE_SIZE );
+            std::copy_n( nextCache.begin(), cacheCount, cache.begin() );
+
+            // The next triangle is the best one using a cached vertex
+            bestTriangle = INVALID_INDEX;
+            float bestScore{ std::numeric_limits<float>::lowest() };
+
+            for ( Size_T entry{}; entry < cacheCount; ++entry ) {
+                const UInt32_T vertex{ cache[entry] };
+
+                for ( UInt32_T adjacent{ adjacencyOffsets[vertex] }; adjacent < adjacencyOffsets[vertex] + remainingTriangles[vertex]; ++adjacent ) {
+                    if ( triangleScores[adjacency[adjacent]] > bestScore ) {
+                        bestScore = triangleScores[adjacency[adjacent]];
+                        bestTriangle = adjacency[adjacent];
+                    }
+                }
+            }
+        }
+
+        std::ranges::copy( result, indices.begin() );
+    }
+
+    auto OptimizeOverdraw( const std::span<UInt32_T> indices, const std::span<const float> vertices, const Size_T vertexStride, const float threshold ) -> void {
+        const Size_T triangleCount{ indices.size() / 3 };
+        const Size_T vertexCount{ vertices.size() / vertexStride };
+
+        if ( triangleCount == 0 ) {
+            return;
+        }
+
+        // FIFO simulation as in AnalyzeVertexCache(), moving the timestamp past the cache size flushes it
+        constexpr UInt32_T cacheSize{ DEFAULT_VERTEX_CACHE_SIZE };
+
+        std::vector<UInt32_T> timestamps( vertexCount, 0 );
+        UInt32_T timestamp{ cacheSize + 1 };
+
+        const auto countMisses{ [&]( const Size_T triangle ) -> UInt32_T {
+            UInt32_T misses{};
+
+            for ( Size_T corner{}; corner < 3; ++corner ) {
+                const UInt32_T index{ indices[triangle * 3 + corner] };
+
+                if ( timestamp - timestamps[index] > cacheSize ) {
+                    timestamps[index] = timestamp++;
+                    ++misses;
+                }
+            }
+
+            return misses;
+        } };
+
+        // Hard boundaries, where the cache order restarted and every vertex of the triangle missed
+        std::vector<Size_T> hardBoundaries{};
+        UInt64_T totalMisses{};
+
+        for ( Size_T triangle{}; triangle < triangleCount; ++triangle ) {
+            const UInt32_T misses{ countMisses( triangle ) };
+
+            if ( triangle == 0 || misses == 3 ) {
+                hardBoundaries.emplace_back( triangle );
+            }
+
+            totalMisses += misses;
+        }
+
+        hardBoundaries.emplace_back( triangleCount );
+
+        // Soft boundaries split a hard cluster once its own ACMR, with a cold cache, is close enough to the whole mesh
+        const float maxClusterACMR{ threshold * static_cast<float>( totalMisses ) / static_cast<float>( triangleCount ) };
+
+        std::vector<Size_T> clusterBegins{};
+
+        for ( Size_T hardCluster{}; hardCluster + 1 < hardBoundaries.size(); ++hardCluster ) {
+            const Size_T end{ hardBoundaries[hardCluster + 1] };
+
+            Size_T begin{ hardBoundaries[hardCluster] };
+            UInt32_T misses{};
+
+            clusterBegins.emplace_back( begin );
+            timestamp += cacheSize + 1;
+
+            for ( Size_T triangle{ begin }; triangle + 1 < end; ++triangle ) {
+                misses += countMisses( triangle );
+
+                if ( static_cast<float>( misses ) <= maxClusterACMR * static_cast<float>( triangle + 1 - begin ) ) {
+                    begin = triangle + 1;
+                    misses = 0;
+
+                    clusterBegins.emplace_back( begin );
+                    timestamp += cacheSize + 1;
+                }
+            }
+        }
+
+        clusterBegins.emplace_back( triangleCount );
+
+        // Area weighted centroid and normal of every cluster
+        const Size_T clusterCount{ clusterBegins.size() - 1 };
+
+        std::vector<glm::vec3> clusterCentroids( clusterCount, glm::vec3{ 0.0f } );
+        std::vector<glm::vec3> clusterNormals( clusterCount, glm::vec3{ 0.0f } );
+        std::vector<float> clusterAreas( clusterCount, 0.0f );
+
+        glm::vec3 meshCentroid{ 0.0f };
+        float meshArea{};
+
+        for ( Size_T cluster{}; cluster < clusterCount; ++cluster ) {
+            for ( Size_T triangle{ clusterBegins[cluster] }; triangle < clusterBegins[cluster + 1]; ++triangle ) {
+                const glm::vec3 p0{ GetPosition( vertices, vertexStride, indices[triangle * 3] ) };
+                const glm::vec3 p1{ GetPosition( vertices, vertexStride, indices[triangle * 3 + 1] ) };
+                const glm::vec3 p2{ GetPosition( vertices, vertexStride, indices[triangle * 3 + 2] ) };
+
+                // Twice the area, it cancels out
+                const glm::vec3 normal{ glm::cross( p1 - p0, p2 - p0 ) };
+                const float area{ glm::length( normal ) };
+
+                clusterCentroids[cluster] += ( p0 + p1 + p2 ) * ( area / 3.0f );
+                clusterNormals[cluster] += normal;
+                clusterAreas[cluster] += area;
+            }
+
+            meshCentroid += clusterCentroids[cluster];
+            meshArea += clusterAreas[cluster];
+        }
+
+        meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3{ 0.0f };
+
+        std::vector<float> sortKeys( clusterCount, 0.0f );
+
+        for ( Size_T cluster{}; cluster < clusterCount; ++cluster ) {
+            const float normalLength{ glm::length( clusterNormals[cluster] ) };
+
+            // Degenerate clusters keep a neutral key
+            if ( clusterAreas[cluster] > 0.0f && normalLength > 0.0f ) {
+                const glm::vec3 centroid{ clusterCentroids[cluster] / clusterAreas[cluster] };
+                sortKeys[cluster] = glm::dot( centroid - meshCentroid, clusterNormals[cluster] / normalLength );
+            }
+        }
+
+        std::vector<Size_T> clusterOrder( clusterCount );
+        std::iota( clusterOrder.begin(), clusterOrder.end(), Size_T{ 0 } );
+
+        std::ranges::stable_sort( clusterOrder, [&sortKeys]( const Size_T left, const Size_T right ) -> bool { return sortKeys[left] > sortKeys[right]; } );
+
+        std::vector<UInt32_T> result{};
+        result.reserve( indices.size() );
+
+        for ( const Size_T cluster : clusterOrder ) {
+            result.insert( result.end(), indices.begin() + static_cast<std::ptrdiff_t>( clusterBegins[cluster] * 3 ), indices.begin() + static_cast<std::ptrdiff_t>( clusterBegins[cluster + 1] * 3 ) );
+        }
+
+        std::ranges::copy( result, indices.begin() );
+    }
+
+    auto SimplifyMesh( const std::span<const UInt32_T> indices, const std::span<const float> vertices, const Size_T vertexStride, const Size_T targetIndexCount, const float maxError, float& resultError ) -> std::vector<UInt32_T> {
+        const Size_T vertexCount{ vertices.size() / vertexStride };
+
+        std::vector<UInt32_T> result( indices.begin(), indices.end() );
+        float resultCost{};
+
+        const auto getPosition{ [&]( const UInt32_T index ) -> glm::vec3 { return GetPosition( vertices, vertexStride, index ); } };
+
+        // Vertices sharing a position are split by their attributes, moving one of them would open the seam
+        std::vector<UInt32_T> positionIds( vertexCount );
+        std::vector<bool> locked( vertexCount, false );
+
+        {
+            const auto isLess{ [&]( const UInt32_T left, const UInt32_T right ) -> bool {
+                const glm::vec3 leftPosition{ getPosition( left ) };
+                const glm::vec3 rightPosition{ getPosition( right ) };
+
+                return std::tie( leftPosition.x, leftPosition.y, leftPosition.z ) < std::tie( rightPosition.x, rightPosition.y, rightPosition.z );
+            } };
+
+            std::vector<UInt32_T> sorted( vertexCount );
+            std::iota( sorted.begin(), sorted.end(), 0u );
+            std::ranges::sort( sorted, isLess );
+
+            for ( Size_T begin{}; begin < vertexCount; ) {
+                Size_T end{ begin + 1 };
+
+                while ( end < vertexCount && !isLess( sorted[begin], sorted[end] ) ) {
+                    ++end;
+                }
+
+                for ( Size_T index{ begin }; index < end; ++index ) {
+                    positionIds[sorted[index]] = sorted[begin];
+                    locked[sorted[index]] = end - begin > 1;
+                }
+
+                begin = end;
+            }
+        }
+
+        // Open borders and non manifold edges are kept as well, an edge there is not shared by exactly two triangles
+        {
+            std::vector<UInt64_T> edges{};
+            edges.reserve( result.size() );
+
+            for ( Size_T triangle{}; triangle < result.size() / 3; ++triangle ) {
+                for ( Size_T corner{}; corner < 3; ++corner ) {
+                    const UInt32_T first{ positionIds[result[triangle * 3 + corner]] };
+                    const UInt32_T second{ positionIds[result[triangle * 3 + ( corner + 1 ) % 3]] };
+
+                    edges.emplace_back( static_cast<UInt64_T>( std::min( first, second ) ) << 32 | std::max( first, second ) );
+                }
+            }
+
+            std::ranges::sort( edges );
+
+            for ( Size_T begin{}; begin < edges.size(); ) {
+                Size_T end{ begin + 1 };
+
+                while ( end < edges.size() && edges[end] == edges[begin] ) {
+                    ++end;
+                }
+
+                // A position on a seam is locked already, otherwise its id is its only vertex
+                if ( end - begin != 2 ) {
+                    locked[static_cast<UInt32_T>( edges[begin] >> 32 )] = true;
+                    locked[static_cast<UInt32_T>( edges[begin] & 0xFFFFFFFF )] = true;
+                }
+
+                begin = end;
+            }
+        }
+
+        std::vector<Quadric> quadrics( vertexCount );
+
+        for ( Size_T triangle{}; triangle < result.size() / 3; ++triangle ) {
+            const glm::vec3 p0{ getPosition( result[triangle * 3] ) };
+            const glm::vec3 normal{ glm::cross( getPosition( result[triangle * 3 + 1] ) - p0, getPosition( result[triangle * 3 + 2] ) - p0 ) };
+            const float length{ glm::length( normal ) };
+
+            if ( length > 0.0f ) {
+                const glm::vec3 unitNormal{ normal / length };
+                const Quadric plane{ MakePlaneQuadric( unitNormal, -glm::dot( unitNormal, p0 ), length * 0.5f ) };
+
+                for ( Size_T corner{}; corner < 3; ++corner ) {
+                    quadrics[result[triangle * 3 + corner]] += plane;
+                }
+            }
+        }
+
+        const auto getCollapseCost{ [&]( const UInt32_T from, const UInt32_T to ) -> float {
+            Quadric merged{ quadrics[from] };
+            merged += quadrics[to];
+
+            return EvaluateQuadric( merged, getPosition( to ) );
+        } };
+
+        const float maxCost{ maxError * maxError };
+
+        std::vector<UInt32_T> adjacencyOffsets{};
+        std::vector<UInt32_T> adjacency{};
+        std::vector<EdgeCollapse> collapses{};
+        std::vector<UInt32_T> remap( vertexCount );
+        std::vector<bool> touched( vertexCount );
+
+        // Every pass collapses the cheapest edges whose vertices were not touched by another collapse of the same pass,
+        // so the adjacency and the flip tests stay valid until the indices are rebuilt
+        while ( result.size() > targetIndexCount ) {
+            const Size_T triangleCount{ result.size() / 3 };
+
+            BuildTriangleAdjacency( result, vertexCount, adjacencyOffsets, adjacency );
+
+            collapses.clear();
+
+            for ( Size_T triangle{}; triangle < triangleCount; ++triangle ) {
+                for ( Size_T corner{}; corner < 3; ++corner ) {
+                    const UInt32_T first{ result[triangle * 3 + corner] };
+                    const UInt32_T second{ result[triangle * 3 + ( corner + 1 ) % 3] };
+
+                    if ( !locked[first] ) {
+                        collapses.emplace_back( EdgeCollapse{ .From{ first }, .To{ second }, .Cost{ getCollapseCost( first, second ) } } );
+                    }
+
+                    if ( !locked[second] ) {
+                        collapses.emplace_back( EdgeCollapse{ .From{ second }, .To{ first }, .Cost{ getCollapseCost( second, first ) } } );
+                    }
+                }
+            }
+
+            std::ranges::sort( collapses, {}, &EdgeCollapse::Cost );
+
+            std::iota( remap.begin(), remap.end(), 0u );
+            touched.assign( vertexCount, false );
+
+            Size_T removedTriangles{};
+            bool collapsed{ false };
+
+            for ( const EdgeCollapse& collapse : collapses ) {
+                if ( collapse.Cost > maxCost || ( triangleCount - removedTriangles ) * 3 <= targetIndexCount ) {
+                    break;
+                }
+
+                if ( touched[collapse.From] || touched[collapse.To] || collapse.From == collapse.To ) {
+                    continue;
+                }
+
+                // The triangles left around From must not flip nor fold over
+                bool isValid{ true };
+                Size_T collapsedTriangles{};
+
+                for ( UInt32_T adjacent{ adjacencyOffsets[collapse.From] }; adjacent < adjacencyOffsets[collapse.From + 1] && isValid; ++adjacent ) {
+                    const UInt32_T* triangle{ result.data() + adjacency[adjacent] * 3 };
+
+                    if ( triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To ) {
+                        ++collapsedTriangles;
+                        continue;
+                    }
+
+                    const glm::vec3 p0{ getPosition( triangle[0] ) };
+                    const glm::vec3 p1{ getPosition( triangle[1] ) };
+                    const glm::vec3 p2{ getPosition( triangle[2] ) };
+
+                    const glm::vec3 q0{ triangle[0] == collapse.From ? getPosition( collapse.To ) : p0 };
+                    const glm::vec3 q1{ triangle[1] == collapse.From ? getPosition( collapse.To ) : p1 };
+                    const glm::vec3 q2{ triangle[2] == collapse.From ? getPosition( collapse.To ) : p2 };
+
+                    const glm::vec3 normal{ glm::cross( p1 - p0, p2 - p0 ) };
+                    const glm::vec3 collapsedNormal{ glm::cross( q1 - q0, q2 - q0 ) };
+
+                    isValid = glm::dot( normal, collapsedNormal ) > 0.25f * glm::length( normal ) * glm::length( collapsedNormal );
+                }
+
+                if ( !isValid ) {
+                    continue;
+                }
+
+                remap[collapse.From] = collapse.To;
+                quadrics[collapse.To] += quadrics[collapse.From];
+
+                for ( UInt32_T adjacent{ adjacencyOffsets[collapse.From] }; adjacent < adjacencyOffsets[collapse.From + 1]; ++adjacent ) {
+                    for ( Size_T corner{}; corner < 3; ++corner ) {
+                        touched[result[adjacency[adjacent] * 3 + corner]] = true;
+                    }
+                }
+
+                removedTriangles += collapsedTriangles;
+                resultCost = std::max( resultCost, collapse.Cost );
+                collapsed = true;
+            }
+
+            if ( !collapsed ) {
+                break;
+            }
+
+            // Triangles left without area by the collapses are dropped
+            Size_T writeIndex{};
+
+            for ( Size_T triangle{}; triangle < triangleCount; ++triangle ) {
+                const UInt32_T a{ remap[result[triangle * 3]] };
+                const UInt32_T b{ remap[result[triangle * 3 + 1]] };
+                const UInt32_T c{ remap[result[triangle * 3 + 2]] };
+
+                if ( a != b && b != c && a != c ) {
+                    result[writeIndex++] = a;
+                    result[writeIndex++] = b;
+                    result[writeIndex++] = c;
+                }
+            }
+
+            result.resize( writeIndex );
+        }
+
+        resultError = std::sqrt( resultCost );
+
+        return result;
+    }
+
+    auto BuildMeshlets( const std::span<UInt32_T> indices, const std::span<const float> vertices, const Size_T vertexStride, const UInt32_T maxVertices, const UInt32_T maxTriangles ) -> std::vector<Meshlet> {
+        const Size_T vertexCount{ vertices.size() / vertexStride };
+        const auto triangleCount{ static_cast<UInt32_T>( indices.size() / 3 ) };
+
+        std::vector<UInt32_T> adjacencyOffsets{};
+        std::vector<UInt32_T> adjacencyTriangles{};
+        BuildTriangleAdjacency( indices, vertexCount, adjacencyOffsets, adjacencyTriangles );
+
+        std::vector<glm::vec3> centroids( triangleCount );
+
+        for ( UInt32_T triangle{}; triangle < triangleCount; ++triangle ) {
+            centroids[triangle] = ( GetPosition( vertices, vertexStride, indices[triangle * 3 + 0] ) +
+                                    GetPosition( vertices, vertexStride, indices[triangle * 3 + 1] ) +
+                                    GetPosition( vertices, vertexStride, indices[triangle * 3 + 2] ) ) / 3.0f;
+        }
+
+        std::vector<bool> emitted( triangleCount, false );
+
+        // Meshlet that last took each vertex, a triangle only costs the vertices the current meshlet does not have yet
+        std::vector<UInt32_T> vertexMeshlet( vertexCount, INVALID_INDEX );
+
+        std::vector<Meshlet> meshlets{};
+        std::vector<UInt32_T> result{};
+        result.reserve( indices.size() );
+
+        std::vector<UInt32_T> meshletTriangles{};
+        std::vector<UInt32_T> meshletVertices{};
+        std::vector<UInt32_T> candidates{};
+
+        // First triangle not emitted yet, seeds the meshlets in the order of the list
+        UInt32_T cursor{};
+
+        while ( true ) {
+            while ( cursor < triangleCount && emitted[cursor] ) {
+                ++cursor;
+            }
+
+            if ( cursor == triangleCount ) {
+                break;
+            }
+
+            const auto meshletIndex{ static_cast<UInt32_T>( meshlets.size() ) };
+
+            meshletTriangles.clear();
+            meshletVertices.clear();
+            candidates.clear();
+
+            glm::vec3 centroidSum{};
+
+            const auto countNewVertices{ [&]( const UInt32_T triangle ) -> UInt32_T {
+                const UInt32_T a{ indices[triangle * 3 + 0] };
+                const UInt32_T b{ indices[triangle * 3 + 1] };
+                const UInt32_T c{ indices[triangle * 3 + 2] };
+
+                UInt32_T count{ vertexMeshlet[a] != meshletIndex ? 1u : 0u };
+                count += vertexMeshlet[b] != meshletIndex && b != a ? 1 : 0;
+                count += vertexMeshlet[c] != meshletIndex && c != a && c != b ? 1 : 0;
+
+                return count;
+            } };
+
+            const auto addTriangle{ [&]( const UInt32_T triangle ) -> void {
+                emitted[triangle] = true;
+                meshletTriangles.emplace_back( triangle );
+                centroidSum += centroids[triangle];
+
+                for ( UInt32_T corner{}; corner < 3; ++corner ) {
+                    const UInt32_T vertex{ indices[triangle * 3 + corner] };
+
+                    if ( vertexMeshlet[vertex] == meshletIndex ) {
+                        continue;
+                    }
+
+                    vertexMeshlet[vertex] = meshletIndex;
+                    meshletVertices.emplace_back( vertex );
+
+                    for ( UInt32_T adjacency{ adjacencyOffsets[vertex] }; adjacency < adjacencyOffsets[vertex + 1]; ++adjacency ) {
+                        if ( !emitted[adjacencyTriangles[adjacency]] ) {
+                            candidates.emplace_back( adjacencyTriangles[adjacency] );
+                        }
+                    }
+                }
+            } };
+
+            addTriangle( cursor );
+
+            while ( meshletTriangles.size() < maxTriangles ) {
+                const glm::vec3 centroid{ centroidSum / static_cast<float>( meshletTriangles.size() ) };
+
+                UInt32_T best{ INVALID_INDEX };
+                UInt32_T bestNewVertices{ std::numeric_limits<UInt32_T>::max() };
+                float bestDistance{ std::numeric_limits<float>::max() };
+
+                // Candidates taken since they were listed are dropped on the way
+                Size_T keptCount{};
+
+                for ( const UInt32_T candidate : candidates ) {
+                    if ( emitted[candidate] ) {
+                        continue;
+                    }
+
+                    candidates[keptCount++] = candidate;
+
+                    const UInt32_T newVertices{ countNewVertices( candidate ) };
+
+                    if ( meshletVertices.size() + newVertices > maxVertices ) {
+                        continue;
+                    }
+
+                    const glm::vec3 offset{ centroids[candidate] - centroid };
+                    const float distance{ glm::dot( offset, offset ) };
+
+                    if ( newVertices < bestNewVertices || ( newVertices == bestNewVertices && distance < bestDistance ) ) {
+                        best = candidate;
+                        bestNewVertices = newVertices;
+                        bestDistance = distance;
+                    }
+                }
+
+                candidates.resize( keptCount );
+
+                // Disconnected pieces, like the leaves of a plant, would otherwise end up in meshlets of a couple triangles
+                if ( best == INVALID_INDEX ) {
+                    while ( cursor < triangleCount && emitted[cursor] ) {
+                        ++cursor;
+                    }
+
+                    if ( cursor < triangleCount && meshletVertices.size() + countNewVertices( cursor ) <= maxVertices ) {
+                        best = cursor;
+                    }
+                }
+
+                if ( best == INVALID_INDEX ) {
+                    break;
+                }
+
+                addTriangle( best );
+            }
+
+            // Same relative order as in the input, the cache optimization mostly survives
+            std::ranges::sort( meshletTriangles );
+
+            Meshlet& meshlet{ meshlets.emplace_back( Meshlet{
+                .FirstIndex{ static_cast<UInt32_T>( result.size() ) },
+                .IndexCount{ static_cast<UInt32_T>( meshletTriangles.size() * 3 ) },
+                .VertexCount{ static_cast<UInt32_T>( meshletVertices.size() ) },
+            } ) };
+
+            ComputeMeshletBounds( indices, vertices, vertexStride, meshletTriangles, meshletVertices, meshlet );
+
+            for ( const UInt32_T triangle : meshletTriangles ) {
+                result.insert( result.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3 );
+            }
+        }
+
+        std::ranges::copy( result, indices.begin() );
+
+        return meshlets;
+    }
+
+    auto OptimizeVertexFetch( const std::span<UInt32_T> indices, const std::span<float> vertices, const Size_T vertexStride ) -> Size_T {
+        const Size_T vertexCount{ vertices.size() / vertexStride };
+
+        // New index of every vertex, by first use
+        std::vector<UInt32_T> remap( vertexCount, INVALID_INDEX );
+        UInt32_T usedCount{};
+
+        for ( UInt32_T& index : indices ) {
+            if ( remap[index] == INVALID_INDEX ) {
+                remap[index] = usedCount++;
+            }
+
+            index = remap[index];
+        }
+
+        std::vector<float> result( usedCount * vertexStride );
+
+        for ( Size_T vertex{}; vertex < vertexCount; ++vertex ) {
+            if ( remap[vertex] != INVALID_INDEX ) {
+                std::copy_n( vertices.begin() + static_cast<std::ptrdiff_t>( vertex * vertexStride ), vertexStride, result.begin() + static_cast<std::ptrdiff_t>( remap[vertex] * vertexStride ) );
+            }
+        }
+
+        std::ranges::copy( result, vertices.begin() );
+
+        return usedCount;
+    }
+}
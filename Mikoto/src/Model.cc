@@ -4,9 +4,20 @@
  * */
 
 // C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <filesystem>
+#include <mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Third Party Libraries
@@ -14,31 +25,280 @@
 #include <assimp/scene.h>
 
 #include <assimp/Importer.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
 
 // Project Headers
 #include <Assets//Mesh.hh>
+#include <Assets/MeshCooker.hh>
 #include <Assets/Model.hh>
 #include <Common/Common.hh>
+#include <Core/Engine.hh>
 #include <Core/Logging/Logger.hh>
 #include <Core/System/AssetsSystem.hh>
+#include <Core/System/TaskSystem.hh>
 #include <Library/Filesystem/PathBuilder.hh>
+#include <Library/Mesh/MeshOptimizer.hh>
 #include <Library/String/String.hh>
 #include <Library/Utility/Types.hh>
+#include <Material/Texture/TextureCooker.hh>
 
 #include "Renderer/Buffer/IndexBuffer.hh"
 #include "Renderer/Buffer/VertexBuffer.hh"
 
 namespace Mikoto {
+    // Textures loaded for the material of every mesh, in the order they are added to the mesh
+    static constexpr std::array MODEL_TEXTURE_TYPES{
+        std::pair{ aiTextureType_DIFFUSE, MapType::TEXTURE_2D_DIFFUSE },
+        std::pair{ aiTextureType_SPECULAR, MapType::TEXTURE_2D_SPECULAR },
+        std::pair{ aiTextureType_NORMALS, MapType::TEXTURE_2D_NORMAL },
+        std::pair{ aiTextureType_EMISSIVE, MapType::TEXTURE_2D_EMISSIVE },
+        std::pair{ aiTextureType_METALNESS, MapType::TEXTURE_2D_ROUGHNESS },
+        std::pair{ aiTextureType_DIFFUSE_ROUGHNESS, MapType::TEXTURE_2D_METALLIC },
+        std::pair{ aiTextureType_AMBIENT_OCCLUSION, MapType::TEXTURE_2D_AMBIENT_OCCLUSION },
+    };
+
+    // Floats per vertex written by Model::ProcessMesh(), the default buffer layout
+    static constexpr Size_T FLOAT32_VERTEX_FLOAT_COUNT{ 11 };
+
+    // Triangles kept by each level of detail after the full one, relative to the full mesh
+    static constexpr std::array LOD_TRIANGLE_RATIOS{ 0.5f, 0.25f, 0.125f };
+    static_assert( LOD_TRIANGLE_RATIOS.size() < MAX_MESH_LODS );
+
+    // Meshes this small are cheaper to draw than to switch
+    static constexpr Size_T MIN_LOD_TRIANGLE_COUNT{ 256 };
+
+    // A level that keeps more of the triangles of the previous one than this is not worth having
+    static constexpr float MAX_LOD_TRIANGLE_SHARE{ 0.8f };
+
+    // Furthest the surface of a level may move, relative to the bounding radius of the mesh
+    static constexpr float MAX_LOD_RELATIVE_ERROR{ 0.25f };
+
+    // Maps a unit vector to the [-1, 1] square, the shaders decode it with DecodeOctahedral()
+    static auto EncodeOctahedral( const glm::vec3& normal ) -> glm::vec2 {
+        const float sum{ std::abs( normal.x ) + std::abs( normal.y ) + std::abs( normal.z ) };
+
+        if ( sum == 0.0f ) {
+            return glm::vec2{ 0.0f };
+        }
+
+        const glm::vec3 projected{ normal / sum };
+
+        // The lower hemisphere is folded over the diagonals
+        if ( projected.z < 0.0f ) {
+            return glm::vec2{
+                ( 1.0f - std::abs( projected.y ) ) * ( projected.x >= 0.0f ? 1.0f : -1.0f ),
+                ( 1.0f - std::abs( projected.x ) ) * ( projected.y >= 0.0f ? 1.0f : -1.0f ) };
+        }
+
+        return glm::vec2{ projected.x, projected.y };
+    }
+
+    // A flat range maps every value to its offset
+    static auto GetInverseScale( const float scale ) -> float {
+        return scale > 0.0f ? 1.0f / scale : 0.0f;
+    }
+
+    /**
+     * Stores vertices in the default buffer layout in the given format
+     * @param vertices FLOAT32_VERTEX_FLOAT_COUNT floats per vertex
+     * @param format layout of the stored vertices
+     * @param meshData receives the vertices and their dequantization, its bounds must be set
+     * */
+    static auto EncodeVertices( const std::span<const float> vertices, const VertexFormat format, ModelMeshData& meshData ) -> void {
+        if ( format == VertexFormat::FLOAT32 ) {
+            const UInt8_T* bytes{ reinterpret_cast<const UInt8_T*>( vertices.data() ) };
+
+            meshData.Vertices.assign( bytes, bytes + vertices.size_bytes() );
+            meshData.Dequantization = VertexDequantization{};
+            return;
+        }
+
+        const Size_T vertexCount{ vertices.size() / FLOAT32_VERTEX_FLOAT_COUNT };
+
+        glm::vec2 texCoordMin{ std::numeric_limits<float>::max() };
+        glm::vec2 texCoordMax{ std::numeric_limits<float>::lowest() };
+
+        for ( Size_T vertex{}; vertex < vertexCount; ++vertex ) {
+            const float* source{ vertices.data() + vertex * FLOAT32_VERTEX_FLOAT_COUNT };
+
+            texCoordMin = glm::min( texCoordMin, glm::vec2{ source[9], source[10] } );
+            texCoordMax = glm::max( texCoordMax, glm::vec2{ source[9], source[10] } );
+        }
+
+        // Positions are stored in [-1, 1] around the center of the bounds, texture coordinates in [0, 1] of their range
+        VertexDequantization& dequantization{ meshData.Dequantization };
+        dequantization.PositionScale = ( meshData.BoundsMax - meshData.BoundsMin ) * 0.5f;
+        dequantization.PositionOffset = ( meshData.BoundsMax + meshData.BoundsMin ) * 0.5f;
+        dequantization.TexCoordScale = vertexCount != 0 ? texCoordMax - texCoordMin : glm::vec2{ 1.0f };
+        dequantization.TexCoordOffset = vertexCount != 0 ? texCoordMin : glm::vec2{ 0.0f };
+
+        const glm::vec3 positionInverseScale{
+            GetInverseScale( dequantization.PositionScale.x ),
+            GetInverseScale( dequantization.PositionScale.y ),
+            GetInverseScale( dequantization.PositionScale.z ) };
+
+        const glm::vec2 texCoordInverseScale{
+            GetInverseScale( dequantization.TexCoordScale.x ),
+            GetInverseScale( dequantization.TexCoordScale.y ) };
+
+        const BufferLayout& layout{ VertexBuffer::GetBufferLayout( VertexFormat::COMPACT ) };
+        const UInt32_T stride{ layout.GetStride() };
+
+        meshData.Vertices.resize( vertexCount * stride );
+
+        for ( Size_T vertex{}; vertex < vertexCount; ++vertex ) {
+            const float* source{ vertices.data() + vertex * FLOAT32_VERTEX_FLOAT_COUNT };
+            UInt8_T* destination{ meshData.Vertices.data() + vertex * stride };
+
+            const glm::vec3 position{ ( glm::vec3{ source[0], source[1], source[2] } - dequantization.PositionOffset ) * positionInverseScale };
+            const glm::vec2 texCoord{ ( glm::vec2{ source[9], source[10] } - dequantization.TexCoordOffset ) * texCoordInverseScale };
+
+            const UInt64_T packedPosition{ glm::packSnorm4x16( glm::vec4{ position, 0.0f } ) };
+            const UInt32_T packedNormal{ glm::packSnorm2x16( EncodeOctahedral( glm::vec3{ source[3], source[4], source[5] } ) ) };
+            const UInt32_T packedColor{ glm::packUnorm4x8( glm::vec4{ source[6], source[7], source[8], 1.0f } ) };
+            const UInt32_T packedTexCoord{ glm::packUnorm2x16( texCoord ) };
+
+            // Same order as the compact buffer layout
+            std::memcpy( destination + layout[0].GetOffset(), std::addressof( packedPosition ), sizeof( packedPosition ) );
+            std::memcpy( destination + layout[1].GetOffset(), std::addressof( packedNormal ), sizeof( packedNormal ) );
+            std::memcpy( destination + layout[2].GetOffset(), std::addressof( packedColor ), sizeof( packedColor ) );
+            std::memcpy( destination + layout[3].GetOffset(), std::addressof( packedTexCoord ), sizeof( packedTexCoord ) );
+        }
+    }
+
+    /**
+     * Calls the function for every index in [0, count) on the TaskSystem workers and waits for those jobs only,
+     * the calling thread runs the ones still queued. Safe from the model loader thread
+     * @throws the first exception thrown by the function, once every job finished
+     * */
+    static auto ParallelFor( const Size_T count, const std::function<void( Size_T )>& function ) -> void {
+        TaskSystem& taskSystem{ Engine::GetSystem<TaskSystem>() };
+        TaskSystem::JobCounter jobs{};
+
+        std::exception_ptr exception{};
+        std::mutex exceptionMutex{};
+
+        taskSystem.Dispatch( static_cast<UInt32_T>( count ), 1, [&]( const TaskSystem::JobDispatchArgs args ) -> void {
+            try {
+                function( args.JobIndex );
+            } catch ( ... ) {
+                std::scoped_lock lock{ exceptionMutex };
+
+                if ( exception == nullptr ) {
+                    exception = std::current_exception();
+                }
+            }
+        }, jobs );
+
+        taskSystem.Wait( jobs );
+
+        if ( exception != nullptr ) {
+            std::rethrow_exception( exception );
+        }
+    }
+
+    /**
+     * Simplifies the mesh into coarser levels of detail and appends their indices after the full ones
+     * @param vertices FLOAT32_VERTEX_FLOAT_COUNT floats per vertex
+     * @param meshData holds the indices of the full mesh, its bounds must be set. Receives the levels of detail
+     * */
+    static auto GenerateLods( const std::span<const float> vertices, ModelMeshData& meshData ) -> void {
+        const Size_T vertexCount{ vertices.size() / FLOAT32_VERTEX_FLOAT_COUNT };
+        const Size_T fullIndexCount{ meshData.Indices.size() };
+
+        meshData.Lods.assign( 1, MeshLod{ .FirstIndex{ 0 }, .IndexCount{ static_cast<UInt32_T>( fullIndexCount ) } } );
+
+        if ( fullIndexCount / 3 < MIN_LOD_TRIANGLE_COUNT ) {
+            return;
+        }
+
+        const float maxError{ glm::length( meshData.BoundsMax - meshData.BoundsMin ) * 0.5f * MAX_LOD_RELATIVE_ERROR };
+
+        // Every level comes from the full mesh, so its error is measured against it
+        for ( const float ratio : LOD_TRIANGLE_RATIOS ) {
+            const Size_T targetIndexCount{ static_cast<Size_T>( static_cast<float>( fullIndexCount / 3 ) * ratio ) * 3 };
+            const std::span<const UInt32_T> fullIndices{ meshData.Indices.data(), fullIndexCount };
+
+            float error{};
+            std::vector<UInt32_T> lodIndices{ MeshOptimizer::SimplifyMesh( fullIndices, vertices, FLOAT32_VERTEX_FLOAT_COUNT, targetIndexCount, maxError, error ) };
+
+            // The simplification stopped at the error bound, further levels would stop there as well
+            if ( lodIndices.empty() || static_cast<float>( lodIndices.size() ) > static_cast<float>( meshData.Lods.back().IndexCount ) * MAX_LOD_TRIANGLE_SHARE ) {
+                break;
+            }
+
+            MeshOptimizer::OptimizeVertexCache( lodIndices, vertexCount );
+
+            meshData.Lods.emplace_back( MeshLod{
+                .FirstIndex{ static_cast<UInt32_T>( meshData.Indices.size() ) },
+                .IndexCount{ static_cast<UInt32_T>( lodIndices.size() ) },
+                .Error{ error },
+            } );
+
+            meshData.Indices.insert( meshData.Indices.end(), lodIndices.begin(), lodIndices.end() );
+        }
+    }
+
+    /**
+     * Splits every level of detail in meshlets, their triangles are reordered within the level
+     * @param vertices FLOAT32_VERTEX_FLOAT_COUNT floats per vertex
+     * @param meshData holds the indices and the levels of detail. Receives the meshlets
+     * */
+    static auto GenerateMeshlets( const std::span<const float> vertices, ModelMeshData& meshData ) -> void {
+        meshData.Meshlets.clear();
+
+        for ( MeshLod& lod : meshData.Lods ) {
+            const std::span<UInt32_T> lodIndices{ meshData.Indices.data() + lod.FirstIndex, lod.IndexCount };
+
+            lod.FirstMeshlet = static_cast<UInt32_T>( meshData.Meshlets.size() );
+
+            for ( MeshOptimizer::Meshlet& meshlet : MeshOptimizer::BuildMeshlets( lodIndices, vertices, FLOAT32_VERTEX_FLOAT_COUNT ) ) {
+                meshlet.FirstIndex += lod.FirstIndex;
+                meshData.Meshlets.emplace_back( meshlet );
+            }
+
+            lod.MeshletCount = static_cast<UInt32_T>( meshData.Meshlets.size() ) - lod.FirstMeshlet;
+        }
+    }
+
     Model::Model( const ModelLoadInfo &info )
-        : m_ModelAbsolutePath{ info.Path }, m_ModelName{ info.Path.stem().string() }, m_InvertedY{ info.InvertedY } {
-        Load( info.WantTextures );
+        : Model{ *Import( info, false ) } {
     }
 
-    auto Model::Load( const bool wantLoadTextures ) -> void {
-        if ( !m_ModelAbsolutePath.has_filename() ) {
-            MKT_THROW_RUNTIME_ERROR( "Model::Load - Not valid path for model object" );
+    Model::Model( ModelData &data )
+        : m_ModelAbsolutePath{ data.Info.Path }, m_ModelName{ data.Info.Path.stem().string() }, m_InvertedY{ data.Info.InvertedY } {
+        Load( data );
+    }
+
+    auto Model::Import( const ModelLoadInfo& info, const bool decodeTextures ) -> Scope_T<ModelData> {
+        if ( !info.Path.has_filename() ) {
+            MKT_THROW_RUNTIME_ERROR( "Model::Import - Not valid path for model object" );
+        }
+
+        // Cooked on the first import, later ones skip Assimp
+        Scope_T<ModelData> data{ MeshCooker::Load( info ) };
+
+        if ( data == nullptr ) {
+            data = ImportSource( info );
+
+            try {
+                MKT_UNUSED_VAR const Size_T cookedSize{ MeshCooker::Write( *data ) };
+                MKT_CORE_LOGGER_INFO( "Model::Import - Cooked [{}] to {} bytes", info.Path.string(), cookedSize );
+            } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+                MKT_CORE_LOGGER_WARN( "Model::Import - Model will not be cooked. {}", exception.what() );
+            }
         }
 
+        if ( decodeTextures && info.WantTextures ) {
+            // In parallel, as for the textures of a model loaded synchronously
+            data->DecodedTextures = AssetsSystem::DecodeTextures( data->Textures );
+        }
+
+        return data;
+    }
+
+    auto Model::ImportSource( const ModelLoadInfo& info ) -> Scope_T<ModelData> {
         Assimp::Importer importer{};
 
         // See more postprocessing options: https://assimp.sourceforge.net/lib_html/postprocess_8h.html
@@ -47,44 +307,121 @@ namespace Mikoto {
                                                                        aiProcess_GenSmoothNormals |
                                                                        aiProcess_JoinIdenticalVertices ) };
 
-        const auto scene{ importer.ReadFile( m_ModelAbsolutePath.string(), importerFlags ) };
+        const auto scene{ importer.ReadFile( info.Path.string(), importerFlags ) };
 
         if ( scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "Model::Load - Failed to load model: '{}'", importer.GetErrorString() ) );
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "Model::ImportSource - Failed to load model: '{}'", importer.GetErrorString() ) );
         }
 
-        m_Meshes.reserve( scene->mRootNode->mNumMeshes );
+        auto data{ CreateScope<ModelData>() };
+        data->Info = info;
+        data->Meshes.reserve( scene->mNumMeshes );
 
         // Contains the model's directory. Since substr will not engine the ast character in the range,
         // this variable does not engine the last slash of the path string
-        auto modelDirectory{ m_ModelAbsolutePath };
+        auto modelDirectory{ info.Path };
         modelDirectory.remove_filename();
         const Path_T modelDirectoryFormatted{ modelDirectory.string().substr( 0, modelDirectory.string().find_last_of( '/' ) ) };
 
-        ProcessNode( scene->mRootNode, scene, modelDirectoryFormatted, wantLoadTextures );
+        std::vector<const aiMesh*> meshes{};
+        ProcessNode( scene->mRootNode, scene, meshes );
+
+        // The meshes only read the scene, their processing and optimization run in parallel
+        std::vector<MeshOptimizer::VertexCacheStatistics> cacheBefore( meshes.size() );
+        std::vector<MeshOptimizer::VertexCacheStatistics> cacheAfter( meshes.size() );
+
+        data->Meshes.resize( meshes.size() );
+
+        ParallelFor( meshes.size(), [&]( const Size_T index ) -> void {
+            data->Meshes[index] = ProcessMesh( meshes[index], info, cacheBefore[index], cacheAfter[index] );
+        } );
+
+        MeshOptimizer::VertexCacheStatistics modelCacheBefore{};
+        MeshOptimizer::VertexCacheStatistics modelCacheAfter{};
+
+        // Textures are shared between the meshes, they are listed in mesh order
+        for ( Size_T index{}; index < meshes.size(); ++index ) {
+            ProcessMaterial( meshes[index], scene, modelDirectoryFormatted, *data, data->Meshes[index] );
+
+            modelCacheBefore += cacheBefore[index];
+            modelCacheAfter += cacheAfter[index];
+        }
+
+        MKT_CORE_LOGGER_INFO( "Model::ImportSource - Optimized [{}] for the vertex cache, ACMR {:.3f} -> {:.3f}",
+            info.Path.string(), modelCacheBefore.GetACMR(), modelCacheAfter.GetACMR() );
+
+        return data;
     }
 
-    auto Model::ProcessNode( const aiNode* root, const aiScene* scene, const Path_T& modelDirectory, const bool wantLoadTextures ) -> void {
-        // Process all the meshes from this node
-        for ( UInt64_T indexMesh{}; indexMesh < root->mNumMeshes; indexMesh++ ) {
-            Scope_T<Mesh> result{ std::move(ProcessMesh( scene->mMeshes[root->mMeshes[indexMesh]], scene, modelDirectory, wantLoadTextures ) ) };
+    auto Model::Load( ModelData& data ) -> void {
+        AssetsSystem& assetsSystem{ Engine::GetSystem<AssetsSystem>() };
+
+        // Same order as data.Textures
+        std::vector<Texture*> textures{};
 
-            m_TotalVertices += result->GetVertexBuffer()->GetCount();
-            m_TotalIndices += result->GetIndexBuffer()->GetCount();
+        if ( !data.DecodedTextures.empty() ) {
+            textures.reserve( data.Textures.size() );
+
+            for ( Size_T index{}; index < data.Textures.size(); ++index ) {
+                textures.emplace_back( data.DecodedTextures[index] != nullptr ? assetsSystem.LoadTexture( data.Textures[index], *data.DecodedTextures[index] ) : nullptr );
+            }
+        } else if ( data.Info.WantTextures ) {
+            // Decoded on the workers, instead of one after another
+            textures = assetsSystem.LoadTextures( data.Textures );
+        }
+
+        m_Meshes.reserve( data.Meshes.size() );
+
+        for ( ModelMeshData& meshData : data.Meshes ) {
+            std::vector<Texture2D*> meshTextures{};
+
+            for ( const Size_T textureIndex : meshData.TextureIndices ) {
+                if ( textureIndex < textures.size() && textures[textureIndex] != nullptr ) {
+                    meshTextures.emplace_back( dynamic_cast<Texture2D*>( textures[textureIndex] ) );
+                }
+            }
+
+            // Shared with the meshes already loaded that have the same geometry
+            MeshBuffers buffers{ assetsSystem.LoadMeshBuffers( meshData, data.Info.Format ) };
+
+            Scope_T<Mesh> mesh{ CreateScope<Mesh>(
+                    meshData.Name,
+                    std::move( buffers.Vertices ),
+                    std::move( buffers.Indices ),
+                    std::move( meshTextures ),
+                    m_ModelAbsolutePath,
+                    std::vector<MeshLod>{ meshData.Lods },
+                    std::vector<MeshOptimizer::Meshlet>{ meshData.Meshlets } ) };
+
+            m_TotalVertices += mesh->GetVertexBuffer()->GetCount();
+
+            // Only the full level of detail, the others draw a subset of it
+            m_TotalIndices += mesh->GetLods().front().IndexCount;
+
+            m_Meshes.emplace_back( std::move( mesh ) );
+        }
+    }
 
-            m_Meshes.emplace_back( std::move( result ) );
+    auto Model::ProcessNode( const aiNode* root, const aiScene* scene, std::vector<const aiMesh*>& meshes ) -> void {
+        // Gather all the meshes from this node
+        for ( UInt64_T indexMesh{}; indexMesh < root->mNumMeshes; indexMesh++ ) {
+            meshes.emplace_back( scene->mMeshes[root->mMeshes[indexMesh]] );
         }
 
         // then do the same for each of its children
         for ( UInt64_T indexChildNode{}; indexChildNode < root->mNumChildren; indexChildNode++ ) {
-            ProcessNode( root->mChildren[indexChildNode], scene, modelDirectory, wantLoadTextures );
+            ProcessNode( root->mChildren[indexChildNode], scene, meshes );
         }
     }
 
-    auto Model::ProcessMesh( const aiMesh* mesh, const aiScene* scene, const Path_T& modelDirectory, const bool wantLoadTextures ) const -> Scope_T<Mesh> {
+    auto Model::ProcessMesh( const aiMesh* mesh, const ModelLoadInfo& info, MeshOptimizer::VertexCacheStatistics& cacheBefore, MeshOptimizer::VertexCacheStatistics& cacheAfter ) -> ModelMeshData {
+        ModelMeshData result{ .Name{ mesh->mName.C_Str() } };
+
+        // Built in the default buffer layout, then stored in the requested format
         std::vector<float> vertices{};
-        std::vector<UInt32_T> indices{};
-        std::vector<Texture2D*> textures{};
+        std::vector<UInt32_T>& indices{ result.Indices };
+
+        vertices.reserve( mesh->mNumVertices * FLOAT32_VERTEX_FLOAT_COUNT );
 
         // The way we construct the vertex buffer data is not guaranteed to follow
         // the buffer layout, which is default for Models. Which means if the mesh
@@ -126,7 +463,7 @@ namespace Mikoto {
             if ( mesh->mTextureCoords[0] != nullptr ) {
                 vertices.push_back( mesh->mTextureCoords[0][index].x );
 
-                vertices.push_back( m_InvertedY ? -mesh->mTextureCoords[0][index].y : mesh->mTextureCoords[0][index].y );
+                vertices.push_back( info.InvertedY ? -mesh->mTextureCoords[0][index].y : mesh->mTextureCoords[0][index].y );
             } else {
                 vertices.emplace_back( 0.0f );
                 vertices.emplace_back( 0.0f );
@@ -139,89 +476,103 @@ namespace Mikoto {
             }
         }
 
-        // Retrieve mesh indices
+        // Retrieve mesh indices. Points and lines left by the triangulation are
+        // skipped, meshes are drawn as triangle lists
         for ( UInt64_T i{}; i < mesh->mNumFaces; i++ ) {
             const auto face{ mesh->mFaces[i] };
 
+            if ( face.mNumIndices != 3 ) {
+                continue;
+            }
+
             for ( UInt64_T index{}; index < face.mNumIndices; index++ ) {
                 indices.emplace_back( face.mIndices[index] );
             }
         }
 
-        // process material
-        if ( mesh->mMaterialIndex > 0 ) {
-            const aiMaterial* material{ scene->mMaterials[mesh->mMaterialIndex] };
+        // Triangles reordered for the post transform cache first, the overdraw pass keeps most of that locality.
+        // The vertices follow the final triangle order
+        cacheBefore = MeshOptimizer::AnalyzeVertexCache( indices, mesh->mNumVertices );
 
-            if ( wantLoadTextures ) {
-                std::vector diffuseMaps{ LoadTextures( material, aiTextureType_DIFFUSE, MapType::TEXTURE_2D_DIFFUSE, scene, modelDirectory ) };
-                std::vector specularMaps{ LoadTextures( material, aiTextureType_SPECULAR, MapType::TEXTURE_2D_SPECULAR, scene, modelDirectory ) };
-                std::vector normalMaps{ LoadTextures( material, aiTextureType_NORMALS, MapType::TEXTURE_2D_NORMAL, scene, modelDirectory ) };
-                std::vector emissiveMaps{ LoadTextures( material, aiTextureType_EMISSIVE, MapType::TEXTURE_2D_EMISSIVE, scene, modelDirectory ) };
-                std::vector metallic{ LoadTextures( material, aiTextureType_METALNESS, MapType::TEXTURE_2D_ROUGHNESS, scene, modelDirectory ) };
-                std::vector roughness{ LoadTextures( material, aiTextureType_DIFFUSE_ROUGHNESS, MapType::TEXTURE_2D_METALLIC, scene, modelDirectory ) };
-                std::vector ao{ LoadTextures( material, aiTextureType_AMBIENT_OCCLUSION, MapType::TEXTURE_2D_AMBIENT_OCCLUSION, scene, modelDirectory ) };
+        MeshOptimizer::OptimizeVertexCache( indices, mesh->mNumVertices );
+        MeshOptimizer::OptimizeOverdraw( indices, vertices, FLOAT32_VERTEX_FLOAT_COUNT );
 
-                for ( auto& item: diffuseMaps )
-                    textures.push_back( std::move( item ) );
+        const Size_T vertexCount{ MeshOptimizer::OptimizeVertexFetch( indices, vertices, FLOAT32_VERTEX_FLOAT_COUNT ) };
+        vertices.resize( vertexCount * FLOAT32_VERTEX_FLOAT_COUNT );
 
-                for ( auto& item: specularMaps )
-                    textures.push_back( std::move( item ) );
+        if ( vertexCount != 0 ) {
+            result.BoundsMin = glm::vec3{ std::numeric_limits<float>::max() };
+            result.BoundsMax = glm::vec3{ std::numeric_limits<float>::lowest() };
 
-                for ( auto& item: normalMaps )
-                    textures.push_back( std::move( item ) );
+            for ( Size_T index{}; index < vertexCount; index++ ) {
+                const float* position{ vertices.data() + index * FLOAT32_VERTEX_FLOAT_COUNT };
 
-                for ( auto& item: emissiveMaps )
-                    textures.push_back( std::move( item ) );
+                result.BoundsMin = glm::min( result.BoundsMin, glm::vec3{ position[0], position[1], position[2] } );
+                result.BoundsMax = glm::max( result.BoundsMax, glm::vec3{ position[0], position[1], position[2] } );
+            }
+        }
 
-                for ( auto& item: metallic )
-                    textures.push_back( std::move( item ) );
+        GenerateLods( vertices, result );
+        GenerateMeshlets( vertices, result );
 
-                for ( auto& item: roughness )
-                    textures.push_back( std::move( item ) );
+        // Measured on the final order, the meshlets regroup the triangles
+        cacheAfter = MeshOptimizer::AnalyzeVertexCache( std::span<const UInt32_T>{ indices.data(), result.Lods.front().IndexCount }, vertexCount );
 
-                for ( auto& item: ao )
-                    textures.push_back( std::move( item ) );
-            }
-        }
+        EncodeVertices( vertices, info.Format, result );
 
-        return CreateScope<Mesh>(
-                mesh->mName.C_Str(),
-                VertexBuffer::Create( vertices ),
-                IndexBuffer::Create( indices ),
-                std::move( textures ),
-                m_ModelAbsolutePath);
+        return result;
     }
 
-    auto Model::LoadTextures( const aiMaterial* mat, const aiTextureType type, const MapType tType, const aiScene* scene, const Path_T& modelDirectory ) -> std::vector<Texture2D*>  {
-        std::vector<Texture2D*> textures{};
-        AssetsSystem& assetsSystem{ Engine::GetSystem<AssetsSystem>() };
+    auto Model::ProcessMaterial( const aiMesh* mesh, const aiScene* scene, const Path_T& modelDirectory, ModelData& data, ModelMeshData& meshData ) -> void {
+        if ( mesh->mMaterialIndex > 0 ) {
+            const aiMaterial* material{ scene->mMaterials[mesh->mMaterialIndex] };
 
+            // Listed even when they are not wanted, so the cooked file serves any load
+            for ( const auto& [textureType, mapType] : MODEL_TEXTURE_TYPES ) {
+                CollectTextures( material, textureType, mapType, scene, modelDirectory, data, meshData );
+            }
+        }
+    }
+
+    auto Model::CollectTextures( const aiMaterial* mat, const aiTextureType type, const MapType tType, const aiScene* scene, const Path_T& modelDirectory, ModelData& data, ModelMeshData& meshData ) -> void {
         for ( Size_T index{}; index < mat->GetTextureCount( type ); index++ ) {
             aiString texturePath{};
 
-            if ( mat->GetTexture( type, index, std::addressof( texturePath ) ) == AI_SUCCESS ) {
+            if ( mat->GetTexture( type, index, std::addressof( texturePath ) ) != AI_SUCCESS ) {
+                continue;
+            }
+
+            Path_T path{};
+
+            // Embedded textures are extracted to files named after their contents, identical ones are then
+            // the same texture here and are shared with other models by the content hash of AssetsSystem
+            if ( const aiTexture* embedded{ scene->GetEmbeddedTexture( texturePath.C_Str() ) }; embedded != nullptr ) {
+                path = TextureCooker::ExtractEmbedded( *embedded, modelDirectory );
+
+                if ( path.empty() ) {
+                    MKT_CORE_LOGGER_WARN( "Model::CollectTextures - Embedded texture [{}] could not be extracted, it is not loaded.", texturePath.C_Str() );
+                    continue;
+                }
+            } else {
                 // Assumes the textures are in the same directory as the model files
-                Path_T path{ PathBuilder()
+                path = PathBuilder()
                     .WithPath( modelDirectory.string() )
                     .WithPath( texturePath.C_Str() )
-                    .Build() };
-
-                if ( auto ptr{ assetsSystem.LoadTexture ( TextureLoadInfo{
-                    .Path{ path },
-                    .Type{ tType },
-                } ) } ) {
-                    textures.emplace_back( dynamic_cast<Texture2D*>( ptr ) );
-                }
+                    .Build();
             }
 
-            // Temporary. See if it is an embedded texture
-            auto [embeddedTexturePtr, embeddedTextureIndex]{ scene->GetEmbeddedTextureAndIndex( texturePath.C_Str() ) };
-            if ( embeddedTextureIndex != -1 ) {
-                MKT_CORE_LOGGER_WARN( "Model::LoadTextures - Texture is embedded! Index is {}", embeddedTextureIndex );
+            // Materials often share their textures, they are loaded once
+            const auto it{ std::ranges::find_if( data.Textures, [&path]( const TextureLoadInfo& info ) -> bool { return info.Path == path; } ) };
+
+            meshData.TextureIndices.emplace_back( static_cast<Size_T>( std::distance( data.Textures.begin(), it ) ) );
+
+            if ( it == data.Textures.end() ) {
+                data.Textures.emplace_back( TextureLoadInfo{
+                    .Path{ std::move( path ) },
+                    .Type{ tType },
+                } );
             }
         }
-
-        return textures;
     }
 
     Model::Model( Model&& other ) noexcept
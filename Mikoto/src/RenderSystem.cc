@@ -19,7 +19,9 @@ namespace Mikoto {
     auto RenderSystem::Init() -> void {
         const RenderContextCreateInfo createInfo{
             .TargetWindow{ m_Options.TargetWindow },
-            .Backend{ m_Options.Options.RendererAPI }
+            .Backend{ m_Options.Options.RendererAPI },
+            .FramesInFlight{ m_Options.Options.FramesInFlight },
+            .PipelineCachePath{ m_Options.Options.PipelineCachePath },
         };
 
         m_Context = RenderContext::Create(createInfo);
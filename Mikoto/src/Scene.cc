@@ -23,6 +23,7 @@ namespace Mikoto {
 
     auto Scene::Update( double deltaTime ) -> void {
         RemoveQueuedEntities();
+        AddPendingModels();
 
         m_SceneRenderer->SetCamera( *m_SceneCamera );
         m_SceneRenderer->SetProjection( m_SceneCamera->GetProjection() );
@@ -248,69 +249,120 @@ namespace Mikoto {
     }
 
     auto Scene::CreateEntity( const EntityCreateInfo& createInfo ) -> Entity* {
-        if (createInfo.ModelMesh == nullptr) {
-            return AddEmptyEntity( createInfo.Name, createInfo.Root );
+        const Model* model{ createInfo.ModelMesh != nullptr ? createInfo.ModelMesh : createInfo.ModelHandle.GetModel() };
+
+        if (model == nullptr) {
+            Entity* newEntity{ AddEmptyEntity( createInfo.Name, createInfo.Root ) };
+
+            // Renders nothing until the model is ready
+            if ( createInfo.ModelHandle.IsPending() ) {
+                m_PendingModelEntities.emplace_back( PendingModelEntity{
+                    .EntityID{ newEntity->GetComponent<TagComponent>().GetGUID() },
+                    .MeshOnRoot{ createInfo.Root != nullptr },
+                    .MeshName{ createInfo.MeshName },
+                    .ModelHandle{ createInfo.ModelHandle },
+                } );
+            }
+
+            return newEntity;
+        }
+
+        Entity* newEntityRoot{  AddEmptyEntity(createInfo.Name, createInfo.Root) };
+        AddModelMeshes( *newEntityRoot, *model, createInfo.Root != nullptr, createInfo.MeshName );
+
+        return newEntityRoot;
+    }
+
+    auto Scene::AddModelMeshes( Entity& root, const Model& model, const bool meshOnRoot, const std::string_view meshName ) -> void {
+        if ( !meshName.empty() ) {
+            const auto it{ std::ranges::find_if( model.GetMeshes(), [&meshName]( const Scope_T<Mesh>& mesh ) -> bool { return mesh->GetName() == meshName; } ) };
+
+            if ( it == model.GetMeshes().end() ) {
+                MKT_CORE_LOGGER_WARN( "Scene::AddModelMeshes - Model [{}] has no mesh named [{}].", model.GetName(), meshName );
+                return;
+            }
+
+            AddMesh( root, **it );
+            return;
         }
 
         // For each mesh from the model we create an entity,
         // The idea later is to be able to construct one mesh from individual meshes
         // and not split them as it is right now. Although if the root is not empty
-        Entity* newEntityRoot{  AddEmptyEntity(createInfo.Name, createInfo.Root) };
-
-        for (auto& mesh : createInfo.ModelMesh->GetMeshes()) {
+        for (auto& mesh : model.GetMeshes()) {
             // If there is only one child, and we already have a root entity,
             // There's no need to create a new root entity for this single child mesh
-            Entity* child{ createInfo.ModelMesh->GetMeshes().size() == 1 && createInfo.Root != nullptr ?
-                newEntityRoot : AddEmptyEntity(mesh->GetName(), newEntityRoot) };
-
-            MaterialComponent& materialComponent{ child->AddComponent<MaterialComponent>() };
-            RenderComponent& renderComponent{ child->AddComponent<RenderComponent>() };
-
-            Texture2D* diffuse{ nullptr };
-            Texture2D* specular{ nullptr };
-
-            PBRMaterialCreateSpec pbrMaterialCreateSpec{
-                .Name{ fmt::format( "Material standard - {}", mesh->GetName() ) }
-            };
-
-            for (auto& textureIt: mesh->GetTextures()) {
-                switch ( textureIt->GetType() ) {
-                    case MapType::TEXTURE_2D_DIFFUSE:
-                        pbrMaterialCreateSpec.AlbedoMap = textureIt;
-                    case MapType::TEXTURE_2D_SPECULAR:
-                        //pbrMaterialCreateSpec.AlbedoMap = textureIt;
-                        break;
-                    case MapType::TEXTURE_2D_NORMAL:
-                        pbrMaterialCreateSpec.NormalMap = textureIt;
-                    break;
-                    case MapType::TEXTURE_2D_METALLIC:
-                        pbrMaterialCreateSpec.MetallicMap = textureIt;
-                    break;
-                    case MapType::TEXTURE_2D_ROUGHNESS:
-                        pbrMaterialCreateSpec.RoughnessMap = textureIt;
-                    break;
-                    case MapType::TEXTURE_2D_AMBIENT_OCCLUSION:
-                        pbrMaterialCreateSpec.AmbientOcclusionMap = textureIt;
+            Entity* child{ model.GetMeshes().size() == 1 && meshOnRoot ?
+                std::addressof( root ) : AddEmptyEntity(mesh->GetName(), std::addressof( root )) };
+
+            AddMesh( *child, *mesh );
+        }
+    }
+
+    auto Scene::AddMesh( Entity& entity, const Mesh& mesh ) -> void {
+        MaterialComponent& materialComponent{ entity.AddComponent<MaterialComponent>() };
+        RenderComponent& renderComponent{ entity.AddComponent<RenderComponent>() };
+
+        Texture2D* diffuse{ nullptr };
+        Texture2D* specular{ nullptr };
+
+        PBRMaterialCreateSpec pbrMaterialCreateSpec{
+            .Name{ fmt::format( "Material standard - {}", mesh.GetName() ) }
+        };
+
+        for (auto& textureIt: mesh.GetTextures()) {
+            switch ( textureIt->GetType() ) {
+                case MapType::TEXTURE_2D_DIFFUSE:
+                    pbrMaterialCreateSpec.AlbedoMap = textureIt;
+                case MapType::TEXTURE_2D_SPECULAR:
+                    //pbrMaterialCreateSpec.AlbedoMap = textureIt;
                     break;
+                case MapType::TEXTURE_2D_NORMAL:
+                    pbrMaterialCreateSpec.NormalMap = textureIt;
+                break;
+                case MapType::TEXTURE_2D_METALLIC:
+                    pbrMaterialCreateSpec.MetallicMap = textureIt;
+                break;
+                case MapType::TEXTURE_2D_ROUGHNESS:
+                    pbrMaterialCreateSpec.RoughnessMap = textureIt;
+                break;
+                case MapType::TEXTURE_2D_AMBIENT_OCCLUSION:
+                    pbrMaterialCreateSpec.AmbientOcclusionMap = textureIt;
+                break;
+
+                default:
+                    MKT_CORE_LOGGER_INFO("Scene::CreatePrefabEntity - Mesh has no data for the requested texture type. {}", (int)textureIt->GetType());
+            }
+        }
+
+        renderComponent.SetMesh(std::addressof(mesh));
 
-                    default:
-                        MKT_CORE_LOGGER_INFO("Scene::CreatePrefabEntity - Mesh has no data for the requested texture type. {}", (int)textureIt->GetType());
-                }
+        StandardMaterialCreateInfo spec{
+            .name{ fmt::format( "Material standard - {}", mesh.GetName() ) },
+            .DiffuseMap{ diffuse },
+            .SpecularMap{ specular },
+        };
+        //materialComponent.SetMaterial(StandardMaterial::Create(spec));
+
+        materialComponent.SetMaterial(PBRMaterial::Create(pbrMaterialCreateSpec));
+    }
+
+    auto Scene::AddPendingModels() -> void {
+        for ( auto it{ m_PendingModelEntities.begin() }; it != m_PendingModelEntities.end(); ) {
+            if ( it->ModelHandle.IsPending() ) {
+                ++it;
+                continue;
             }
 
-            renderComponent.SetMesh(mesh.get());
+            // The entity may have been removed while the model was loading
+            Entity* entity{ FindEntityByID( it->EntityID ) };
 
-            StandardMaterialCreateInfo spec{
-                .name{ fmt::format( "Material standard - {}", mesh->GetName() ) },
-                .DiffuseMap{ diffuse },
-                .SpecularMap{ specular },
-            };
-            //materialComponent.SetMaterial(StandardMaterial::Create(spec));
+            if ( entity != nullptr && it->ModelHandle.IsReady() ) {
+                AddModelMeshes( *entity, *it->ModelHandle.GetModel(), it->MeshOnRoot, it->MeshName );
+            }
 
-            materialComponent.SetMaterial(PBRMaterial::Create(pbrMaterialCreateSpec));
+            it = m_PendingModelEntities.erase( it );
         }
-
-        return newEntityRoot;
     }
 
     auto Scene::Clear() -> void {
@@ -326,6 +378,7 @@ namespace Mikoto {
         }
 
         m_Lights.clear();
+        m_PendingModelEntities.clear();
         m_Hierarchy.Clear();
         m_Entities.clear();
 
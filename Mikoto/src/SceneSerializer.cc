@@ -22,7 +22,9 @@
 // Project Headers
 #include <Core/Logging/Assert.hh>
 #include <Core/Logging/Logger.hh>
+#include <Core/System/AssetsSystem.hh>
 #include <Core/System/FileSystem.hh>
+#include <Core/System/RenderSystem.hh>
 #include <Scene/Scene/Entity.hh>
 #include <Scene/SceneSerializer.hh>
 
@@ -113,6 +115,11 @@ namespace Mikoto {
     static auto SerializeComponent( const RenderComponent& renderComponent, YAML::Emitter& emitter ) -> void {
         emitter << YAML::BeginMap;
 
+        // The mesh is found again by name in its model when the scene is loaded
+        if ( renderComponent.HasMesh() ) {
+            emitter << YAML::Key << "Model" << YAML::Value << renderComponent.GetMesh()->GetDirectory().string();
+            emitter << YAML::Key << "Mesh" << YAML::Value << renderComponent.GetMesh()->GetName();
+        }
 
         emitter << YAML::EndMap;
     }
@@ -225,14 +232,55 @@ namespace Mikoto {
         }
 
         if ( !node->IsLeaf() ) {
+            emitter << YAML::Key << "Children" << YAML::Value << YAML::BeginSeq;
+
             for ( const auto& childrenNode: node->children ) {
                 SerializeNode( emitter, childrenNode.get() );
             }
+
+            emitter << YAML::EndSeq;
         }
 
         emitter << YAML::EndMap;
     }
 
+    static auto DeserializeNode( Scene& scene, const YAML::Node& object, const Entity* root ) -> void {
+        EntityCreateInfo entityCreateInfo{
+            .Name{ object["TagComponent"]["Name"].as<std::string>() },
+            .Root{ root },
+        };
+
+        // Models are loaded in the background, the entity gets its mesh once its model is ready
+        if ( const YAML::Node renderComponent{ object["RenderComponent"] }; renderComponent.IsMap() && renderComponent["Model"].IsDefined() ) {
+            AssetsSystem& assetsSystem{ Engine::GetSystem<AssetsSystem>() };
+            const RenderSystem& renderSystem{ Engine::GetSystem<RenderSystem>() };
+
+            const ModelLoadInfo modelLoadInfo{
+                .Path{ renderComponent["Model"].as<std::string>() },
+                .InvertedY{ renderSystem.GetDefaultApi() == GraphicsAPI::VULKAN_API },
+                .WantTextures{ true },
+            };
+
+            entityCreateInfo.ModelHandle = assetsSystem.LoadModelAsync( modelLoadInfo );
+            entityCreateInfo.MeshName = renderComponent["Mesh"].as<std::string>();
+        }
+
+        Entity* entity{ scene.CreateEntity( entityCreateInfo ) };
+
+        entity->GetComponent<TagComponent>().SetVisibility( object["TagComponent"]["Visibility"].as<bool>() );
+
+        const auto position{ object["TransformComponent"]["Position"].as<glm::vec3>() };
+        const auto rotation{ object["TransformComponent"]["Rotation"].as<glm::vec3>() };
+        const auto scale{ object["TransformComponent"]["Scale"].as<glm::vec3>() };
+        entity->GetComponent<TransformComponent>().ComputeTransform( position, scale, rotation );
+
+        if ( const YAML::Node children{ object["Children"] }; children.IsSequence() ) {
+            for ( const YAML::Node& child : children ) {
+                DeserializeNode( scene, child, entity );
+            }
+        }
+    }
+
     auto SceneSerializer::Serialize( const Scene& scene, const Path_T& saveFilePath ) -> void {
         FileSystem& fileSystem{ Engine::GetSystem<FileSystem>() };
 
@@ -293,61 +341,15 @@ namespace Mikoto {
 
         const auto sceneEntities{ data["Objects"] };
 
-        if ( !sceneEntities.IsNull() ) {
-
-#if false
-            EntityCreateInfo entityCreateInfo{};
-
-            for (const auto& object : sceneEntities) {
-                Entity entity{};
-
-                // Get the entity ID
-                const std::string uuid{ object["Object"].as<std::string>() };
-                const std::string name{ object["TagComponent"]["Name"].as<std::string>() };
-
-                // Get Render component
-                if (!object["RenderComponent"].IsNull()) {
-                    const bool isPrefab{ object["RenderComponent"]["IsPrefab"].as<bool>() };
-
-                    entityCreateInfo.Name = name;
-                    entityCreateInfo.PrefabType = PrefabSceneObject::NO_PREFAB_OBJECT;
-
-                    if (isPrefab) {
-                        // Get the type of prefab if it was one
-                        entityCreateInfo.PrefabType = PrefabTypeFromName(object["RenderComponent"]["PrefabType"].as<std::string>());
-                    }
-
-                    //SceneManager::AddEntityToScene(newScene, entityCreateInfo);
-                }
-
-                // Get Material component
-                if (!object["MaterialComponent"].IsNull()) {
-                    const auto color{ object["MaterialComponent"]["Color"].as<glm::vec4>() };
-                }
-
-                // Get the Tag component
-                TagComponent tagComponent{};
-                tagComponent.SetTag(name);
-                tagComponent.SetVisibility(object["TagComponent"]["Visibility"].as<bool>());
-                MKT_CORE_LOGGER_INFO("Found entity with name {}", tagComponent.GetTag());
-
-                // Get Transform component
-                TransformComponent transformComponent{};
-                const auto position{ object["TransformComponent"]["Position"].as<glm::vec3>() };
-                const auto rotation{ object["TransformComponent"]["Rotation"].as<glm::vec3>() };
-                const auto scale{ object["TransformComponent"]["Scale"].as<glm::vec3>() };
-                transformComponent.ComputeTransform(position, scale, rotation);
-
-                entity.GetComponent<TransformComponent>() = transformComponent;
-                entity.GetComponent<TagComponent>() = tagComponent;
-            }
-        }
-        else {
-            MKT_CORE_LOGGER_INFO("File opened '{}' but has no scene objects", saveFilePath.string());
+        if ( !sceneEntities.IsSequence() ) {
+            MKT_CORE_LOGGER_INFO( "File opened '{}' but has no scene objects", saveFilePath.string() );
+            return result;
         }
-#endif
+
+        for ( const YAML::Node& object : sceneEntities ) {
+            DeserializeNode( *result, object, nullptr );
         }
 
-        return nullptr;
+        return result;
     }
 }// namespace Mikoto
@@ -5,6 +5,9 @@
 
 // C++ Standard Library
 
+// Third-Party Libraries
+#include <stb_image.h>
+
 // Project Headers
 #include <Core/Engine.hh>
 #include <Core/Logging/Logger.hh>
@@ -16,14 +19,21 @@
 
 
 namespace Mikoto {
-    auto Texture2D::Create(const Path_T& path, MapType type) -> Scope_T<Texture2D> {
+    Texture2DData::~Texture2DData() {
+        if ( Texels != nullptr ) {
+            stbi_image_free( Texels );
+        }
+    }
+
+    auto Texture2D::Create(const Path_T& path, MapType type, Texture2DData* data) -> Scope_T<Texture2D> {
         auto& renderSystem{ Engine::GetSystem<RenderSystem>() };
         switch(renderSystem.GetDefaultApi()) {
             case GraphicsAPI::VULKAN_API:
                 return VulkanTexture2D::Create( VulkanTexture2DCreateInfo{
                     .Path{ path },
                     .Type{ type },
-                    .RetainFileData{ false }
+                    .RetainFileData{ false },
+                    .Data{ data },
                 } );
             default:
                 MKT_CORE_LOGGER_CRITICAL("Texture2D::Create - Unsupported renderer API");
@@ -32,4 +42,17 @@ namespace Mikoto {
 
         return nullptr;
     }
+
+    auto Texture2D::Decode(const Path_T& path) -> Scope_T<Texture2DData> {
+        auto& renderSystem{ Engine::GetSystem<RenderSystem>() };
+        switch(renderSystem.GetDefaultApi()) {
+            case GraphicsAPI::VULKAN_API:
+                return VulkanTexture2D::Decode( path, false );
+            default:
+                MKT_CORE_LOGGER_CRITICAL("Texture2D::Decode - Unsupported renderer API");
+            break;
+        }
+
+        return nullptr;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,841 @@
+/**
+ * TextureCooker.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+#include <stb_image.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Core/Logging/Logger.hh>
+#include <Library/Filesystem/PathBuilder.hh>
+#include <Library/Utility/Hash.hh>
+#include <Library/Utility/Types.hh>
+#include <Material/Texture/TextureCooker.hh>
+
+namespace Mikoto {
+
+    constexpr Size_T CHANNEL_COUNT{ 4 };
+    constexpr UInt32_T BLOCK_DIMENSION{ 4 };
+    constexpr Size_T TEXELS_PER_BLOCK{ BLOCK_DIMENSION * BLOCK_DIMENSION };
+
+    // Levels in the KTX2 file and in the upload staging memory start at multiples of this
+    constexpr UInt64_T LEVEL_ALIGNMENT{ 16 };
+
+    // Next to the model, see TextureCooker::ExtractEmbedded()
+    constexpr std::string_view EMBEDDED_TEXTURES_DIRECTORY{ "EmbeddedTextures" };
+
+    constexpr std::array<UInt8_T, 12> KTX2_IDENTIFIER{ 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    // Header and index of a KTX2 file, followed by one Ktx2LevelIndex per level
+    struct Ktx2Header {
+        std::array<UInt8_T, 12> Identifier{};
+        UInt32_T VkFormat{};
+        UInt32_T TypeSize{};
+        UInt32_T PixelWidth{};
+        UInt32_T PixelHeight{};
+        UInt32_T PixelDepth{};
+        UInt32_T LayerCount{};
+        UInt32_T FaceCount{};
+        UInt32_T LevelCount{};
+        UInt32_T SupercompressionScheme{};
+
+        UInt32_T DfdByteOffset{};
+        UInt32_T DfdByteLength{};
+        UInt32_T KvdByteOffset{};
+        UInt32_T KvdByteLength{};
+        UInt64_T SgdByteOffset{};
+        UInt64_T SgdByteLength{};
+    };
+
+    struct Ktx2LevelIndex {
+        UInt64_T ByteOffset{};
+        UInt64_T ByteLength{};
+        UInt64_T UncompressedByteLength{};
+    };
+
+    static_assert( sizeof( Ktx2Header ) == 80, "Ktx2Header must match the layout of the file." );
+    static_assert( sizeof( Ktx2LevelIndex ) == 24, "Ktx2LevelIndex must match the layout of the file." );
+
+    // BC7 mode 6 interpolation weights for 4 bit indices
+    constexpr std::array<UInt32_T, 16> BC7_WEIGHTS{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    using BlockTexels_T = std::array<std::array<UInt8_T, CHANNEL_COUNT>, TEXELS_PER_BLOCK>;
+
+    static auto AlignUp( const UInt64_T value, const UInt64_T alignment ) -> UInt64_T {
+        return ( value + alignment - 1 ) & ~( alignment - 1 );
+    }
+
+    static auto GetLevelDimension( const UInt32_T dimension, const UInt32_T level ) -> UInt32_T {
+        return std::max( dimension >> level, 1u );
+    }
+
+    static auto GetBlockSize( const VkFormat format ) -> Size_T {
+        return format == VK_FORMAT_BC4_UNORM_BLOCK ? 8 : 16;
+    }
+
+    static auto IsCookedFormat( const VkFormat format ) -> bool {
+        switch ( format ) {
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static auto GetSRGBToLinearTable() -> const std::array<float, 256>& {
+        static const std::array<float, 256> table{ []() -> std::array<float, 256> {
+            std::array<float, 256> result{};
+
+            for ( Size_T index{}; index < result.size(); ++index ) {
+                const float value{ static_cast<float>( index ) / 255.0f };
+                result[index] = value <= 0.04045f ? value / 12.92f : std::pow( ( value + 0.055f ) / 1.055f, 2.4f );
+            }
+
+            return result;
+        }() };
+
+        return table;
+    }
+
+    // Indexed by the linear value scaled to [0, LINEAR_TO_SRGB_TABLE_SIZE - 1]
+    constexpr Size_T LINEAR_TO_SRGB_TABLE_SIZE{ 4096 };
+
+    static auto GetLinearToSRGBTable() -> const std::array<UInt8_T, LINEAR_TO_SRGB_TABLE_SIZE>& {
+        static const std::array<UInt8_T, LINEAR_TO_SRGB_TABLE_SIZE> table{ []() -> std::array<UInt8_T, LINEAR_TO_SRGB_TABLE_SIZE> {
+            std::array<UInt8_T, LINEAR_TO_SRGB_TABLE_SIZE> result{};
+
+            for ( Size_T index{}; index < result.size(); ++index ) {
+                const float value{ static_cast<float>( index ) / static_cast<float>( LINEAR_TO_SRGB_TABLE_SIZE - 1 ) };
+                const float encoded{ value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow( value, 1.0f / 2.4f ) - 0.055f };
+                result[index] = static_cast<UInt8_T>( std::lround( std::clamp( encoded, 0.0f, 1.0f ) * 255.0f ) );
+            }
+
+            return result;
+        }() };
+
+        return table;
+    }
+
+    /**
+     * Box filters the RGBA8 level into the next one, alpha and the channels of linear data are
+     * averaged as is. Odd dimensions repeat the last row or column. The rows are converted to
+     * floats first so the sums run over contiguous memory the compiler can vectorize.
+     * */
+    static auto DownsampleLevel( const UInt8_T* source, const UInt32_T sourceWidth, const UInt32_T sourceHeight,
+                                 UInt8_T* destination, const UInt32_T width, const UInt32_T height, const bool isSRGB,
+                                 std::vector<float>& rowA, std::vector<float>& rowB ) -> void {
+        const std::array<float, 256>& toLinear{ GetSRGBToLinearTable() };
+        const std::array<UInt8_T, LINEAR_TO_SRGB_TABLE_SIZE>& toSRGB{ GetLinearToSRGBTable() };
+
+        const Size_T sourceRowSize{ sourceWidth * CHANNEL_COUNT };
+        rowA.resize( sourceRowSize );
+        rowB.resize( sourceRowSize );
+
+        const auto decodeRow{ [&]( const UInt8_T* row, std::vector<float>& result ) -> void {
+            for ( Size_T index{}; index < sourceRowSize; ++index ) {
+                const bool isColor{ isSRGB && index % CHANNEL_COUNT != 3 };
+                result[index] = isColor ? toLinear[row[index]] : static_cast<float>( row[index] ) / 255.0f;
+            }
+        } };
+
+        for ( UInt32_T y{}; y < height; ++y ) {
+            const UInt32_T sourceY0{ std::min( y * 2, sourceHeight - 1 ) };
+            const UInt32_T sourceY1{ std::min( y * 2 + 1, sourceHeight - 1 ) };
+
+            decodeRow( source + sourceY0 * sourceRowSize, rowA );
+            decodeRow( source + sourceY1 * sourceRowSize, rowB );
+
+            for ( Size_T index{}; index < sourceRowSize; ++index ) {
+                rowA[index] += rowB[index];
+            }
+
+            UInt8_T* destinationRow{ destination + static_cast<Size_T>( y ) * width * CHANNEL_COUNT };
+
+            for ( UInt32_T x{}; x < width; ++x ) {
+                const Size_T sourceX0{ std::min( x * 2, sourceWidth - 1 ) * CHANNEL_COUNT };
+                const Size_T sourceX1{ std::min( x * 2 + 1, sourceWidth - 1 ) * CHANNEL_COUNT };
+
+                for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                    const float average{ ( rowA[sourceX0 + channel] + rowA[sourceX1 + channel] ) * 0.25f };
+                    const bool isColor{ isSRGB && channel != 3 };
+
+                    destinationRow[x * CHANNEL_COUNT + channel] = isColor
+                        ? toSRGB[static_cast<Size_T>( average * static_cast<float>( LINEAR_TO_SRGB_TABLE_SIZE - 1 ) + 0.5f )]
+                        : static_cast<UInt8_T>( std::lround( average * 255.0f ) );
+                }
+            }
+        }
+    }
+
+    // Writes the bits of a compressed block from the least significant one
+    struct BlockBitWriter {
+        std::array<UInt8_T, 16> Bits{};
+        UInt32_T Position{};
+
+        auto Write( const UInt32_T value, const UInt32_T count ) -> void {
+            for ( UInt32_T bit{}; bit < count; ++bit, ++Position ) {
+                if ( ( ( value >> bit ) & 1 ) != 0 ) {
+                    Bits[Position / 8] |= static_cast<UInt8_T>( 1 << ( Position % 8 ) );
+                }
+            }
+        }
+    };
+
+    /**
+     * BC4 block in the eight values mode. The endpoints are the extremes of the block and every
+     * texel takes the closest of the interpolated values.
+     * */
+    static auto EncodeBC4Block( const std::array<UInt8_T, TEXELS_PER_BLOCK>& values, UInt8_T* output ) -> void {
+        const auto [minIt, maxIt]{ std::ranges::minmax_element( values ) };
+        const UInt32_T minValue{ *minIt };
+        const UInt32_T maxValue{ *maxIt };
+
+        BlockBitWriter writer{};
+        writer.Write( maxValue, 8 );
+        writer.Write( minValue, 8 );
+
+        for ( const UInt8_T value : values ) {
+            UInt32_T index{};
+
+            if ( maxValue != minValue ) {
+                // Position between the endpoints, 0 is the minimum and 7 the maximum
+                const UInt32_T position{ ( ( value - minValue ) * 14 + ( maxValue - minValue ) ) / ( ( maxValue - minValue ) * 2 ) };
+                index = position == 7 ? 0 : position == 0 ? 1 : 8 - position;
+            }
+
+            writer.Write( index, 3 );
+        }
+
+        std::memcpy( output, writer.Bits.data(), 8 );
+    }
+
+    static auto QuantizeBC7Endpoint( const std::array<float, CHANNEL_COUNT>& endpoint, std::array<UInt32_T, CHANNEL_COUNT>& quantized ) -> UInt32_T {
+        UInt32_T bestPBit{};
+        float bestError{ std::numeric_limits<float>::max() };
+
+        for ( UInt32_T pBit{}; pBit < 2; ++pBit ) {
+            std::array<UInt32_T, CHANNEL_COUNT> candidate{};
+            float error{};
+
+            for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                candidate[channel] = static_cast<UInt32_T>( std::clamp( std::lround( ( endpoint[channel] - static_cast<float>( pBit ) ) * 0.5f ), 0l, 127l ) );
+
+                const float difference{ static_cast<float>( ( candidate[channel] << 1 ) | pBit ) - endpoint[channel] };
+                error += difference * difference;
+            }
+
+            if ( error < bestError ) {
+                bestError = error;
+                bestPBit = pBit;
+                quantized = candidate;
+            }
+        }
+
+        return bestPBit;
+    }
+
+    /**
+     * BC7 block in mode 6: a single subset with 7 bit RGBA endpoints, a p-bit each and 4 bit indices.
+     * The endpoints are the extremes of the texels projected on the principal axis of the block.
+     * */
+    static auto EncodeBC7Block( const BlockTexels_T& texels, UInt8_T* output ) -> void {
+        std::array<float, CHANNEL_COUNT> mean{};
+        for ( const auto& texel : texels ) {
+            for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                mean[channel] += static_cast<float>( texel[channel] ) / static_cast<float>( TEXELS_PER_BLOCK );
+            }
+        }
+
+        std::array<std::array<float, CHANNEL_COUNT>, CHANNEL_COUNT> covariance{};
+        for ( const auto& texel : texels ) {
+            for ( Size_T row{}; row < CHANNEL_COUNT; ++row ) {
+                for ( Size_T column{}; column < CHANNEL_COUNT; ++column ) {
+                    covariance[row][column] += ( static_cast<float>( texel[row] ) - mean[row] ) * ( static_cast<float>( texel[column] ) - mean[column] );
+                }
+            }
+        }
+
+        // Power iteration converges to the axis of largest variance
+        std::array<float, CHANNEL_COUNT> axis{ 1.0f, 1.0f, 1.0f, 1.0f };
+        for ( Size_T iteration{}; iteration < 8; ++iteration ) {
+            std::array<float, CHANNEL_COUNT> next{};
+            for ( Size_T row{}; row < CHANNEL_COUNT; ++row ) {
+                for ( Size_T column{}; column < CHANNEL_COUNT; ++column ) {
+                    next[row] += covariance[row][column] * axis[column];
+                }
+            }
+
+            const float length{ std::sqrt( next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3] ) };
+            if ( length < 1e-6f ) {
+                break;
+            }
+
+            for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                axis[channel] = next[channel] / length;
+            }
+        }
+
+        float minProjection{ std::numeric_limits<float>::max() };
+        float maxProjection{ std::numeric_limits<float>::lowest() };
+
+        for ( const auto& texel : texels ) {
+            float projection{};
+            for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                projection += ( static_cast<float>( texel[channel] ) - mean[channel] ) * axis[channel];
+            }
+
+            minProjection = std::min( minProjection, projection );
+            maxProjection = std::max( maxProjection, projection );
+        }
+
+        std::array<float, CHANNEL_COUNT> endpoint0{};
+        std::array<float, CHANNEL_COUNT> endpoint1{};
+        for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+            endpoint0[channel] = std::clamp( mean[channel] + axis[channel] * minProjection, 0.0f, 255.0f );
+            endpoint1[channel] = std::clamp( mean[channel] + axis[channel] * maxProjection, 0.0f, 255.0f );
+        }
+
+        std::array<UInt32_T, CHANNEL_COUNT> quantized0{};
+        std::array<UInt32_T, CHANNEL_COUNT> quantized1{};
+        UInt32_T pBit0{ QuantizeBC7Endpoint( endpoint0, quantized0 ) };
+        UInt32_T pBit1{ QuantizeBC7Endpoint( endpoint1, quantized1 ) };
+
+        std::array<std::array<UInt32_T, CHANNEL_COUNT>, BC7_WEIGHTS.size()> palette{};
+        for ( Size_T entry{}; entry < palette.size(); ++entry ) {
+            for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                const UInt32_T value0{ ( quantized0[channel] << 1 ) | pBit0 };
+                const UInt32_T value1{ ( quantized1[channel] << 1 ) | pBit1 };
+                palette[entry][channel] = ( ( 64 - BC7_WEIGHTS[entry] ) * value0 + BC7_WEIGHTS[entry] * value1 + 32 ) >> 6;
+            }
+        }
+
+        std::array<UInt32_T, TEXELS_PER_BLOCK> indices{};
+        for ( Size_T texelIndex{}; texelIndex < TEXELS_PER_BLOCK; ++texelIndex ) {
+            UInt32_T bestError{ std::numeric_limits<UInt32_T>::max() };
+
+            for ( Size_T entry{}; entry < palette.size(); ++entry ) {
+                UInt32_T error{};
+                for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+                    const Int32_T difference{ static_cast<Int32_T>( palette[entry][channel] ) - static_cast<Int32_T>( texels[texelIndex][channel] ) };
+                    error += static_cast<UInt32_T>( difference * difference );
+                }
+
+                if ( error < bestError ) {
+                    bestError = error;
+                    indices[texelIndex] = static_cast<UInt32_T>( entry );
+                }
+            }
+        }
+
+        // The most significant bit of the first index is implicit and must be zero
+        if ( indices[0] >= 8 ) {
+            std::swap( quantized0, quantized1 );
+            std::swap( pBit0, pBit1 );
+
+            for ( UInt32_T& index : indices ) {
+                index = 15 - index;
+            }
+        }
+
+        BlockBitWriter writer{};
+        writer.Write( 1 << 6, 7 );
+
+        for ( Size_T channel{}; channel < CHANNEL_COUNT; ++channel ) {
+            writer.Write( quantized0[channel], 7 );
+            writer.Write( quantized1[channel], 7 );
+        }
+
+        writer.Write( pBit0, 1 );
+        writer.Write( pBit1, 1 );
+
+        for ( Size_T texelIndex{}; texelIndex < TEXELS_PER_BLOCK; ++texelIndex ) {
+            writer.Write( indices[texelIndex], texelIndex == 0 ? 3 : 4 );
+        }
+
+        std::memcpy( output, writer.Bits.data(), writer.Bits.size() );
+    }
+
+    static auto EncodeLevel( const UInt8_T* texels, const UInt32_T width, const UInt32_T height, const VkFormat format ) -> std::vector<UInt8_T> {
+        const UInt32_T blocksX{ ( width + BLOCK_DIMENSION - 1 ) / BLOCK_DIMENSION };
+        const UInt32_T blocksY{ ( height + BLOCK_DIMENSION - 1 ) / BLOCK_DIMENSION };
+        const Size_T blockSize{ GetBlockSize( format ) };
+
+        std::vector<UInt8_T> result( static_cast<Size_T>( blocksX ) * blocksY * blockSize );
+
+        BlockTexels_T block{};
+
+        for ( UInt32_T blockY{}; blockY < blocksY; ++blockY ) {
+            for ( UInt32_T blockX{}; blockX < blocksX; ++blockX ) {
+                // Texels past the edge of levels smaller than a block repeat the last ones
+                for ( UInt32_T y{}; y < BLOCK_DIMENSION; ++y ) {
+                    for ( UInt32_T x{}; x < BLOCK_DIMENSION; ++x ) {
+                        const UInt32_T sourceX{ std::min( blockX * BLOCK_DIMENSION + x, width - 1 ) };
+                        const UInt32_T sourceY{ std::min( blockY * BLOCK_DIMENSION + y, height - 1 ) };
+
+                        std::memcpy( block[y * BLOCK_DIMENSION + x].data(), texels + ( static_cast<Size_T>( sourceY ) * width + sourceX ) * CHANNEL_COUNT, CHANNEL_COUNT );
+                    }
+                }
+
+                UInt8_T* output{ result.data() + ( static_cast<Size_T>( blockY ) * blocksX + blockX ) * blockSize };
+
+                if ( format == VK_FORMAT_BC7_SRGB_BLOCK || format == VK_FORMAT_BC7_UNORM_BLOCK ) {
+                    EncodeBC7Block( block, output );
+                    continue;
+                }
+
+                // BC5 is a BC4 block for red followed by one for green
+                const Size_T channelCount{ format == VK_FORMAT_BC5_UNORM_BLOCK ? Size_T{ 2 } : Size_T{ 1 } };
+
+                for ( Size_T channel{}; channel < channelCount; ++channel ) {
+                    std::array<UInt8_T, TEXELS_PER_BLOCK> values{};
+                    std::ranges::transform( block, values.begin(), [channel]( const auto& texel ) -> UInt8_T { return texel[channel]; } );
+
+                    EncodeBC4Block( values, output + channel * 8 );
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Basic data format descriptor of the block compressed formats, required by KTX2.
+     * See the Khronos Data Format Specification, section 5.
+     * */
+    static auto BuildDataFormatDescriptor( const VkFormat format ) -> std::vector<UInt32_T> {
+        constexpr UInt32_T KHR_DF_MODEL_BC4{ 131 };
+        constexpr UInt32_T KHR_DF_MODEL_BC5{ 132 };
+        constexpr UInt32_T KHR_DF_MODEL_BC7{ 134 };
+        constexpr UInt32_T KHR_DF_PRIMARIES_BT709{ 1 };
+        constexpr UInt32_T KHR_DF_TRANSFER_LINEAR{ 1 };
+        constexpr UInt32_T KHR_DF_TRANSFER_SRGB{ 2 };
+        constexpr UInt32_T KHR_DF_CHANNEL_RED{ 0 };
+        constexpr UInt32_T KHR_DF_CHANNEL_GREEN{ 1 };
+
+        const UInt32_T blockBits{ static_cast<UInt32_T>( GetBlockSize( format ) * 8 ) };
+
+        UInt32_T model{ KHR_DF_MODEL_BC7 };
+        std::vector<std::pair<UInt32_T, UInt32_T>> samples{ { 0, blockBits } };
+
+        if ( format == VK_FORMAT_BC4_UNORM_BLOCK ) {
+            model = KHR_DF_MODEL_BC4;
+            samples = { { KHR_DF_CHANNEL_RED, blockBits } };
+        } else if ( format == VK_FORMAT_BC5_UNORM_BLOCK ) {
+            model = KHR_DF_MODEL_BC5;
+            samples = { { KHR_DF_CHANNEL_RED, blockBits / 2 }, { KHR_DF_CHANNEL_GREEN, blockBits / 2 } };
+        }
+
+        const UInt32_T transfer{ format == VK_FORMAT_BC7_SRGB_BLOCK ? KHR_DF_TRANSFER_SRGB : KHR_DF_TRANSFER_LINEAR };
+        const UInt32_T descriptorBlockSize{ 24 + 16 * static_cast<UInt32_T>( samples.size() ) };
+
+        std::vector<UInt32_T> descriptor{};
+        descriptor.emplace_back( 4 + descriptorBlockSize );
+
+        // Khronos vendor and basic descriptor type, version 1.3
+        descriptor.emplace_back( 0 );
+        descriptor.emplace_back( 2 | ( descriptorBlockSize << 16 ) );
+        descriptor.emplace_back( model | ( KHR_DF_PRIMARIES_BT709 << 8 ) | ( transfer << 16 ) );
+
+        // 4x4 texel blocks, dimensions are stored minus one
+        descriptor.emplace_back( ( BLOCK_DIMENSION - 1 ) | ( ( BLOCK_DIMENSION - 1 ) << 8 ) );
+        descriptor.emplace_back( static_cast<UInt32_T>( GetBlockSize( format ) ) );
+        descriptor.emplace_back( 0 );
+
+        UInt32_T bitOffset{};
+        for ( const auto& [channel, bitLength] : samples ) {
+            descriptor.emplace_back( bitOffset | ( ( bitLength - 1 ) << 16 ) | ( channel << 24 ) );
+            descriptor.emplace_back( 0 );
+            descriptor.emplace_back( 0 );
+            descriptor.emplace_back( 0xFFFFFFFF );
+
+            bitOffset += bitLength;
+        }
+
+        return descriptor;
+    }
+
+    static auto WriteKtx2( const Path_T& path, const VkFormat format, const UInt32_T width, const UInt32_T height, const std::vector<std::vector<UInt8_T>>& levels ) -> Size_T {
+        const std::vector<UInt32_T> descriptor{ BuildDataFormatDescriptor( format ) };
+
+        Ktx2Header header{};
+        header.Identifier = KTX2_IDENTIFIER;
+        header.VkFormat = format;
+        header.TypeSize = 1;
+        header.PixelWidth = width;
+        header.PixelHeight = height;
+        header.FaceCount = 1;
+        header.LevelCount = static_cast<UInt32_T>( levels.size() );
+
+        header.DfdByteOffset = static_cast<UInt32_T>( sizeof( Ktx2Header ) + levels.size() * sizeof( Ktx2LevelIndex ) );
+        header.DfdByteLength = static_cast<UInt32_T>( descriptor.size() * sizeof( UInt32_T ) );
+
+        // The level index lists the biggest level first, while their data is stored from the smallest one
+        std::vector<Ktx2LevelIndex> levelIndex( levels.size() );
+        UInt64_T offset{ header.DfdByteOffset + header.DfdByteLength };
+
+        for ( Size_T level{ levels.size() }; level-- > 0; ) {
+            offset = AlignUp( offset, LEVEL_ALIGNMENT );
+
+            levelIndex[level].ByteOffset = offset;
+            levelIndex[level].ByteLength = levels[level].size();
+            levelIndex[level].UncompressedByteLength = levels[level].size();
+
+            offset += levels[level].size();
+        }
+
+        std::vector<UInt8_T> file( offset );
+        std::memcpy( file.data(), std::addressof( header ), sizeof( Ktx2Header ) );
+        std::memcpy( file.data() + sizeof( Ktx2Header ), levelIndex.data(), levelIndex.size() * sizeof( Ktx2LevelIndex ) );
+        std::memcpy( file.data() + header.DfdByteOffset, descriptor.data(), header.DfdByteLength );
+
+        for ( Size_T level{}; level < levels.size(); ++level ) {
+            std::memcpy( file.data() + levelIndex[level].ByteOffset, levels[level].data(), levels[level].size() );
+        }
+
+        std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+        if ( !stream.write( reinterpret_cast<const char*>( file.data() ), static_cast<std::streamsize>( file.size() ) ) ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "TextureCooker::Cook - Failed to write cooked texture [{}].", path.string() ) );
+        }
+
+        return file.size();
+    }
+
+    // Same fallbacks as VulkanTexture2D::LoadImageData, .tif textures are usually shipped with a PNG or JPEG version
+    static auto ResolveSourceImage( const Path_T& path ) -> Path_T {
+        if ( path.extension() != ".tif" ) {
+            return path;
+        }
+
+        for ( const auto& extension : { ".png", ".jpg", ".jpeg" } ) {
+            Path_T alternative{ path };
+            alternative.replace_extension( extension );
+
+            if ( std::filesystem::exists( alternative ) ) {
+                return alternative;
+            }
+        }
+
+        return path;
+    }
+
+    static auto IsCookedFileUpToDate( const Path_T& source, const Path_T& cooked ) -> bool {
+        std::error_code error{};
+
+        const auto cookedTime{ std::filesystem::last_write_time( cooked, error ) };
+        if ( error ) {
+            return false;
+        }
+
+        // Projects may ship the cooked files only
+        const auto sourceTime{ std::filesystem::last_write_time( ResolveSourceImage( source ), error ) };
+
+        return error || cookedTime >= sourceTime;
+    }
+
+    auto TextureCooker::GetCookedPath( const Path_T& source ) -> Path_T {
+        Path_T result{ source };
+        result.replace_extension( ".ktx2" );
+
+        return result;
+    }
+
+    auto TextureCooker::GetCookedFormat( const MapType type ) -> VkFormat {
+        switch ( type ) {
+            case MapType::TEXTURE_2D_NORMAL:
+                return VK_FORMAT_BC5_UNORM_BLOCK;
+            case MapType::TEXTURE_2D_ROUGHNESS:
+            case MapType::TEXTURE_2D_METALLIC:
+            case MapType::TEXTURE_2D_AMBIENT_OCCLUSION:
+                return VK_FORMAT_BC4_UNORM_BLOCK;
+            default:
+                return VK_FORMAT_BC7_SRGB_BLOCK;
+        }
+    }
+
+    auto TextureCooker::GetMipLevelCount( const UInt32_T width, const UInt32_T height ) -> UInt32_T {
+        return static_cast<UInt32_T>( std::bit_width( std::max( width, height ) ) );
+    }
+
+    auto TextureCooker::BuildMipChain( const UInt8_T* data, const UInt32_T width, const UInt32_T height, const UInt32_T mipLevels, const bool isSRGB ) -> MipChain {
+        MipChain result{};
+        result.LevelOffsets.reserve( mipLevels );
+
+        UInt64_T chainSize{};
+        for ( UInt32_T level{}; level < mipLevels; ++level ) {
+            result.LevelOffsets.emplace_back( chainSize );
+            chainSize += static_cast<UInt64_T>( GetLevelDimension( width, level ) ) * GetLevelDimension( height, level ) * CHANNEL_COUNT;
+        }
+
+        result.Data.resize( chainSize );
+        std::copy_n( data, static_cast<Size_T>( width ) * height * CHANNEL_COUNT, result.Data.data() );
+
+        // Scratch rows reused by every level
+        std::vector<float> rowA{};
+        std::vector<float> rowB{};
+
+        for ( UInt32_T level{ 1 }; level < mipLevels; ++level ) {
+            DownsampleLevel( result.Data.data() + result.LevelOffsets[level - 1], GetLevelDimension( width, level - 1 ), GetLevelDimension( height, level - 1 ),
+                             result.Data.data() + result.LevelOffsets[level], GetLevelDimension( width, level ), GetLevelDimension( height, level ),
+                             isSRGB, rowA, rowB );
+        }
+
+        return result;
+    }
+
+    auto TextureCooker::Cook( const Path_T& source, const MapType type ) -> TextureCookReport {
+        const Path_T sourceImage{ ResolveSourceImage( source ) };
+        const VkFormat format{ GetCookedFormat( type ) };
+
+        // Same orientation as the textures decoded at load
+        stbi_set_flip_vertically_on_load( true );
+
+        Int32_T width{};
+        Int32_T height{};
+        Int32_T channels{};
+
+        stbi_uc* texels{ stbi_load( sourceImage.string().c_str(), std::addressof( width ), std::addressof( height ), std::addressof( channels ), STBI_rgb_alpha ) };
+
+        if ( texels == nullptr ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "TextureCooker::Cook - Failed to load texture image [{}].", sourceImage.string() ) );
+        }
+
+        const UInt32_T levelCount{ GetMipLevelCount( static_cast<UInt32_T>( width ), static_cast<UInt32_T>( height ) ) };
+        const MipChain chain{ BuildMipChain( texels, static_cast<UInt32_T>( width ), static_cast<UInt32_T>( height ), levelCount, format == VK_FORMAT_BC7_SRGB_BLOCK ) };
+
+        stbi_image_free( texels );
+
+        std::vector<std::vector<UInt8_T>> levels{};
+        levels.reserve( levelCount );
+
+        for ( UInt32_T level{}; level < levelCount; ++level ) {
+            levels.emplace_back( EncodeLevel( chain.Data.data() + chain.LevelOffsets[level],
+                GetLevelDimension( static_cast<UInt32_T>( width ), level ), GetLevelDimension( static_cast<UInt32_T>( height ), level ), format ) );
+        }
+
+        const Size_T cookedBytes{ WriteKtx2( GetCookedPath( source ), format, static_cast<UInt32_T>( width ), static_cast<UInt32_T>( height ), levels ) };
+
+        return TextureCookReport{
+            .CookedCount{ 1 },
+            .UncompressedBytes{ chain.Data.size() },
+            .CookedBytes{ cookedBytes },
+        };
+    }
+
+    auto TextureCooker::CookModelTextures( const Path_T& modelPath ) -> TextureCookReport {
+        // Only the materials are needed, the meshes are not processed
+        Assimp::Importer importer{};
+        const aiScene* scene{ importer.ReadFile( modelPath.string(), 0 ) };
+
+        if ( scene == nullptr || scene->mRootNode == nullptr ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "TextureCooker::CookModelTextures - Failed to load model: '{}'", importer.GetErrorString() ) );
+        }
+
+        // Matches the textures loaded by Model::ProcessMesh
+        constexpr std::array textureTypes{
+            std::pair{ aiTextureType_DIFFUSE, MapType::TEXTURE_2D_DIFFUSE },
+            std::pair{ aiTextureType_SPECULAR, MapType::TEXTURE_2D_SPECULAR },
+            std::pair{ aiTextureType_NORMALS, MapType::TEXTURE_2D_NORMAL },
+            std::pair{ aiTextureType_EMISSIVE, MapType::TEXTURE_2D_EMISSIVE },
+            std::pair{ aiTextureType_METALNESS, MapType::TEXTURE_2D_METALLIC },
+            std::pair{ aiTextureType_DIFFUSE_ROUGHNESS, MapType::TEXTURE_2D_ROUGHNESS },
+            std::pair{ aiTextureType_AMBIENT_OCCLUSION, MapType::TEXTURE_2D_AMBIENT_OCCLUSION },
+        };
+
+        Path_T modelDirectory{ modelPath };
+        modelDirectory.remove_filename();
+
+        TextureCookReport report{};
+        std::unordered_set<std::string> visited{};
+
+        for ( UInt32_T materialIndex{}; materialIndex < scene->mNumMaterials; ++materialIndex ) {
+            const aiMaterial* material{ scene->mMaterials[materialIndex] };
+
+            for ( const auto& [textureType, mapType] : textureTypes ) {
+                for ( UInt32_T textureIndex{}; textureIndex < material->GetTextureCount( textureType ); ++textureIndex ) {
+                    aiString texturePath{};
+
+                    if ( material->GetTexture( textureType, textureIndex, std::addressof( texturePath ) ) != AI_SUCCESS ) {
+                        continue;
+                    }
+
+                    // Same file as the one Model::CollectTextures loads
+                    Path_T source{};
+                    if ( const aiTexture* embedded{ scene->GetEmbeddedTexture( texturePath.C_Str() ) }; embedded != nullptr ) {
+                        source = ExtractEmbedded( *embedded, modelDirectory );
+                    } else {
+                        source = PathBuilder()
+                            .WithPath( modelDirectory.string() )
+                            .WithPath( texturePath.C_Str() )
+                            .Build();
+                    }
+
+                    if ( source.empty() ) {
+                        continue;
+                    }
+
+                    if ( !visited.insert( source.string() ).second ) {
+                        continue;
+                    }
+
+                    if ( IsCookedFileUpToDate( source, GetCookedPath( source ) ) ) {
+                        ++report.SkippedCount;
+                        continue;
+                    }
+
+                    try {
+                        const TextureCookReport textureReport{ Cook( source, mapType ) };
+
+                        report.CookedCount += textureReport.CookedCount;
+                        report.UncompressedBytes += textureReport.UncompressedBytes;
+                        report.CookedBytes += textureReport.CookedBytes;
+                    } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+                        ++report.FailedCount;
+                    }
+                }
+            }
+        }
+
+        return report;
+    }
+
+    auto TextureCooker::ExtractEmbedded( const aiTexture& texture, const Path_T& modelDirectory ) -> Path_T {
+        // A height of zero means the data is a compressed image (png, jpg...) of mWidth bytes
+        if ( texture.mHeight != 0 || texture.pcData == nullptr ) {
+            return {};
+        }
+
+        const std::span<const UInt8_T> bytes{ reinterpret_cast<const UInt8_T*>( texture.pcData ), texture.mWidth };
+        const std::string extension{ texture.achFormatHint[0] != '\0' ? texture.achFormatHint : "img" };
+
+        const Path_T path{ PathBuilder()
+            .WithPath( modelDirectory.string() )
+            .WithPath( EMBEDDED_TEXTURES_DIRECTORY )
+            .WithPath( fmt::format( "{:016x}.{}", Hash::ComputeXXHash64( bytes ), extension ) )
+            .Build() };
+
+        std::error_code errorCode{};
+
+        // Extracted by a previous load, the name already tells the contents are the same
+        if ( const auto size{ std::filesystem::file_size( path, errorCode ) }; !errorCode && size == bytes.size() ) {
+            return path;
+        }
+
+        std::filesystem::create_directories( path.parent_path(), errorCode );
+
+        // Models are imported on several workers, each one writes its own file before renaming it
+        Path_T temporaryPath{ path };
+        temporaryPath += fmt::format( ".{}.tmp", std::hash<std::thread::id>{}( std::this_thread::get_id() ) );
+
+        {
+            std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+            file.write( reinterpret_cast<const char*>( bytes.data() ), static_cast<std::streamsize>( bytes.size() ) );
+            file.close();
+
+            if ( !file.good() ) {
+                MKT_CORE_LOGGER_WARN( "TextureCooker::ExtractEmbedded - Failed to write '{}'.", temporaryPath.string() );
+                std::filesystem::remove( temporaryPath, errorCode );
+                return {};
+            }
+        }
+
+        std::filesystem::rename( temporaryPath, path, errorCode );
+
+        if ( errorCode ) {
+            std::filesystem::remove( temporaryPath, errorCode );
+
+            // Another worker extracted the same contents in the meantime
+            return std::filesystem::exists( path, errorCode ) ? path : Path_T{};
+        }
+
+        return path;
+    }
+
+    auto TextureCooker::LoadCooked( const Path_T& source ) -> std::optional<CookedTexture> {
+        const Path_T cookedPath{ GetCookedPath( source ) };
+
+        if ( !IsCookedFileUpToDate( source, cookedPath ) ) {
+            return std::nullopt;
+        }
+
+        std::ifstream stream{ cookedPath, std::ios::binary | std::ios::ate };
+        if ( !stream ) {
+            return std::nullopt;
+        }
+
+        std::vector<UInt8_T> file( static_cast<Size_T>( stream.tellg() ) );
+        stream.seekg( 0 );
+
+        if ( file.size() < sizeof( Ktx2Header ) || !stream.read( reinterpret_cast<char*>( file.data() ), static_cast<std::streamsize>( file.size() ) ) ) {
+            return std::nullopt;
+        }
+
+        Ktx2Header header{};
+        std::memcpy( std::addressof( header ), file.data(), sizeof( Ktx2Header ) );
+
+        const VkFormat format{ static_cast<VkFormat>( header.VkFormat ) };
+
+        // 2D textures with a complete set of levels and no supercompression, as written by Cook()
+        if ( header.Identifier != KTX2_IDENTIFIER || !IsCookedFormat( format ) ||
+             header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth != 0 ||
+             header.LayerCount > 1 || header.FaceCount != 1 || header.SupercompressionScheme != 0 ||
+             header.LevelCount == 0 || header.LevelCount > GetMipLevelCount( header.PixelWidth, header.PixelHeight ) ||
+             file.size() < sizeof( Ktx2Header ) + header.LevelCount * sizeof( Ktx2LevelIndex ) ) {
+            return std::nullopt;
+        }
+
+        std::vector<Ktx2LevelIndex> levelIndex( header.LevelCount );
+        std::memcpy( levelIndex.data(), file.data() + sizeof( Ktx2Header ), levelIndex.size() * sizeof( Ktx2LevelIndex ) );
+
+        CookedTexture result{
+            .Format{ format },
+            .Width{ header.PixelWidth },
+            .Height{ header.PixelHeight },
+        };
+
+        // Packed from the biggest level, as VulkanUploadManager::UploadImage expects them
+        UInt64_T packedSize{};
+        for ( const Ktx2LevelIndex& level : levelIndex ) {
+            if ( level.ByteOffset > file.size() || level.ByteLength > file.size() - level.ByteOffset ) {
+                return std::nullopt;
+            }
+
+            result.Levels.LevelOffsets.emplace_back( packedSize );
+            packedSize = AlignUp( packedSize + level.ByteLength, LEVEL_ALIGNMENT );
+        }
+
+        result.Levels.Data.resize( packedSize );
+
+        for ( Size_T level{}; level < levelIndex.size(); ++level ) {
+            std::memcpy( result.Levels.Data.data() + result.Levels.LevelOffsets[level], file.data() + levelIndex[level].ByteOffset, levelIndex[level].ByteLength );
+        }
+
+        return result;
+    }
+}
@@ -4,6 +4,7 @@
  * */
 
 // C++ Standard Library
+#include <span>
 #include <vector>
 #include <memory>
 
@@ -14,12 +15,13 @@
 #include <Renderer/Vulkan/VulkanVertexBuffer.hh>
 
 namespace Mikoto {
-    auto VertexBuffer::Create(const std::vector<float>& data, const BufferLayout& layout) -> Scope_T<VertexBuffer> {
+    auto VertexBuffer::Create( const std::span<const UInt8_T> data, const VertexFormat format, const VertexDequantization& dequantization ) -> Scope_T<VertexBuffer> {
         auto& renderSystem{ Engine::GetSystem<RenderSystem>() };
 
         const VertexBufferCreateInfo createInfo{
             .Data{ data },
-            .Layout{ layout },
+            .Format{ format },
+            .Dequantization{ dequantization },
             .RetainData{ false },
         };
 
@@ -0,0 +1,242 @@
+/**
+ * VulkanBindlessManager.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Renderer/Vulkan/VulkanBindlessManager.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanDescriptorManager.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
+
+namespace Mikoto {
+
+    auto VulkanBindlessManager::SlotAllocator::Allocate() -> UInt32_T {
+        if ( !FreeIndices.empty() ) {
+            const UInt32_T index{ FreeIndices.back() };
+            FreeIndices.pop_back();
+
+            return index;
+        }
+
+        if ( NextIndex >= Capacity ) {
+            return INVALID_INDEX;
+        }
+
+        return NextIndex++;
+    }
+
+    auto VulkanBindlessManager::SlotAllocator::Retire( const UInt32_T index, const UInt64_T frameNumber ) -> void {
+        RetiredIndices.emplace_back( index, frameNumber );
+    }
+
+    auto VulkanBindlessManager::SlotAllocator::Recycle( const UInt64_T completedFrameNumber ) -> void {
+        const auto itRecycled{ std::ranges::partition( RetiredIndices,
+            [completedFrameNumber]( const std::pair<UInt32_T, UInt64_T>& retired ) -> bool {
+                return retired.second > completedFrameNumber;
+            } ) };
+
+        for ( const auto& [index, frameNumber] : itRecycled ) {
+            FreeIndices.push_back( index );
+        }
+
+        RetiredIndices.erase( itRecycled.begin(), itRecycled.end() );
+    }
+
+    auto VulkanBindlessManager::Init( const VulkanBindlessManagerCreateInfo& createInfo ) -> void {
+        m_Device = VulkanContext::Get().GetDevice().GetLogicalDevice();
+        m_DescriptorSetLayout = createInfo.DescriptorSetLayout;
+        m_FramesInFlight = createInfo.FramesInFlight;
+        m_TextureCapacity = createInfo.TextureCapacity;
+
+        m_FrameNumber = 0;
+
+        m_TextureSlots = SlotAllocator{ .Capacity{ m_TextureCapacity } };
+        m_MaterialSlots = SlotAllocator{ .Capacity{ MAX_MATERIALS } };
+
+        m_PendingTextureWrites.resize( m_FramesInFlight );
+
+        CreateDescriptorPool();
+        CreateMaterialBuffers();
+        CreateDescriptorSets();
+    }
+
+    auto VulkanBindlessManager::Shutdown() -> void {
+        m_MaterialBuffers.clear();
+        m_DescriptorSets.clear();
+        m_PendingTextureWrites.clear();
+
+        // Destroying the pool frees the sets allocated from it
+        vkDestroyDescriptorPool( m_Device, m_DescriptorPool, nullptr );
+        m_DescriptorPool = VK_NULL_HANDLE;
+    }
+
+    auto VulkanBindlessManager::CreateDescriptorPool() -> void {
+        const std::array poolSizes{
+            VkDescriptorPoolSize{
+                .type{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER },
+                .descriptorCount{ m_TextureCapacity * m_FramesInFlight },
+            },
+            VkDescriptorPoolSize{
+                .type{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER },
+                .descriptorCount{ m_FramesInFlight },
+            },
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo{ VulkanHelpers::Initializers::DescriptorPoolCreateInfo() };
+        poolInfo.maxSets = m_FramesInFlight;
+        poolInfo.poolSizeCount = static_cast<UInt32_T>( poolSizes.size() );
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        if ( vkCreateDescriptorPool( m_Device, std::addressof( poolInfo ), nullptr, std::addressof( m_DescriptorPool ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanBindlessManager::CreateDescriptorPool - Failed to create descriptor pool." );
+        }
+    }
+
+    auto VulkanBindlessManager::CreateMaterialBuffers() -> void {
+        m_MaterialBuffers.clear();
+
+        for ( UInt32_T frameIndex{}; frameIndex < m_FramesInFlight; ++frameIndex ) {
+            VulkanBufferCreateInfo allocInfo{};
+
+            allocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            allocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            allocInfo.BufferCreateInfo.size = MAX_MATERIALS * sizeof( BindlessMaterialData );
+
+            allocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            allocInfo.WantMapping = true;
+
+            m_MaterialBuffers.emplace_back( VulkanBuffer::Create( allocInfo ) );
+        }
+    }
+
+    auto VulkanBindlessManager::CreateDescriptorSets() -> void {
+        m_DescriptorSets.clear();
+
+        for ( UInt32_T frameIndex{}; frameIndex < m_FramesInFlight; ++frameIndex ) {
+            VkDescriptorSetAllocateInfo allocInfo{ VulkanHelpers::Initializers::DescriptorSetAllocateInfo() };
+            allocInfo.descriptorPool = m_DescriptorPool;
+            allocInfo.descriptorSetCount = 1;
+            allocInfo.pSetLayouts = std::addressof( m_DescriptorSetLayout );
+
+            VkDescriptorSet descriptorSet{};
+            if ( vkAllocateDescriptorSets( m_Device, std::addressof( allocInfo ), std::addressof( descriptorSet ) ) != VK_SUCCESS ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanBindlessManager::CreateDescriptorSets - Failed to allocate descriptor set." );
+            }
+
+            // The textures array is partially bound, entries are written as textures get registered
+            VulkanDescriptorWriter()
+                .WriteBuffer( MATERIALS_BINDING, m_MaterialBuffers[frameIndex]->Get(), m_MaterialBuffers[frameIndex]->GetSize(), 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .UpdateSet( m_Device, descriptorSet );
+
+            m_DescriptorSets.push_back( descriptorSet );
+        }
+    }
+
+    auto VulkanBindlessManager::RegisterTexture( const VkImageView view, const VkSampler sampler ) -> UInt32_T {
+        std::scoped_lock lock{ m_Mutex };
+
+        const UInt32_T index{ m_TextureSlots.Allocate() };
+
+        if ( index == INVALID_INDEX ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanBindlessManager::RegisterTexture - Exceeded the maximum number of bindless textures." );
+        }
+
+        // A set may still be in use by a frame in flight, each one is written when its frame begins
+        for ( auto& pendingWrites : m_PendingTextureWrites ) {
+            pendingWrites.emplace_back( PendingTextureWrite{ .Index{ index }, .View{ view }, .Sampler{ sampler } } );
+        }
+
+        return index;
+    }
+
+    auto VulkanBindlessManager::ReleaseTexture( const UInt32_T index ) -> void {
+        if ( index == INVALID_INDEX ) {
+            return;
+        }
+
+        std::scoped_lock lock{ m_Mutex };
+
+        // The view is about to be destroyed, it must not be written anymore
+        for ( auto& pendingWrites : m_PendingTextureWrites ) {
+            std::erase_if( pendingWrites, [index]( const PendingTextureWrite& write ) -> bool { return write.Index == index; } );
+        }
+
+        m_TextureSlots.Retire( index, m_FrameNumber );
+    }
+
+    auto VulkanBindlessManager::AllocateMaterial() -> UInt32_T {
+        std::scoped_lock lock{ m_Mutex };
+
+        const UInt32_T index{ m_MaterialSlots.Allocate() };
+
+        if ( index == INVALID_INDEX ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanBindlessManager::AllocateMaterial - Exceeded the maximum number of bindless materials." );
+        }
+
+        return index;
+    }
+
+    auto VulkanBindlessManager::ReleaseMaterial( const UInt32_T index ) -> void {
+        if ( index == INVALID_INDEX ) {
+            return;
+        }
+
+        std::scoped_lock lock{ m_Mutex };
+        m_MaterialSlots.Retire( index, m_FrameNumber );
+    }
+
+    auto VulkanBindlessManager::WriteMaterial( const UInt32_T index, const BindlessMaterialData& data ) const -> void {
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+        auto* materials{ static_cast<BindlessMaterialData*>( m_MaterialBuffers[frameIndex]->GetMappedPtr() ) };
+
+        std::memcpy( materials + index, std::addressof( data ), sizeof( BindlessMaterialData ) );
+    }
+
+    auto VulkanBindlessManager::BeginFrame() -> void {
+        std::scoped_lock lock{ m_Mutex };
+
+        ++m_FrameNumber;
+
+        // The fence of the current frame was waited on, every frame up to this one
+        // minus the number of frames in flight is done on the GPU
+        if ( m_FrameNumber > m_FramesInFlight ) {
+            const UInt64_T completedFrameNumber{ m_FrameNumber - m_FramesInFlight };
+
+            m_TextureSlots.Recycle( completedFrameNumber );
+            m_MaterialSlots.Recycle( completedFrameNumber );
+        }
+
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+        std::vector<PendingTextureWrite>& pendingWrites{ m_PendingTextureWrites[frameIndex] };
+
+        if ( pendingWrites.empty() ) {
+            return;
+        }
+
+        VulkanDescriptorWriter writer{};
+
+        for ( const auto& [index, view, sampler] : pendingWrites ) {
+            writer.WriteImage( TEXTURES_BINDING, view, sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, index );
+        }
+
+        writer.UpdateSet( m_Device, m_DescriptorSets[frameIndex] );
+        pendingWrites.clear();
+    }
+
+    auto VulkanBindlessManager::Bind( const VkCommandBuffer commandBuffer, const VkPipelineLayout pipelineLayout, const UInt32_T set ) const -> void {
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        vkCmdBindDescriptorSets( commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            pipelineLayout,
+            set, 1, std::addressof( m_DescriptorSets[frameIndex] ),
+            0, nullptr );
+    }
+}
@@ -14,10 +14,10 @@ namespace Mikoto {
     auto VulkanBuffer::Release() -> void {
         PersistentUnmap();
 
-        auto& device{ VulkanContext::Get().GetDevice() };
-        device.WaitIdle();
-
-        vmaDestroyBuffer( device.GetAllocator(), m_Buffer, m_VmaAllocation );
+        // Frames in flight may still read the buffer
+        VulkanDeletionQueue::Retire( [allocator = VulkanContext::Get().GetDevice().GetAllocator(), buffer = m_Buffer, allocation = m_VmaAllocation]() -> void {
+            vmaDestroyBuffer( allocator, buffer, allocation );
+        } );
     }
 
     VulkanBuffer::~VulkanBuffer() {
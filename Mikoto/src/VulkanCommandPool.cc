@@ -53,13 +53,14 @@ namespace Mikoto {
     auto VulkanCommandPool::Release() -> void {
         const VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
-        device.WaitIdle();
+        // Command buffers of the pool may still be executing
+        VulkanDeletionQueue::Retire( [device = device.GetLogicalDevice(), commandPool = m_CommandPool, commandBuffers = m_CommandBuffers]() -> void {
+            for ( const auto& commandBuffer : commandBuffers ) {
+                vkFreeCommandBuffers( device, commandPool, 1, std::addressof( commandBuffer ) );
+            }
 
-        for ( auto& commandBuffer : m_CommandBuffers ) {
-            vkFreeCommandBuffers( device.GetLogicalDevice(), m_CommandPool, 1, std::addressof( commandBuffer ) );
-        }
-
-        vkDestroyCommandPool( device.GetLogicalDevice(), m_CommandPool, nullptr );
+            vkDestroyCommandPool( device, commandPool, nullptr );
+        } );
     }
 
     auto VulkanCommandPool::Create( const VulkanCommandPoolCreateInfo& createInfo ) -> Scope_T<VulkanCommandPool> {
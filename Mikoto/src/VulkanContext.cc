@@ -5,12 +5,14 @@
 
 // C++ Standard Library
 #include <any>
+#include <array>
 #include <memory>
 #include <numeric>
 #include <set>
 #include <stdexcept>
 #include <unordered_set>
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 // Third-Party Libraries
@@ -94,6 +96,8 @@ namespace Mikoto {
         bool success{ true };
 
         try {
+            m_FramesInFlight = std::clamp( m_ContextData.FramesInFlight, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT );
+
             InitVolk();
 
             CreateInstance();
@@ -103,6 +107,11 @@ namespace Mikoto {
             LoadVmaRequiredFunctions();
 
             CreateDevice();
+            CreateTimelines();
+
+            m_PipelineCache.Init( VulkanPipelineCacheCreateInfo{
+                .FilePath{ m_ContextData.PipelineCachePath },
+            } );
 
             PrepareImmediateSubmit();
 
@@ -112,6 +121,17 @@ namespace Mikoto {
             CreateDefaultDescriptorLayouts();
 
             InitDescriptorAllocator();
+            InitBindlessManager();
+
+            m_UploadManager.Init( VulkanUploadManagerCreateInfo{
+                .StagingCapacity{ VulkanUploadManager::DEFAULT_STAGING_CAPACITY },
+                .Timeline{ std::addressof( m_TransferTimeline ) },
+            } );
+
+            m_GeometryHeap.Init( VulkanGeometryHeapCreateInfo{
+                .VertexCapacity{ VulkanGeometryHeap::DEFAULT_VERTEX_CAPACITY },
+                .IndexCapacity{ VulkanGeometryHeap::DEFAULT_INDEX_CAPACITY },
+            } );
 
             VulkanShaderLibrary::Init();
 
@@ -138,6 +158,14 @@ namespace Mikoto {
         m_VulkanData.Device->Init();
     }
 
+    auto VulkanContext::CreateTimelines() -> void {
+        const VkDevice device{ m_VulkanData.Device->GetLogicalDevice() };
+
+        m_GraphicsTimeline.Init( device );
+        m_ComputeTimeline.Init( device );
+        m_TransferTimeline.Init( device );
+    }
+
     auto VulkanContext::PrepareImmediateSubmit() -> void {
         // Command pool for immediate submission
         VkCommandPoolCreateInfo immediateSubmitCreateInfo{ VulkanHelpers::Initializers::CommandPoolCreateInfo() };
@@ -153,16 +181,6 @@ namespace Mikoto {
         immediateSubmitAllocInfo.commandBufferCount = 1;
 
         m_ImmediateSubmitContext.CommandBuffer = *m_ImmediateSubmitContext.CommandPool->AllocateCommandBuffer( immediateSubmitAllocInfo );
-
-        // Fence for immediate submission
-        VkFenceCreateInfo immediateSubmitFenceInfo{ VulkanHelpers::Initializers::FenceCreateInfo() };
-
-        if ( vkCreateFence( m_VulkanData.Device->GetLogicalDevice(),
-                            std::addressof( immediateSubmitFenceInfo ),
-                            nullptr,
-                            std::addressof( m_ImmediateSubmitContext.UploadFence ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanDevice::PrepareImmediateSubmit - Failed to create Vulkan immediate submit fence!" ) );
-                            }
     }
 
     auto VulkanContext::ImmediateSubmit( const std::function<void( const VkCommandBuffer& )>& task) -> void {
@@ -178,9 +196,19 @@ namespace Mikoto {
 
         VulkanShaderLibrary::Shutdown();
 
+        m_BindlessManager.Shutdown();
+        // Pending uploads may still target the geometry heap
+        m_UploadManager.Shutdown();
+        m_GeometryHeap.Shutdown();
+
         m_ImmediateSubmitContext.CommandPool = nullptr;
 
-        vkDestroyFence( m_VulkanData.Device->GetLogicalDevice(), m_ImmediateSubmitContext.UploadFence, nullptr );
+        m_GraphicsTimeline.Shutdown();
+        m_ComputeTimeline.Shutdown();
+        m_TransferTimeline.Shutdown();
+
+        // Pipelines built during this run are picked up by the next one
+        m_PipelineCache.Shutdown();
 
         if ( m_VulkanData.EnableValidationLayers && vkDestroyDebugUtilsMessengerEXT != nullptr ) {
             vkDestroyDebugUtilsMessengerEXT( GetInstance(), m_VulkanData.DebugMessenger, nullptr );
@@ -205,6 +233,8 @@ namespace Mikoto {
         SubmitCommands();
 
         PresentToSwapchain();
+
+        m_CurrentFrameIndex = ( m_CurrentFrameIndex + 1 ) % m_FramesInFlight;
     }
 
     static auto CreateDebugUtilsMessengerEXT(
@@ -352,24 +382,37 @@ namespace Mikoto {
             MKT_THROW_RUNTIME_ERROR( "VulkanContext - Error on vkBeginCommandBuffer on ImmediateSubmit" );
         }
 
+        // Tasks run on the graphics queue, they signal its timeline like any other submission
+        const UInt64_T signalValue{ m_GraphicsTimeline.Advance() };
+        const VkSemaphore timelineSemaphore{ m_GraphicsTimeline.GetSemaphore() };
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.signalSemaphoreValueCount = 1;
+        timelineSubmitInfo.pSignalSemaphoreValues = std::addressof( signalValue );
+
         VkSubmitInfo submitInfo{ VulkanHelpers::Initializers::SubmitInfo() };
-        submitInfo.pNext = nullptr;
+        submitInfo.pNext = std::addressof( timelineSubmitInfo );
         submitInfo.pWaitDstStageMask = nullptr;
         submitInfo.waitSemaphoreCount = 0;
         submitInfo.pWaitSemaphores = nullptr;
-        submitInfo.signalSemaphoreCount = 0;
-        submitInfo.pSignalSemaphores = nullptr;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = std::addressof( timelineSemaphore );
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = std::addressof(cmd);
 
         const QueuesData& queuesData{ m_VulkanData.Device->GetLogicalDeviceQueues() };
 
-        if ( vkQueueSubmit( queuesData.Graphics->Queue, 1, std::addressof( submitInfo ), m_ImmediateSubmitContext.UploadFence ) ) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanContext - Error on vkQueueSubmit on ImmediateSubmit" );
+        {
+            const auto queueLock{ m_VulkanData.Device->LockQueues() };
+
+            if ( vkQueueSubmit( queuesData.Graphics->Queue, 1, std::addressof( submitInfo ), VK_NULL_HANDLE ) ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanContext - Error on vkQueueSubmit on ImmediateSubmit" );
+            }
         }
 
-        vkWaitForFences( m_VulkanData.Device->GetLogicalDevice() , 1, std::addressof( m_ImmediateSubmitContext.UploadFence ), true, 9999999999 );
-        vkResetFences( m_VulkanData.Device->GetLogicalDevice(), 1, std::addressof( m_ImmediateSubmitContext.UploadFence ) );
+        // The command pool is reset right after, the tasks have to be done with it
+        m_GraphicsTimeline.Wait( signalValue );
 
         // reset the command buffers inside the command pool
         vkResetCommandPool( m_VulkanData.Device->GetLogicalDevice(), m_ImmediateSubmitContext.CommandPool->Get(), 0 );
@@ -408,6 +451,8 @@ namespace Mikoto {
     }
 
     auto VulkanContext::CreateDefaultDescriptorLayouts() -> void {
+        // Every layout is registered with the shader library, the pipeline
+        // layouts sharing them are validated against the reflected shaders
         // -----------------------------------------------------------
         DescriptorLayoutBuilder baseShaderDescriptorLayoutBuilder{};
         VkDescriptorSetLayout descLayout{ baseShaderDescriptorLayoutBuilder
@@ -418,6 +463,7 @@ namespace Mikoto {
                                        .Build( m_VulkanData.Device->GetLogicalDevice() ) };
 
         m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_BASE_SHADER, descLayout );
+        VulkanShaderLibrary::RegisterSharedSetLayout( descLayout, baseShaderDescriptorLayoutBuilder.GetBindings() );
 
         // -----------------------------------------------------------
         DescriptorLayoutBuilder baseShaderWireframeDescriptorLayoutBuilder{};
@@ -425,6 +471,7 @@ namespace Mikoto {
                                                 .WithBinding( 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER )
                                                .Build( m_VulkanData.Device->GetLogicalDevice() ) };
         m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_BASE_SHADER_WIREFRAME, descLayoutWireframe );
+        VulkanShaderLibrary::RegisterSharedSetLayout( descLayoutWireframe, baseShaderWireframeDescriptorLayoutBuilder.GetBindings() );
 
         // -----------------------------------------------------------
         DescriptorLayoutBuilder pbrShadersDescriptorLayoutBuilder{};
@@ -438,6 +485,7 @@ namespace Mikoto {
                                        .WithBinding( 6, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT )
                                        .Build( m_VulkanData.Device->GetLogicalDevice() ) };
         m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_PBR_SHADER, descLayoutPbr );
+        VulkanShaderLibrary::RegisterSharedSetLayout( descLayoutPbr, pbrShadersDescriptorLayoutBuilder.GetBindings() );
 
         // -----------------------------------------------------------
         DescriptorLayoutBuilder computeShaderSimpleLayoutCreateInfo{};
@@ -445,6 +493,55 @@ namespace Mikoto {
                                                 .WithBinding( 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT )
                                                .Build( m_VulkanData.Device->GetLogicalDevice() ) };
         m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_COMPUTE_PIPELINE, compShaderSimple );
+        VulkanShaderLibrary::RegisterSharedSetLayout( compShaderSimple, computeShaderSimpleLayoutCreateInfo.GetBindings() );
+
+        // -----------------------------------------------------------
+        // Lights of the scene, shared by every material. Bound as the second set (set = 1) by graphics pipelines
+        // and as the first one by the light culling compute pipeline, which writes the cluster bindings
+        // binding 0: lights, binding 1: cluster grid, binding 2: cluster light indices, binding 3: camera data of the frame
+        // binding 4: draw instances, bindings 5 and 6: indirect draw commands of the main and depth pre-pass, binding 7: draw count
+        // binding 8: meshlets of the draw instances
+        // The draw culling compute pipeline binds it as the first set too, it writes the indirect draw bindings
+        constexpr VkShaderStageFlags sceneLightsStages{ VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT };
+
+        DescriptorLayoutBuilder sceneLightsDescriptorLayoutBuilder{};
+        VkDescriptorSetLayout descLayoutSceneLights{ sceneLightsDescriptorLayoutBuilder
+                                                .WithBinding( 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sceneLightsStages )
+                                                .WithBinding( 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sceneLightsStages )
+                                                .WithBinding( 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sceneLightsStages )
+                                                .WithBinding( 3, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT )
+                                                .WithBinding( 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT )
+                                                .WithBinding( 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT )
+                                                .WithBinding( 6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT )
+                                                .WithBinding( 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT )
+                                                .WithBinding( 8, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT )
+                                               .Build( m_VulkanData.Device->GetLogicalDevice() ) };
+        m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS, descLayoutSceneLights );
+        VulkanShaderLibrary::RegisterSharedSetLayout( descLayoutSceneLights, sceneLightsDescriptorLayoutBuilder.GetBindings() );
+
+        // -----------------------------------------------------------
+        // Bindless resources, bound as the first set (set = 0) by the PBR pipelines
+        // binding 0: array of every registered texture, binding 1: parameters of every material
+        // The array is sized to what the device can sample from a single stage
+        const VkPhysicalDeviceLimits& limits{ m_VulkanData.Device->GetPhysicalDeviceProperties().limits };
+
+        m_BindlessTextureCapacity = std::min( { VulkanBindlessManager::MAX_TEXTURES,
+                                                limits.maxPerStageDescriptorSampledImages,
+                                                limits.maxPerStageDescriptorSamplers,
+                                                limits.maxDescriptorSetSampledImages,
+                                                limits.maxDescriptorSetSamplers } );
+
+        DescriptorLayoutBuilder bindlessDescriptorLayoutBuilder{};
+        VkDescriptorSetLayout descLayoutBindless{ bindlessDescriptorLayoutBuilder
+                                                .WithBindingArray( VulkanBindlessManager::TEXTURES_BINDING,
+                                                    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                    m_BindlessTextureCapacity,
+                                                    VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                    VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT )
+                                                .WithBinding( VulkanBindlessManager::MATERIALS_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT )
+                                               .Build( m_VulkanData.Device->GetLogicalDevice() ) };
+        m_DescriptorSetLayouts.try_emplace( DESCRIPTOR_SET_LAYOUT_BINDLESS, descLayoutBindless );
+        VulkanShaderLibrary::RegisterSharedSetLayout( descLayoutBindless, bindlessDescriptorLayoutBuilder.GetBindings() );
     }
 
     auto VulkanContext::RecreateSwapChain( const bool enableVsync ) -> void {
@@ -463,12 +560,23 @@ namespace Mikoto {
         m_VulkanData.Device->WaitIdle();
 
         CreateSwapChain(createInfo);
+
+        // Previous images are gone, nothing is using the new ones yet
+        m_ImagesInFlight.assign( m_SwapChain->GetImageCount(), 0 );
     }
 
     auto VulkanContext::PrepareFrame() -> void {
+        const FrameSynchronizationPrimitives& frameSyncObjects{ m_FrameSyncObjects[m_CurrentFrameIndex] };
+
+        // Waits for this frame slot's previous submission, after this
+        // point the frame's command buffers and uniform slices can be reused
+        m_GraphicsTimeline.Wait( m_FrameTimelineValues[m_CurrentFrameIndex] );
+
+        // Objects released during the frames that just completed can go now
+        VulkanDeletionQueue::Collect();
+
         const auto ret{ GetSwapChain().GetNextRenderableImage( m_CurrentRenderableSwapChainImage,
-                                                     m_SwapChainSyncObjects.RenderFence,
-                                                     m_SwapChainSyncObjects.PresentSemaphore ) };
+                                                     frameSyncObjects.PresentSemaphore ) };
 
         if ( ret == VK_ERROR_OUT_OF_DATE_KHR ) {
             RecreateSwapChain( GetSwapChain().IsVsyncEnabled() );
@@ -477,27 +585,41 @@ namespace Mikoto {
         if ( ret != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanContext::PrepareFrame - Failed to acquire swap chain image!" );
         }
+
+        // The swapchain may hand out images out of order, if the acquired image is still
+        // being rendered by another frame in flight we have to wait for that frame as well
+        m_GraphicsTimeline.Wait( m_ImagesInFlight[m_CurrentRenderableSwapChainImage] );
     }
 
     auto VulkanContext::SubmitCommands() -> void {
         FlushImmediateSubmitTasks();
 
-        FrameSynchronizationPrimitives submitInfo{};
+        // Specify present and render semaphores of the current frame
+        const FrameSynchronizationPrimitives& submitInfo{ m_FrameSyncObjects[m_CurrentFrameIndex] };
+
+        // Submit the pending uploads, the frame must not read them before they land
+        m_UploadManager.Flush();
 
-        // Specify present and render semaphores
-        submitInfo.RenderFence = m_SwapChainSyncObjects.RenderFence;
-        submitInfo.RenderSemaphore = m_SwapChainSyncObjects.RenderSemaphore;
-        submitInfo.PresentSemaphore = m_SwapChainSyncObjects.PresentSemaphore;
+        const std::array uploadWaits{
+            TimelineWait{
+                .Semaphore{ m_TransferTimeline.GetSemaphore() },
+                .Value{ m_TransferTimeline.GetSubmittedValue() },
+            },
+        };
 
-        m_VulkanData.Device->SubmitCommandsGraphicsQueue( submitInfo );
+        const UInt64_T frameValue{ m_VulkanData.Device->SubmitCommandsGraphicsQueue( submitInfo, uploadWaits, m_GraphicsTimeline ) };
+
+        // Both the frame slot and the swapchain image are free again once the GPU reaches this value
+        m_FrameTimelineValues[m_CurrentFrameIndex] = frameValue;
+        m_ImagesInFlight[m_CurrentRenderableSwapChainImage] = frameValue;
 
         ComputeSynchronizationPrimitives computeSubmitInfo{};
 
-        m_VulkanData.Device->SubmitCommandsComputeQueue( computeSubmitInfo );
+        m_VulkanData.Device->SubmitCommandsComputeQueue( computeSubmitInfo, m_ComputeTimeline );
     }
 
     auto VulkanContext::PresentToSwapchain() -> void {
-        const auto result{ m_SwapChain->Present( m_CurrentRenderableSwapChainImage, m_SwapChainSyncObjects.RenderSemaphore ) };
+        const auto result{ m_SwapChain->Present( m_CurrentRenderableSwapChainImage, m_FrameSyncObjects[m_CurrentFrameIndex].RenderSemaphore ) };
 
         if ( result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ) {
             RecreateSwapChain( GetSwapChain().IsVsyncEnabled() );
@@ -528,46 +650,47 @@ namespace Mikoto {
         m_DescriptorAllocator.Init( m_VulkanData.Device->GetLogicalDevice(), 1000, sizes );
     }
 
+    auto VulkanContext::InitBindlessManager() -> void {
+        const VulkanBindlessManagerCreateInfo createInfo{
+            .DescriptorSetLayout{ m_DescriptorSetLayouts[DESCRIPTOR_SET_LAYOUT_BINDLESS] },
+            .FramesInFlight{ m_FramesInFlight },
+            .TextureCapacity{ m_BindlessTextureCapacity },
+        };
+
+        m_BindlessManager.Init( createInfo );
+    }
+
     auto VulkanContext::CreateSynchronizationPrimitives() -> void {
-        VkFenceCreateInfo fenceInfo{ VulkanHelpers::Initializers::FenceCreateInfo() };
+        VkSemaphoreCreateInfo semaphoreCreateInfo{ VulkanHelpers::Initializers::SemaphoreCreateInfo() };
 
-        // We want to create the fence with the Create Signaled flag, so we
-        // can wait on it before using it on a GPU command (for the first frame)
-        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        m_FrameSyncObjects.resize( m_FramesInFlight );
 
-        if ( vkCreateFence( m_VulkanData.Device->GetLogicalDevice(),
-                            std::addressof( fenceInfo ),
-                            nullptr,
-                            std::addressof( m_SwapChainSyncObjects.RenderFence ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "Failed to create swap chain render fence!" ) );
-        }
+        // The graphics timeline starts at zero, waiting on it before the first frame returns right away
+        m_FrameTimelineValues.assign( m_FramesInFlight, 0 );
 
-        VulkanDeletionQueue::Push( [this]() -> void {
-            vkDestroyFence( m_VulkanData.Device->GetLogicalDevice(), m_SwapChainSyncObjects.RenderFence, nullptr );
-        } );
+        for ( Size_T frameIndex{}; frameIndex < m_FrameSyncObjects.size(); ++frameIndex ) {
+            if ( vkCreateSemaphore( m_VulkanData.Device->GetLogicalDevice(),
+                                    std::addressof( semaphoreCreateInfo ),
+                                    nullptr,
+                                    std::addressof( m_FrameSyncObjects[frameIndex].PresentSemaphore ) ) != VK_SUCCESS ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "Failed to create swap chain present semaphore for frame {}", frameIndex ) );
+            }
 
-        VkSemaphoreCreateInfo semaphoreCreateInfo{ VulkanHelpers::Initializers::SemaphoreCreateInfo() };
-        if ( vkCreateSemaphore( m_VulkanData.Device->GetLogicalDevice(),
-                                std::addressof( semaphoreCreateInfo ),
-                                nullptr,
-                                std::addressof( m_SwapChainSyncObjects.PresentSemaphore ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "Failed to create swap chain present semaphore" ) );
-        }
+            VulkanDeletionQueue::Push( [this, frameIndex]() -> void {
+                vkDestroySemaphore( m_VulkanData.Device->GetLogicalDevice(), m_FrameSyncObjects[frameIndex].PresentSemaphore, nullptr );
+            } );
 
-        VulkanDeletionQueue::Push( [this]() -> void {
-            vkDestroySemaphore( m_VulkanData.Device->GetLogicalDevice(), m_SwapChainSyncObjects.PresentSemaphore, nullptr );
-        } );
+            if ( vkCreateSemaphore( m_VulkanData.Device->GetLogicalDevice(),
+                                    std::addressof( semaphoreCreateInfo ),
+                                    nullptr,
+                                    std::addressof( m_FrameSyncObjects[frameIndex].RenderSemaphore ) ) != VK_SUCCESS ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "Failed to create swap chain render semaphore for frame {}", frameIndex ) );
+            }
 
-        if ( vkCreateSemaphore( m_VulkanData.Device->GetLogicalDevice(),
-                                std::addressof( semaphoreCreateInfo ),
-                                nullptr,
-                                std::addressof( m_SwapChainSyncObjects.RenderSemaphore ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "Failed to create swap chain render semaphore" ) );
+            VulkanDeletionQueue::Push( [this, frameIndex]() -> void {
+                vkDestroySemaphore( m_VulkanData.Device->GetLogicalDevice(), m_FrameSyncObjects[frameIndex].RenderSemaphore, nullptr );
+            } );
         }
-
-        VulkanDeletionQueue::Push( [this]() -> void {
-            vkDestroySemaphore( m_VulkanData.Device->GetLogicalDevice(), m_SwapChainSyncObjects.RenderSemaphore, nullptr );
-        } );
     }
 
     auto VulkanContext::InitVolk() -> void {
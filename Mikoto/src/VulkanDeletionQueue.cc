@@ -0,0 +1,110 @@
+/**
+ * VulkanDeletionQueue.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+// Project Headers
+#include <Core/Logging/Assert.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanDeletionQueue.hh>
+
+namespace Mikoto {
+
+    auto VulkanDeletionQueue::Retire( std::function<void()>&& function ) -> void {
+        std::unique_lock lock{ s_RetireMutex };
+
+        if ( s_IsFlushed ) {
+            // Tasks may release more objects, they must not find the lock taken
+            lock.unlock();
+            function();
+
+            return;
+        }
+
+        VulkanContext& context{ VulkanContext::Get() };
+
+        // The frame being recorded signals the next graphics value, it is the last one that may reference the object.
+        // Uploads it depends on are waited on by that frame, so the transfer timeline is covered as well.
+        // The compute queue only gets work in some frames, see Collect() for how its value is resolved
+        s_RetiredTasks.emplace_back( RetiredTask{
+            .GraphicsValue{ context.GetGraphicsTimeline().GetSubmittedValue() + 1 },
+            .ComputeValue{ context.GetComputeTimeline().GetSubmittedValue() },
+            .Function{ std::move( function ) },
+        } );
+    }
+
+    auto VulkanDeletionQueue::Collect() -> void {
+        VulkanContext& context{ VulkanContext::Get() };
+
+        const UInt64_T graphicsValue{ context.GetGraphicsTimeline().GetCompletedValue() };
+        const UInt64_T computeSubmittedValue{ context.GetComputeTimeline().GetSubmittedValue() };
+        const UInt64_T computeValue{ context.GetComputeTimeline().GetCompletedValue() };
+
+        // A task holds the compute value submitted when it was retired. Once its graphics frame has completed,
+        // that frame's compute submission has been made as well: it signaled the next value if there was any,
+        // otherwise only the work already in flight at the time may use the object
+        const auto isComputeDone{ [computeSubmittedValue, computeValue]( const RetiredTask& task ) -> bool {
+            return std::min( task.ComputeValue + 1, computeSubmittedValue ) <= computeValue;
+        } };
+
+        std::deque<RetiredTask> completedTasks{};
+
+        {
+            std::scoped_lock lock{ s_RetireMutex };
+
+            while ( !s_RetiredTasks.empty() &&
+                    s_RetiredTasks.front().GraphicsValue <= graphicsValue &&
+                    isComputeDone( s_RetiredTasks.front() ) ) {
+                completedTasks.emplace_back( std::move( s_RetiredTasks.front() ) );
+                s_RetiredTasks.pop_front();
+            }
+
+            // Every queue is done with a frame a few frames after it completes on the graphics queue,
+            // a task still waiting past that would keep its object alive until shutdown
+            MKT_ASSERT( s_RetiredTasks.empty() || s_RetiredTasks.front().GraphicsValue + VulkanContext::MAX_FRAMES_IN_FLIGHT > graphicsValue,
+                "VulkanDeletionQueue::Collect - Retired objects are not being destroyed" );
+        }
+
+        // Run outside the lock, deleting an object may retire the objects it owns
+        for ( const auto& task : completedTasks ) {
+            task.Function();
+        }
+    }
+
+    auto VulkanDeletionQueue::CollectAll() -> void {
+        std::deque<RetiredTask> retiredTasks{};
+
+        {
+            std::scoped_lock lock{ s_RetireMutex };
+
+            retiredTasks = std::move( s_RetiredTasks );
+            s_RetiredTasks.clear();
+        }
+
+        for ( const auto& task : retiredTasks ) {
+            task.Function();
+        }
+    }
+
+    auto VulkanDeletionQueue::Flush() -> void {
+        {
+            std::scoped_lock lock{ s_RetireMutex };
+            s_IsFlushed = true;
+        }
+
+        // Tasks retired from here on run right away
+        CollectAll();
+
+        for (auto it{ s_DeleteTasks.rbegin() }; it != s_DeleteTasks.rend(); it++) {
+            (*it)();
+        }
+        s_DeleteTasks.clear();
+    }
+}
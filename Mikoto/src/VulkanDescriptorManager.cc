@@ -10,6 +10,7 @@ namespace Mikoto {
 
     auto DescriptorLayoutBuilder::Clear() -> void {
         m_Bindings.clear();
+        m_BindingFlags.clear();
     }
 
     auto DescriptorLayoutBuilder::WithBinding( UInt32_T binding, VkDescriptorType type, VkShaderStageFlags shaderStages ) -> DescriptorLayoutBuilder& {
@@ -22,6 +23,22 @@ namespace Mikoto {
         };
 
         m_Bindings.emplace_back(newBinding);
+        m_BindingFlags.emplace_back(0);
+
+        return *this;
+    }
+
+    auto DescriptorLayoutBuilder::WithBindingArray( UInt32_T binding, VkDescriptorType type, UInt32_T count, VkShaderStageFlags shaderStages, VkDescriptorBindingFlags flags ) -> DescriptorLayoutBuilder& {
+        VkDescriptorSetLayoutBinding newBinding{
+            .binding{ binding },
+            .descriptorType{ type },
+            .descriptorCount{ count },
+            .stageFlags{ shaderStages },
+            .pImmutableSamplers{}
+        };
+
+        m_Bindings.emplace_back(newBinding);
+        m_BindingFlags.emplace_back(flags);
 
         return *this;
     }
@@ -29,6 +46,16 @@ namespace Mikoto {
     auto DescriptorLayoutBuilder::Build( const VkDevice device, const void* pNext, VkDescriptorSetLayoutCreateFlags flags ) const -> VkDescriptorSetLayout {
         VkDescriptorSetLayoutCreateInfo info{ VulkanHelpers::Initializers::DescriptorSetLayoutCreateInfo() };
         info.pNext = pNext;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{ VulkanHelpers::Initializers::DescriptorSetLayoutBindingFlagsCreateInfo() };
+
+        if ( std::ranges::any_of( m_BindingFlags, []( const VkDescriptorBindingFlags flags ) -> bool { return flags != 0; } ) ) {
+            bindingFlagsInfo.pNext = pNext;
+            bindingFlagsInfo.bindingCount = static_cast<UInt32_T>( m_BindingFlags.size() );
+            bindingFlagsInfo.pBindingFlags = m_BindingFlags.data();
+
+            info.pNext = std::addressof( bindingFlagsInfo );
+        }
         info.pBindings = m_Bindings.data();
         info.bindingCount = static_cast<UInt32_T>( m_Bindings.size() );
         info.flags = flags;
@@ -71,7 +98,7 @@ namespace Mikoto {
         return *this;
     }
 
-    auto VulkanDescriptorWriter::WriteImage( UInt32_T binding, VkImageView image, VkSampler sampler, VkImageLayout layout, VkDescriptorType type ) -> VulkanDescriptorWriter& {
+    auto VulkanDescriptorWriter::WriteImage( UInt32_T binding, VkImageView image, VkSampler sampler, VkImageLayout layout, VkDescriptorType type, const UInt32_T arrayElement ) -> VulkanDescriptorWriter& {
         // The layout is going to be almost always either VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
         // the best layout to use for accessing textures in the shaders, or VK_IMAGE_LAYOUT_GENERAL
         // when we are using them from compute shaders and writing them.
@@ -86,6 +113,7 @@ namespace Mikoto {
         VkWriteDescriptorSet write{ VulkanHelpers::Initializers::WriteDescriptorSet() };
 
         write.dstBinding = binding;
+        write.dstArrayElement = arrayElement;
         write.dstSet = VK_NULL_HANDLE; //left empty for now until we need to write it
         write.descriptorCount = 1;
         write.descriptorType = type;
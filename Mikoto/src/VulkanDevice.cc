@@ -1,6 +1,9 @@
 //
 // Created by kate on 1/26/2025.
 //
+#include <array>
+#include <set>
+
 #include <Core/Logging/Logger.hh>
 #include <Core/Logging/StackTrace.hh>
 #include <Renderer/Vulkan/VulkanContext.hh>
@@ -105,6 +108,8 @@ namespace Mikoto {
     }
 
     auto VulkanDevice::WaitIdle() const -> void {
+        // Accesses every queue of the device
+        const auto queueLock{ LockQueues() };
         vkDeviceWaitIdle(m_LogicalDevice);
     }
 
@@ -118,7 +123,7 @@ namespace Mikoto {
 
         // Verify queue support (Present is needed if the surface is not null)
         // For now I always want a graphics queue by default for the device
-        const auto& [Present, Graphics, Compute] { GetQueueFamilyIndices( device, requirements.Surface ) };
+        const auto& [Present, Graphics, Compute, Transfer] { GetQueueFamilyIndices( device, requirements.Surface ) };
         const bool deviceSupportsRequiredQueues{ Graphics.has_value() && (requirements.Surface != nullptr && Present.has_value()) };
 
         // Check swapchain support
@@ -131,10 +136,35 @@ namespace Mikoto {
         // Check support physical device features
         VkPhysicalDeviceFeatures supportedFeatures{};
         vkGetPhysicalDeviceFeatures( device, std::addressof(supportedFeatures) );
+        VkPhysicalDeviceVulkan12Features supportedVulkan12Features{ VulkanHelpers::Initializers::PhysicalDeviceVulkan12Features() };
+        VkPhysicalDeviceFeatures2 supportedFeatures2{ VulkanHelpers::Initializers::PhysicalDeviceFeatures2() };
+        supportedFeatures2.pNext = std::addressof( supportedVulkan12Features );
+        vkGetPhysicalDeviceFeatures2( device, std::addressof( supportedFeatures2 ) );
+
+        const bool supportsDescriptorIndexing{
+            supportedVulkan12Features.descriptorIndexing &&
+            supportedVulkan12Features.runtimeDescriptorArray &&
+            supportedVulkan12Features.descriptorBindingPartiallyBound &&
+            supportedVulkan12Features.shaderSampledImageArrayNonUniformIndexing
+        };
+
+        // Required by the upload manager to track the completion of its batches
+        const bool supportsTimelineSemaphores{ supportedVulkan12Features.timelineSemaphore == VK_TRUE };
+
+        // Required by the GPU culling, the draws of the visible meshes are issued with a single indirect call
+        const bool supportsIndirectDrawing{
+            supportedFeatures.multiDrawIndirect &&
+            supportedFeatures.drawIndirectFirstInstance &&
+            supportedVulkan12Features.drawIndirectCount
+        };
+
         bool supportRequiredPhysicalFeatures{
             // Anisotropic filtering requested and supported
             (!requirements.AnysotropicFiltering || supportedFeatures.samplerAnisotropy) &&
-            (!requirements.FillModeNonSolid || supportedFeatures.fillModeNonSolid)
+            (!requirements.FillModeNonSolid || supportedFeatures.fillModeNonSolid) &&
+            (!requirements.DescriptorIndexing || supportsDescriptorIndexing) &&
+            supportsTimelineSemaphores &&
+            supportsIndirectDrawing
         };
 
         return deviceSupportsRequiredQueues && extensionsSupported && deviceHasSwapchainSupport && supportRequiredPhysicalFeatures;
@@ -156,6 +186,7 @@ namespace Mikoto {
                                       const PhysicalDeviceRequiredFeatures reqs{
                                           .AnysotropicFiltering{ true },
                                           .FillModeNonSolid{ true },
+                                          .DescriptorIndexing{ true },
                                           .Surface{ m_Surface },
                                           .RequestedExtensions{ std::addressof( m_RequestedExtensions ) },
                                       };
@@ -178,19 +209,38 @@ namespace Mikoto {
         const auto graphicsQueueFamilyIndex{ m_QueueFamiliesData.Graphics->FamilyIndex };
         const auto presentQueueFamilyIndex{ m_QueueFamiliesData.Present->FamilyIndex };
 
-        const auto queueCreateInfos{ VulkanHelpers::SetupDeviceQueueCreateInfo( { graphicsQueueFamilyIndex, presentQueueFamilyIndex } ) };
+        std::set<UInt32_T> uniqueQueueFamilies{ graphicsQueueFamilyIndex, presentQueueFamilyIndex };
+
+        if ( m_QueueFamiliesData.Transfer.has_value() ) {
+            uniqueQueueFamilies.insert( m_QueueFamiliesData.Transfer->FamilyIndex );
+        }
+
+        const auto queueCreateInfos{ VulkanHelpers::SetupDeviceQueueCreateInfo( uniqueQueueFamilies ) };
 
         // Requested device features
         VkPhysicalDeviceFeatures deviceFeatures{};
         deviceFeatures.samplerAnisotropy = VK_TRUE;
         deviceFeatures.fillModeNonSolid = VK_TRUE;// required for wireframe mode
+        deviceFeatures.multiDrawIndirect = VK_TRUE;// required for the GPU driven draws
+        deviceFeatures.drawIndirectFirstInstance = VK_TRUE;// the first instance selects the draw instance data
+        deviceFeatures.textureCompressionBC = m_PhysicalDeviceInfo.Features.textureCompressionBC;// optional, cooked textures are skipped without it
 
         VkPhysicalDeviceVulkan13Features vulkan13Features{ VulkanHelpers::Initializers::PhysicalDeviceVulkan13Features() };
         vulkan13Features.synchronization2 = VK_TRUE;// required for vkCmdPipelineBarrier2 used when image transitions
 
+        // Required for the bindless texture array, see VulkanBindlessManager
+        VkPhysicalDeviceVulkan12Features vulkan12Features{ VulkanHelpers::Initializers::PhysicalDeviceVulkan12Features() };
+        vulkan12Features.descriptorIndexing = VK_TRUE;
+        vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+        vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+        vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        vulkan12Features.timelineSemaphore = VK_TRUE;
+        vulkan12Features.drawIndirectCount = VK_TRUE;
+        vulkan12Features.pNext = std::addressof( vulkan13Features );
+
         VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{ VulkanHelpers::Initializers::PhysicalDeviceFeatures2() };
         physicalDeviceFeatures2.features = deviceFeatures;
-        physicalDeviceFeatures2.pNext = std::addressof( vulkan13Features );
+        physicalDeviceFeatures2.pNext = std::addressof( vulkan12Features );
 
         VkDeviceCreateInfo createInfo{ VulkanHelpers::Initializers::DeviceCreateInfo() };
         createInfo.queueCreateInfoCount = static_cast<UInt32_T>( queueCreateInfos.size() );
@@ -246,44 +296,70 @@ namespace Mikoto {
         m_ComputeSubmitCommands.emplace_back( cmd );
     }
 
-    auto VulkanDevice::SubmitCommandsGraphicsQueue( const FrameSynchronizationPrimitives& syncPrimitives ) -> void {
-        if (m_GraphicsSubmitCommands.empty()) {
-            return;
-        }
+    auto VulkanDevice::SubmitCommandsGraphicsQueue( const FrameSynchronizationPrimitives& syncPrimitives, const std::span<const TimelineWait> timelineWaits, VulkanTimeline& timeline ) -> UInt64_T {
+        // Submitted even without command buffers, present waits on the render
+        // semaphore and the frame pacing waits on the timeline value
 
         // Prepare the submission to the queue. We want to wait on
         // the present semaphore, which is signaled when the swapchain
         // is ready (there's image available to render to). We will
         // signal the render semaphore to signal that rendering has finished
 
-        VkPipelineStageFlags waitStage{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        // The timeline waits come after the present semaphore, its value is ignored since it is a binary semaphore
+        std::vector<VkSemaphore> waitSemaphores{ syncPrimitives.PresentSemaphore };
+        std::vector<VkPipelineStageFlags> waitStages{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        std::vector<UInt64_T> waitValues{ 0 };
+
+        for ( const auto& [semaphore, value] : timelineWaits ) {
+            waitSemaphores.push_back( semaphore );
+            waitStages.push_back( VK_PIPELINE_STAGE_ALL_COMMANDS_BIT );
+            waitValues.push_back( value );
+        }
+
+        // The render semaphore is binary as well, the queue timeline tells the host when the frame is done
+        const UInt64_T signalValue{ timeline.Advance() };
+
+        const std::array signalSemaphores{ syncPrimitives.RenderSemaphore, timeline.GetSemaphore() };
+        const std::array<UInt64_T, 2> signalValues{ 0, signalValue };
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.waitSemaphoreValueCount = static_cast<UInt32_T>( waitValues.size() );
+        timelineSubmitInfo.pWaitSemaphoreValues = waitValues.data();
+        timelineSubmitInfo.signalSemaphoreValueCount = static_cast<UInt32_T>( signalValues.size() );
+        timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+
         VkSubmitInfo submit{ VulkanHelpers::Initializers::SubmitInfo() };
-        submit.pNext = nullptr;
+        submit.pNext = std::addressof( timelineSubmitInfo );
 
-        submit.pWaitDstStageMask = std::addressof( waitStage );
+        submit.pWaitDstStageMask = waitStages.data();
 
         // Wait-on semaphores
-        submit.waitSemaphoreCount = 1;
-        submit.pWaitSemaphores = std::addressof( syncPrimitives.PresentSemaphore );
+        submit.waitSemaphoreCount = static_cast<UInt32_T>( waitSemaphores.size() );
+        submit.pWaitSemaphores = waitSemaphores.data();
 
         // Completion signal semaphores
-        submit.signalSemaphoreCount = 1;
-        submit.pSignalSemaphores = std::addressof( syncPrimitives.RenderSemaphore );
+        submit.signalSemaphoreCount = static_cast<UInt32_T>( signalSemaphores.size() );
+        submit.pSignalSemaphores = signalSemaphores.data();
 
         // Command buffers
         submit.commandBufferCount = m_GraphicsSubmitCommands.size();
         submit.pCommandBuffers = m_GraphicsSubmitCommands.data();
 
-        if ( vkQueueSubmit( m_QueueFamiliesData.Graphics->Queue, 1, std::addressof( submit ), syncPrimitives.RenderFence ) != VK_SUCCESS ) {
+        const auto queueLock{ LockQueues() };
+
+        if ( vkQueueSubmit( m_QueueFamiliesData.Graphics->Queue, 1, std::addressof( submit ), VK_NULL_HANDLE ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanDevice::SubmitCommand - Error trying to submit commands." );
         }
 
         m_GraphicsSubmitCommands.clear();
+
+        return signalValue;
     }
 
-    auto VulkanDevice::SubmitCommandsComputeQueue( const ComputeSynchronizationPrimitives& syncPrimitives ) -> void {
+    auto VulkanDevice::SubmitCommandsComputeQueue( const ComputeSynchronizationPrimitives& syncPrimitives, VulkanTimeline& timeline ) -> UInt64_T {
         if (m_ComputeSubmitCommands.empty()) {
-            return;
+            return timeline.GetSubmittedValue();
         }
 
         // Prepare the submission to the queue. We want to wait on
@@ -291,29 +367,47 @@ namespace Mikoto {
         // is ready (there's image available to render to). We will
         // signal the render semaphore to signal that rendering has finished
 
-        VkPipelineStageFlags waitStage{ VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT };
+        const std::vector<VkPipelineStageFlags> waitStages( syncPrimitives.WaitSemaphores.size(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT );
+
+        // The binary signal semaphores come first, their values are ignored
+        std::vector<VkSemaphore> signalSemaphores{ syncPrimitives.SignalSemaphores };
+        std::vector<UInt64_T> signalValues( signalSemaphores.size(), 0 );
+
+        const UInt64_T signalValue{ timeline.Advance() };
+        signalSemaphores.push_back( timeline.GetSemaphore() );
+        signalValues.push_back( signalValue );
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.signalSemaphoreValueCount = static_cast<UInt32_T>( signalValues.size() );
+        timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+
         VkSubmitInfo submit{ VulkanHelpers::Initializers::SubmitInfo() };
-        submit.pNext = nullptr;
+        submit.pNext = std::addressof( timelineSubmitInfo );
 
-        submit.pWaitDstStageMask = std::addressof( waitStage );
+        submit.pWaitDstStageMask = waitStages.data();
 
         // Wait-on semaphores
         submit.waitSemaphoreCount = static_cast<UInt32_T>( syncPrimitives.WaitSemaphores.size() );
         submit.pWaitSemaphores = syncPrimitives.WaitSemaphores.data();
 
         // Completion signal semaphores
-        submit.signalSemaphoreCount = static_cast<UInt32_T>( syncPrimitives.SignalSemaphores.size() );
-        submit.pSignalSemaphores = syncPrimitives.SignalSemaphores.data();
+        submit.signalSemaphoreCount = static_cast<UInt32_T>( signalSemaphores.size() );
+        submit.pSignalSemaphores = signalSemaphores.data();
 
         // Command buffers
         submit.commandBufferCount = m_ComputeSubmitCommands.size();
         submit.pCommandBuffers = m_ComputeSubmitCommands.data();
 
+        const auto queueLock{ LockQueues() };
+
         if ( vkQueueSubmit( m_QueueFamiliesData.Compute->Queue, 1, std::addressof( submit ), syncPrimitives.Fence ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanDevice::SubmitCommand - Error trying to submit commands." );
         }
 
         m_ComputeSubmitCommands.clear();
+
+        return signalValue;
     }
 
     auto VulkanDevice::Release() -> void {
@@ -391,6 +485,14 @@ namespace Mikoto {
                 } );
             }
 
+            // Check dedicated transfer queue
+            if (!result.Transfer.has_value() && VulkanHelpers::HasDedicatedTransferQueue(queueFamilyProperties)) {
+                result.Transfer = std::make_optional( VulkanQueueData{
+                    .Queue{ VK_NULL_HANDLE },
+                    .FamilyIndex{ queueFamilyIndex },
+                } );
+            }
+
             ++queueFamilyIndex;
         }
 
@@ -409,5 +511,9 @@ namespace Mikoto {
         if (queues.Compute.has_value()) {
             vkGetDeviceQueue( device, queues.Compute->FamilyIndex, 0, std::addressof(queues.Compute->Queue) );
         }
+
+        if (queues.Transfer.has_value()) {
+            vkGetDeviceQueue( device, queues.Transfer->FamilyIndex, 0, std::addressof(queues.Transfer->Queue) );
+        }
     }
 }
@@ -29,9 +29,9 @@ namespace Mikoto {
     auto VulkanFrameBuffer::Release() -> void {
         VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
-        device.WaitIdle();
-
-        vkDestroyFramebuffer( device.GetLogicalDevice(), m_FrameBuffer, nullptr );
+        VulkanDeletionQueue::Retire( [device = device.GetLogicalDevice(), frameBuffer = m_FrameBuffer]() -> void {
+            vkDestroyFramebuffer( device, frameBuffer, nullptr );
+        } );
     }
 
     VulkanFrameBuffer::~VulkanFrameBuffer() {
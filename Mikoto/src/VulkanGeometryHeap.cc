@@ -0,0 +1,212 @@
+/**
+ * VulkanGeometryHeap.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+
+// Third-Party Libraries
+#include <fmt/format.h>
+#include <volk.h>
+#include <vk_mem_alloc.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Core/Logging/Logger.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanDeletionQueue.hh>
+#include <Renderer/Vulkan/VulkanGeometryHeap.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
+
+namespace Mikoto {
+
+    auto VulkanGeometryHeap::Init( const VulkanGeometryHeapCreateInfo& createInfo ) -> void {
+        // Transfer source is needed to copy the contents over when a buffer grows
+        m_Vertices.Name = "vertex";
+        m_Vertices.Usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        m_Vertices.Buffer = CreateBuffer( createInfo.VertexCapacity, m_Vertices.Usage );
+        m_Vertices.Allocator.Reset( createInfo.VertexCapacity );
+
+        m_Indices.Name = "index";
+        m_Indices.Usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        m_Indices.Buffer = CreateBuffer( createInfo.IndexCapacity, m_Indices.Usage );
+        m_Indices.Allocator.Reset( createInfo.IndexCapacity );
+    }
+
+    auto VulkanGeometryHeap::Shutdown() -> void {
+        m_Vertices.Buffer = nullptr;
+        m_Vertices.Allocator.Reset( 0 );
+
+        m_Indices.Buffer = nullptr;
+        m_Indices.Allocator.Reset( 0 );
+    }
+
+    auto VulkanGeometryHeap::CreateBuffer( const VkDeviceSize size, const VkBufferUsageFlags usage ) -> Scope_T<VulkanBuffer> {
+        VkBufferCreateInfo bufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
+        bufferInfo.pNext = nullptr;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+
+        // Written from the transfer queue, read from the graphics queue
+        VulkanContext::Get().GetUploadManager().ConfigureSharingMode( bufferInfo );
+
+        // Let the VMA library know that this data should be GPU native
+        VmaAllocationCreateInfo vmaAllocationCreateInfo{};
+        vmaAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        vmaAllocationCreateInfo.priority = 1.0f;
+
+        const VulkanBufferCreateInfo createInfo{
+            .BufferCreateInfo{ bufferInfo },
+            .AllocationCreateInfo{ vmaAllocationCreateInfo },
+            .WantMapping{ false }
+        };
+
+        return VulkanBuffer::Create( createInfo );
+    }
+
+    auto VulkanGeometryHeap::AllocateVertices( const VkDeviceSize size, const VkDeviceSize alignment ) -> Allocation {
+        std::scoped_lock lock{ m_Mutex };
+        return Allocate( m_Vertices, size, alignment );
+    }
+
+    auto VulkanGeometryHeap::AllocateIndices( const VkDeviceSize size ) -> Allocation {
+        std::scoped_lock lock{ m_Mutex };
+        return Allocate( m_Indices, size, sizeof( UInt32_T ) );
+    }
+
+    auto VulkanGeometryHeap::FreeVertices( const Allocation& allocation ) -> void {
+        Free( m_Vertices, allocation );
+    }
+
+    auto VulkanGeometryHeap::FreeIndices( const Allocation& allocation ) -> void {
+        Free( m_Indices, allocation );
+    }
+
+    auto VulkanGeometryHeap::UploadVertices( const Allocation& allocation, const void* data, const VkDeviceSize size ) -> void {
+        std::scoped_lock lock{ m_Mutex };
+        Upload( m_Vertices, allocation, data, size );
+    }
+
+    auto VulkanGeometryHeap::UploadIndices( const Allocation& allocation, const void* data, const VkDeviceSize size ) -> void {
+        std::scoped_lock lock{ m_Mutex };
+        Upload( m_Indices, allocation, data, size );
+    }
+
+    auto VulkanGeometryHeap::Bind( const VkCommandBuffer commandBuffer ) const -> void {
+        const std::array buffers{ m_Vertices.Buffer->Get() };
+        constexpr std::array<VkDeviceSize, 1> offsets{};
+
+        vkCmdBindVertexBuffers( commandBuffer, 0, 1, buffers.data(), offsets.data() );
+
+        // VK_INDEX_TYPE_UINT32 because the indices are created from UInt32_T types
+        vkCmdBindIndexBuffer( commandBuffer, m_Indices.Buffer->Get(), 0, VK_INDEX_TYPE_UINT32 );
+    }
+
+    auto VulkanGeometryHeap::GetVertexStats() const -> OffsetAllocator::Stats {
+        std::scoped_lock lock{ m_Mutex };
+        return m_Vertices.Allocator.GetStats();
+    }
+
+    auto VulkanGeometryHeap::GetIndexStats() const -> OffsetAllocator::Stats {
+        std::scoped_lock lock{ m_Mutex };
+        return m_Indices.Allocator.GetStats();
+    }
+
+    auto VulkanGeometryHeap::Allocate( Region& region, const VkDeviceSize size, const VkDeviceSize alignment ) -> Allocation {
+        // Empty meshes get an empty range, freeing it is a no-op
+        if ( size == 0 ) {
+            return Allocation{};
+        }
+
+        std::optional<Allocation> allocation{ region.Allocator.Allocate( size, alignment ) };
+
+        if ( !allocation ) {
+            // Worst case the new space is preceded by alignment - 1 bytes of padding
+            Grow( region, size + alignment );
+            allocation = region.Allocator.Allocate( size, alignment );
+        }
+
+        if ( !allocation ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanGeometryHeap::Allocate - Failed to allocate {} bytes from the {} buffer.", size, region.Name ) );
+        }
+
+        return *allocation;
+    }
+
+    auto VulkanGeometryHeap::Free( Region& region, const Allocation& allocation ) -> void {
+        if ( allocation.Size == 0 ) {
+            return;
+        }
+
+        // The range may still be read by a frame in flight, it is handed out again once those have completed.
+        // Not locked here, the deletion queue runs the task right away after shutdown
+        VulkanDeletionQueue::Retire( [this, &region, allocation]() -> void {
+            std::scoped_lock lock{ m_Mutex };
+
+            // Meshes outliving the heap have nothing to give back
+            if ( region.Buffer == nullptr ) {
+                return;
+            }
+
+            // Adjacent free ranges are merged, so the heap does not fragment over load/unload cycles
+            region.Allocator.Free( allocation );
+        } );
+    }
+
+    auto VulkanGeometryHeap::Upload( const Region& region, const Allocation& allocation, const void* data, const VkDeviceSize size ) -> void {
+        if ( size > allocation.Size ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanGeometryHeap::Upload - Data does not fit in the allocation." );
+        }
+
+        // If the buffer grows before the batch is submitted, the copy of
+        // the old contents recorded after this one carries the upload over
+        VulkanContext::Get().GetUploadManager().UploadBuffer( region.Buffer->Get(), allocation.Offset, data, size );
+    }
+
+    auto VulkanGeometryHeap::Grow( Region& region, const VkDeviceSize requiredSize ) -> void {
+        const VkDeviceSize oldCapacity{ region.Allocator.GetCapacity() };
+        const VkDeviceSize newCapacity{ std::max( oldCapacity * 2, oldCapacity + requiredSize ) };
+
+        MKT_CORE_LOGGER_INFO( "VulkanGeometryHeap::Grow - Growing the {} buffer from {} to {} bytes.", region.Name, oldCapacity, newCapacity );
+
+        // Frames in flight may still read the old buffer, releasing it retires it
+        // once the copy has completed, so it outlives them as well
+        std::shared_ptr<VulkanBuffer> oldBuffer{ std::move( region.Buffer ) };
+        region.Buffer = CreateBuffer( newCapacity, region.Usage );
+
+        const VkBuffer newBuffer{ region.Buffer->Get() };
+        const VkBuffer previousBuffer{ oldBuffer->Get() };
+
+        // The old buffer is kept alive by the upload batch until the copy has completed
+        VulkanContext::Get().GetUploadManager().Record( [previousBuffer, newBuffer, oldCapacity]( const VkCommandBuffer cmd ) -> void {
+            // Uploads recorded before this copy write the old buffer, and the ones
+            // after it may write ranges this copy also writes
+            VkMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+            vkCmdPipelineBarrier( cmd,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 1, std::addressof( barrier ), 0, nullptr, 0, nullptr );
+
+            const VkBufferCopy copy{
+                .srcOffset{ 0 },
+                .dstOffset{ 0 },
+                .size{ oldCapacity },
+            };
+
+            vkCmdCopyBuffer( cmd, previousBuffer, newBuffer, 1, std::addressof( copy ) );
+
+            vkCmdPipelineBarrier( cmd,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 1, std::addressof( barrier ), 0, nullptr, 0, nullptr );
+        }, std::move( oldBuffer ) );
+
+        region.Allocator.Grow( newCapacity );
+    }
+}
@@ -89,6 +89,12 @@ namespace Mikoto::VulkanHelpers {
         return queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
     }
 
+    auto HasDedicatedTransferQueue( const VkQueueFamilyProperties& queueFamily ) -> bool {
+        // Transfer only families usually map to the copy engines, they run alongside the graphics work
+        constexpr VkQueueFlags graphicsOrCompute{ VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT };
+        return queueFamily.queueCount > 0 && ( queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT ) && !( queueFamily.queueFlags & graphicsOrCompute );
+    }
+
     auto HasPresentQueue( const VkPhysicalDevice& device, const UInt32_T queueFamilyIndex,  const VkSurfaceKHR& surface, const VkQueueFamilyProperties& queueFamilyProperties  ) -> bool {
         VkBool32 presentSupport{ VK_FALSE };
         if (vkGetPhysicalDeviceSurfaceSupportKHR( device, queueFamilyIndex, surface, std::addressof( presentSupport ) ) != VK_SUCCESS) {
@@ -120,6 +126,14 @@ namespace Mikoto::VulkanHelpers {
             case ShaderDataType::INT4_TYPE: return VK_FORMAT_R32G32B32A32_SINT;
             case ShaderDataType::BOOL_TYPE: return VK_FORMAT_R32_SINT;
 
+            // Compact formats, all of them are read as floats by the shaders
+            case ShaderDataType::HALF2_TYPE: return VK_FORMAT_R16G16_SFLOAT;
+            case ShaderDataType::HALF4_TYPE: return VK_FORMAT_R16G16B16A16_SFLOAT;
+            case ShaderDataType::SNORM16_2_TYPE: return VK_FORMAT_R16G16_SNORM;
+            case ShaderDataType::SNORM16_4_TYPE: return VK_FORMAT_R16G16B16A16_SNORM;
+            case ShaderDataType::UNORM16_2_TYPE: return VK_FORMAT_R16G16_UNORM;
+            case ShaderDataType::UNORM8_4_TYPE: return VK_FORMAT_R8G8B8A8_UNORM;
+
             case ShaderDataType::NONE:
             case ShaderDataType::COUNT: [[fallthrough]];
             default:
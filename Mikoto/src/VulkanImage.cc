@@ -26,6 +26,7 @@ namespace Mikoto {
 
         // The image has not been allocated, and we need to allocate it on the given device
         if ( createInfo.Image == VK_NULL_HANDLE ) {
+            m_ImageCreateInfo = createInfo.ImageCreateInfo;
 
             m_CurrentLayout = m_ImageCreateInfo.initialLayout;
 
@@ -71,6 +72,9 @@ namespace Mikoto {
 
         VkImageAspectFlags aspectMask = (newLayout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
         imageBarrier.subresourceRange = VulkanHelpers::Initializers::ImageSubresourceRange(aspectMask);
+
+        // The whole mip chain moves to the new layout
+        imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
         imageBarrier.image = m_Image;
 
         VkDependencyInfo depInfo {};
@@ -93,13 +97,16 @@ namespace Mikoto {
     auto VulkanImage::Release() -> void {
         VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
-        device.WaitIdle();
-
-        vkDestroyImageView( device.GetLogicalDevice(), m_ImageView, nullptr );
+        // Frames in flight may still sample or render to the image
+        VulkanDeletionQueue::Retire( [device = device.GetLogicalDevice(), allocator = device.GetAllocator(),
+                                      imageView = m_ImageView, image = m_Image, allocation = m_Allocation,
+                                      isImageExternal = m_IsImageExternal]() -> void {
+            vkDestroyImageView( device, imageView, nullptr );
 
-        if (!m_IsImageExternal) {
-            vmaDestroyImage( device.GetAllocator(), m_Image, m_Allocation );
-        }
+            if (!isImageExternal) {
+                vmaDestroyImage( allocator, image, allocation );
+            }
+        } );
     }
 
     VulkanImage::~VulkanImage() {
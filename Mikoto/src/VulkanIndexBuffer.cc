@@ -26,11 +26,12 @@ namespace Mikoto {
 
     auto VulkanIndexBuffer::Bind( const VkCommandBuffer commandBuffer ) const -> void {
         // VK_INDEX_TYPE_UINT32 because the indices are created from UInt32_T types
-        vkCmdBindIndexBuffer( commandBuffer, m_Buffer->Get(), 0, VK_INDEX_TYPE_UINT32 );
+        vkCmdBindIndexBuffer( commandBuffer, VulkanContext::Get().GetGeometryHeap().GetIndexBuffer(), m_Allocation.Offset, VK_INDEX_TYPE_UINT32 );
     }
 
     auto VulkanIndexBuffer::Release() -> void {
-        m_Buffer = nullptr;
+        VulkanContext::Get().GetGeometryHeap().FreeIndices( m_Allocation );
+        m_Allocation = {};
     }
 
     VulkanIndexBuffer::~VulkanIndexBuffer() {
@@ -47,24 +48,11 @@ namespace Mikoto {
     auto VulkanIndexBuffer::LoadIndices(const std::span<const UInt32_T>& indices) -> void {
         m_Count = indices.size();
 
-        const VulkanBufferCreateInfo allocaInfo{
-            .BufferCreateInfo{
-                .sType{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO },
-                .size{ m_Count * sizeof(UInt32_T) },
-                .usage{ VK_BUFFER_USAGE_INDEX_BUFFER_BIT }
-            },
-            .AllocationCreateInfo{
-                // Buffer is writeable by host and readable by device
-                // DEPRECATED: look docs for details
-                .usage{ VMA_MEMORY_USAGE_CPU_TO_GPU },
-            },
-            .WantMapping{ true },
-        };
+        m_Size = m_Count * sizeof( UInt32_T );
 
-        m_Buffer = VulkanBuffer::Create( allocaInfo );
+        VulkanGeometryHeap& geometryHeap{ VulkanContext::Get().GetGeometryHeap() };
 
-        // Copy data to CPU readable memory
-        std::memcpy(m_Buffer->GetMappedPtr(), indices.data(), m_Buffer->GetSize() );
-        m_Buffer->PersistentUnmap();
+        m_Allocation = geometryHeap.AllocateIndices( m_Size );
+        geometryHeap.UploadIndices( m_Allocation, indices.data(), m_Size );
     }
 }
\ No newline at end of file
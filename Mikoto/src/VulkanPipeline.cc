@@ -6,6 +6,7 @@
 // C++ Standard Library
 #include <fstream>
 #include <array>
+#include <vector>
 
 // Third-Party Libraries
 #include <volk.h>
@@ -66,8 +67,18 @@ namespace Mikoto {
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{ VulkanHelpers::Initializers::PipelineVertexInputStateCreateInfo() };
 
         // Binding descriptions (define data layout)
-        const auto& bindingDesc{ VulkanVertexBuffer::GetDefaultBindingDescriptions() };
-        const auto& attributeDesc{ VulkanVertexBuffer::GetDefaultAttributeDescriptions() };
+        std::vector<VkVertexInputBindingDescription> bindingDesc{ m_ConfigInfo.VertexBindings.begin(), m_ConfigInfo.VertexBindings.end() };
+        std::vector<VkVertexInputAttributeDescription> attributeDesc{ m_ConfigInfo.VertexAttributes.begin(), m_ConfigInfo.VertexAttributes.end() };
+
+        if ( bindingDesc.empty() ) {
+            bindingDesc = VulkanVertexBuffer::GetDefaultBindingDescriptions();
+            attributeDesc = VulkanVertexBuffer::GetDefaultAttributeDescriptions();
+        }
+
+        if ( m_ConfigInfo.VertexStageReflection != nullptr ) {
+            attributeDesc = m_ConfigInfo.VertexStageReflection->MatchVertexAttributes( attributeDesc );
+        }
+
         vertexInputInfo.vertexBindingDescriptionCount = bindingDesc.size();
         vertexInputInfo.vertexAttributeDescriptionCount = attributeDesc.size();
         vertexInputInfo.pVertexAttributeDescriptions = attributeDesc.data();
@@ -93,7 +104,9 @@ namespace Mikoto {
 
         VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
-        if ( vkCreateGraphicsPipelines( device.GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline ) != VK_SUCCESS ) {
+        const VkPipelineCache pipelineCache{ VulkanContext::Get().GetPipelineCache().Get() };
+
+        if ( vkCreateGraphicsPipelines( device.GetLogicalDevice(), pipelineCache, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanPipeline::Init - Failed to create Graphics pipeline" );
         }
     }
@@ -106,7 +119,9 @@ namespace Mikoto {
 
         VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
-        if ( vkCreateComputePipelines( device.GetLogicalDevice(), VK_NULL_HANDLE, 1,
+        const VkPipelineCache pipelineCache{ VulkanContext::Get().GetPipelineCache().Get() };
+
+        if ( vkCreateComputePipelines( device.GetLogicalDevice(), pipelineCache, 1,
             std::addressof( computePipelineCreateInfo ), nullptr, std::addressof( m_GraphicsPipeline ) ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanPipeline::Init - Failed to create Graphics pipeline" );
         }
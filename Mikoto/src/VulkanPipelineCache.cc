@@ -0,0 +1,199 @@
+/**
+ * VulkanPipelineCache.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Core/Logging/Logger.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
+#include <Renderer/Vulkan/VulkanPipelineCache.hh>
+
+namespace Mikoto {
+
+    auto VulkanPipelineCache::Init( const VulkanPipelineCacheCreateInfo& createInfo ) -> void {
+        m_Device = VulkanContext::Get().GetDevice().GetLogicalDevice();
+        m_FilePath = createInfo.FilePath;
+
+        const std::vector<UInt8_T> initialData{ LoadFromFile() };
+
+        VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+        pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        pipelineCacheCreateInfo.initialDataSize = initialData.size();
+        pipelineCacheCreateInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        m_IsWarm = !initialData.empty();
+
+        if ( vkCreatePipelineCache( m_Device, std::addressof( pipelineCacheCreateInfo ), nullptr, std::addressof( m_PipelineCache ) ) == VK_SUCCESS ) {
+            return;
+        }
+
+        // The driver may still refuse data it produced, start over without it
+        MKT_CORE_LOGGER_WARN( "VulkanPipelineCache::Init - Driver rejected the pipeline cache data, starting with an empty cache." );
+
+        pipelineCacheCreateInfo.initialDataSize = 0;
+        pipelineCacheCreateInfo.pInitialData = nullptr;
+        m_IsWarm = false;
+
+        if ( vkCreatePipelineCache( m_Device, std::addressof( pipelineCacheCreateInfo ), nullptr, std::addressof( m_PipelineCache ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanPipelineCache::Init - Failed to create the pipeline cache." );
+        }
+    }
+
+    auto VulkanPipelineCache::Shutdown() -> void {
+        if ( m_PipelineCache == VK_NULL_HANDLE ) {
+            return;
+        }
+
+        SaveToFile();
+
+        vkDestroyPipelineCache( m_Device, m_PipelineCache, nullptr );
+        m_PipelineCache = VK_NULL_HANDLE;
+    }
+
+    auto VulkanPipelineCache::GetCurrentHeader() const -> FileHeader {
+        // The device UUID is only reported by the 1.1 properties
+        VkPhysicalDeviceIDProperties idProperties{};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = std::addressof( idProperties );
+
+        vkGetPhysicalDeviceProperties2( VulkanContext::Get().GetDevice().GetPhysicalDevice(), std::addressof( properties ) );
+
+        FileHeader header{
+            .Magic{ FILE_MAGIC },
+            .Version{ FILE_VERSION },
+            .VendorID{ properties.properties.vendorID },
+            .DeviceID{ properties.properties.deviceID },
+            .DriverVersion{ properties.properties.driverVersion },
+        };
+
+        std::copy_n( idProperties.deviceUUID, VK_UUID_SIZE, header.DeviceUUID.begin() );
+        std::copy_n( properties.properties.pipelineCacheUUID, VK_UUID_SIZE, header.PipelineCacheUUID.begin() );
+
+        return header;
+    }
+
+    auto VulkanPipelineCache::LoadFromFile() const -> std::vector<UInt8_T> {
+        if ( m_FilePath.empty() ) {
+            return {};
+        }
+
+        std::ifstream file{ m_FilePath, std::ios::binary };
+
+        if ( !file.is_open() ) {
+            MKT_CORE_LOGGER_INFO( "VulkanPipelineCache::LoadFromFile - No pipeline cache at '{}', pipelines will be compiled from scratch.", m_FilePath.string() );
+            return {};
+        }
+
+        FileHeader header{};
+        file.read( reinterpret_cast<char*>( std::addressof( header ) ), sizeof( FileHeader ) );
+
+        const FileHeader current{ GetCurrentHeader() };
+
+        const bool isValid{ file.good() &&
+                            header.Magic == current.Magic &&
+                            header.Version == current.Version &&
+                            header.VendorID == current.VendorID &&
+                            header.DeviceID == current.DeviceID &&
+                            header.DriverVersion == current.DriverVersion &&
+                            header.DeviceUUID == current.DeviceUUID &&
+                            header.PipelineCacheUUID == current.PipelineCacheUUID };
+
+        if ( !isValid ) {
+            MKT_CORE_LOGGER_INFO( "VulkanPipelineCache::LoadFromFile - Pipeline cache at '{}' was created by another device or driver, discarding it.", m_FilePath.string() );
+            return {};
+        }
+
+        // The size comes from the file, it is checked before anything is allocated with it
+        std::error_code error{};
+        const std::uintmax_t fileSize{ std::filesystem::file_size( m_FilePath, error ) };
+
+        if ( error || fileSize < sizeof( FileHeader ) || header.DataSize != fileSize - sizeof( FileHeader ) ) {
+            MKT_CORE_LOGGER_WARN( "VulkanPipelineCache::LoadFromFile - Pipeline cache at '{}' does not match its header, discarding it.", m_FilePath.string() );
+            return {};
+        }
+
+        std::vector<UInt8_T> data( header.DataSize );
+        file.read( reinterpret_cast<char*>( data.data() ), static_cast<std::streamsize>( data.size() ) );
+
+        if ( !file.good() ) {
+            MKT_CORE_LOGGER_WARN( "VulkanPipelineCache::LoadFromFile - Pipeline cache at '{}' is truncated, discarding it.", m_FilePath.string() );
+            return {};
+        }
+
+        MKT_CORE_LOGGER_INFO( "VulkanPipelineCache::LoadFromFile - Loaded {} bytes of pipeline cache from '{}'.", data.size(), m_FilePath.string() );
+
+        return data;
+    }
+
+    auto VulkanPipelineCache::SaveToFile() const -> void {
+        if ( m_FilePath.empty() ) {
+            return;
+        }
+
+        Size_T dataSize{};
+        vkGetPipelineCacheData( m_Device, m_PipelineCache, std::addressof( dataSize ), nullptr );
+
+        std::vector<UInt8_T> data( dataSize );
+
+        if ( vkGetPipelineCacheData( m_Device, m_PipelineCache, std::addressof( dataSize ), data.data() ) != VK_SUCCESS ) {
+            MKT_CORE_LOGGER_ERROR( "VulkanPipelineCache::SaveToFile - Failed to retrieve the pipeline cache data." );
+            return;
+        }
+
+        FileHeader header{ GetCurrentHeader() };
+        header.DataSize = dataSize;
+
+        std::error_code errorCode{};
+        std::filesystem::create_directories( m_FilePath.parent_path(), errorCode );
+
+        // Written next to the destination and renamed, a crash while saving does not leave a truncated cache behind
+        Path_T temporaryPath{ m_FilePath };
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+
+            if ( !file.is_open() ) {
+                MKT_CORE_LOGGER_ERROR( "VulkanPipelineCache::SaveToFile - Could not open '{}' for writing.", temporaryPath.string() );
+                return;
+            }
+
+            file.write( reinterpret_cast<const char*>( std::addressof( header ) ), sizeof( FileHeader ) );
+            file.write( reinterpret_cast<const char*>( data.data() ), static_cast<std::streamsize>( dataSize ) );
+            file.close();
+
+            // A short write (i.e, disk full) must not replace the cache saved last time
+            if ( !file.good() ) {
+                MKT_CORE_LOGGER_ERROR( "VulkanPipelineCache::SaveToFile - Failed to write '{}', keeping the previous pipeline cache.", temporaryPath.string() );
+                std::filesystem::remove( temporaryPath, errorCode );
+                return;
+            }
+        }
+
+        std::filesystem::rename( temporaryPath, m_FilePath, errorCode );
+
+        if ( errorCode ) {
+            MKT_CORE_LOGGER_ERROR( "VulkanPipelineCache::SaveToFile - Failed to write the pipeline cache to '{}'. {}", m_FilePath.string(), errorCode.message() );
+            return;
+        }
+
+        MKT_CORE_LOGGER_INFO( "VulkanPipelineCache::SaveToFile - Saved {} bytes of pipeline cache to '{}'.", dataSize, m_FilePath.string() );
+    }
+}
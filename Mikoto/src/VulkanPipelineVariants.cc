@@ -0,0 +1,214 @@
+/**
+ * VulkanPipelineVariants.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Core/Engine.hh>
+#include <Core/Logging/Logger.hh>
+#include <Core/System/TaskSystem.hh>
+#include <Renderer/Buffer/VertexBuffer.hh>
+#include <Renderer/Vulkan/VulkanPipelineVariants.hh>
+#include <Renderer/Vulkan/VulkanVertexBuffer.hh>
+
+namespace Mikoto {
+
+    namespace {
+        // Matches the layout of the specialization constants, see the map entries below
+        struct SpecializationData {
+            Int32_T RenderMode{};
+            VkBool32 Wireframe{};
+            VkBool32 CompactVertices{};
+        };
+
+        // Default variant of the pass keeping the features the draws rely on
+        auto GetFallbackKey( const VulkanPipelineVariantKey& defaultKey, const VulkanPipelineVariantKey& key ) -> VulkanPipelineVariantKey {
+            return VulkanPipelineVariantKey{
+                .Pass{ defaultKey.Pass },
+                .RenderMode{ defaultKey.RenderMode },
+                .Features{ defaultKey.Features | ( key.Features & PIPELINE_VARIANT_REQUIRED_FEATURES ) },
+            };
+        }
+    }
+
+    auto VulkanPipelineVariantCache::Init() -> void {
+        m_IsShuttingDown = false;
+    }
+
+    auto VulkanPipelineVariantCache::Shutdown() -> void {
+        {
+            std::scoped_lock lock{ m_Mutex };
+            m_IsShuttingDown = true;
+        }
+
+        // Builds not started yet return right away
+        Engine::GetSystem<TaskSystem>().Wait( m_CompileJobs );
+
+        m_Variants.clear();
+        m_PendingVariants.clear();
+        m_Passes.clear();
+    }
+
+    auto VulkanPipelineVariantCache::AddPass( const Size_T pass, const VulkanPipelineCreateInfo& createInfo, const UInt32_T defaultRenderMode ) -> void {
+        auto passState{ CreateScope<PassState>() };
+
+        passState->CreateInfo = createInfo;
+        passState->DefaultKey = VulkanPipelineVariantKey{ .Pass{ pass }, .RenderMode{ defaultRenderMode }, .Features{ PIPELINE_VARIANT_FEATURE_NONE } };
+
+        passState->ShaderStages.assign( createInfo.ShaderStages.begin(), createInfo.ShaderStages.end() );
+        passState->VertexBindings.assign( createInfo.VertexBindings.begin(), createInfo.VertexBindings.end() );
+        passState->VertexAttributes.assign( createInfo.VertexAttributes.begin(), createInfo.VertexAttributes.end() );
+        passState->DynamicStates.assign( createInfo.DynamicStateEnables.begin(), createInfo.DynamicStateEnables.end() );
+
+        passState->CreateInfo.ShaderStages = passState->ShaderStages;
+        passState->CreateInfo.VertexBindings = passState->VertexBindings;
+        passState->CreateInfo.VertexAttributes = passState->VertexAttributes;
+        passState->CreateInfo.DynamicStateEnables = passState->DynamicStates;
+        passState->CreateInfo.DynamicStateInfo.pDynamicStates = passState->DynamicStates.data();
+        passState->CreateInfo.DynamicStateInfo.dynamicStateCount = static_cast<UInt32_T>( passState->DynamicStates.size() );
+
+        // The blend state points to the attachment of the create info it was copied from
+        if ( passState->CreateInfo.ColorBlendInfo.attachmentCount != 0 ) {
+            passState->CreateInfo.ColorBlendInfo.pAttachments = std::addressof( passState->CreateInfo.ColorBlendAttachment );
+        }
+
+        // Frames recorded before any other variant is ready use these ones
+        VulkanPipelineVariantKey compactKey{ passState->DefaultKey };
+        compactKey.Features |= PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES;
+
+        Scope_T<VulkanPipeline> defaultVariant{ Build( *passState, passState->DefaultKey ) };
+        Scope_T<VulkanPipeline> compactVariant{ Build( *passState, compactKey ) };
+
+        std::scoped_lock lock{ m_Mutex };
+
+        m_Variants.insert_or_assign( passState->DefaultKey, std::move( defaultVariant ) );
+        m_Variants.insert_or_assign( compactKey, std::move( compactVariant ) );
+        m_Passes.insert_or_assign( pass, std::move( passState ) );
+    }
+
+    auto VulkanPipelineVariantCache::Resolve( const VulkanPipelineVariantKey& key ) -> const VulkanPipeline* {
+        std::unique_lock lock{ m_Mutex };
+
+        const auto passIt{ m_Passes.find( key.Pass ) };
+        if ( passIt == m_Passes.end() ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanPipelineVariantCache::Resolve - Pass has no variants." );
+        }
+
+        if ( const auto it{ m_Variants.find( key ) }; it != m_Variants.end() && it->second != nullptr ) {
+            return it->second.get();
+        }
+
+        if ( !m_Variants.contains( key ) && !m_PendingVariants.contains( key ) ) {
+            m_PendingVariants.insert( key );
+
+            lock.unlock();
+            Engine::GetSystem<TaskSystem>().Dispatch( 1, 1, [this, key]( MKT_UNUSED_VAR const TaskSystem::JobDispatchArgs args ) -> void { Compile( key ); }, m_CompileJobs );
+            lock.lock();
+        }
+
+        return m_Variants.at( GetFallbackKey( passIt->second->DefaultKey, key ) ).get();
+    }
+
+    auto VulkanPipelineVariantCache::Build( const PassState& passState, const VulkanPipelineVariantKey& key ) -> Scope_T<VulkanPipeline> {
+        const SpecializationData specializationData{
+            .RenderMode{ static_cast<Int32_T>( key.RenderMode ) },
+            .Wireframe{ ( key.Features & PIPELINE_VARIANT_FEATURE_WIREFRAME ) != 0 ? VK_TRUE : VK_FALSE },
+            .CompactVertices{ ( key.Features & PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES ) != 0 ? VK_TRUE : VK_FALSE },
+        };
+
+        const std::array mapEntries{
+            VkSpecializationMapEntry{ RENDER_MODE_CONSTANT_ID, offsetof( SpecializationData, RenderMode ), sizeof( Int32_T ) },
+            VkSpecializationMapEntry{ WIREFRAME_CONSTANT_ID, offsetof( SpecializationData, Wireframe ), sizeof( VkBool32 ) },
+            VkSpecializationMapEntry{ COMPACT_VERTICES_CONSTANT_ID, offsetof( SpecializationData, CompactVertices ), sizeof( VkBool32 ) },
+        };
+
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = static_cast<UInt32_T>( mapEntries.size() );
+        specializationInfo.pMapEntries = mapEntries.data();
+        specializationInfo.dataSize = sizeof( SpecializationData );
+        specializationInfo.pData = std::addressof( specializationData );
+
+        // Stages that do not declare the constants ignore them
+        std::vector<VkPipelineShaderStageCreateInfo> shaderStages{ passState.ShaderStages };
+        for ( VkPipelineShaderStageCreateInfo& stage : shaderStages ) {
+            stage.pSpecializationInfo = std::addressof( specializationInfo );
+        }
+
+        VulkanPipelineCreateInfo createInfo{ passState.CreateInfo };
+        createInfo.ShaderStages = shaderStages;
+
+        if ( createInfo.ColorBlendInfo.attachmentCount != 0 ) {
+            createInfo.ColorBlendInfo.pAttachments = std::addressof( createInfo.ColorBlendAttachment );
+        }
+
+        // Referenced by the create info until the pipeline is built
+        std::vector<VkVertexInputBindingDescription> vertexBindings{};
+        std::vector<VkVertexInputAttributeDescription> vertexAttributes{};
+
+        // Same attribute locations, the vertex shader decodes them with the specialization constant
+        if ( ( key.Features & PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES ) != 0 ) {
+            const BufferLayout& compactLayout{ VertexBuffer::GetBufferLayout( VertexFormat::COMPACT ) };
+
+            vertexBindings = VulkanVertexBuffer::GetDefaultBindingDescriptions( compactLayout );
+            vertexAttributes = VulkanVertexBuffer::GetDefaultAttributeDescriptions( compactLayout );
+
+            createInfo.VertexBindings = vertexBindings;
+            createInfo.VertexAttributes = vertexAttributes;
+        }
+
+        if ( ( key.Features & PIPELINE_VARIANT_FEATURE_WIREFRAME ) != 0 ) {
+            constexpr float GPU_STANDARD_LINE_WIDTH{ 1.0f };
+
+            createInfo.RasterizationInfo.polygonMode = VK_POLYGON_MODE_LINE;
+            createInfo.RasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+            createInfo.RasterizationInfo.lineWidth = GPU_STANDARD_LINE_WIDTH;
+        }
+
+        auto pipeline{ CreateScope<VulkanPipeline>( createInfo ) };
+        pipeline->Init();
+
+        return pipeline;
+    }
+
+    auto VulkanPipelineVariantCache::Compile( const VulkanPipelineVariantKey& key ) -> void {
+        const PassState* passState{};
+
+        {
+            std::scoped_lock lock{ m_Mutex };
+
+            if ( m_IsShuttingDown ) {
+                return;
+            }
+
+            // Passes are never removed while builds are in progress
+            passState = m_Passes.at( key.Pass ).get();
+        }
+
+        Scope_T<VulkanPipeline> pipeline{};
+
+        try {
+            pipeline = Build( *passState, key );
+        } catch ( MKT_UNUSED_VAR const std::exception& exception ) {
+            MKT_CORE_LOGGER_ERROR( "VulkanPipelineVariantCache::Compile - Failed to build variant of pass {}, render mode {}, features {}. {}",
+                key.Pass, key.RenderMode, key.Features, exception.what() );
+        }
+
+        std::scoped_lock lock{ m_Mutex };
+
+        m_PendingVariants.erase( key );
+        m_Variants.insert_or_assign( key, std::move( pipeline ) );
+    }
+}
@@ -4,7 +4,15 @@
  * */
 
 // C++ Standard Library
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 // Third-Party Libraries
 #include <volk.h>
@@ -12,8 +20,11 @@
 // Project Headers
 #include <Common/Common.hh>
 #include <Core/System/FileSystem.hh>
+#include <Core/System/TaskSystem.hh>
 #include <Core/System/TimeSystem.hh>
 #include <Library/Filesystem/PathBuilder.hh>
+#include <Profiling/Timer.hh>
+#include <Renderer/Vulkan/VulkanBindlessManager.hh>
 #include <Renderer/Vulkan/VulkanContext.hh>
 #include <Renderer/Vulkan/VulkanDeletionQueue.hh>
 #include <Renderer/Vulkan/VulkanDescriptorManager.hh>
@@ -122,6 +133,35 @@ namespace Mikoto {
         return configInfo;
     }
 
+    // Planes of the frustum in world space, pointing inside. The projection maps depth to [0, 1]
+    static auto GetFrustumPlanes( const glm::mat4& viewProjection ) -> std::array<glm::vec4, 6> {
+        const glm::vec4 row0{ viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+        const glm::vec4 row1{ viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+        const glm::vec4 row2{ viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+        const glm::vec4 row3{ viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+        std::array planes{
+            row3 + row0, // left
+            row3 - row0, // right
+            row3 + row1, // bottom
+            row3 - row1, // top
+            row2,        // near
+            row3 - row2, // far
+        };
+
+        // Normalized so the distance to the plane can be compared with a radius
+        for ( glm::vec4& plane : planes ) {
+            plane /= glm::length( glm::vec3{ plane } );
+        }
+
+        return planes;
+    }
+
+    // Depth pre-pass pipeline reading the positions stream of the given vertex format
+    static auto GetDepthPrepassPass( const VertexFormat format ) -> MaterialPass {
+        return format == VertexFormat::COMPACT ? MATERIAL_PASS_DEPTH_PREPASS_COMPACT : MATERIAL_PASS_DEPTH_PREPASS;
+    }
+
     VulkanRenderer::VulkanRenderer( const VulkanRendererCreateInfo& createInfo )
         : m_OffscreenExtent{
               .width{ createInfo.Info.ViewportWidth },
@@ -137,9 +177,12 @@ namespace Mikoto {
         try {
             CreateCommandPools();
             CreateCommandBuffers();
+            CreateSecondaryCommandBuffers();
+            CreateSceneLightsBuffers();
 
             PrepareOffscreenRender();
 
+            m_PipelineVariants.Init();
             CreateRendererPipelines();
         } catch ( std::exception& exception ) {
             MKT_CORE_LOGGER_ERROR( "VulkanRenderer::Init - Exception {}", exception.what() );
@@ -164,6 +207,22 @@ namespace Mikoto {
     auto VulkanRenderer::Shutdown() -> void {
         m_Device->WaitIdle();
 
+        m_FramePipelineVariants.fill( nullptr );
+        m_PipelineVariants.Shutdown();
+
+        m_RecordingContexts.clear();
+
+        m_SceneLightsBuffers.clear();
+        m_ClusterGridBuffers.clear();
+        m_ClusterLightIndicesBuffers.clear();
+        m_FrameUniformBuffers.clear();
+        m_DrawInstanceBuffers.clear();
+        m_DrawMeshletBuffers.clear();
+        m_IndirectDrawBuffers.clear();
+        m_DepthPrepassIndirectDrawBuffers.clear();
+        m_IndirectDrawCountBuffers.clear();
+        m_SceneLightsDescriptorSets.clear();
+
         m_OffscreenColorAttachment = nullptr;
         m_OffscreenDepthAttachment = nullptr;
     }
@@ -183,6 +242,10 @@ namespace Mikoto {
         m_WireframeEnable = enable;
     }
 
+    auto VulkanRenderer::EnableDepthPrepass( const bool enable ) -> void {
+        m_DepthPrepassEnable = enable;
+    }
+
     auto VulkanRenderer::RemoveLight( const UInt64_T id ) -> bool {
         const UInt64_T count{ m_Lights.erase( id ) };
 
@@ -214,113 +277,508 @@ namespace Mikoto {
     }
 
     auto VulkanRenderer::CreateCommandBuffers() -> void {
-        // Create as many as images we have to render
-        constexpr UInt32_T COMMAND_BUFFERS_COUNT{ 1 };
+        // One command buffer per frame in flight, so we can record
+        // a frame while the GPU is still processing the previous ones
+        const UInt32_T framesInFlight{ VulkanContext::Get().GetFramesInFlight() };
 
         VkCommandBufferAllocateInfo allocInfo{ VulkanHelpers::Initializers::CommandBufferAllocateInfo() };
         allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         allocInfo.commandPool = m_GraphicsCommandPool->Get();
-        allocInfo.commandBufferCount = COMMAND_BUFFERS_COUNT;
+        allocInfo.commandBufferCount = 1;
 
-        m_DrawCommandBuffer = *m_GraphicsCommandPool->AllocateCommandBuffer( allocInfo );
+        m_DrawCommandBuffers.clear();
+        m_ComputeCommandBuffers.clear();
 
-        // Compute command buffer
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = m_ComputeCommandPool->Get();
-        allocInfo.commandBufferCount = COMMAND_BUFFERS_COUNT;
-        m_ComputeCommandBuffer = *m_ComputeCommandPool->AllocateCommandBuffer( allocInfo );
+        for ( UInt32_T frameIndex{}; frameIndex < framesInFlight; ++frameIndex ) {
+            allocInfo.commandPool = m_GraphicsCommandPool->Get();
+            m_DrawCommandBuffers.emplace_back( *m_GraphicsCommandPool->AllocateCommandBuffer( allocInfo ) );
+
+            // Compute command buffer
+            allocInfo.commandPool = m_ComputeCommandPool->Get();
+            m_ComputeCommandBuffers.emplace_back( *m_ComputeCommandPool->AllocateCommandBuffer( allocInfo ) );
+        }
     }
 
-    auto VulkanRenderer::SetupObjectOutline( const MeshRenderInfo& meshRenderInfo ) -> void {
-        // TODO: fix outline
-        if (true) {
-            return;
+    auto VulkanRenderer::CreateSecondaryCommandBuffers() -> void {
+        // One recording context per worker and frame in flight. Each context gets its
+        // own command pool as pools can't be used from multiple threads at the same time
+        const UInt32_T framesInFlight{ VulkanContext::Get().GetFramesInFlight() };
+        const UInt32_T recordingTasks{ std::max( 1u, Engine::GetSystem<TaskSystem>().GetWorkersCount() ) };
+
+        const auto& [Present, Graphics, Compute, Transfer]{ m_Device->GetLogicalDeviceQueues() };
+
+        m_RecordingContexts.resize( framesInFlight );
+
+        for ( std::vector<SecondaryRecordingContext>& frameContexts : m_RecordingContexts ) {
+            frameContexts.resize( recordingTasks );
+
+            for ( SecondaryRecordingContext& context : frameContexts ) {
+                // Pools are reset as a whole every frame
+                VkCommandPoolCreateInfo poolCreateInfo{ VulkanHelpers::Initializers::CommandPoolCreateInfo() };
+                poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                poolCreateInfo.queueFamilyIndex = Graphics->FamilyIndex;
+
+                context.CommandPool = VulkanCommandPool::Create( VulkanCommandPoolCreateInfo{ .CreateInfo{ poolCreateInfo } } );
+
+                VkCommandBufferAllocateInfo allocInfo{ VulkanHelpers::Initializers::CommandBufferAllocateInfo() };
+                allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+                allocInfo.commandPool = context.CommandPool->Get();
+                allocInfo.commandBufferCount = 1;
+
+                context.CommandBuffer = *context.CommandPool->AllocateCommandBuffer( allocInfo );
+            }
         }
+    }
 
-        const VulkanPipeline* pipeline{ nullptr };
+    auto VulkanRenderer::CreateSceneLightsBuffers() -> void {
+        const UInt32_T framesInFlight{ VulkanContext::Get().GetFramesInFlight() };
+        const VkDescriptorSetLayout& descriptorSetLayout{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS ) };
+        VulkanDescriptorAllocator& descriptorAllocator{ VulkanContext::Get().GetDescriptorAllocator() };
 
-        VulkanPBRMaterial* pbrMaterial{ dynamic_cast<VulkanPBRMaterial*>( meshRenderInfo.MaterialData ) };
+        constexpr VkDeviceSize clusterGridSize{ CLUSTER_COUNT * sizeof( glm::uvec4 ) };
+        constexpr VkDeviceSize clusterLightIndicesSize{ CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER * sizeof( UInt32_T ) };
 
-        // Setup render mode
-        pbrMaterial->SetRenderMode( m_RenderMode );
-        pbrMaterial->EnableWireframe( m_WireframeEnable ? MKT_SHADER_TRUE : MKT_SHADER_FALSE );
+        constexpr VkDeviceSize drawInstancesSize{ MAX_DRAW_INSTANCES * sizeof( DrawInstanceData ) };
+        constexpr VkDeviceSize drawMeshletsSize{ MAX_DRAW_MESHLETS * sizeof( DrawMeshletData ) };
+        constexpr VkDeviceSize indirectDrawsSize{ VERTEX_FORMAT_COUNT * MAX_DRAW_MESHLETS * sizeof( VkDrawIndexedIndirectCommand ) };
+        constexpr VkDeviceSize indirectDrawCountsSize{ VERTEX_FORMAT_COUNT * sizeof( UInt32_T ) };
 
-        // The material will store its passes so we dont have to do the switch stamentnt below
-        auto findIt{ m_Pipelines.find( MATERIAL_PASS_OUTLINE ) };
+        m_SceneLightsBuffers.clear();
+        m_ClusterGridBuffers.clear();
+        m_ClusterLightIndicesBuffers.clear();
+        m_FrameUniformBuffers.clear();
+        m_DrawInstanceBuffers.clear();
+        m_DrawMeshletBuffers.clear();
+        m_IndirectDrawBuffers.clear();
+        m_DepthPrepassIndirectDrawBuffers.clear();
+        m_IndirectDrawCountBuffers.clear();
+        m_SceneLightsDescriptorSets.clear();
 
-        pipeline = findIt != m_Pipelines.end() ? std::addressof( findIt->second ) : nullptr;
-        if ( pipeline == nullptr ) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordCommands - Pipeline objects are null." );
+        for ( UInt32_T frameIndex{}; frameIndex < framesInFlight; ++frameIndex ) {
+            // [Lights, written by the host every frame]
+            VulkanBufferCreateInfo lightsAllocInfo{};
+
+            lightsAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            lightsAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            lightsAllocInfo.BufferCreateInfo.size = sizeof( SceneLightsData );
+
+            lightsAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            lightsAllocInfo.WantMapping = true;
+
+            const Scope_T<VulkanBuffer>& lightsBuffer{ m_SceneLightsBuffers.emplace_back( VulkanBuffer::Create( lightsAllocInfo ) ) };
+
+            // [Cluster lists, only touched by the GPU]
+            VulkanBufferCreateInfo clusterAllocInfo{};
+
+            clusterAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            clusterAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            clusterAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            clusterAllocInfo.WantMapping = false;
+
+            clusterAllocInfo.BufferCreateInfo.size = clusterGridSize;
+            const Scope_T<VulkanBuffer>& clusterGridBuffer{ m_ClusterGridBuffers.emplace_back( VulkanBuffer::Create( clusterAllocInfo ) ) };
+
+            clusterAllocInfo.BufferCreateInfo.size = clusterLightIndicesSize;
+            const Scope_T<VulkanBuffer>& clusterLightIndicesBuffer{ m_ClusterLightIndicesBuffers.emplace_back( VulkanBuffer::Create( clusterAllocInfo ) ) };
+
+            // [Camera of the frame, written by the host every frame]
+            VulkanBufferCreateInfo frameAllocInfo{};
+
+            frameAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            frameAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+            frameAllocInfo.BufferCreateInfo.size = sizeof( FrameUniformData );
+
+            frameAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            frameAllocInfo.WantMapping = true;
+
+            const Scope_T<VulkanBuffer>& frameUniformBuffer{ m_FrameUniformBuffers.emplace_back( VulkanBuffer::Create( frameAllocInfo ) ) };
+
+            // [Draw instances and their meshlets, written by the host every frame]
+            VulkanBufferCreateInfo instancesAllocInfo{};
+
+            instancesAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            instancesAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            instancesAllocInfo.BufferCreateInfo.size = drawInstancesSize;
+
+            instancesAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+            instancesAllocInfo.WantMapping = true;
+
+            const Scope_T<VulkanBuffer>& drawInstancesBuffer{ m_DrawInstanceBuffers.emplace_back( VulkanBuffer::Create( instancesAllocInfo ) ) };
+
+            instancesAllocInfo.BufferCreateInfo.size = drawMeshletsSize;
+            const Scope_T<VulkanBuffer>& drawMeshletsBuffer{ m_DrawMeshletBuffers.emplace_back( VulkanBuffer::Create( instancesAllocInfo ) ) };
+
+            // [Indirect draws, written by the draw culling pass]
+            VulkanBufferCreateInfo indirectAllocInfo{};
+
+            indirectAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            indirectAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+            indirectAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            indirectAllocInfo.WantMapping = false;
+
+            indirectAllocInfo.BufferCreateInfo.size = indirectDrawsSize;
+            const Scope_T<VulkanBuffer>& indirectDrawBuffer{ m_IndirectDrawBuffers.emplace_back( VulkanBuffer::Create( indirectAllocInfo ) ) };
+            const Scope_T<VulkanBuffer>& depthPrepassIndirectDrawBuffer{ m_DepthPrepassIndirectDrawBuffers.emplace_back( VulkanBuffer::Create( indirectAllocInfo ) ) };
+
+            // Cleared with vkCmdFillBuffer before the culling appends to it
+            indirectAllocInfo.BufferCreateInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            indirectAllocInfo.BufferCreateInfo.size = indirectDrawCountsSize;
+            const Scope_T<VulkanBuffer>& indirectDrawCountBuffer{ m_IndirectDrawCountBuffers.emplace_back( VulkanBuffer::Create( indirectAllocInfo ) ) };
+
+            // The set always points to the same buffers, it never has to be updated again
+            const VkDescriptorSet descriptorSet{ *descriptorAllocator.Allocate( m_Device->GetLogicalDevice(), descriptorSetLayout ) };
+
+            VulkanDescriptorWriter()
+                .WriteBuffer( 0, lightsBuffer->Get(), sizeof( SceneLightsData ), 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 1, clusterGridBuffer->Get(), clusterGridSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 2, clusterLightIndicesBuffer->Get(), clusterLightIndicesSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 3, frameUniformBuffer->Get(), sizeof( FrameUniformData ), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER )
+                .WriteBuffer( 4, drawInstancesBuffer->Get(), drawInstancesSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 5, indirectDrawBuffer->Get(), indirectDrawsSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 6, depthPrepassIndirectDrawBuffer->Get(), indirectDrawsSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 7, indirectDrawCountBuffer->Get(), indirectDrawCountsSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .WriteBuffer( 8, drawMeshletsBuffer->Get(), drawMeshletsSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER )
+                .UpdateSet( m_Device->GetLogicalDevice(), descriptorSet );
+
+            m_SceneLightsDescriptorSets.emplace_back( descriptorSet );
         }
+    }
+
+    auto VulkanRenderer::UploadSceneLights() -> void {
+        // The buffer of the current frame is no longer read by the GPU, the context waited for its fence.
+        // Written in place, the light arrays are large and only the part in use is touched
+        SceneLightsData& sceneLights{ *static_cast<SceneLightsData*>( m_SceneLightsBuffers[VulkanContext::Get().GetCurrentFrameIndex()]->GetMappedPtr() ) };
+
+        glm::ivec4 lightCounts{ 0 };
+
+        for ( const auto& [data, activeType] : m_Lights | std::views::values ) {
+            switch ( activeType ) {
+                case LightType::DIRECTIONAL_LIGHT_TYPE:
+                    if ( lightCounts.x < MAX_DIRECTIONAL_LIGHTS_PER_SCENE ) {
+                        sceneLights.DirectionalLights[lightCounts.x++] = data->DireLightData;
+                    }
+                    break;
+
+                case LightType::POINT_LIGHT_TYPE:
+                    if ( lightCounts.y < MAX_LIGHTS_PER_SCENE ) {
+                        sceneLights.PointLights[lightCounts.y++] = data->PointLightDat;
+                    }
+                    break;
+
+                case LightType::SPOT_LIGHT_TYPE:
+                    if ( lightCounts.z < MAX_LIGHTS_PER_SCENE ) {
+                        sceneLights.SpotLights[lightCounts.z++] = data->SpotLightData;
+                    }
+                    break;
+            }
+        }
+
+        sceneLights.LightCounts = lightCounts;
 
-        pbrMaterial->SetProjection( m_Camera->GetProjection() );
-        pbrMaterial->SetView( m_Camera->GetViewMatrix() );
-        pbrMaterial->SetTransform( meshRenderInfo.MeshRenderInfo::Transform );
-        pbrMaterial->SetViewPosition( m_Camera->GetPosition() );
+        // Exponential depth slices: slice = log(depth) * scale - bias
+        const float nearPlane{ m_Camera->GetNearPlane() };
+        const float farPlane{ m_Camera->GetFarPlane() };
+        const float depthRangeLog{ std::log( farPlane / nearPlane ) };
+
+        sceneLights.ClusterGridSize = glm::uvec4{ CLUSTER_GRID_SIZE_X, CLUSTER_GRID_SIZE_Y, CLUSTER_GRID_SIZE_Z, MAX_LIGHTS_PER_CLUSTER };
+        sceneLights.ClusterDepthParams = glm::vec4{
+            nearPlane,
+            farPlane,
+            static_cast<float>( CLUSTER_GRID_SIZE_Z ) / depthRangeLog,
+            static_cast<float>( CLUSTER_GRID_SIZE_Z ) * std::log( nearPlane ) / depthRangeLog
+        };
+
+        const auto width{ static_cast<float>( m_OffscreenExtent.width ) };
+        const auto height{ static_cast<float>( m_OffscreenExtent.height ) };
+
+        sceneLights.ScreenSize = glm::vec4{
+            width,
+            height,
+            std::ceil( width / static_cast<float>( CLUSTER_GRID_SIZE_X ) ),
+            std::ceil( height / static_cast<float>( CLUSTER_GRID_SIZE_Y ) )
+        };
+
+        sceneLights.View = m_Camera->GetViewMatrix();
+        sceneLights.InverseProjection = glm::inverse( m_Camera->GetProjection() );
+    }
 
-        pbrMaterial->ResetLights();
+    auto VulkanRenderer::RecordLightCulling( const VkCommandBuffer cmd ) -> void {
+        const auto findIt{ m_Pipelines.find( MATERIAL_PASS_LIGHT_CULLING ) };
 
-        for ( const auto& lightInfo: m_Lights | std::views::values ) {
-            pbrMaterial->UpdateLightsInfo( *lightInfo.Data, lightInfo.ActiveType );
+        if ( findIt == m_Pipelines.end() ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordLightCulling - Light culling pipeline is missing." );
         }
 
-        pbrMaterial->UploadUniformBuffers();
-        pbrMaterial->BindDescriptorSet( m_DrawCommandBuffer, pipeline->GetLayout() );
+        const VulkanPipeline& cullingPipeline{ findIt->second };
 
-        pipeline->Bind( m_DrawCommandBuffer );
+        // Same set the graphics pipelines bind as set 1
+        vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullingPipeline.Get() );
+        vkCmdBindDescriptorSets( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullingPipeline.GetLayout(), 0, 1,
+            std::addressof( m_SceneLightsDescriptorSets[VulkanContext::Get().GetCurrentFrameIndex()] ), 0, nullptr );
 
-        const VulkanVertexBuffer* vulkanVertexBuffer{ dynamic_cast<const VulkanVertexBuffer*>( meshRenderInfo.Object->GetVertexBuffer() ) };
-        const VulkanIndexBuffer* vulkanIndexBuffer{ dynamic_cast<const VulkanIndexBuffer*>( meshRenderInfo.Object->GetIndexBuffer() ) };
+        // One invocation per cluster
+        constexpr UInt32_T groupCount{ ( CLUSTER_COUNT + LIGHT_CULLING_GROUP_SIZE - 1 ) / LIGHT_CULLING_GROUP_SIZE };
+        vkCmdDispatch( cmd, groupCount, 1, 1 );
 
-        vulkanVertexBuffer->Bind( m_DrawCommandBuffer );
-        vulkanIndexBuffer->Bind( m_DrawCommandBuffer );
+        // The cluster lists have to be written before the fragment shaders of the main pass read them
+        VkMemoryBarrier barrier{ VulkanHelpers::Initializers::MemoryBarrier() };
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-        vkCmdDrawIndexed( m_DrawCommandBuffer, vulkanIndexBuffer->GetCount(), 1, 0, 0, 0 );
+        vkCmdPipelineBarrier( cmd,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+            1, std::addressof( barrier ),
+            0, nullptr,
+            0, nullptr );
     }
 
-    auto VulkanRenderer::SetupPBRPass( const MeshRenderInfo& meshRenderInfo ) -> void {
-        const VulkanPipeline* pipeline{ nullptr };
+    auto VulkanRenderer::UploadDrawInstances() -> void {
+        // The buffers of the current frame are no longer read by the GPU, the context waited for its fence
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+        DrawInstanceData* instances{ static_cast<DrawInstanceData*>( m_DrawInstanceBuffers[frameIndex]->GetMappedPtr() ) };
+        DrawMeshletData* meshlets{ static_cast<DrawMeshletData*>( m_DrawMeshletBuffers[frameIndex]->GetMappedPtr() ) };
+
+        // Same as the lights, draws past the capacity of the buffers are dropped
+        m_DrawInstanceCount = static_cast<UInt32_T>( std::min<Size_T>( m_IndirectDrawList.size(), MAX_DRAW_INSTANCES ) );
+        m_DrawMeshletCount = 0;
+        m_FormatDrawMeshletCounts.fill( 0 );
+
+        if ( m_IndirectDrawList.size() > MAX_DRAW_INSTANCES && !m_HasReportedDrawInstanceLimit ) {
+            MKT_CORE_LOGGER_WARN( "VulkanRenderer::UploadDrawInstances - {} PBR draws this frame, only the first {} are drawn. Raise MAX_DRAW_INSTANCES.",
+                m_IndirectDrawList.size(), MAX_DRAW_INSTANCES );
+            m_HasReportedDrawInstanceLimit = true;
+        }
+
+        Size_T droppedMeshletCount{};
+
+        for ( UInt32_T index{}; index < m_DrawInstanceCount; ++index ) {
+            const MeshRenderInfo& meshRenderInfo{ *m_IndirectDrawList[index] };
+
+            const VulkanPBRMaterial* pbrMaterial{ dynamic_cast<const VulkanPBRMaterial*>( meshRenderInfo.MaterialData ) };
+            const VulkanVertexBuffer* vulkanVertexBuffer{ dynamic_cast<const VulkanVertexBuffer*>( meshRenderInfo.Object->GetVertexBuffer() ) };
+            const VulkanIndexBuffer* vulkanIndexBuffer{ dynamic_cast<const VulkanIndexBuffer*>( meshRenderInfo.Object->GetIndexBuffer() ) };
+
+            const auto format{ static_cast<UInt32_T>( vulkanVertexBuffer->GetFormat() ) };
+            const VertexDequantization& dequantization{ vulkanVertexBuffer->GetDequantization() };
+            const MeshLod& lod{ meshRenderInfo.Object->GetLods()[meshRenderInfo.LodIndex] };
+
+            // Normals only keep their angles under a uniform scale, and mirroring swaps the faces
+            constexpr float coneScaleTolerance{ 1e-3f };
+
+            const glm::mat3 basis{ meshRenderInfo.Transform };
+            const float minScale{ std::min( { glm::length( basis[0] ), glm::length( basis[1] ), glm::length( basis[2] ) } ) };
+            const float maxScale{ std::max( { glm::length( basis[0] ), glm::length( basis[1] ), glm::length( basis[2] ) } ) };
+            const bool keepsCones{ glm::determinant( basis ) > 0.0f && maxScale - minScale <= maxScale * coneScaleTolerance };
+
+            instances[index] = DrawInstanceData{
+                .Transform{ meshRenderInfo.Transform },
+                .BoundingSphere{ vulkanVertexBuffer->GetBoundingSphere() },
+                .Geometry{
+                    static_cast<Int32_T>( lod.IndexCount ),
+                    static_cast<Int32_T>( vulkanIndexBuffer->GetFirstIndex() + lod.FirstIndex ),
+                    vulkanVertexBuffer->GetVertexOffset(),
+                    vulkanVertexBuffer->GetPositionsVertexOffset() },
+                .Material{ pbrMaterial->GetBindlessIndex(), format, keepsCones ? 1u : 0u, 0 },
+                .PositionScale{ dequantization.PositionScale, 0.0f },
+                .PositionOffset{ dequantization.PositionOffset, 0.0f },
+                .TexCoordTransform{ dequantization.TexCoordScale, dequantization.TexCoordOffset },
+            };
+
+            const auto addMeshlet{ [&]( const glm::vec4& boundingSphere, const glm::vec4& cone, const UInt32_T indexCount, const UInt32_T firstIndex ) -> void {
+                if ( m_DrawMeshletCount == MAX_DRAW_MESHLETS ) {
+                    ++droppedMeshletCount;
+                    return;
+                }
+
+                meshlets[m_DrawMeshletCount++] = DrawMeshletData{
+                    .BoundingSphere{ boundingSphere },
+                    .Cone{ cone },
+                    .Geometry{ index, indexCount, vulkanIndexBuffer->GetFirstIndex() + firstIndex, 0 },
+                };
+
+                ++m_FormatDrawMeshletCounts[format];
+            } };
+
+            // Meshes built without meshlets are a single one, which is never cone culled
+            if ( lod.MeshletCount == 0 ) {
+                addMeshlet( vulkanVertexBuffer->GetBoundingSphere(), glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f }, lod.IndexCount, lod.FirstIndex );
+                continue;
+            }
+
+            const std::vector<MeshOptimizer::Meshlet>& meshMeshlets{ meshRenderInfo.Object->GetMeshlets() };
+
+            for ( UInt32_T meshletIndex{ lod.FirstMeshlet }; meshletIndex < lod.FirstMeshlet + lod.MeshletCount; ++meshletIndex ) {
+                const MeshOptimizer::Meshlet& meshlet{ meshMeshlets[meshletIndex] };
+                addMeshlet( meshlet.BoundingSphere, meshlet.Cone, meshlet.IndexCount, meshlet.FirstIndex );
+            }
+        }
 
-        VulkanPBRMaterial* pbrMaterial{ dynamic_cast<VulkanPBRMaterial*>( meshRenderInfo.MaterialData ) };
+        if ( droppedMeshletCount != 0 && !m_HasReportedDrawMeshletLimit ) {
+            MKT_CORE_LOGGER_WARN( "VulkanRenderer::UploadDrawInstances - {} meshlets past the capacity of {} are not drawn this frame. Raise MAX_DRAW_MESHLETS.",
+                droppedMeshletCount, MAX_DRAW_MESHLETS );
+            m_HasReportedDrawMeshletLimit = true;
+        }
+    }
+
+    auto VulkanRenderer::RecordDrawCulling( const VkCommandBuffer cmd ) -> void {
+        const auto findIt{ m_Pipelines.find( MATERIAL_PASS_DRAW_CULLING ) };
+
+        if ( findIt == m_Pipelines.end() ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordDrawCulling - Draw culling pipeline is missing." );
+        }
+
+        const VulkanPipeline& cullingPipeline{ findIt->second };
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        // The visible draws are appended, start from an empty list
+        vkCmdFillBuffer( cmd, m_IndirectDrawCountBuffers[frameIndex]->Get(), 0, VERTEX_FORMAT_COUNT * sizeof( UInt32_T ), 0 );
+
+        VkMemoryBarrier clearBarrier{ VulkanHelpers::Initializers::MemoryBarrier() };
+        clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier( cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+            1, std::addressof( clearBarrier ),
+            0, nullptr,
+            0, nullptr );
+
+        DrawCullingPushConstants pushConstants{
+            .CameraPosition{ m_Camera->GetPosition(), 1.0f },
+            .MeshletCount{ m_DrawMeshletCount },
+            .BatchCapacity{ MAX_DRAW_MESHLETS },
+            .ConeCulling{ MESHLET_CONE_CULLING ? 1u : 0u },
+        };
+
+        std::ranges::copy( GetFrustumPlanes( m_Camera->GetProjection() * m_Camera->GetViewMatrix() ), std::begin( pushConstants.FrustumPlanes ) );
+
+        // Same set the graphics pipelines bind as set 1
+        vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullingPipeline.Get() );
+        vkCmdBindDescriptorSets( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullingPipeline.GetLayout(), 0, 1,
+            std::addressof( m_SceneLightsDescriptorSets[frameIndex] ), 0, nullptr );
+
+        vkCmdPushConstants( cmd, cullingPipeline.GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( DrawCullingPushConstants ), std::addressof( pushConstants ) );
+
+        // One invocation per meshlet
+        if ( m_DrawMeshletCount != 0 ) {
+            vkCmdDispatch( cmd, ( m_DrawMeshletCount + DRAW_CULLING_GROUP_SIZE - 1 ) / DRAW_CULLING_GROUP_SIZE, 1, 1 );
+        }
+
+        // The commands and their count are read by the indirect draws of the depth pre-pass and the main pass
+        VkMemoryBarrier barrier{ VulkanHelpers::Initializers::MemoryBarrier() };
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+        vkCmdPipelineBarrier( cmd,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0,
+            1, std::addressof( barrier ),
+            0, nullptr,
+            0, nullptr );
+    }
+
+    auto VulkanRenderer::RecordIndirectDraws( const VkCommandBuffer cmd ) -> void {
+        if ( m_DrawMeshletCount == 0 ) {
+            return;
+        }
+
+        // The pass and its variant for each vertex format were picked by ResolvePipelineVariants()
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        BindPBRDescriptorSets( cmd );
+
+        VulkanContext::Get().GetGeometryHeap().Bind( cmd );
+
+        // Every visible PBR meshlet of a vertex format in a single call, the draw counts were written by the culling pass
+        for ( UInt32_T format{}; format < VERTEX_FORMAT_COUNT; ++format ) {
+            if ( m_FormatDrawMeshletCounts[format] == 0 ) {
+                continue;
+            }
 
-        // Setup render mode
-        pbrMaterial->SetRenderMode( m_RenderMode );
-        pbrMaterial->EnableWireframe( m_WireframeEnable ? MKT_SHADER_TRUE : MKT_SHADER_FALSE );
+            const VulkanPipeline* pipeline{ m_FramePipelineVariants[format] };
+
+            if ( pipeline == nullptr ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordIndirectDraws - Pipeline objects are null." );
+            }
+
+            pipeline->Bind( cmd );
+
+            vkCmdDrawIndexedIndirectCount( cmd,
+                m_IndirectDrawBuffers[frameIndex]->Get(), format * MAX_DRAW_MESHLETS * sizeof( VkDrawIndexedIndirectCommand ),
+                m_IndirectDrawCountBuffers[frameIndex]->Get(), format * sizeof( UInt32_T ),
+                m_FormatDrawMeshletCounts[format], sizeof( VkDrawIndexedIndirectCommand ) );
+        }
+    }
+
+    auto VulkanRenderer::BindSceneLights( const VkCommandBuffer cmd, const VkPipelineLayout pipelineLayout ) const -> void {
+        // Set 0 is bound by the material
+        constexpr UInt32_T sceneLightsSet{ 1 };
+        vkCmdBindDescriptorSets( cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, sceneLightsSet, 1,
+            std::addressof( m_SceneLightsDescriptorSets[VulkanContext::Get().GetCurrentFrameIndex()] ), 0, nullptr );
+    }
+
+    auto VulkanRenderer::UploadFrameUniforms() -> void {
+        const FrameUniformData frameData{
+            .View{ m_Camera->GetViewMatrix() },
+            .Projection{ m_Camera->GetProjection() },
+            .ViewPosition{ glm::vec4{ m_Camera->GetPosition(), 1.0f } },
+            .RenderSettings{ static_cast<Int32_T>( m_RenderMode ), m_WireframeEnable ? MKT_SHADER_TRUE : MKT_SHADER_FALSE, 0, 0 },
+        };
+
+        std::memcpy( m_FrameUniformBuffers[VulkanContext::Get().GetCurrentFrameIndex()]->GetMappedPtr(), std::addressof( frameData ), sizeof( FrameUniformData ) );
+    }
+
+    auto VulkanRenderer::BindPBRDescriptorSets( const VkCommandBuffer cmd ) const -> void {
+        // Same for every PBR draw, bound once per command buffer
+        constexpr UInt32_T bindlessSet{ 0 };
+        VulkanContext::Get().GetBindlessManager().Bind( cmd, m_PBRPipelineLayout, bindlessSet );
+
+        BindSceneLights( cmd, m_PBRPipelineLayout );
+    }
+
+    auto VulkanRenderer::PushDrawConstants( const VkCommandBuffer cmd, const VkPipelineLayout pipelineLayout, const MeshRenderInfo& meshRenderInfo ) const -> void {
+        // Standard materials have their parameters in their own uniform buffer
+        const VulkanPBRMaterial* pbrMaterial{ dynamic_cast<const VulkanPBRMaterial*>( meshRenderInfo.MaterialData ) };
+
+        const DrawPushConstants pushConstants{
+            .Transform{ meshRenderInfo.Transform },
+            .MaterialIndex{ pbrMaterial != nullptr ? pbrMaterial->GetBindlessIndex() : VulkanBindlessManager::INVALID_INDEX },
+        };
+
+        vkCmdPushConstants( cmd, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0, sizeof( DrawPushConstants ), std::addressof( pushConstants ) );
+    }
+
+    auto VulkanRenderer::SetupObjectOutline( const VkCommandBuffer cmd, const MeshRenderInfo& meshRenderInfo ) -> void {
+        // TODO: fix outline
+        if (true) {
+            return;
+        }
+
+        const VulkanPipeline* pipeline{ nullptr };
 
         // The material will store its passes so we dont have to do the switch stamentnt below
-        auto findIt{ m_Pipelines.find( m_WireframeEnable ? MATERIAL_PASS_WIREFRAME : pbrMaterial->GetPass() ) };
+        auto findIt{ m_Pipelines.find( MATERIAL_PASS_OUTLINE ) };
 
         pipeline = findIt != m_Pipelines.end() ? std::addressof( findIt->second ) : nullptr;
         if ( pipeline == nullptr ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordCommands - Pipeline objects are null." );
         }
 
-        pbrMaterial->SetProjection( m_Camera->GetProjection() );
-        pbrMaterial->SetView( m_Camera->GetViewMatrix() );
-        pbrMaterial->SetTransform( meshRenderInfo.Transform );
-        pbrMaterial->SetViewPosition( m_Camera->GetPosition() );
+        BindPBRDescriptorSets( cmd );
 
-        pbrMaterial->ResetLights();
+        pipeline->Bind( cmd );
 
-        for ( const auto& lightInfo: m_Lights | std::views::values ) {
-            pbrMaterial->UpdateLightsInfo( *lightInfo.Data, lightInfo.ActiveType );
-        }
-
-        pbrMaterial->UploadUniformBuffers();
-        pbrMaterial->BindDescriptorSet( m_DrawCommandBuffer, pipeline->GetLayout() );
-
-        pipeline->Bind( m_DrawCommandBuffer );
+        PushDrawConstants( cmd, m_PBRPipelineLayout, meshRenderInfo );
 
         const VulkanVertexBuffer* vulkanVertexBuffer{ dynamic_cast<const VulkanVertexBuffer*>( meshRenderInfo.Object->GetVertexBuffer() ) };
         const VulkanIndexBuffer* vulkanIndexBuffer{ dynamic_cast<const VulkanIndexBuffer*>( meshRenderInfo.Object->GetIndexBuffer() ) };
+        const MeshLod& lod{ meshRenderInfo.Object->GetLods()[meshRenderInfo.LodIndex] };
 
-        vulkanVertexBuffer->Bind( m_DrawCommandBuffer );
-        vulkanIndexBuffer->Bind( m_DrawCommandBuffer );
-
-        vkCmdDrawIndexed( m_DrawCommandBuffer, vulkanIndexBuffer->GetCount(), 1, 0, 0, 0 );
+        // The geometry heap was bound by the caller, the draw selects the mesh range of the level of detail
+        vkCmdDrawIndexed( cmd, lod.IndexCount, 1, vulkanIndexBuffer->GetFirstIndex() + lod.FirstIndex, vulkanVertexBuffer->GetVertexOffset(), 0 );
     }
 
-    auto VulkanRenderer::SetupDefaultPass( const MeshRenderInfo& meshRenderInfo ) -> void {
+    auto VulkanRenderer::SetupDefaultPass( const VkCommandBuffer cmd, const MeshRenderInfo& meshRenderInfo ) -> void {
         const VulkanPipeline* pipeline{ nullptr };
 
         VulkanStandardMaterial* standardMaterial{ dynamic_cast<VulkanStandardMaterial*>( meshRenderInfo.MaterialData ) };
@@ -333,39 +791,315 @@ namespace Mikoto {
             MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordCommands - Pipeline objects are null." );
         }
 
-        standardMaterial->SetProjection( m_Camera->GetProjection() );
-        standardMaterial->SetView( m_Camera->GetViewMatrix() );
-        standardMaterial->SetTransform( meshRenderInfo.Transform );
+        standardMaterial->BindDescriptorSet( cmd, pipeline->GetLayout() );
+        BindSceneLights( cmd, pipeline->GetLayout() );
 
-        standardMaterial->SetViewPosition( m_Camera->GetPosition() );
+        pipeline->Bind( cmd );
 
-        standardMaterial->ResetLights();
+        PushDrawConstants( cmd, pipeline->GetLayout(), meshRenderInfo );
 
-        for ( const auto& lightInfo: m_Lights | std::views::values ) {
-            standardMaterial->UpdateLightsInfo( *lightInfo.Data, lightInfo.ActiveType );
-        }
+        const VulkanVertexBuffer* vulkanVertexBuffer{ dynamic_cast<const VulkanVertexBuffer*>( meshRenderInfo.Object->GetVertexBuffer() ) };
+        const VulkanIndexBuffer* vulkanIndexBuffer{ dynamic_cast<const VulkanIndexBuffer*>( meshRenderInfo.Object->GetIndexBuffer() ) };
+        const MeshLod& lod{ meshRenderInfo.Object->GetLods()[meshRenderInfo.LodIndex] };
 
-        standardMaterial->UploadUniformBuffers();
-        standardMaterial->BindDescriptorSet( m_DrawCommandBuffer, pipeline->GetLayout() );
+        // The geometry heap was bound by the caller, the draw selects the mesh range of the level of detail
+        vkCmdDrawIndexed( cmd, lod.IndexCount, 1, vulkanIndexBuffer->GetFirstIndex() + lod.FirstIndex, vulkanVertexBuffer->GetVertexOffset(), 0 );
+    }
+
+    auto VulkanRenderer::SelectLod( MeshRenderInfo& meshRenderInfo ) const -> void {
+        const std::vector<MeshLod>& lods{ meshRenderInfo.Object->GetLods() };
 
-        pipeline->Bind( m_DrawCommandBuffer );
+        if ( lods.size() < 2 ) {
+            meshRenderInfo.LodIndex = 0;
+            return;
+        }
 
         const VulkanVertexBuffer* vulkanVertexBuffer{ dynamic_cast<const VulkanVertexBuffer*>( meshRenderInfo.Object->GetVertexBuffer() ) };
-        const VulkanIndexBuffer* vulkanIndexBuffer{ dynamic_cast<const VulkanIndexBuffer*>( meshRenderInfo.Object->GetIndexBuffer() ) };
+        const glm::vec4& boundingSphere{ vulkanVertexBuffer->GetBoundingSphere() };
+
+        // Same world space bounds as the draw culling pass
+        const glm::mat4& transform{ meshRenderInfo.Transform };
+        const glm::vec3 center{ transform * glm::vec4{ glm::vec3{ boundingSphere }, 1.0f } };
+        const float scale{ std::max( { glm::length( glm::vec3{ transform[0] } ), glm::length( glm::vec3{ transform[1] } ), glm::length( glm::vec3{ transform[2] } ) } ) };
+        const float radius{ boundingSphere.w * scale };
+        const float distance{ glm::length( center - m_Camera->GetPosition() ) };
+
+        // The camera is inside the bounds, any error may be right in front of it
+        if ( distance <= radius ) {
+            meshRenderInfo.LodIndex = 0;
+            return;
+        }
+
+        // Pixels covered by one object space unit at the nearest point of the bounds,
+        // the Y scale of the projection is 1 / tan(fov / 2)
+        const float pixelsPerUnit{ scale * std::abs( m_Camera->GetProjection()[1][1] ) * 0.5f * static_cast<float>( m_OffscreenExtent.height ) / ( distance - radius ) };
+
+        // Coarsest level within the threshold lowered and raised by the hysteresis. The error grows with the level
+        UInt32_T minLod{};
+        UInt32_T maxLod{};
+
+        for ( UInt32_T lod{ 1 }; lod < lods.size(); ++lod ) {
+            const float projectedError{ lods[lod].Error * pixelsPerUnit };
+
+            if ( projectedError <= LOD_ERROR_THRESHOLD_PIXELS * ( 1.0f - LOD_HYSTERESIS ) ) {
+                minLod = lod;
+            }
+
+            if ( projectedError <= LOD_ERROR_THRESHOLD_PIXELS * ( 1.0f + LOD_HYSTERESIS ) ) {
+                maxLod = lod;
+            }
+        }
+
+        // A finer level than minLod moves to it, a coarser one than maxLod too. Within the band the current level is kept
+        meshRenderInfo.LodIndex = std::clamp( meshRenderInfo.LodIndex, minLod, maxLod );
+    }
+
+    auto VulkanRenderer::BuildDrawList() -> void {
+        m_DrawList.clear();
+        m_IndirectDrawList.clear();
+
+        // PBR draws share the same pipeline and sets, they are culled on the GPU and drawn indirectly.
+        // The others bind their own material sets and are recorded one by one
+        for ( auto& meshRenderInfo : m_DrawQueue | std::views::values ) {
+            if ( meshRenderInfo.Object ) {
+                SelectLod( meshRenderInfo );
+
+                if ( meshRenderInfo.MaterialData->GetType() == MaterialType::PBR ) {
+                    m_IndirectDrawList.emplace_back( std::addressof( meshRenderInfo ) );
+                } else if ( meshRenderInfo.Object->GetVertexBuffer()->GetFormat() == VertexFormat::FLOAT32 ) {
+                    // The standard pipelines only read the default buffer layout
+                    m_DrawList.emplace_back( std::addressof( meshRenderInfo ) );
+                }
+            }
+        }
+
+        // Group draws by material
+        const auto byMaterial{ []( const MeshRenderInfo* lhs, const MeshRenderInfo* rhs ) -> bool {
+            return lhs->MaterialData < rhs->MaterialData;
+        } };
+
+        std::ranges::sort( m_DrawList, byMaterial );
+        std::ranges::sort( m_IndirectDrawList, byMaterial );
+    }
+
+    auto VulkanRenderer::UpdateMaterialUniforms() -> void {
+        // Done once before any recording, the depth pre-pass and
+        // the main pass (possibly recorded by the workers) read the same uniforms.
+        // Descriptor sets are written here too, recording only binds them
+        // Camera and transform are not part of the materials, see UploadFrameUniforms() and PushDrawConstants(),
+        // so a material shared by several meshes is written once. The draw list keeps draws of a material together
+        const Material* previousMaterial{ nullptr };
+
+        for ( const std::vector<const MeshRenderInfo*>* drawList : { std::addressof( m_IndirectDrawList ), std::addressof( m_DrawList ) } ) {
+            for ( const MeshRenderInfo* meshRenderInfo : *drawList ) {
+                if ( meshRenderInfo->MaterialData == previousMaterial ) {
+                    continue;
+                }
+
+                previousMaterial = meshRenderInfo->MaterialData;
+
+                switch ( meshRenderInfo->MaterialData->GetType() ) {
+                    case MaterialType::PBR: {
+                        VulkanPBRMaterial* pbrMaterial{ dynamic_cast<VulkanPBRMaterial*>( meshRenderInfo->MaterialData ) };
+                        pbrMaterial->UploadUniformBuffers();
+                        break;
+                    }
+
+                    case MaterialType::STANDARD: {
+                        VulkanStandardMaterial* standardMaterial{ dynamic_cast<VulkanStandardMaterial*>( meshRenderInfo->MaterialData ) };
+                        standardMaterial->UploadUniformBuffers();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    auto VulkanRenderer::RecordDepthPrepass( const VkCommandBuffer cmd ) -> void {
+        VkClearValue depthClearValue{};
+        depthClearValue.depthStencil = { 1.0f, 0 };
+
+        VkRenderPassBeginInfo renderPassInfo{ VulkanHelpers::Initializers::RenderPassBeginInfo() };
+        renderPassInfo.renderPass = m_DepthPrepassRenderPass;
+        renderPassInfo.framebuffer = m_DepthPrepassFrameBuffer->Get();
+        renderPassInfo.renderArea.offset = { 0, 0 };
+        renderPassInfo.renderArea.extent = m_OffscreenExtent;
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = std::addressof( depthClearValue );
+
+        vkCmdBeginRenderPass( cmd, std::addressof( renderPassInfo ), VK_SUBPASS_CONTENTS_INLINE );
+
+        BindPBRDescriptorSets( cmd );
+
+        // Every mesh lives in the geometry heap, positions are addressed with their own vertex offset
+        VulkanContext::Get().GetGeometryHeap().Bind( cmd );
+
+        // Only the PBR draws use the EQUAL depth test in the main pass, the rest
+        // still benefit from the depth laid down here but write their own.
+        // Same visible draws as the main pass, with the commands addressing the positions stream
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        for ( UInt32_T format{}; format < VERTEX_FORMAT_COUNT; ++format ) {
+            if ( m_FormatDrawMeshletCounts[format] == 0 ) {
+                continue;
+            }
+
+            const auto findIt{ m_Pipelines.find( GetDepthPrepassPass( static_cast<VertexFormat>( format ) ) ) };
+
+            if ( findIt == m_Pipelines.end() ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordDepthPrepass - Depth pre-pass pipeline is missing." );
+            }
+
+            findIt->second.Bind( cmd );
+
+            vkCmdDrawIndexedIndirectCount( cmd,
+                m_DepthPrepassIndirectDrawBuffers[frameIndex]->Get(), format * MAX_DRAW_MESHLETS * sizeof( VkDrawIndexedIndirectCommand ),
+                m_IndirectDrawCountBuffers[frameIndex]->Get(), format * sizeof( UInt32_T ),
+                m_FormatDrawMeshletCounts[format], sizeof( VkDrawIndexedIndirectCommand ) );
+        }
+
+        vkCmdEndRenderPass( cmd );
+    }
+
+    auto VulkanRenderer::RecordDrawRange( const VkCommandBuffer cmd, const Size_T first, const Size_T last ) -> void {
+        // Vertex and index buffers are shared by every mesh, pipeline switches leave them bound
+        VulkanContext::Get().GetGeometryHeap().Bind( cmd );
+
+        for ( Size_T index{ first }; index < last; ++index ) {
+            const MeshRenderInfo& meshRenderInfo{ *m_DrawList[index] };
+
+            switch (meshRenderInfo.MaterialData->GetType()) {
+
+                case MaterialType::PBR:
+                    // Not part of the draw list, see RecordIndirectDraws()
+                    break;
+
+                case MaterialType::STANDARD:
+                    SetupDefaultPass( cmd, meshRenderInfo );
+                    break;
+            }
+
+            SetupObjectOutline( cmd, meshRenderInfo );
+        }
+    }
+
+    auto VulkanRenderer::ResolvePipelineVariants() -> void {
+        // Render mode and wireframe are specialization constants, switching them only
+        // picks another variant. A variant not built yet is compiled in the background
+        const UInt32_T features{ m_WireframeEnable ? static_cast<UInt32_T>( PIPELINE_VARIANT_FEATURE_WIREFRAME ) : static_cast<UInt32_T>( PIPELINE_VARIANT_FEATURE_NONE ) };
+
+        // With the depth pre-pass the depth buffer already holds the closest surfaces,
+        // so only the fragments that are going to be visible get shaded
+        const Size_T pass{ m_DepthPrepassEnable && !m_WireframeEnable ? MATERIAL_PASS_PBR_DEPTH_EQUAL : MATERIAL_PASS_PBR };
+
+        // Compact vertices are read through another vertex input, only the formats drawn this frame are resolved
+        for ( UInt32_T format{}; format < VERTEX_FORMAT_COUNT; ++format ) {
+            const UInt32_T vertexFeatures{ static_cast<VertexFormat>( format ) == VertexFormat::COMPACT
+                ? static_cast<UInt32_T>( PIPELINE_VARIANT_FEATURE_COMPACT_VERTICES ) : static_cast<UInt32_T>( PIPELINE_VARIANT_FEATURE_NONE ) };
+
+            m_FramePipelineVariants[format] = m_FormatDrawMeshletCounts[format] == 0 ? nullptr : m_PipelineVariants.Resolve( VulkanPipelineVariantKey{
+                .Pass{ pass },
+                .RenderMode{ static_cast<UInt32_T>( m_RenderMode ) },
+                .Features{ features | vertexFeatures },
+            } );
+        }
+    }
+
+    auto VulkanRenderer::RecordSecondaryCommands( const VkCommandBuffer primaryCmd ) -> void {
+        TaskSystem& taskSystem{ Engine::GetSystem<TaskSystem>() };
+
+        std::vector<SecondaryRecordingContext>& recordingContexts{ m_RecordingContexts[VulkanContext::Get().GetCurrentFrameIndex()] };
+
+        // Each task records a contiguous range of the sorted draw list
+        const Size_T drawCount{ m_DrawList.size() };
+        const Size_T taskCount{ std::clamp<Size_T>( drawCount / MIN_DRAWS_PER_RECORDING_TASK, 1, recordingContexts.size() ) };
+        const Size_T drawsPerTask{ ( drawCount + taskCount - 1 ) / taskCount };
+
+        VkCommandBufferInheritanceInfo inheritanceInfo{ VulkanHelpers::Initializers::CommandBufferInheritanceInfo() };
+        inheritanceInfo.renderPass = m_OffscreenMainRenderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = m_OffscreenFrameBuffer->Get();
+
+        VkCommandBufferBeginInfo beginInfo{ VulkanHelpers::Initializers::CommandBufferBeginInfo() };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = std::addressof( inheritanceInfo );
+
+        // Only waited on by this frame, background jobs may still be running on other workers
+        TaskSystem::JobCounter recordingJobs{};
+
+        taskSystem.Dispatch( static_cast<UInt32_T>( taskCount ), 1, [&]( const TaskSystem::JobDispatchArgs args ) -> void {
+            SecondaryRecordingContext& context{ recordingContexts[args.JobIndex] };
+
+            try {
+                // The frame fence was already waited on, nothing from this pool is in use
+                vkResetCommandPool( m_Device->GetLogicalDevice(), context.CommandPool->Get(), 0 );
+
+                if ( vkBeginCommandBuffer( context.CommandBuffer, std::addressof( beginInfo ) ) != VK_SUCCESS ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordSecondaryCommands - Failed to begin recording to secondary command buffer." );
+                }
+
+                // Dynamic state is not inherited from the primary command buffer
+                vkCmdSetViewport( context.CommandBuffer, 0, 1, std::addressof( m_OffscreenViewport ) );
+                vkCmdSetScissor( context.CommandBuffer, 0, 1, std::addressof( m_OffscreenScissor ) );
+
+                // Keeps the PBR draws ahead of the others, as in the inline recording
+                if ( args.JobIndex == 0 ) {
+                    RecordIndirectDraws( context.CommandBuffer );
+                }
+
+                const Size_T first{ args.JobIndex * drawsPerTask };
+                RecordDrawRange( context.CommandBuffer, first, std::min( first + drawsPerTask, drawCount ) );
+
+                if ( vkEndCommandBuffer( context.CommandBuffer ) != VK_SUCCESS ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordSecondaryCommands - Failed to end recording secondary command buffer." );
+                }
+            } catch ( ... ) {
+                context.Error = std::current_exception();
+            }
+        }, recordingJobs );
+
+        taskSystem.Wait( recordingJobs );
 
-        vulkanVertexBuffer->Bind( m_DrawCommandBuffer );
-        vulkanIndexBuffer->Bind( m_DrawCommandBuffer );
+        std::vector<VkCommandBuffer> secondaryCommandBuffers{};
+        secondaryCommandBuffers.reserve( taskCount );
 
-        vkCmdDrawIndexed( m_DrawCommandBuffer, vulkanIndexBuffer->GetCount(), 1, 0, 0, 0 );
+        for ( Size_T taskIndex{}; taskIndex < taskCount; ++taskIndex ) {
+            SecondaryRecordingContext& context{ recordingContexts[taskIndex] };
+
+            if ( context.Error ) {
+                std::rethrow_exception( std::exchange( context.Error, nullptr ) );
+            }
+
+            secondaryCommandBuffers.emplace_back( context.CommandBuffer );
+        }
+
+        // Executed in order, so the draw list order is preserved
+        vkCmdExecuteCommands( primaryCmd, static_cast<UInt32_T>( secondaryCommandBuffers.size() ), secondaryCommandBuffers.data() );
     }
 
     auto VulkanRenderer::RecordCommands() -> void {
+        // Command buffer owned by the current frame in flight, the context
+        // has already waited for the GPU to be done with it in PrepareFrame()
+        const VkCommandBuffer cmd{ m_DrawCommandBuffers[VulkanContext::Get().GetCurrentFrameIndex()] };
+
         VkCommandBufferBeginInfo beginInfo{ VulkanHelpers::Initializers::CommandBufferBeginInfo() };
 
-        if ( vkBeginCommandBuffer( m_DrawCommandBuffer, std::addressof( beginInfo ) ) != VK_SUCCESS ) {
+        if ( vkBeginCommandBuffer( cmd, std::addressof( beginInfo ) ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanRenderer - Failed to begin recording to command buffer." );
         }
 
+        BuildDrawList();
+        UpdateMaterialUniforms();
+        UploadDrawInstances();
+        ResolvePipelineVariants();
+
+        // Assign lights to clusters before any fragment gets shaded. Recorded in the graphics
+        // command buffer so no synchronization between queues is needed
+        RecordLightCulling( cmd );
+
+        // Writes the indirect draws of the visible PBR meshlets, used by the depth pre-pass and the main pass
+        RecordDrawCulling( cmd );
+
         // Clear values
         m_ClearValues[1].depthStencil = { 1.0f, 0 };
         m_ClearValues[0].color = { { m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a } };
@@ -381,33 +1115,37 @@ namespace Mikoto {
         UpdateViewport( 0, 0, static_cast<float>( m_OffscreenExtent.width ), static_cast<float>( m_OffscreenExtent.height ) );
         UpdateScissor( 0, 0, { m_OffscreenExtent.width, m_OffscreenExtent.height } );
 
-        vkCmdSetViewport( m_DrawCommandBuffer, 0, 1, std::addressof( m_OffscreenViewport ) );
-        vkCmdSetScissor( m_DrawCommandBuffer, 0, 1, std::addressof( m_OffscreenScissor ) );
+        vkCmdSetViewport( cmd, 0, 1, std::addressof( m_OffscreenViewport ) );
+        vkCmdSetScissor( cmd, 0, 1, std::addressof( m_OffscreenScissor ) );
 
-        vkCmdBeginRenderPass( m_DrawCommandBuffer, std::addressof( renderPassInfo ), VK_SUBPASS_CONTENTS_INLINE );
+        // Wireframe draws don't write depth the same way, the pre-pass would hide them
+        const bool useDepthPrepass{ m_DepthPrepassEnable && !m_WireframeEnable };
 
-        for ( const auto& meshRenderInfo : m_DrawQueue | std::views::values ) {
+        if ( useDepthPrepass ) {
+            RecordDepthPrepass( cmd );
 
-            if ( meshRenderInfo.Object ) {
-                switch (meshRenderInfo.MaterialData->GetType()) {
+            // Both render passes are compatible, the framebuffer and pipelines work with either
+            renderPassInfo.renderPass = m_OffscreenMainLoadDepthRenderPass;
+        }
 
-                    case MaterialType::PBR:
-                        SetupPBRPass( meshRenderInfo );
-                        break;
+        // Only worth spreading the recording across workers when every task gets a decent amount of draws
+        const bool recordInParallel{ m_RecordingContexts[VulkanContext::Get().GetCurrentFrameIndex()].size() > 1 &&
+                                     m_DrawList.size() >= 2 * MIN_DRAWS_PER_RECORDING_TASK };
 
-                    case MaterialType::STANDARD:
-                        SetupDefaultPass( meshRenderInfo );
-                        break;
-                }
+        if ( recordInParallel ) {
+            vkCmdBeginRenderPass( cmd, std::addressof( renderPassInfo ), VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
 
-                SetupObjectOutline(meshRenderInfo);
-            }
+            RecordSecondaryCommands( cmd );
+        } else {
+            vkCmdBeginRenderPass( cmd, std::addressof( renderPassInfo ), VK_SUBPASS_CONTENTS_INLINE );
 
+            RecordIndirectDraws( cmd );
+            RecordDrawRange( cmd, 0, m_DrawList.size() );
         }
 
-        vkCmdEndRenderPass( m_DrawCommandBuffer );
+        vkCmdEndRenderPass( cmd );
 
-        if ( vkEndCommandBuffer( m_DrawCommandBuffer ) != VK_SUCCESS ) {
+        if ( vkEndCommandBuffer( cmd ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::RecordCommands - Failed to end recording command buffer" );
         }
     }
@@ -475,10 +1213,12 @@ namespace Mikoto {
             std::memcpy(values.data(), stagingBuffer->GetMappedPtr(), stagingBuffer->GetSize());
         }
 
+        const VkCommandBuffer computeCmd{ m_ComputeCommandBuffers[VulkanContext::Get().GetCurrentFrameIndex()] };
+
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-        if (vkBeginCommandBuffer(m_ComputeCommandBuffer, &beginInfo) != VK_SUCCESS) {
+        if (vkBeginCommandBuffer(computeCmd, &beginInfo) != VK_SUCCESS) {
             MKT_THROW_RUNTIME_ERROR("VulkanRenderer::RecordComputeCommands - Failed to begin recording command buffer!");
         }
 
@@ -486,17 +1226,20 @@ namespace Mikoto {
 
         const VulkanPipeline* computePipeline{ findIt == m_Pipelines.end() ? nullptr : std::addressof( findIt->second ) };
 
-        vkCmdBindPipeline(m_ComputeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->Get());
-        vkCmdBindDescriptorSets(m_ComputeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->GetLayout(), 0, 1, std::addressof( s_DescriptorSet ), 0, 0);
+        vkCmdBindPipeline(computeCmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->Get());
+        vkCmdBindDescriptorSets(computeCmd, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline->GetLayout(), 0, 1, std::addressof( s_DescriptorSet ), 0, 0);
 
-        vkCmdDispatch(m_ComputeCommandBuffer, 10, 0, 0);
+        vkCmdDispatch(computeCmd, 10, 0, 0);
 
-        if (vkEndCommandBuffer(m_ComputeCommandBuffer) != VK_SUCCESS) {
+        if (vkEndCommandBuffer(computeCmd) != VK_SUCCESS) {
             MKT_THROW_RUNTIME_ERROR("VulkanRenderer::RecordComputeCommands - Failed to record compute commands");
         }
     }
 
-    auto VulkanRenderer::CreateOffscreenRenderPass() -> void {
+    auto VulkanRenderer::CreateOffscreenRenderPass( const VkAttachmentLoadOp depthLoadOp ) -> VkRenderPass {
+        // When the depth is loaded it was written by the depth pre-pass and is already in the attachment layout
+        const bool loadsDepth{ depthLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD };
+
         // Color Attachment
         VkAttachmentDescription colorAttachmentDesc{};
         colorAttachmentDesc.format = m_ColorAttachmentFormat;
@@ -517,11 +1260,11 @@ namespace Mikoto {
         depthAttachmentDesc.flags = 0;
         depthAttachmentDesc.format = m_DepthAttachmentFormat;
         depthAttachmentDesc.samples = VK_SAMPLE_COUNT_1_BIT;
-        depthAttachmentDesc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachmentDesc.loadOp = depthLoadOp;
         depthAttachmentDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         depthAttachmentDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         depthAttachmentDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        depthAttachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachmentDesc.initialLayout = loadsDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
         depthAttachmentDesc.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
         VkAttachmentReference depthAttachmentRef{};
@@ -549,9 +1292,9 @@ namespace Mikoto {
         deptAttachmentDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
         deptAttachmentDependency.dstSubpass = 0;
         deptAttachmentDependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-        deptAttachmentDependency.srcAccessMask = 0;
+        deptAttachmentDependency.srcAccessMask = loadsDepth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : 0;
         deptAttachmentDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-        deptAttachmentDependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        deptAttachmentDependency.dstAccessMask = loadsDepth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
         std::array attachmentDependencies{ colorAttachmentDependency, deptAttachmentDependency };
         std::array attachmentDescriptions{ colorAttachmentDesc, depthAttachmentDesc };
@@ -566,11 +1309,64 @@ namespace Mikoto {
         info.subpassCount = 1;
         info.pSubpasses = &subpass;
 
-        if ( vkCreateRenderPass( m_Device->GetLogicalDevice(), &info, nullptr, &m_OffscreenMainRenderPass ) != VK_SUCCESS ) {
+        VkRenderPass renderPass{};
+        if ( vkCreateRenderPass( m_Device->GetLogicalDevice(), &info, nullptr, &renderPass ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "Failed to create render pass for the Vulkan Renderer!" );
         }
 
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(), renderPass = m_OffscreenMainRenderPass]() -> void {
+        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(), renderPass]() -> void {
+            vkDestroyRenderPass( device, renderPass, nullptr );
+        } );
+
+        return renderPass;
+    }
+
+    auto VulkanRenderer::CreateDepthPrepassRenderPass() -> void {
+        VkAttachmentDescription depthAttachmentDesc{};
+        depthAttachmentDesc.flags = 0;
+        depthAttachmentDesc.format = m_DepthAttachmentFormat;
+        depthAttachmentDesc.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachmentDesc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachmentDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachmentDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachmentDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachmentDesc.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 0;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 0;
+        subpass.pColorAttachments = nullptr;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        // The previous frame main pass might still be testing against the depth attachment
+        VkSubpassDependency deptAttachmentDependency{};
+        deptAttachmentDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+        deptAttachmentDependency.dstSubpass = 0;
+        deptAttachmentDependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        deptAttachmentDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        deptAttachmentDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        deptAttachmentDependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        VkRenderPassCreateInfo info{ VulkanHelpers::Initializers::RenderPassCreateInfo() };
+        info.attachmentCount = 1;
+        info.pAttachments = &depthAttachmentDesc;
+
+        info.dependencyCount = 1;
+        info.pDependencies = &deptAttachmentDependency;
+
+        info.subpassCount = 1;
+        info.pSubpasses = &subpass;
+
+        if ( vkCreateRenderPass( m_Device->GetLogicalDevice(), &info, nullptr, &m_DepthPrepassRenderPass ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::CreateDepthPrepassRenderPass - Failed to create depth pre-pass render pass." );
+        }
+
+        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(), renderPass = m_DepthPrepassRenderPass]() -> void {
             vkDestroyRenderPass( device, renderPass, nullptr );
         } );
     }
@@ -594,6 +1390,15 @@ namespace Mikoto {
         };
 
         m_OffscreenFrameBuffer = CreateScope<VulkanFrameBuffer>( frameBufferCreateInfo );
+
+        // Depth pre-pass, only the depth attachment
+        const std::array depthAttachments{ m_OffscreenDepthAttachment->GetView() };
+
+        createInfo.renderPass = m_DepthPrepassRenderPass;
+        createInfo.attachmentCount = static_cast<UInt32_T>( depthAttachments.size() );
+        createInfo.pAttachments = depthAttachments.data();
+
+        m_DepthPrepassFrameBuffer = CreateScope<VulkanFrameBuffer>( VulkanFrameBufferCreateInfo{ .CreateInfo{ createInfo } } );
     }
 
     auto VulkanRenderer::UpdateViewport( const float x, const float y, const float width, const float height ) -> void {
@@ -700,7 +1505,10 @@ namespace Mikoto {
                 VK_IMAGE_TILING_OPTIMAL,
                 VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT );
 
-        CreateOffscreenRenderPass();
+        m_OffscreenMainRenderPass = CreateOffscreenRenderPass( VK_ATTACHMENT_LOAD_OP_CLEAR );
+        m_OffscreenMainLoadDepthRenderPass = CreateOffscreenRenderPass( VK_ATTACHMENT_LOAD_OP_LOAD );
+        CreateDepthPrepassRenderPass();
+
         CreateOffscreenAttachments();
         CreateOffscreenFramebuffers();
 
@@ -709,9 +1517,11 @@ namespace Mikoto {
     }
 
     auto VulkanRenderer::SubmitCommands() const -> void {
-        //m_Device->RegisterComputeCommand( m_ComputeCommandBuffer );
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        //m_Device->RegisterComputeCommand( m_ComputeCommandBuffers[frameIndex] );
 
-        m_Device->RegisterGraphicsCommand( m_DrawCommandBuffer );
+        m_Device->RegisterGraphicsCommand( m_DrawCommandBuffers[frameIndex] );
     }
 
     auto VulkanRenderer::InitializeDefaultPipeline() -> void {
@@ -743,24 +1553,21 @@ namespace Mikoto {
             fragmentShader->GetPipelineStageCreateInfo()
         };
 
-        const std::array descLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_BASE_SHADER ) };
-
-        // Create the pipeline layout
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( descLayouts.size() );
-        pipelineLayoutInfo.pSetLayouts = descLayouts.data();
+        // Set 0 is owned by the material, set 1 holds the lights of the scene and the camera of the frame
+        const std::array sharedSetLayouts{
+            VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_BASE_SHADER ),
+            VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS )
+        };
 
-        VkPipelineLayout layout{};
-        if ( vkCreatePipelineLayout( m_Device->GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( "Failed to create pipeline layout" );
-        }
+        const std::array shaders{ vertexShader, fragmentShader };
 
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(),
-                                    pipelineLayout = layout]() -> void {
-            vkDestroyPipelineLayout( device, pipelineLayout, nullptr );
-        } );
+        // Same push constant range as the PBR pipelines, see PushDrawConstants()
+        const VkPipelineLayout layout{ VulkanShaderLibrary::GetPipelineLayout( VulkanPipelineLayoutCreateInfo{
+            .Shaders{ shaders },
+            .SharedSetLayouts{ sharedSetLayouts },
+            .PushConstantSize{ sizeof( DrawPushConstants ) },
+            .PushConstantStages{ VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT },
+        } ) };
 
         // Create the pipeline
         auto defaultMatPipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
@@ -768,6 +1575,7 @@ namespace Mikoto {
         defaultMatPipelineConfig.PipelineLayout = layout;
         defaultMatPipelineConfig.RenderPass = m_OffscreenMainRenderPass;
         defaultMatPipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        defaultMatPipelineConfig.VertexStageReflection = std::addressof( vertexShader->GetReflection() );
 
         auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_COLOR, defaultMatPipelineConfig ) };
         if ( !success ) {
@@ -806,31 +1614,8 @@ namespace Mikoto {
             fragmentShader->GetPipelineStageCreateInfo()
         };
 
-        // Set layout
-        const std::array descLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_PBR_SHADER ) };
-
-        // Push constants. See push constants in frag shader
-        // First data is 12 bytes is which size sizeof(glm::vec3) using floats for the vec3
-        std::array pushConstantRanges{
-            VulkanHelpers::Initializers::PushConstantRange( VK_SHADER_STAGE_FRAGMENT_BIT, 32, sizeof( glm::vec4 ) ),
-        };
-
-        // Create the pipeline layout
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( descLayouts.size() );
-        pipelineLayoutInfo.pSetLayouts = descLayouts.data();
-
-        VkPipelineLayout layout{};
-        if ( vkCreatePipelineLayout( m_Device->GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( "Failed to create pipeline layout" );
-        }
-
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(),
-                                    pipelineLayout = layout]() -> void {
-            vkDestroyPipelineLayout( device, pipelineLayout, nullptr );
-        } );
+        // Every PBR pipeline shares the same layout, see CreatePBRPipelineLayout()
+        const VkPipelineLayout layout{ m_PBRPipelineLayout };
 
         // Create the pipeline
         auto defaultMatPipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
@@ -838,11 +1623,77 @@ namespace Mikoto {
         defaultMatPipelineConfig.PipelineLayout = layout;
         defaultMatPipelineConfig.RenderPass = m_OffscreenMainRenderPass;
         defaultMatPipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        defaultMatPipelineConfig.VertexStageReflection = std::addressof( vertexShader->GetReflection() );
+
+        // Variants for the other render modes and wireframe are built when first used
+        m_PipelineVariants.AddPass( MATERIAL_PASS_PBR, defaultMatPipelineConfig, DISPLAY_COLOR );
+
+        // Used after the depth pre-pass, the depth is already
+        // there, every fragment that fails the EQUAL test is skipped before shading
+        auto depthEqualPipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
+
+        depthEqualPipelineConfig.DepthStencilInfo.depthCompareOp = VK_COMPARE_OP_EQUAL;
+        depthEqualPipelineConfig.DepthStencilInfo.depthWriteEnable = VK_FALSE;
+
+        depthEqualPipelineConfig.PipelineLayout = layout;
+        depthEqualPipelineConfig.RenderPass = m_OffscreenMainLoadDepthRenderPass;
+        depthEqualPipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        depthEqualPipelineConfig.VertexStageReflection = std::addressof( vertexShader->GetReflection() );
+
+        m_PipelineVariants.AddPass( MATERIAL_PASS_PBR_DEPTH_EQUAL, depthEqualPipelineConfig, DISPLAY_COLOR );
+    }
+
+    auto VulkanRenderer::InitializeDepthPrepassPipeline() -> void {
+        const auto& fileSystem{ Engine::GetSystem<FileSystem>() };
+
+        const VulkanShaderCreateInfo vertexStage{
+            .FilePath{ PathBuilder()
+                               .WithPath( fileSystem.GetShadersRootPath().string() )
+                               .WithPath( "vulkan-spirv" )
+                               .WithPath( "DepthPrepassVertexShader.sprv" )
+                               .Build() },
+            .Stage{ VERTEX_STAGE },
+        };
+
+        const VulkanShader* vertexShader = VulkanShaderLibrary::LoadShader( vertexStage );
+
+        // No fragment stage, only the depth is written
+        const std::array pipelineShaderStageCreateInfos{
+            vertexShader->GetPipelineStageCreateInfo(),
+        };
+
+        // Reads the camera from the scene set and the transform from the push constants
+        const VkPipelineLayout layout{ m_PBRPipelineLayout };
+
+        auto depthPrepassPipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
+
+        // The render pass has no color attachments
+        depthPrepassPipelineConfig.ColorBlendInfo.attachmentCount = 0;
+        depthPrepassPipelineConfig.ColorBlendInfo.pAttachments = nullptr;
+
+        depthPrepassPipelineConfig.DepthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+        depthPrepassPipelineConfig.DepthStencilInfo.stencilTestEnable = VK_FALSE;
+
+        depthPrepassPipelineConfig.PipelineLayout = layout;
+        depthPrepassPipelineConfig.RenderPass = m_DepthPrepassRenderPass;
+        depthPrepassPipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        depthPrepassPipelineConfig.VertexStageReflection = std::addressof( vertexShader->GetReflection() );
+
+        // One pipeline per vertex format, the positions stream keeps the format of the vertices
+        for ( UInt32_T format{}; format < VERTEX_FORMAT_COUNT; ++format ) {
+            const BufferLayout& layout{ VertexBuffer::GetBufferLayout( static_cast<VertexFormat>( format ) ) };
+
+            const std::vector<VkVertexInputBindingDescription> positionBindings{ VulkanVertexBuffer::GetPositionBindingDescriptions( layout ) };
+            const std::vector<VkVertexInputAttributeDescription> positionAttributes{ VulkanVertexBuffer::GetPositionAttributeDescriptions( layout ) };
+
+            depthPrepassPipelineConfig.VertexBindings = positionBindings;
+            depthPrepassPipelineConfig.VertexAttributes = positionAttributes;
+
+            auto [it, success]{ m_Pipelines.try_emplace( GetDepthPrepassPass( static_cast<VertexFormat>( format ) ), depthPrepassPipelineConfig ) };
+            if ( !success ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeDepthPrepassPipeline - Failed to create depth pre-pass pipeline." );
+            }
 
-        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_PBR, defaultMatPipelineConfig ) };
-        if ( !success ) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeDefaultPipeline - Failed to create standard pipeline." );
-        } else {
             it->second.Init();
         }
     }
@@ -876,25 +1727,8 @@ namespace Mikoto {
             fragmentShader->GetPipelineStageCreateInfo()
         };
 
-        // Set layout
-        const std::array descLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_PBR_SHADER ) };
-
-        // Create the pipeline layout
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( descLayouts.size() );
-        pipelineLayoutInfo.pSetLayouts = descLayouts.data();
-
-        VkPipelineLayout layout{};
-        if ( vkCreatePipelineLayout( m_Device->GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( "Failed to create pipeline layout" );
-        }
-
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(),
-                                    pipelineLayout = layout]() -> void {
-            vkDestroyPipelineLayout( device, pipelineLayout, nullptr );
-        } );
+        // Same layout as the PBR pipelines, see CreatePBRPipelineLayout()
+        const VkPipelineLayout layout{ m_PBRPipelineLayout };
 
         // Create the pipeline
         auto defaultMatPipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
@@ -909,6 +1743,7 @@ namespace Mikoto {
         defaultMatPipelineConfig.PipelineLayout = layout;
         defaultMatPipelineConfig.RenderPass = m_OffscreenMainRenderPass;
         defaultMatPipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        defaultMatPipelineConfig.VertexStageReflection = std::addressof( vertexShader->GetReflection() );
 
         auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_OUTLINE, defaultMatPipelineConfig ) };
         if ( !success ) {
@@ -918,68 +1753,42 @@ namespace Mikoto {
         it->second.Init();
     }
 
-    auto VulkanRenderer::InitializePBRWireFramePipeline() -> void {
+    auto VulkanRenderer::InitializeComputePipelines() -> void {
         const auto& fileSystem{ Engine::GetSystem<FileSystem>() };
 
-        const VulkanShaderCreateInfo vertexStage{
+        // Compute pipeline only takes one shader stage
+        const VulkanShaderCreateInfo lightCullingComputeShaderCreateInfo{
             .FilePath{ PathBuilder()
                                .WithPath( fileSystem.GetShadersRootPath().string() )
                                .WithPath( "vulkan-spirv" )
-                               .WithPath( "PBRVertexShader.sprv" )
+                               .WithPath( "Compute_Shader.sprv" )
                                .Build() },
-            .Stage{ VERTEX_STAGE },
+            .Stage{ COMPUTE_STAGE },
         };
 
-        const VulkanShaderCreateInfo fragmentStage{
-            .FilePath{ PathBuilder()
-                               .WithPath( fileSystem.GetShadersRootPath().string() )
-                               .WithPath( "vulkan-spirv" )
-                               .WithPath( "PBRFragmentShader.sprv" )
-                               .Build() },
-            .Stage{ FRAGMENT_STAGE },
-        };
 
-        const VulkanShader* fragmentShader = VulkanShaderLibrary::LoadShader( fragmentStage );
-        const VulkanShader* vertexShader = VulkanShaderLibrary::LoadShader( vertexStage );
+        const VulkanShader* lightCullingComputeShader{ VulkanShaderLibrary::LoadShader( lightCullingComputeShaderCreateInfo ) };
 
         const std::array pipelineShaderStageCreateInfos{
-            vertexShader->GetPipelineStageCreateInfo(),
-            fragmentShader->GetPipelineStageCreateInfo()
+            lightCullingComputeShader->GetPipelineStageCreateInfo(),
         };
 
-        const std::array descLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_PBR_SHADER ) };
-
-        // Create the pipeline layout
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( descLayouts.size() );
-        pipelineLayoutInfo.pSetLayouts = descLayouts.data();
-
-        VkPipelineLayout layout{};
-        if ( vkCreatePipelineLayout( m_Device->GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( "Failed to create pipeline layout" );
-        }
-
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(),
-                                    pipelineLayout = layout]() -> void {
-            vkDestroyPipelineLayout( device, pipelineLayout, nullptr );
-        } );
+        const std::array sharedSetLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_COMPUTE_PIPELINE ) };
+        const std::array shaders{ lightCullingComputeShader };
 
+        const VkPipelineLayout layout{ VulkanShaderLibrary::GetPipelineLayout( VulkanPipelineLayoutCreateInfo{
+            .Shaders{ shaders },
+            .SharedSetLayouts{ sharedSetLayouts },
+        } ) };
 
         // Create the pipeline
-        auto wireframePipelineConfig{ GetDefaultGraphicsPipelineConfigInfo() };
-
-        constexpr float GPU_STANDARD_LINE_WIDTH{ 1.0f };
-        wireframePipelineConfig.RasterizationInfo.polygonMode = VK_POLYGON_MODE_LINE;
-        wireframePipelineConfig.RasterizationInfo.cullMode = VK_CULL_MODE_NONE;
-        wireframePipelineConfig.RasterizationInfo.lineWidth = GPU_STANDARD_LINE_WIDTH;
+        auto computePipelineCreateInfo{ GetDefaultComputePipelineConfigInfo() };
+        computePipelineCreateInfo.Type = PipelineType::VULKAN_COMPUTE_PIPELINE;
 
-        wireframePipelineConfig.RenderPass = m_OffscreenMainRenderPass;
-        wireframePipelineConfig.PipelineLayout = layout;
-        wireframePipelineConfig.ShaderStages = pipelineShaderStageCreateInfos;
+        computePipelineCreateInfo.PipelineLayout = layout;
+        computePipelineCreateInfo.ShaderStages = pipelineShaderStageCreateInfos;
 
-        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_WIREFRAME, wireframePipelineConfig ) };
+        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_COMPUTE, computePipelineCreateInfo ) };
         if ( !success ) {
             MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeDefaultPipeline - Failed to create standard pipeline." );
         } else {
@@ -987,74 +1796,163 @@ namespace Mikoto {
         }
     }
 
-    auto VulkanRenderer::InitializeComputePipelines() -> void {
+    auto VulkanRenderer::InitializeLightCullingPipeline() -> void {
         const auto& fileSystem{ Engine::GetSystem<FileSystem>() };
 
-        // Compute pipeline only takes one shader stage
-        const VulkanShaderCreateInfo lightCullingComputeShaderCreateInfo{
+        const VulkanShaderCreateInfo lightCullingShaderCreateInfo{
             .FilePath{ PathBuilder()
                                .WithPath( fileSystem.GetShadersRootPath().string() )
                                .WithPath( "vulkan-spirv" )
-                               .WithPath( "Compute_Shader.sprv" )
+                               .WithPath( "ClusteredLightCulling.sprv" )
                                .Build() },
             .Stage{ COMPUTE_STAGE },
         };
 
-
-        const VulkanShader* lightCullingComputeShader{ VulkanShaderLibrary::LoadShader( lightCullingComputeShaderCreateInfo ) };
+        const VulkanShader* lightCullingShader{ VulkanShaderLibrary::LoadShader( lightCullingShaderCreateInfo ) };
 
         const std::array pipelineShaderStageCreateInfos{
-            lightCullingComputeShader->GetPipelineStageCreateInfo(),
+            lightCullingShader->GetPipelineStageCreateInfo(),
         };
 
-        const std::array descLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_COMPUTE_PIPELINE ) };
+        // Reads the lights and writes the cluster lists of the scene lights set
+        const std::array sharedSetLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS ) };
+        const std::array shaders{ lightCullingShader };
+
+        const VkPipelineLayout layout{ VulkanShaderLibrary::GetPipelineLayout( VulkanPipelineLayoutCreateInfo{
+            .Shaders{ shaders },
+            .SharedSetLayouts{ sharedSetLayouts },
+        } ) };
 
-        // Create the pipeline layout
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( descLayouts.size() );
-        pipelineLayoutInfo.pSetLayouts = descLayouts.data();
+        auto lightCullingPipelineCreateInfo{ GetDefaultComputePipelineConfigInfo() };
+        lightCullingPipelineCreateInfo.Type = PipelineType::VULKAN_COMPUTE_PIPELINE;
 
-        VkPipelineLayout layout{};
-        if ( vkCreatePipelineLayout( m_Device->GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeComputePipelines - Failed to create pipeline layout" );
+        lightCullingPipelineCreateInfo.PipelineLayout = layout;
+        lightCullingPipelineCreateInfo.ShaderStages = pipelineShaderStageCreateInfos;
+
+        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_LIGHT_CULLING, lightCullingPipelineCreateInfo ) };
+        if ( !success ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeLightCullingPipeline - Failed to create light culling pipeline." );
+        } else {
+            it->second.Init();
         }
+    }
 
-        VulkanDeletionQueue::Push( [device = m_Device->GetLogicalDevice(), pipelineLayout = layout]() -> void {
-            vkDestroyPipelineLayout( device, pipelineLayout, nullptr );
-        } );
+    auto VulkanRenderer::InitializeDrawCullingPipeline() -> void {
+        const auto& fileSystem{ Engine::GetSystem<FileSystem>() };
 
-        // Create the pipeline
-        auto computePipelineCreateInfo{ GetDefaultComputePipelineConfigInfo() };
-        computePipelineCreateInfo.Type = PipelineType::VULKAN_COMPUTE_PIPELINE;
+        const VulkanShaderCreateInfo drawCullingShaderCreateInfo{
+            .FilePath{ PathBuilder()
+                               .WithPath( fileSystem.GetShadersRootPath().string() )
+                               .WithPath( "vulkan-spirv" )
+                               .WithPath( "DrawCulling.sprv" )
+                               .Build() },
+            .Stage{ COMPUTE_STAGE },
+        };
 
-        computePipelineCreateInfo.PipelineLayout = layout;
-        computePipelineCreateInfo.ShaderStages = pipelineShaderStageCreateInfos;
+        const VulkanShader* drawCullingShader{ VulkanShaderLibrary::LoadShader( drawCullingShaderCreateInfo ) };
 
-        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_COMPUTE, computePipelineCreateInfo ) };
+        const std::array pipelineShaderStageCreateInfos{
+            drawCullingShader->GetPipelineStageCreateInfo(),
+        };
+
+        // Reads the draw instances and writes the indirect draw bindings of the scene lights set
+        const std::array sharedSetLayouts{ VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS ) };
+        const std::array shaders{ drawCullingShader };
+
+        const VkPipelineLayout layout{ VulkanShaderLibrary::GetPipelineLayout( VulkanPipelineLayoutCreateInfo{
+            .Shaders{ shaders },
+            .SharedSetLayouts{ sharedSetLayouts },
+            .PushConstantSize{ sizeof( DrawCullingPushConstants ) },
+            .PushConstantStages{ VK_SHADER_STAGE_COMPUTE_BIT },
+        } ) };
+
+        auto drawCullingPipelineCreateInfo{ GetDefaultComputePipelineConfigInfo() };
+        drawCullingPipelineCreateInfo.Type = PipelineType::VULKAN_COMPUTE_PIPELINE;
+
+        drawCullingPipelineCreateInfo.PipelineLayout = layout;
+        drawCullingPipelineCreateInfo.ShaderStages = pipelineShaderStageCreateInfos;
+
+        auto [it, success]{ m_Pipelines.try_emplace( MATERIAL_PASS_DRAW_CULLING, drawCullingPipelineCreateInfo ) };
         if ( !success ) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeDefaultPipeline - Failed to create standard pipeline." );
+            MKT_THROW_RUNTIME_ERROR( "VulkanRenderer::InitializeDrawCullingPipeline - Failed to create draw culling pipeline." );
         } else {
             it->second.Init();
         }
     }
 
+    auto VulkanRenderer::CreatePBRPipelineLayout() -> void {
+        const auto& fileSystem{ Engine::GetSystem<FileSystem>() };
+
+        const auto loadShader{ [&fileSystem]( const std::string_view fileName, const ShaderStage stage ) -> const VulkanShader* {
+            return VulkanShaderLibrary::LoadShader( VulkanShaderCreateInfo{
+                .FilePath{ PathBuilder()
+                                   .WithPath( fileSystem.GetShadersRootPath().string() )
+                                   .WithPath( "vulkan-spirv" )
+                                   .WithPath( fileName )
+                                   .Build() },
+                .Stage{ stage },
+            } );
+        } };
+
+        // Every pipeline sharing the layout, the layout has to satisfy all of them
+        const std::array shaders{
+            loadShader( "PBRVertexShader.sprv", VERTEX_STAGE ),
+            loadShader( "PBRFragmentShader.sprv", FRAGMENT_STAGE ),
+            loadShader( "DepthPrepassVertexShader.sprv", VERTEX_STAGE ),
+            loadShader( "Outline_Vert.sprv", VERTEX_STAGE ),
+            loadShader( "Outline_Frag.sprv", FRAGMENT_STAGE ),
+        };
+
+        // Set 0 holds the bindless textures and materials, set 1 the lights and the camera of the frame
+        const std::array sharedSetLayouts{
+            VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_BINDLESS ),
+            VulkanContext::Get().GetDescriptorSetLayouts( DESCRIPTOR_SET_LAYOUT_SCENE_LIGHTS )
+        };
+
+        // Transform and material index of the outline draws, the other PBR pipelines read them from the draw instances
+        m_PBRPipelineLayout = VulkanShaderLibrary::GetPipelineLayout( VulkanPipelineLayoutCreateInfo{
+            .Shaders{ shaders },
+            .SharedSetLayouts{ sharedSetLayouts },
+            .PushConstantSize{ sizeof( DrawPushConstants ) },
+            .PushConstantStages{ VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT },
+        } );
+    }
+
     auto VulkanRenderer::CreateRendererPipelines() -> void {
-        InitializeDefaultPipeline();
+        const Timer timer{ "VulkanRenderer::CreateRendererPipelines - Building renderer pipelines." };
 
-        InitializePBRWireFramePipeline();
+        CreatePBRPipelineLayout();
+
+        InitializeDefaultPipeline();
 
         InitializePBRPipeline();
 
+        InitializeDepthPrepassPipeline();
+
         InitializeComputePipelines();
 
+        InitializeLightCullingPipeline();
+
+        InitializeDrawCullingPipeline();
+
         InitializeOutlinePipeline();
+
+        // Dominates the time to first frame when the pipeline cache is cold
+        MKT_CORE_LOGGER_INFO( "VulkanRenderer::CreateRendererPipelines - Built pipelines in {:.2f} ms, pipeline cache was {}.",
+            timer.GetCurrentProgress( TimeUnit::MILLISECONDS ),
+            VulkanContext::Get().GetPipelineCache().IsWarm() ? "warm" : "cold" );
     }
 
     auto VulkanRenderer::Flush() -> void {
         RecordComputeCommands();
 
+        // Lights are shared by every draw and culled on the GPU, upload them once before recording
+        UploadSceneLights();
+        UploadFrameUniforms();
+
+        // Textures registered since this frame's set was last used get written now
+        VulkanContext::Get().GetBindlessManager().BeginFrame();
+
         RecordCommands();
 
         // NOTE: Compute, Graphics and Present queues might be the same
@@ -1062,11 +1960,6 @@ namespace Mikoto {
         // If Graphics queue and Compute queue are the same queue they will share index
         // so might consider for this specific case to use pipeline barriers between these two commands buffers
         SubmitCommands();
-
-        // For light culling we want to:
-        // submit depth pre-pass command buffer
-        // submit light culling command buffer
-        // Submitting final composition command buffer
     }
 
     auto VulkanRenderer::AddToDrawQueue( const EntityQueueInfo& queueInfo ) -> bool {
@@ -1079,6 +1972,11 @@ namespace Mikoto {
         };
 
         if ( it != m_DrawQueue.end() ) {
+            // Entries are updated every frame, the level of detail carries over while the mesh stays the same
+            if ( it->second.Object == info.Object ) {
+                info.LodIndex = it->second.LodIndex;
+            }
+
             it->second = info;
             return true;
         }
@@ -1105,7 +2003,7 @@ namespace Mikoto {
     }
 
     auto VulkanRenderer::CreateCommandPools() -> void {
-        const auto& [Present, Graphics, Compute]{
+        const auto& [Present, Graphics, Compute, Transfer]{
             m_Device->GetLogicalDeviceQueues()
         };
 
@@ -1123,9 +2021,9 @@ namespace Mikoto {
 
         // Command pool to allocate command buffers for compute queue operations
         VkCommandPoolCreateInfo computeQueueCmdPoolCreateInfo{ VulkanHelpers::Initializers::CommandPoolCreateInfo() };
-        graphicsQueueCmdPoolCreateInfo.flags = 0;
-        graphicsQueueCmdPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        graphicsQueueCmdPoolCreateInfo.queueFamilyIndex = Compute->FamilyIndex;
+        computeQueueCmdPoolCreateInfo.flags = 0;
+        computeQueueCmdPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        computeQueueCmdPoolCreateInfo.queueFamilyIndex = Compute->FamilyIndex;
 
         const VulkanCommandPoolCreateInfo vulkanComputeQueueCommandPoolCreateInfo{
             .CreateInfo{ computeQueueCmdPoolCreateInfo },
@@ -6,6 +6,7 @@
 // C++ Standard Library
 #include <filesystem>
 #include <fstream>
+#include <span>
 
 // Third-Party Libraries
 #include "volk.h"
@@ -35,10 +36,24 @@ namespace Mikoto {
         }
 
         m_File = shaderFile;
+        m_FilePath = createInfo.FilePath;
+
+        if ( m_File->GetFileContents().size() % sizeof( UInt32_T ) != 0 ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShader::Upload - '{}' is not a SPIR-V module.", m_FilePath.string() ) );
+        }
+
+        const std::span<const UInt32_T> code{
+            reinterpret_cast<const UInt32_T*>( m_File->GetFileContents().data() ),
+            m_File->GetFileContents().size() / sizeof( UInt32_T )
+        };
+
+        // Bindings, push constants and vertex inputs are checked against
+        // the pipeline layouts when the pipelines are created, not when drawing
+        m_Reflection = VulkanShaderReflection::Reflect( code, VulkanHelpers::GetVkStageFromShaderStage( m_Stage ) );
 
         VkShaderModuleCreateInfo moduleCreateInfo{ VulkanHelpers::Initializers::ShaderModuleCreateInfo() };
-        moduleCreateInfo.codeSize = m_File->GetFileContents().size();
-        moduleCreateInfo.pCode = reinterpret_cast<const UInt32_T*>( m_File->GetFileContents().data() );
+        moduleCreateInfo.codeSize = code.size_bytes();
+        moduleCreateInfo.pCode = code.data();
 
         VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
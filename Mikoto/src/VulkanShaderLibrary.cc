@@ -2,12 +2,59 @@
 // Created by zanet on 2/9/2025.
 //
 
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+
+#include <fmt/format.h>
+#include <volk.h>
+
+#include <Common/Common.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
 #include <Renderer/Vulkan/VulkanShaderLibrary.hh>
 
 namespace Mikoto {
+    namespace {
+        // Layouts with the same key are interchangeable
+        auto AppendKey( std::string &key, const UInt64_T value ) -> void {
+            fmt::format_to( std::back_inserter( key ), "{}:", value );
+        }
+
+        auto GetDescriptorSetLayoutKey( const std::span<const VkDescriptorSetLayoutBinding> bindings ) -> std::string {
+            std::string key{};
+
+            for ( const VkDescriptorSetLayoutBinding &binding : bindings ) {
+                AppendKey( key, binding.binding );
+                AppendKey( key, binding.descriptorType );
+                AppendKey( key, binding.descriptorCount );
+                AppendKey( key, binding.stageFlags );
+            }
+
+            return key;
+        }
+    }
+
     auto VulkanShaderLibrary::Init() -> void {
     }
+
     auto VulkanShaderLibrary::Shutdown() -> void {
+        const VkDevice device{ VulkanContext::Get().GetDevice().GetLogicalDevice() };
+
+        for ( const VkPipelineLayout layout : s_PipelineLayouts | std::views::values ) {
+            vkDestroyPipelineLayout( device, layout, nullptr );
+        }
+
+        // Shared layouts are destroyed by their owners
+        for ( const VkDescriptorSetLayout layout : s_SetLayouts | std::views::values ) {
+            vkDestroyDescriptorSetLayout( device, layout, nullptr );
+        }
+
+        s_PipelineLayouts.clear();
+        s_SetLayouts.clear();
+        s_SetLayoutBindings.clear();
+
         s_Shaders.clear();
     }
 
@@ -38,4 +85,160 @@ namespace Mikoto {
 
         return nullptr;
     }
-}
\ No newline at end of file
+
+    auto VulkanShaderLibrary::RegisterSharedSetLayout( const VkDescriptorSetLayout layout, const std::span<const VkDescriptorSetLayoutBinding> bindings ) -> void {
+        std::scoped_lock lock{ s_LayoutsMutex };
+
+        s_SetLayoutBindings.insert_or_assign( layout, std::vector<VkDescriptorSetLayoutBinding>{ bindings.begin(), bindings.end() } );
+    }
+
+    auto VulkanShaderLibrary::GetDescriptorSetLayout( const std::span<const VkDescriptorSetLayoutBinding> bindings ) -> VkDescriptorSetLayout {
+        std::scoped_lock lock{ s_LayoutsMutex };
+
+        const std::string key{ GetDescriptorSetLayoutKey( bindings ) };
+
+        if ( const auto it{ s_SetLayouts.find( key ) }; it != s_SetLayouts.end() ) {
+            return it->second;
+        }
+
+        VkDescriptorSetLayoutCreateInfo createInfo{ VulkanHelpers::Initializers::DescriptorSetLayoutCreateInfo() };
+        createInfo.bindingCount = static_cast<UInt32_T>( bindings.size() );
+        createInfo.pBindings = bindings.data();
+
+        VkDescriptorSetLayout layout{};
+        if ( vkCreateDescriptorSetLayout( VulkanContext::Get().GetDevice().GetLogicalDevice(), std::addressof( createInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanShaderLibrary::GetDescriptorSetLayout - Failed to create descriptor set layout." );
+        }
+
+        s_SetLayouts.try_emplace( key, layout );
+        s_SetLayoutBindings.try_emplace( layout, bindings.begin(), bindings.end() );
+
+        return layout;
+    }
+
+    auto VulkanShaderLibrary::GetPipelineLayout( const VulkanPipelineLayoutCreateInfo &createInfo ) -> VkPipelineLayout {
+        VulkanShaderReflection reflection{};
+        std::string shaderNames{};
+
+        for ( const VulkanShader *shader : createInfo.Shaders ) {
+            reflection.Merge( shader->GetReflection() );
+
+            fmt::format_to( std::back_inserter( shaderNames ), "{}'{}'", shaderNames.empty() ? "" : ", ", shader->GetFilePath().filename().string() );
+        }
+
+        // Sets without bindings in between the used ones still need a layout
+        const UInt32_T setCount{ std::max( reflection.GetSetCount(), static_cast<UInt32_T>( createInfo.SharedSetLayouts.size() ) ) };
+        std::vector<VkDescriptorSetLayout> setLayouts( setCount );
+
+        for ( UInt32_T set{}; set < setCount; ++set ) {
+            std::vector<ShaderBindingReflection> setBindings{};
+            std::ranges::copy_if( reflection.GetBindings(), std::back_inserter( setBindings ), [set]( const ShaderBindingReflection &binding ) -> bool {
+                return binding.Set == set;
+            } );
+
+            if ( set < createInfo.SharedSetLayouts.size() && createInfo.SharedSetLayouts[set] != VK_NULL_HANDLE ) {
+                ValidateSharedSetLayout( createInfo.SharedSetLayouts[set], setBindings, shaderNames );
+                setLayouts[set] = createInfo.SharedSetLayouts[set];
+                continue;
+            }
+
+            std::vector<VkDescriptorSetLayoutBinding> layoutBindings{};
+            layoutBindings.reserve( setBindings.size() );
+
+            for ( const ShaderBindingReflection &binding : setBindings ) {
+                if ( binding.Count == 0 ) {
+                    MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::GetPipelineLayout - {} declare a runtime array at set {} binding {}, it needs a shared set layout.",
+                        shaderNames, binding.Set, binding.Binding ) );
+                }
+
+                layoutBindings.emplace_back( VkDescriptorSetLayoutBinding{
+                    .binding{ binding.Binding },
+                    .descriptorType{ binding.Type },
+                    .descriptorCount{ binding.Count },
+                    .stageFlags{ binding.Stages },
+                    .pImmutableSamplers{},
+                } );
+            }
+
+            setLayouts[set] = GetDescriptorSetLayout( layoutBindings );
+        }
+
+        // A single range seen by every stage the renderer pushes to
+        if ( reflection.GetPushConstantSize() > createInfo.PushConstantSize ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::GetPipelineLayout - {} read {} bytes of push constants, only {} are pushed.",
+                shaderNames, reflection.GetPushConstantSize(), createInfo.PushConstantSize ) );
+        }
+
+        if ( ( reflection.GetPushConstantStages() & ~createInfo.PushConstantStages ) != 0 ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::GetPipelineLayout - {} read push constants from stages that are not pushed to.", shaderNames ) );
+        }
+
+        std::vector<VkPushConstantRange> pushConstantRanges{};
+        if ( createInfo.PushConstantSize != 0 ) {
+            pushConstantRanges.emplace_back( VulkanHelpers::Initializers::PushConstantRange( createInfo.PushConstantStages, createInfo.PushConstantSize, 0 ) );
+        }
+
+        std::scoped_lock lock{ s_LayoutsMutex };
+
+        std::string key{};
+        for ( const VkDescriptorSetLayout setLayout : setLayouts ) {
+            AppendKey( key, reinterpret_cast<UInt64_T>( setLayout ) );
+        }
+
+        AppendKey( key, createInfo.PushConstantSize );
+        AppendKey( key, createInfo.PushConstantStages );
+
+        if ( const auto it{ s_PipelineLayouts.find( key ) }; it != s_PipelineLayouts.end() ) {
+            return it->second;
+        }
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{ VulkanHelpers::Initializers::PipelineLayoutCreateInfo() };
+        pipelineLayoutInfo.pushConstantRangeCount = static_cast<UInt32_T>( pushConstantRanges.size() );
+        pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
+        pipelineLayoutInfo.setLayoutCount = static_cast<UInt32_T>( setLayouts.size() );
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+
+        VkPipelineLayout layout{};
+        if ( vkCreatePipelineLayout( VulkanContext::Get().GetDevice().GetLogicalDevice(), std::addressof( pipelineLayoutInfo ), nullptr, std::addressof( layout ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanShaderLibrary::GetPipelineLayout - Failed to create pipeline layout." );
+        }
+
+        s_PipelineLayouts.try_emplace( key, layout );
+
+        return layout;
+    }
+
+    auto VulkanShaderLibrary::ValidateSharedSetLayout( const VkDescriptorSetLayout layout, const std::span<const ShaderBindingReflection> bindings, const std::string &shaderNames ) -> void {
+        std::scoped_lock lock{ s_LayoutsMutex };
+
+        const auto layoutIt{ s_SetLayoutBindings.find( layout ) };
+        if ( layoutIt == s_SetLayoutBindings.end() ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanShaderLibrary::ValidateSharedSetLayout - Shared set layout was not registered." );
+        }
+
+        for ( const ShaderBindingReflection &binding : bindings ) {
+            const auto it{ std::ranges::find( layoutIt->second, binding.Binding, &VkDescriptorSetLayoutBinding::binding ) };
+
+            if ( it == layoutIt->second.end() ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::ValidateSharedSetLayout - {} use set {} binding {}, which the layout does not declare.",
+                    shaderNames, binding.Set, binding.Binding ) );
+            }
+
+            if ( it->descriptorType != binding.Type ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::ValidateSharedSetLayout - {} expect a different descriptor type at set {} binding {}.",
+                    shaderNames, binding.Set, binding.Binding ) );
+            }
+
+            // Runtime arrays take whatever the layout provides
+            if ( binding.Count > it->descriptorCount ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::ValidateSharedSetLayout - {} expect {} descriptors at set {} binding {}, the layout has {}.",
+                    shaderNames, binding.Count, binding.Set, binding.Binding, it->descriptorCount ) );
+            }
+
+            if ( ( binding.Stages & ~it->stageFlags ) != 0 ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderLibrary::ValidateSharedSetLayout - Set {} binding {} is not visible to every stage of {} using it.",
+                    binding.Set, binding.Binding, shaderNames ) );
+            }
+        }
+    }
+}
@@ -0,0 +1,613 @@
+/**
+ * VulkanShaderReflection.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Third-Party Libraries
+#include <fmt/format.h>
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Renderer/Vulkan/VulkanShaderReflection.hh>
+
+namespace Mikoto {
+
+    namespace {
+        // See the SPIR-V specification, only the values the reflection looks at are listed
+        constexpr UInt32_T SPIRV_MAGIC_NUMBER{ 0x07230203 };
+        constexpr Size_T SPIRV_HEADER_WORD_COUNT{ 5 };
+
+        constexpr UInt32_T OP_DECORATE{ 71 };
+        constexpr UInt32_T OP_MEMBER_DECORATE{ 72 };
+        constexpr UInt32_T OP_TYPE_BOOL{ 20 };
+        constexpr UInt32_T OP_TYPE_INT{ 21 };
+        constexpr UInt32_T OP_TYPE_FLOAT{ 22 };
+        constexpr UInt32_T OP_TYPE_VECTOR{ 23 };
+        constexpr UInt32_T OP_TYPE_MATRIX{ 24 };
+        constexpr UInt32_T OP_TYPE_IMAGE{ 25 };
+        constexpr UInt32_T OP_TYPE_SAMPLER{ 26 };
+        constexpr UInt32_T OP_TYPE_SAMPLED_IMAGE{ 27 };
+        constexpr UInt32_T OP_TYPE_ARRAY{ 28 };
+        constexpr UInt32_T OP_TYPE_RUNTIME_ARRAY{ 29 };
+        constexpr UInt32_T OP_TYPE_STRUCT{ 30 };
+        constexpr UInt32_T OP_TYPE_POINTER{ 32 };
+        constexpr UInt32_T OP_CONSTANT{ 43 };
+        constexpr UInt32_T OP_SPEC_CONSTANT{ 50 };
+        constexpr UInt32_T OP_VARIABLE{ 59 };
+        constexpr UInt32_T OP_TYPE_ACCELERATION_STRUCTURE{ 5341 };
+
+        constexpr UInt32_T DECORATION_BUFFER_BLOCK{ 3 };
+        constexpr UInt32_T DECORATION_ARRAY_STRIDE{ 6 };
+        constexpr UInt32_T DECORATION_MATRIX_STRIDE{ 7 };
+        constexpr UInt32_T DECORATION_BUILT_IN{ 11 };
+        constexpr UInt32_T DECORATION_LOCATION{ 30 };
+        constexpr UInt32_T DECORATION_BINDING{ 33 };
+        constexpr UInt32_T DECORATION_DESCRIPTOR_SET{ 34 };
+        constexpr UInt32_T DECORATION_OFFSET{ 35 };
+
+        constexpr UInt32_T STORAGE_CLASS_UNIFORM_CONSTANT{ 0 };
+        constexpr UInt32_T STORAGE_CLASS_INPUT{ 1 };
+        constexpr UInt32_T STORAGE_CLASS_UNIFORM{ 2 };
+        constexpr UInt32_T STORAGE_CLASS_PUSH_CONSTANT{ 9 };
+        constexpr UInt32_T STORAGE_CLASS_STORAGE_BUFFER{ 12 };
+
+        constexpr UInt32_T IMAGE_DIM_BUFFER{ 5 };
+        constexpr UInt32_T IMAGE_DIM_SUBPASS_DATA{ 6 };
+        constexpr UInt32_T IMAGE_SAMPLED_STORAGE{ 2 };
+
+        // Words the reflection reads from an instruction, opcode included, see the SPIR-V specification
+        constexpr auto GetMinimumWordCount( const UInt32_T opcode ) -> UInt32_T {
+            switch ( opcode ) {
+                case OP_TYPE_BOOL:
+                case OP_TYPE_SAMPLER:
+                case OP_TYPE_STRUCT:
+                case OP_TYPE_ACCELERATION_STRUCTURE:
+                    return 2;
+                case OP_DECORATE:
+                case OP_TYPE_FLOAT:
+                case OP_TYPE_SAMPLED_IMAGE:
+                case OP_TYPE_RUNTIME_ARRAY:
+                    return 3;
+                case OP_MEMBER_DECORATE:
+                case OP_TYPE_INT:
+                case OP_TYPE_VECTOR:
+                case OP_TYPE_MATRIX:
+                case OP_TYPE_ARRAY:
+                case OP_TYPE_POINTER:
+                case OP_CONSTANT:
+                case OP_SPEC_CONSTANT:
+                case OP_VARIABLE:
+                    return 4;
+                case OP_TYPE_IMAGE:
+                    return 9;
+                default:
+                    return 1;
+            }
+        }
+
+        struct SpirvId {
+            UInt32_T Opcode{};
+
+            // Words of the instruction that declared the id, opcode included
+            std::span<const UInt32_T> Instruction{};
+
+            UInt32_T Set{};
+            UInt32_T Binding{};
+            UInt32_T Location{};
+            UInt32_T ArrayStride{};
+
+            bool HasBinding{};
+            bool HasLocation{};
+            bool IsBuiltIn{};
+            bool IsBufferBlock{};
+        };
+
+        struct SpirvMember {
+            UInt32_T Offset{};
+            UInt32_T MatrixStride{};
+            bool HasOffset{};
+        };
+
+        class SpirvModule {
+        public:
+            explicit SpirvModule( const std::span<const UInt32_T> code ) {
+                if ( code.size() < SPIRV_HEADER_WORD_COUNT || code[0] != SPIRV_MAGIC_NUMBER ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanShaderReflection::Reflect - Code is not a SPIR-V module." );
+                }
+
+                // Every id of the module is lower than the bound
+                m_Ids.resize( code[3] );
+
+                for ( Size_T offset{ SPIRV_HEADER_WORD_COUNT }; offset < code.size(); ) {
+                    const UInt32_T wordCount{ code[offset] >> 16 };
+                    const UInt32_T opcode{ code[offset] & 0xFFFF };
+
+                    if ( wordCount == 0 || offset + wordCount > code.size() ) {
+                        MKT_THROW_RUNTIME_ERROR( "VulkanShaderReflection::Reflect - SPIR-V module is truncated." );
+                    }
+
+                    if ( wordCount < GetMinimumWordCount( opcode ) ) {
+                        MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Reflect - SPIR-V instruction with opcode {} has {} words, expected at least {}.", opcode, wordCount, GetMinimumWordCount( opcode ) ) );
+                    }
+
+                    const std::span<const UInt32_T> instruction{ code.subspan( offset, wordCount ) };
+                    ParseInstruction( opcode, instruction );
+
+                    offset += wordCount;
+                }
+            }
+
+            MKT_NODISCARD auto GetId( const UInt32_T id ) const -> const SpirvId& {
+                if ( id >= m_Ids.size() ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanShaderReflection::Reflect - SPIR-V id out of bounds." );
+                }
+
+                return m_Ids[id];
+            }
+
+            MKT_NODISCARD auto GetMember( const UInt32_T structId, const UInt32_T member ) const -> SpirvMember {
+                const auto it{ m_Members.find( GetMemberKey( structId, member ) ) };
+                return it != m_Members.end() ? it->second : SpirvMember{};
+            }
+
+            MKT_NODISCARD auto GetVariables() const -> const std::vector<UInt32_T>& { return m_Variables; }
+
+            MKT_NODISCARD auto GetConstant( const UInt32_T id ) const -> UInt32_T {
+                const SpirvId& constant{ GetId( id ) };
+
+                // Specialization constants are read with their default value
+                if ( ( constant.Opcode != OP_CONSTANT && constant.Opcode != OP_SPEC_CONSTANT ) || constant.Instruction.size() < 4 ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanShaderReflection::Reflect - Array length is not a constant." );
+                }
+
+                return constant.Instruction[3];
+            }
+
+            // Bytes taken by a value of the type in an explicitly laid out block
+            MKT_NODISCARD auto GetTypeSize( const UInt32_T typeId ) const -> UInt32_T {
+                const SpirvId& type{ GetId( typeId ) };
+
+                switch ( type.Opcode ) {
+                    case OP_TYPE_BOOL:
+                        return sizeof( UInt32_T );
+                    case OP_TYPE_INT:
+                    case OP_TYPE_FLOAT:
+                        return type.Instruction[2] / 8;
+                    case OP_TYPE_VECTOR:
+                        return GetTypeSize( type.Instruction[2] ) * type.Instruction[3];
+                    case OP_TYPE_MATRIX:
+                        return GetTypeSize( type.Instruction[2] ) * type.Instruction[3];
+                    case OP_TYPE_ARRAY: {
+                        const UInt32_T stride{ type.ArrayStride != 0 ? type.ArrayStride : GetTypeSize( type.Instruction[2] ) };
+                        return stride * GetConstant( type.Instruction[3] );
+                    }
+                    case OP_TYPE_RUNTIME_ARRAY:
+                        return 0;
+                    case OP_TYPE_STRUCT:
+                        return GetStructSize( typeId );
+                    default:
+                        MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Reflect - Type with opcode {} cannot be placed in a block.", type.Opcode ) );
+                }
+            }
+
+        private:
+            MKT_NODISCARD static auto GetMemberKey( const UInt32_T structId, const UInt32_T member ) -> UInt64_T {
+                return ( static_cast<UInt64_T>( structId ) << 32 ) | member;
+            }
+
+            MKT_NODISCARD auto GetStructSize( const UInt32_T structId ) const -> UInt32_T {
+                const SpirvId& type{ GetId( structId ) };
+
+                UInt32_T size{};
+                UInt32_T packedOffset{};
+
+                for ( UInt32_T member{}; member + 2 < type.Instruction.size(); ++member ) {
+                    const UInt32_T memberTypeId{ type.Instruction[member + 2] };
+                    const SpirvMember memberInfo{ GetMember( structId, member ) };
+
+                    UInt32_T memberSize{ GetTypeSize( memberTypeId ) };
+
+                    // Matrix columns may be padded, i.e, std140 mat3
+                    const SpirvId& memberType{ GetId( memberTypeId ) };
+                    if ( memberType.Opcode == OP_TYPE_MATRIX && memberInfo.MatrixStride != 0 ) {
+                        memberSize = memberInfo.MatrixStride * memberType.Instruction[3];
+                    }
+
+                    const UInt32_T memberOffset{ memberInfo.HasOffset ? memberInfo.Offset : packedOffset };
+
+                    packedOffset = memberOffset + memberSize;
+                    size = std::max( size, packedOffset );
+                }
+
+                return size;
+            }
+
+            // The instruction has at least the words given by GetMinimumWordCount()
+            auto ParseInstruction( const UInt32_T opcode, const std::span<const UInt32_T> instruction ) -> void {
+                switch ( opcode ) {
+                    case OP_DECORATE:
+                        Decorate( GetRecordedId( instruction[1] ), instruction[2], instruction.subspan( 3 ) );
+                        break;
+
+                    case OP_MEMBER_DECORATE:
+                        DecorateMember( instruction[1], instruction[2], instruction[3], instruction.subspan( 4 ) );
+                        break;
+
+                    case OP_TYPE_BOOL:
+                    case OP_TYPE_INT:
+                    case OP_TYPE_FLOAT:
+                    case OP_TYPE_VECTOR:
+                    case OP_TYPE_MATRIX:
+                    case OP_TYPE_IMAGE:
+                    case OP_TYPE_SAMPLER:
+                    case OP_TYPE_SAMPLED_IMAGE:
+                    case OP_TYPE_ARRAY:
+                    case OP_TYPE_RUNTIME_ARRAY:
+                    case OP_TYPE_STRUCT:
+                    case OP_TYPE_POINTER:
+                    case OP_TYPE_ACCELERATION_STRUCTURE: {
+                        // The result id is the first operand of type declarations
+                        SpirvId& id{ GetRecordedId( instruction[1] ) };
+                        id.Opcode = opcode;
+                        id.Instruction = instruction;
+                        break;
+                    }
+
+                    case OP_CONSTANT:
+                    case OP_SPEC_CONSTANT:
+                    case OP_VARIABLE: {
+                        // Preceded by the result type
+                        SpirvId& id{ GetRecordedId( instruction[2] ) };
+                        id.Opcode = opcode;
+                        id.Instruction = instruction;
+
+                        if ( opcode == OP_VARIABLE ) {
+                            m_Variables.emplace_back( instruction[2] );
+                        }
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+
+            MKT_NODISCARD auto GetRecordedId( const UInt32_T id ) -> SpirvId& {
+                if ( id >= m_Ids.size() ) {
+                    MKT_THROW_RUNTIME_ERROR( "VulkanShaderReflection::Reflect - SPIR-V id out of bounds." );
+                }
+
+                return m_Ids[id];
+            }
+
+            MKT_NODISCARD static auto GetDecorationLiteral( const UInt32_T decoration, const std::span<const UInt32_T> literals ) -> UInt32_T {
+                if ( literals.empty() ) {
+                    MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Reflect - SPIR-V decoration {} is missing its literal.", decoration ) );
+                }
+
+                return literals[0];
+            }
+
+            static auto Decorate( SpirvId& id, const UInt32_T decoration, const std::span<const UInt32_T> literals ) -> void {
+                switch ( decoration ) {
+                    case DECORATION_DESCRIPTOR_SET:
+                        id.Set = GetDecorationLiteral( decoration, literals );
+                        break;
+                    case DECORATION_BINDING:
+                        id.Binding = GetDecorationLiteral( decoration, literals );
+                        id.HasBinding = true;
+                        break;
+                    case DECORATION_LOCATION:
+                        id.Location = GetDecorationLiteral( decoration, literals );
+                        id.HasLocation = true;
+                        break;
+                    case DECORATION_ARRAY_STRIDE:
+                        id.ArrayStride = GetDecorationLiteral( decoration, literals );
+                        break;
+                    case DECORATION_BUILT_IN:
+                        id.IsBuiltIn = true;
+                        break;
+                    case DECORATION_BUFFER_BLOCK:
+                        id.IsBufferBlock = true;
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            auto DecorateMember( const UInt32_T structId, const UInt32_T member, const UInt32_T decoration, const std::span<const UInt32_T> literals ) -> void {
+                if ( decoration != DECORATION_OFFSET && decoration != DECORATION_MATRIX_STRIDE ) {
+                    return;
+                }
+
+                SpirvMember& memberInfo{ m_Members[GetMemberKey( structId, member )] };
+
+                if ( decoration == DECORATION_OFFSET ) {
+                    memberInfo.Offset = GetDecorationLiteral( decoration, literals );
+                    memberInfo.HasOffset = true;
+                } else {
+                    memberInfo.MatrixStride = GetDecorationLiteral( decoration, literals );
+                }
+            }
+
+        private:
+            std::vector<SpirvId> m_Ids{};
+            std::vector<UInt32_T> m_Variables{};
+            std::unordered_map<UInt64_T, SpirvMember> m_Members{};
+        };
+
+        auto GetDescriptorType( const SpirvModule& module, const SpirvId& type, const UInt32_T storageClass ) -> VkDescriptorType {
+            switch ( type.Opcode ) {
+                case OP_TYPE_STRUCT:
+                    // Before SPIR-V 1.3 storage buffers are uniform blocks decorated as BufferBlock
+                    return storageClass == STORAGE_CLASS_STORAGE_BUFFER || type.IsBufferBlock
+                        ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                        : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+                case OP_TYPE_SAMPLED_IMAGE: {
+                    const SpirvId& image{ module.GetId( type.Instruction[2] ) };
+                    return image.Instruction[3] == IMAGE_DIM_BUFFER ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                }
+
+                case OP_TYPE_IMAGE: {
+                    const UInt32_T dimension{ type.Instruction[3] };
+                    const bool isStorage{ type.Instruction[7] == IMAGE_SAMPLED_STORAGE };
+
+                    if ( dimension == IMAGE_DIM_SUBPASS_DATA ) {
+                        return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    }
+
+                    if ( dimension == IMAGE_DIM_BUFFER ) {
+                        return isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    }
+
+                    return isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                }
+
+                case OP_TYPE_SAMPLER:
+                    return VK_DESCRIPTOR_TYPE_SAMPLER;
+
+                case OP_TYPE_ACCELERATION_STRUCTURE:
+                    return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+
+                default:
+                    MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Reflect - Resource of type with opcode {} has no descriptor type.", type.Opcode ) );
+            }
+        }
+
+        auto GetVertexInputFormat( const ShaderNumericType numericType, const UInt32_T width, const UInt32_T componentCount ) -> VkFormat {
+            constexpr std::array floatFormats{ VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+            constexpr std::array signedFormats{ VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+            constexpr std::array unsignedFormats{ VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+
+            if ( width != 32 || componentCount == 0 || componentCount > floatFormats.size() ) {
+                return VK_FORMAT_UNDEFINED;
+            }
+
+            switch ( numericType ) {
+                case ShaderNumericType::SIGNED_INT:
+                    return signedFormats[componentCount - 1];
+                case ShaderNumericType::UNSIGNED_INT:
+                    return unsignedFormats[componentCount - 1];
+                default:
+                    return floatFormats[componentCount - 1];
+            }
+        }
+
+        auto GetFormatNumericType( const VkFormat format ) -> ShaderNumericType {
+            switch ( format ) {
+                case VK_FORMAT_R8_SINT:
+                case VK_FORMAT_R8G8_SINT:
+                case VK_FORMAT_R8G8B8_SINT:
+                case VK_FORMAT_R8G8B8A8_SINT:
+                case VK_FORMAT_R16_SINT:
+                case VK_FORMAT_R16G16_SINT:
+                case VK_FORMAT_R16G16B16_SINT:
+                case VK_FORMAT_R16G16B16A16_SINT:
+                case VK_FORMAT_R32_SINT:
+                case VK_FORMAT_R32G32_SINT:
+                case VK_FORMAT_R32G32B32_SINT:
+                case VK_FORMAT_R32G32B32A32_SINT:
+                    return ShaderNumericType::SIGNED_INT;
+
+                case VK_FORMAT_R8_UINT:
+                case VK_FORMAT_R8G8_UINT:
+                case VK_FORMAT_R8G8B8_UINT:
+                case VK_FORMAT_R8G8B8A8_UINT:
+                case VK_FORMAT_R16_UINT:
+                case VK_FORMAT_R16G16_UINT:
+                case VK_FORMAT_R16G16B16_UINT:
+                case VK_FORMAT_R16G16B16A16_UINT:
+                case VK_FORMAT_R32_UINT:
+                case VK_FORMAT_R32G32_UINT:
+                case VK_FORMAT_R32G32B32_UINT:
+                case VK_FORMAT_R32G32B32A32_UINT:
+                    return ShaderNumericType::UNSIGNED_INT;
+
+                // Normalized and scaled formats are read as floats
+                default:
+                    return ShaderNumericType::FLOAT;
+            }
+        }
+
+        auto AddBinding( std::vector<ShaderBindingReflection>& bindings, const ShaderBindingReflection& binding ) -> void {
+            const auto it{ std::ranges::find_if( bindings, [&binding]( const ShaderBindingReflection& other ) -> bool {
+                return other.Set == binding.Set && other.Binding == binding.Binding;
+            } ) };
+
+            if ( it == bindings.end() ) {
+                bindings.emplace_back( binding );
+                return;
+            }
+
+            if ( it->Type != binding.Type || it->Count != binding.Count ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Merge - Stages disagree on the descriptor at set {} binding {}.", binding.Set, binding.Binding ) );
+            }
+
+            it->Stages |= binding.Stages;
+        }
+    }
+
+    auto VulkanShaderReflection::Reflect( const std::span<const UInt32_T> code, const VkShaderStageFlagBits stage ) -> VulkanShaderReflection {
+        const SpirvModule module{ code };
+
+        VulkanShaderReflection result{};
+        result.m_Stages = stage;
+
+        for ( const UInt32_T variableId : module.GetVariables() ) {
+            const SpirvId& variable{ module.GetId( variableId ) };
+            const UInt32_T storageClass{ variable.Instruction[3] };
+
+            // Variables are pointers, the interface is described by the pointee
+            const SpirvId& pointer{ module.GetId( variable.Instruction[1] ) };
+            if ( pointer.Opcode != OP_TYPE_POINTER ) {
+                continue;
+            }
+
+            UInt32_T typeId{ pointer.Instruction[3] };
+
+            switch ( storageClass ) {
+                case STORAGE_CLASS_UNIFORM_CONSTANT:
+                case STORAGE_CLASS_UNIFORM:
+                case STORAGE_CLASS_STORAGE_BUFFER: {
+                    if ( !variable.HasBinding ) {
+                        break;
+                    }
+
+                    // Arrays of resources take one descriptor per element
+                    UInt32_T count{ 1 };
+                    while ( module.GetId( typeId ).Opcode == OP_TYPE_ARRAY || module.GetId( typeId ).Opcode == OP_TYPE_RUNTIME_ARRAY ) {
+                        const SpirvId& array{ module.GetId( typeId ) };
+
+                        count = array.Opcode == OP_TYPE_RUNTIME_ARRAY ? 0 : count * module.GetConstant( array.Instruction[3] );
+                        typeId = array.Instruction[2];
+                    }
+
+                    AddBinding( result.m_Bindings, ShaderBindingReflection{
+                        .Set{ variable.Set },
+                        .Binding{ variable.Binding },
+                        .Type{ GetDescriptorType( module, module.GetId( typeId ), storageClass ) },
+                        .Count{ count },
+                        .Stages{ static_cast<VkShaderStageFlags>( stage ) },
+                    } );
+
+                    break;
+                }
+
+                case STORAGE_CLASS_PUSH_CONSTANT:
+                    result.m_PushConstantSize = std::max( result.m_PushConstantSize, module.GetTypeSize( typeId ) );
+                    result.m_PushConstantStages = stage;
+                    break;
+
+                case STORAGE_CLASS_INPUT: {
+                    if ( stage != VK_SHADER_STAGE_VERTEX_BIT || variable.IsBuiltIn || !variable.HasLocation ) {
+                        break;
+                    }
+
+                    // Arrays and matrices take one location per element and column
+                    UInt32_T locationCount{ 1 };
+                    while ( module.GetId( typeId ).Opcode == OP_TYPE_ARRAY || module.GetId( typeId ).Opcode == OP_TYPE_MATRIX ) {
+                        const SpirvId& aggregate{ module.GetId( typeId ) };
+
+                        locationCount *= aggregate.Opcode == OP_TYPE_ARRAY ? module.GetConstant( aggregate.Instruction[3] ) : aggregate.Instruction[3];
+                        typeId = aggregate.Instruction[2];
+                    }
+
+                    UInt32_T componentCount{ 1 };
+                    if ( module.GetId( typeId ).Opcode == OP_TYPE_VECTOR ) {
+                        componentCount = module.GetId( typeId ).Instruction[3];
+                        typeId = module.GetId( typeId ).Instruction[2];
+                    }
+
+                    const SpirvId& scalar{ module.GetId( typeId ) };
+                    if ( scalar.Opcode != OP_TYPE_INT && scalar.Opcode != OP_TYPE_FLOAT ) {
+                        MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::Reflect - Vertex input at location {} has an unsupported type.", variable.Location ) );
+                    }
+
+                    ShaderNumericType numericType{ ShaderNumericType::FLOAT };
+                    if ( scalar.Opcode == OP_TYPE_INT ) {
+                        numericType = scalar.Instruction[3] != 0 ? ShaderNumericType::SIGNED_INT : ShaderNumericType::UNSIGNED_INT;
+                    }
+
+                    for ( UInt32_T location{}; location < locationCount; ++location ) {
+                        result.m_VertexInputs.emplace_back( ShaderVertexInputReflection{
+                            .Location{ variable.Location + location },
+                            .NumericType{ numericType },
+                            .ComponentCount{ componentCount },
+                            .Format{ GetVertexInputFormat( numericType, scalar.Instruction[2], componentCount ) },
+                        } );
+                    }
+
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        std::ranges::sort( result.m_Bindings, []( const ShaderBindingReflection& lhs, const ShaderBindingReflection& rhs ) -> bool {
+            return lhs.Set != rhs.Set ? lhs.Set < rhs.Set : lhs.Binding < rhs.Binding;
+        } );
+
+        std::ranges::sort( result.m_VertexInputs, {}, &ShaderVertexInputReflection::Location );
+
+        return result;
+    }
+
+    auto VulkanShaderReflection::Merge( const VulkanShaderReflection& other ) -> void {
+        m_Stages |= other.m_Stages;
+
+        for ( const ShaderBindingReflection& binding : other.m_Bindings ) {
+            AddBinding( m_Bindings, binding );
+        }
+
+        std::ranges::sort( m_Bindings, []( const ShaderBindingReflection& lhs, const ShaderBindingReflection& rhs ) -> bool {
+            return lhs.Set != rhs.Set ? lhs.Set < rhs.Set : lhs.Binding < rhs.Binding;
+        } );
+
+        // A single range visible to every stage that reads it covers all of them
+        if ( other.m_PushConstantSize != 0 ) {
+            m_PushConstantSize = std::max( m_PushConstantSize, other.m_PushConstantSize );
+            m_PushConstantStages |= other.m_PushConstantStages;
+        }
+
+        // Only the vertex stage has inputs
+        if ( m_VertexInputs.empty() ) {
+            m_VertexInputs = other.m_VertexInputs;
+        }
+    }
+
+    auto VulkanShaderReflection::MatchVertexAttributes( const std::span<const VkVertexInputAttributeDescription> attributes ) const -> std::vector<VkVertexInputAttributeDescription> {
+        std::vector<VkVertexInputAttributeDescription> result{};
+        result.reserve( m_VertexInputs.size() );
+
+        for ( const ShaderVertexInputReflection& input : m_VertexInputs ) {
+            const auto it{ std::ranges::find( attributes, input.Location, &VkVertexInputAttributeDescription::location ) };
+
+            if ( it == attributes.end() ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::MatchVertexAttributes - No vertex attribute for the input at location {}.", input.Location ) );
+            }
+
+            if ( GetFormatNumericType( it->format ) != input.NumericType ) {
+                MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanShaderReflection::MatchVertexAttributes - Vertex attribute at location {} does not match the type of the input.", input.Location ) );
+            }
+
+            result.emplace_back( *it );
+        }
+
+        return result;
+    }
+
+    auto VulkanShaderReflection::GetSetCount() const -> UInt32_T {
+        return m_Bindings.empty() ? 0 : m_Bindings.back().Set + 1;
+    }
+}
@@ -4,6 +4,7 @@
  * */
 
 // C++ Standard Library
+#include <algorithm>
 #include <array>
 #include <memory>
 
@@ -33,7 +34,7 @@ namespace Mikoto {
         m_UniformDataStructureSize = paddedSize;
 
         // UniformBuffer size padded. Fragment shader
-        const VkDeviceSize fragmentPaddedSize{ VulkanHelpers::GetUniformBufferPadding(sizeof(LightsUniformData), minOffsetAlignment) };
+        const VkDeviceSize fragmentPaddedSize{ VulkanHelpers::GetUniformBufferPadding(sizeof(FragmentUniformBufferData), minOffsetAlignment) };
         m_FragmentUniformDataStructureSize = fragmentPaddedSize;
 
         CreateUniformBuffers();
@@ -77,30 +78,23 @@ namespace Mikoto {
     }
 
     auto VulkanStandardMaterial::BindDescriptorSet( const VkCommandBuffer& commandBuffer, const VkPipelineLayout& pipelineLayout ) -> void {
-        // if needed update before use
-        if (m_WantDescriptorUpdate) {
-            UpdateDescriptorSets();
-            m_WantDescriptorUpdate = false;
-        }
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
 
         // It is here that we specify which desc set we bind to, always 0 for now
         constexpr Size_T firstSet{ 0 };
-        vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, firstSet, 1, &m_DescriptorSet, 0, nullptr );
+        vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, firstSet, 1, std::addressof( m_DescriptorSets[frameIndex] ), 0, nullptr );
     }
 
     auto VulkanStandardMaterial::CreateUniformBuffers() -> void {
-        // NOTE: maxUniformBufferRange is the maximum value that can be specified in
-        // the range member of a VkDescriptorBufferInfo structure passed to vkUpdateDescriptorSets
-        // for descriptors of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER or VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC.
-        // If we want to keep adding more lights we can't just increase the max lights. Most of devices support 65536 at best:
-        // https://vulkan.gpuinfo.org/displaydevicelimit.php?name=maxUniformBufferRange
+        // Each buffer holds one slice per frame in flight
+        const UInt32_T framesInFlight{ VulkanContext::Get().GetFramesInFlight() };
 
         // [Vertex shader uniform buffer]
         VulkanBufferCreateInfo vertexAllocInfo{};
 
         vertexAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         vertexAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-        vertexAllocInfo.BufferCreateInfo.size = m_UniformDataStructureSize;
+        vertexAllocInfo.BufferCreateInfo.size = m_UniformDataStructureSize * framesInFlight;
 
         vertexAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
         vertexAllocInfo.WantMapping = true;
@@ -112,7 +106,7 @@ namespace Mikoto {
 
         fragmentAllocInfo.BufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         fragmentAllocInfo.BufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-        fragmentAllocInfo.BufferCreateInfo.size = m_FragmentUniformDataStructureSize;
+        fragmentAllocInfo.BufferCreateInfo.size = m_FragmentUniformDataStructureSize * framesInFlight;
 
         fragmentAllocInfo.AllocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
         fragmentAllocInfo.WantMapping = true;
@@ -124,20 +118,24 @@ namespace Mikoto {
         // upload the color
         m_VertexUniformData.Color = m_Color;
 
-        m_FragmentUniformLightsData.LightMeta.x = static_cast<float>( m_LightsCount );
-        m_FragmentUniformLightsData.LightMeta.y = HasDiffuseMap() ? 1 : 0;
-        m_FragmentUniformLightsData.LightMeta.z = HasSpecularMap() ? 1 : 0;
-        m_FragmentUniformLightsData.LightMeta.w = m_Shininess;
+        m_FragmentUniformData.LightMeta.y = HasDiffuseMap() ? 1 : 0;
+        m_FragmentUniformData.LightMeta.z = HasSpecularMap() ? 1 : 0;
+        m_FragmentUniformData.LightMeta.w = m_Shininess;
 
-        std::memcpy( m_VertexUniformBuffer->GetMappedPtr(), std::addressof( m_VertexUniformData ), sizeof( m_VertexUniformData ) );
-        std::memcpy( m_FragmentUniformBuffer->GetMappedPtr(), std::addressof( m_FragmentUniformLightsData ), sizeof( m_FragmentUniformLightsData ) );
-    }
+        // Write into the slice owned by the current frame, other slices may still be read by the GPU
+        const UInt32_T frameIndex{ VulkanContext::Get().GetCurrentFrameIndex() };
+
+        // The set of this frame is no longer in flight either. Updated here, on the main thread, because
+        // draws using the material may be recorded by several workers at once, see VulkanRenderer::RecordSecondaryCommands()
+        if ( m_WantDescriptorUpdate[frameIndex] ) {
+            UpdateDescriptorSet( frameIndex );
+            m_WantDescriptorUpdate[frameIndex] = false;
+        }
 
-    auto VulkanStandardMaterial::ResetLights() -> void {
-        m_LightsCount = 0;
-        m_DirLightIndex = 0;
-        m_PointLightIndex = 0;
-        m_SpotLightIndex = 0;
+        std::memcpy( static_cast<std::byte*>( m_VertexUniformBuffer->GetMappedPtr() ) + frameIndex * m_UniformDataStructureSize,
+            std::addressof( m_VertexUniformData ), sizeof( m_VertexUniformData ) );
+        std::memcpy( static_cast<std::byte*>( m_FragmentUniformBuffer->GetMappedPtr() ) + frameIndex * m_FragmentUniformDataStructureSize,
+            std::addressof( m_FragmentUniformData ), sizeof( m_FragmentUniformData ) );
     }
 
     auto VulkanStandardMaterial::CreateDescriptorSet() -> void {
@@ -146,7 +144,14 @@ namespace Mikoto {
         const VulkanDevice& device{ VulkanContext::Get().GetDevice() };
         VulkanDescriptorAllocator& descriptorAllocator{ VulkanContext::Get().GetDescriptorAllocator() };
 
-        m_DescriptorSet = *descriptorAllocator.Allocate( device.GetLogicalDevice(), descriptorSetLayout );
+        const UInt32_T framesInFlight{ VulkanContext::Get().GetFramesInFlight() };
+
+        m_DescriptorSets.clear();
+        for ( UInt32_T frameIndex{}; frameIndex < framesInFlight; ++frameIndex ) {
+            m_DescriptorSets.emplace_back( *descriptorAllocator.Allocate( device.GetLogicalDevice(), descriptorSetLayout ) );
+        }
+
+        m_WantDescriptorUpdate.assign( framesInFlight, false );
     }
 
     auto VulkanStandardMaterial::SetTexture( Texture* map, const MapType type ) -> void {
@@ -165,8 +170,8 @@ namespace Mikoto {
                     break;
             }
 
-            // Deffer descriptor set update until we bound them again
-            m_WantDescriptorUpdate = true;
+            // Deffer descriptor set update until their frames upload the uniforms again
+            std::ranges::fill( m_WantDescriptorUpdate, true );
         }
     }
 
@@ -201,45 +206,31 @@ namespace Mikoto {
                 break;
         }
 
-        // Deffer descriptor set update until we bound them again
-        m_WantDescriptorUpdate = true;
+        // Deffer descriptor set update until their frames upload the uniforms again
+        std::ranges::fill( m_WantDescriptorUpdate, true );
 
     }
 
     auto VulkanStandardMaterial::UpdateDescriptorSets() -> void {
+        for ( UInt32_T frameIndex{}; frameIndex < m_DescriptorSets.size(); ++frameIndex ) {
+            UpdateDescriptorSet( frameIndex );
+        }
 
+        std::ranges::fill( m_WantDescriptorUpdate, false );
+    }
+
+    auto VulkanStandardMaterial::UpdateDescriptorSet( const UInt32_T frameIndex ) -> void {
         const VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
         VulkanTexture2D* diffuse{ dynamic_cast<VulkanTexture2D *>( m_DiffuseTexture ) };
         VulkanTexture2D* specular{ dynamic_cast<VulkanTexture2D *>( m_SpecularTexture ) };
 
+        m_DescriptorWriter.Clear();
         m_DescriptorWriter
             .WriteImage( 1, diffuse->GetImage().GetView(), diffuse->GetSampler(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER )
             .WriteImage( 2, specular->GetImage().GetView(), specular->GetSampler(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER )
-            .WriteBuffer( 0, m_VertexUniformBuffer->Get(), m_VertexUniformBuffer->GetSize(), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
-            .WriteBuffer( 3, m_FragmentUniformBuffer->Get(), m_FragmentUniformBuffer->GetSize(), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
-        .UpdateSet( device.GetLogicalDevice(), m_DescriptorSet );
-    }
-
-    auto VulkanStandardMaterial::UpdateLightsInfo(const LightData& lightData, const LightType type) -> void {
-        m_LightsCount += 1;
-
-        switch ( type ) {
-            case LightType::DIRECTIONAL_LIGHT_TYPE:
-                m_FragmentUniformLightsData.DirectionalLights[m_DirLightIndex++] = lightData.DireLightData;
-            break;
-
-            case LightType::POINT_LIGHT_TYPE:
-                m_FragmentUniformLightsData.PointLights[m_PointLightIndex++] = lightData.PointLightDat;
-            break;
-
-            case LightType::SPOT_LIGHT_TYPE:
-                m_FragmentUniformLightsData.SpotLights[m_SpotLightIndex++] = lightData.SpotLightData;
-            break;
-        }
-
-        m_FragmentUniformLightsData.LightTypesCount.x = static_cast<float>(m_DirLightIndex);
-        m_FragmentUniformLightsData.LightTypesCount.y = static_cast<float>(m_PointLightIndex);
-        m_FragmentUniformLightsData.LightTypesCount.z = static_cast<float>(m_SpotLightIndex);
+            .WriteBuffer( 0, m_VertexUniformBuffer->Get(), m_UniformDataStructureSize, frameIndex * m_UniformDataStructureSize, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+            .WriteBuffer( 3, m_FragmentUniformBuffer->Get(), m_FragmentUniformDataStructureSize, frameIndex * m_FragmentUniformDataStructureSize, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+        .UpdateSet( device.GetLogicalDevice(), m_DescriptorSets[frameIndex] );
     }
 }
@@ -18,6 +18,7 @@
 #include <Library/Utility/Types.hh>
 #include <Renderer/Vulkan/VulkanHelpers.hh>
 #include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanDeletionQueue.hh>
 #include <Renderer/Vulkan/VulkanSwapChain.hh>
 
 namespace Mikoto {
@@ -90,7 +91,7 @@ namespace Mikoto {
         // swap chain image ready for render and then be presented
         createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
-        const auto& [Present, Graphics, Compute] {
+        const auto& [Present, Graphics, Compute, Transfer] {
             device.GetLogicalDeviceQueues()
         };
 
@@ -162,13 +163,11 @@ namespace Mikoto {
         }
     }
 
-    auto VulkanSwapChain::GetNextRenderableImage( UInt32_T &imageIndex, const VkFence fence, const VkSemaphore imageAvailable ) const -> VkResult {
+    auto VulkanSwapChain::GetNextRenderableImage( UInt32_T &imageIndex, const VkSemaphore imageAvailable ) const -> VkResult {
         static VulkanDevice& device{ VulkanContext::Get().GetDevice() };
 
+        // Frame pacing is done by the context on the graphics timeline before acquiring
         // For simplicity, parenthesize std::numeric_limits<std::uint64_t>::max because windows has a macro literally called max that causes conflicts
-        vkWaitForFences( device.GetLogicalDevice(), 1, std::addressof( fence ), VK_TRUE, ( std::numeric_limits<std::uint64_t>::max )() );
-        vkResetFences( device.GetLogicalDevice(), 1, std::addressof( fence ) );
-
         return vkAcquireNextImageKHR( device.GetLogicalDevice(), m_Swapchain, ( std::numeric_limits<UInt64_T>::max )(), imageAvailable, VK_NULL_HANDLE, std::addressof( imageIndex ) );
     }
 
@@ -191,10 +190,10 @@ namespace Mikoto {
 
         // Only the GUI is directly rendering to the swapchain images at the moment.
         // Generally, the renderer is drawing to a texture which can then be copied to a
-        // swap chain image ready for render and then be presented
-        m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        // swap chain image ready for render and then be presented.
+        // Frame pacing (frames in flight) is handled by the VulkanContext.
 
-        const auto& [Present, Graphics, Compute]{ device.GetLogicalDeviceQueues() };
+        const auto& [Present, Graphics, Compute, Transfer]{ device.GetLogicalDeviceQueues() };
         VkQueue presentQueue{ VK_NULL_HANDLE };
 
         if (Present.has_value() && Present->Queue != VK_NULL_HANDLE) {
@@ -206,6 +205,8 @@ namespace Mikoto {
             MKT_CORE_LOGGER_ERROR( "VulkanSwapChain::Present - No presentation queue available." );
         }
 
+        const auto queueLock{ device.LockQueues() };
+
         return vkQueuePresentKHR(presentQueue, std::addressof( presentInfo ) );
     }
 
@@ -276,6 +277,9 @@ namespace Mikoto {
 
         m_Images.clear();
 
+        // The views of the images must go before the swapchain, nothing is in flight after the wait
+        VulkanDeletionQueue::CollectAll();
+
         // Destroy handles
         // The device is owned by the context and is destroyed before the instance and after any object is
         // created from it has finished being used
@@ -6,7 +6,9 @@
 // C++ Standard Library
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
 // Third-Party Libraries
 #include <volk.h>
@@ -17,6 +19,7 @@
 #include <Common/Common.hh>
 #include <Core/System/FileSystem.hh>
 #include <Library/Utility/Types.hh>
+#include <Material/Texture/TextureCooker.hh>
 #include <Renderer/Vulkan/VulkanContext.hh>
 #include <Renderer/Vulkan/VulkanDeletionQueue.hh>
 #include <Renderer/Vulkan/VulkanHelpers.hh>
@@ -25,19 +28,77 @@
 
 namespace Mikoto {
 
+    static auto SupportsLinearBlits( const VkFormat format ) -> bool {
+        VulkanDevice& device{ VulkanContext::Get().GetDevice() };
+
+        VkFormatProperties formatProperties{};
+        vkGetPhysicalDeviceFormatProperties( device.GetPhysicalDevice(), format, std::addressof( formatProperties ) );
+
+        constexpr VkFormatFeatureFlags requiredFeatures{ VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT };
+
+        return ( formatProperties.optimalTilingFeatures & requiredFeatures ) == requiredFeatures;
+    }
+
+    // Mips of uncooked textures are blitted on the GPU when possible, built on the CPU otherwise
+    static auto CanBlitMips() -> bool {
+        return VulkanContext::Get().GetUploadManager().SupportsBlits() && SupportsLinearBlits( VK_FORMAT_R8G8B8A8_SRGB );
+    }
+
     VulkanTexture2D::VulkanTexture2D( const VulkanTexture2DCreateInfo& data )
         : Texture2D{ data.Type }
     {
         try {
-            LoadImageData( data.Path );
-            CreateImage();
+            Scope_T<Texture2DData> decodedData{};
+            Texture2DData* textureData{ data.Data };
+
+            if ( textureData == nullptr ) {
+                decodedData = Decode( data.Path, data.RetainFileData );
+                textureData = decodedData.get();
+            }
+
+            m_File = Engine::GetSystem<FileSystem>().LoadFile( textureData->FilePath );
+
+            if ( m_File == nullptr ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanTexture2D::VulkanTexture2D - Failed to load texture file." );
+            }
+
+            m_Width = textureData->Width;
+            m_Height = textureData->Height;
+            m_Channels = textureData->Channels;
+
+            if ( textureData->Cooked.has_value() ) {
+                const CookedTexture& cookedTexture{ *textureData->Cooked };
+
+                m_BufferSize = cookedTexture.Levels.Data.size();
+
+                CreateImage( cookedTexture.Format, static_cast<UInt32_T>( cookedTexture.Levels.LevelOffsets.size() ) );
+                UploadCookedData( cookedTexture );
+            } else {
+                // since we use STBI_rgb_alpha, stb will load the image with four
+                // channels which matches the format we are going to be using for now
+                constexpr auto channelCount{ 4 };
+
+                m_FileData = std::exchange( textureData->Texels, nullptr );
+                m_BufferSize = m_Width * m_Height * channelCount;
+
+                CreateImage( VK_FORMAT_R8G8B8A8_SRGB, TextureCooker::GetMipLevelCount( static_cast<UInt32_T>( m_Width ), static_cast<UInt32_T>( m_Height ) ) );
+                UploadImageData( textureData->Levels );
+            }
+
             CreateSampler();
 
-            if ( !data.RetainFileData ) {
+            // Shaders reference the texture by its index in the bindless array
+            m_BindlessIndex = VulkanContext::Get().GetBindlessManager().RegisterTexture( m_Image->GetView(), m_Sampler );
+
+            if ( !data.RetainFileData && m_FileData != nullptr ) {
                 stbi_image_free( m_FileData );
                 m_FileData = nullptr;
             }
         } catch (const std::exception& exception) {
+            if ( m_FileData != nullptr ) {
+                stbi_image_free( m_FileData );
+            }
+
             m_FileData = nullptr;
             m_BufferSize = 0;
             m_Image = nullptr;
@@ -65,6 +126,9 @@ namespace Mikoto {
         m_BufferSize = 0;
         m_FileData = nullptr;
 
+        VulkanContext::Get().GetBindlessManager().ReleaseTexture( m_BindlessIndex );
+        m_BindlessIndex = VulkanBindlessManager::INVALID_INDEX;
+
         vkDestroySampler( device.GetLogicalDevice(), m_Sampler, nullptr );
 
         m_File = nullptr;
@@ -79,112 +143,113 @@ namespace Mikoto {
         }
     }
 
-    auto VulkanTexture2D::LoadImageData( const Path_T& path ) -> void {
-        FileSystem& fileSystem{ Engine::GetSystem<FileSystem>() };
+    auto VulkanTexture2D::Decode( const Path_T& path, const bool retainFileData ) -> Scope_T<Texture2DData> {
+        auto result{ CreateScope<Texture2DData>() };
+
+        // Cooked textures have no RGBA8 texels to hand out
+        if ( !retainFileData && VulkanContext::Get().GetDevice().GetPhysicalDeviceFeatures().textureCompressionBC == VK_TRUE ) {
+            result->Cooked = TextureCooker::LoadCooked( path );
+        }
+
+        if ( result->Cooked.has_value() ) {
+            result->FilePath = TextureCooker::GetCookedPath( path );
+            result->Width = static_cast<Int32_T>( result->Cooked->Width );
+            result->Height = static_cast<Int32_T>( result->Cooked->Height );
+
+            switch ( result->Cooked->Format ) {
+                case VK_FORMAT_BC4_UNORM_BLOCK:
+                    result->Channels = 1;
+                    break;
+                case VK_FORMAT_BC5_UNORM_BLOCK:
+                    result->Channels = 2;
+                    break;
+                default:
+                    result->Channels = 4;
+                    break;
+            }
 
-        const File* textureFile{ nullptr };
+            return result;
+        }
 
-        if (path.extension() == ".tif") {
+        result->FilePath = path;
 
+        if ( path.extension() == ".tif" ) {
             // traverse possible alternative extensions
-            for (const auto& extension : { ".png", ".jpg", ".jpeg" }) {
+            for ( const auto& extension : { ".png", ".jpg", ".jpeg" } ) {
                 // Look for the PNG version instead
-                Path_T pngVersion{ path };
-                pngVersion.replace_extension( extension );
-                textureFile = fileSystem.LoadFile( pngVersion );
+                Path_T alternative{ path };
+                alternative.replace_extension( extension );
 
-                if (textureFile != nullptr) {
+                if ( std::filesystem::exists( alternative ) ) {
+                    result->FilePath = alternative;
                     break;
                 }
             }
-        } else {
-            textureFile = fileSystem.LoadFile( path );
-        }
-
-        if (textureFile == nullptr) {
-            MKT_THROW_RUNTIME_ERROR( "VulkanTexture2D::LoadImageData - Failed to load texture file." );
         }
 
-        m_File = textureFile;
-
+        // Same value on every thread, it is global state in stb
         stbi_set_flip_vertically_on_load( true );
 
-        m_FileData = stbi_load(
-            m_File->GetPathCStr(),
-            std::addressof( m_Width ),
-            std::addressof( m_Height ),
-            std::addressof( m_Channels ),
+        result->Texels = stbi_load(
+            result->FilePath.string().c_str(),
+            std::addressof( result->Width ),
+            std::addressof( result->Height ),
+            std::addressof( result->Channels ),
             STBI_rgb_alpha );
 
-        if ( !m_FileData ) {
-            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanTexture2D - Failed to load texture image! File: [{}]", m_File->GetPathCStr() ) );
+        if ( result->Texels == nullptr ) {
+            MKT_THROW_RUNTIME_ERROR( fmt::format( "VulkanTexture2D - Failed to load texture image! File: [{}]", result->FilePath.string() ) );
         }
 
-        // since we use STBI_rgb_alpha, stb will load the image with four
-        // channels which matches the format we are going to be using for now
-        constexpr auto channelCount{ 4 };
-        m_BufferSize = m_Width * m_Height * channelCount;
-    }
-
-    auto VulkanTexture2D::CreateImage() -> void {
-        VulkanDevice& device{ VulkanContext::Get().GetDevice() };
-
-        // allocate staging buffer
-        VkBufferCreateInfo stagingBufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
-        stagingBufferInfo.pNext = nullptr;
-
-        stagingBufferInfo.size = m_BufferSize;
-        stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-        //let the VMA library know that this data should be on CPU RAM
-        VmaAllocationCreateInfo vmaStagingAllocationCreateInfo{};
-        vmaStagingAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-        vmaStagingAllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        if ( !CanBlitMips() ) {
+            const UInt32_T width{ static_cast<UInt32_T>( result->Width ) };
+            const UInt32_T height{ static_cast<UInt32_T>( result->Height ) };
 
-        const VulkanBufferCreateInfo stagingBufferBufferCreateInfo{
-            .BufferCreateInfo{ stagingBufferInfo },
-            .AllocationCreateInfo{ vmaStagingAllocationCreateInfo },
-            .WantMapping{ true }
-        };
-
-         m_StagingBuffer = VulkanBuffer::Create( stagingBufferBufferCreateInfo );
+            result->Levels = TextureCooker::BuildMipChain( result->Texels, width, height, TextureCooker::GetMipLevelCount( width, height ), true );
+        }
 
-        // Copy vertex data to staging buffer
-        std::memcpy(m_StagingBuffer->GetVmaAllocationInfo().pMappedData, m_FileData, m_BufferSize);
+        return result;
+    }
 
-        m_StagingBuffer->PersistentUnmap();
+    auto VulkanTexture2D::CreateImage( const VkFormat format, const UInt32_T mipLevels ) -> void {
+        VulkanUploadManager& uploadManager{ VulkanContext::Get().GetUploadManager() };
 
         // Allocate image
         const VkExtent3D extent{ static_cast<UInt32_T>( m_Width ), static_cast<UInt32_T>( m_Height ), 1 };
 
         VkImageCreateInfo vkImageCreateInfo{ VulkanHelpers::Initializers::ImageCreateInfo() };
 
-        // VK_FORMAT_R8G8B8A8_SRGB matches the image format loaded with stb
-        vkImageCreateInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
+        vkImageCreateInfo.format = format;
         vkImageCreateInfo.extent = extent;
         vkImageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-        vkImageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
-        vkImageCreateInfo.mipLevels = 1;
+        // The mips of uncooked textures may be blitted from the first one
+        vkImageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+        // Full chain down to 1x1, minification without it aliases and thrashes the texture cache
+        vkImageCreateInfo.mipLevels = mipLevels;
         vkImageCreateInfo.arrayLayers = 1;
         vkImageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         vkImageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         vkImageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
         // The image will only be used by one queue family: the one that supports graphics (and therefore also) transfer operations.
+        // Unless the uploads go through a dedicated transfer queue, then both families share it.
         vkImageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         vkImageCreateInfo.flags = 0;
 
+        uploadManager.ConfigureSharingMode( vkImageCreateInfo );
+
         VkImageViewCreateInfo imageViewCreateInfo{ VulkanHelpers::Initializers::ImageViewCreateInfo() };
 
         imageViewCreateInfo.pNext = nullptr;
         imageViewCreateInfo.flags = 0;
         imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        imageViewCreateInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
+        imageViewCreateInfo.format = format;
 
         imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-        imageViewCreateInfo.subresourceRange.levelCount = 1;
+        imageViewCreateInfo.subresourceRange.levelCount = mipLevels;
         imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
         imageViewCreateInfo.subresourceRange.layerCount = 1;
 
@@ -195,30 +260,30 @@ namespace Mikoto {
         };
 
         m_Image = VulkanImage::Create( vulkanImageCreateInfo );
+    }
+
+    auto VulkanTexture2D::UploadImageData( const MipChain& levels ) -> void {
+        VulkanUploadManager& uploadManager{ VulkanContext::Get().GetUploadManager() };
+
+        const VkImageCreateInfo& imageCreateInfo{ m_Image->GetCreateInfo() };
+
+        // Staged in the upload manager ring and copied with the rest of the batch, nothing waits on it here
+        if ( !levels.Data.empty() ) {
+            uploadManager.UploadImage( *m_Image, levels.Data.data(), levels.Data.size(), imageCreateInfo.extent, levels.LevelOffsets );
+        } else if ( CanBlitMips() ) {
+            uploadManager.UploadImageAndGenerateMips( *m_Image, m_FileData, m_BufferSize, imageCreateInfo.extent, imageCreateInfo.mipLevels );
+        } else {
+            const MipChain mipChain{ TextureCooker::BuildMipChain( m_FileData, imageCreateInfo.extent.width, imageCreateInfo.extent.height, imageCreateInfo.mipLevels, true ) };
+            uploadManager.UploadImage( *m_Image, mipChain.Data.data(), mipChain.Data.size(), imageCreateInfo.extent, mipChain.LevelOffsets );
+        }
+    }
+
+    auto VulkanTexture2D::UploadCookedData( const CookedTexture& cookedTexture ) -> void {
+        VulkanUploadManager& uploadManager{ VulkanContext::Get().GetUploadManager() };
+
+        const VkImageCreateInfo& imageCreateInfo{ m_Image->GetCreateInfo() };
 
-        VulkanContext::Get().ImmediateSubmit( [&, extent]( const VkCommandBuffer& cmd ) -> void {
-            m_Image->LayoutTransition( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd );
-
-            // Copy from staging buffer to image buffer
-            VkBufferImageCopy copyRegion{};
-            copyRegion.bufferOffset = 0;
-            copyRegion.bufferRowLength = 0;
-            copyRegion.bufferImageHeight = 0;
-
-            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            copyRegion.imageSubresource.mipLevel = 0;
-            copyRegion.imageSubresource.baseArrayLayer = 0;
-            copyRegion.imageSubresource.layerCount = 1;
-            copyRegion.imageExtent = extent;
-
-            //copy the buffer into the image
-            vkCmdCopyBufferToImage( cmd, m_StagingBuffer->Get(), m_Image->Get(), m_Image->GetCurrentLayout(), 1, std::addressof( copyRegion ) );
-        } );
-
-        VulkanContext::Get().ImmediateSubmit( [&]( VkCommandBuffer cmd ) -> void {
-            // Perform second transition for the descriptor set creation
-            m_Image->LayoutTransition(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cmd);
-        } );
+        uploadManager.UploadImage( *m_Image, cookedTexture.Levels.Data.data(), cookedTexture.Levels.Data.size(), imageCreateInfo.extent, cookedTexture.Levels.LevelOffsets );
     }
 
     auto VulkanTexture2D::CreateSampler() -> void {
@@ -247,7 +312,7 @@ namespace Mikoto {
         samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
         samplerInfo.mipLodBias = 0.0f;
         samplerInfo.minLod = 0.0f;
-        samplerInfo.maxLod = 0.0f;
+        samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 
         if ( vkCreateSampler( device.GetLogicalDevice(), &samplerInfo, nullptr, &m_Sampler ) != VK_SUCCESS ) {
             MKT_THROW_RUNTIME_ERROR( "Failed to create texture sampler!" );
@@ -0,0 +1,64 @@
+/**
+ * VulkanTimeline.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <limits>
+#include <memory>
+
+// Third-Party Libraries
+#include <volk.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
+#include <Renderer/Vulkan/VulkanTimeline.hh>
+
+namespace Mikoto {
+
+    auto VulkanTimeline::Init( const VkDevice device ) -> void {
+        m_Device = device;
+        m_SubmittedValue = 0;
+
+        VkSemaphoreTypeCreateInfo semaphoreTypeInfo{};
+        semaphoreTypeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        semaphoreTypeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        semaphoreTypeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo{ VulkanHelpers::Initializers::SemaphoreCreateInfo() };
+        semaphoreCreateInfo.pNext = std::addressof( semaphoreTypeInfo );
+
+        if ( vkCreateSemaphore( m_Device, std::addressof( semaphoreCreateInfo ), nullptr, std::addressof( m_Semaphore ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanTimeline::Init - Failed to create the timeline semaphore." );
+        }
+    }
+
+    auto VulkanTimeline::Shutdown() -> void {
+        vkDestroySemaphore( m_Device, m_Semaphore, nullptr );
+        m_Semaphore = VK_NULL_HANDLE;
+    }
+
+    auto VulkanTimeline::GetCompletedValue() const -> UInt64_T {
+        UInt64_T value{};
+
+        if ( vkGetSemaphoreCounterValue( m_Device, m_Semaphore, std::addressof( value ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanTimeline::GetCompletedValue - Failed to query the timeline semaphore." );
+        }
+
+        return value;
+    }
+
+    auto VulkanTimeline::Wait( const UInt64_T value ) const -> void {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = std::addressof( m_Semaphore );
+        waitInfo.pValues = std::addressof( value );
+
+        // For simplicity, parenthesize std::numeric_limits<std::uint64_t>::max because windows has a macro literally called max that causes conflicts
+        if ( vkWaitSemaphores( m_Device, std::addressof( waitInfo ), ( std::numeric_limits<UInt64_T>::max )() ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanTimeline::Wait - Failed to wait on the timeline semaphore." );
+        }
+    }
+}
@@ -0,0 +1,465 @@
+/**
+ * VulkanUploadManager.cc
+ * Created by kate on 10/18/2026.
+ * */
+
+// C++ Standard Library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Third-Party Libraries
+#include <volk.h>
+#include <vk_mem_alloc.h>
+
+// Project Headers
+#include <Common/Common.hh>
+#include <Renderer/Vulkan/VulkanContext.hh>
+#include <Renderer/Vulkan/VulkanHelpers.hh>
+#include <Renderer/Vulkan/VulkanUploadManager.hh>
+
+namespace Mikoto {
+
+    auto VulkanUploadManager::Init( const VulkanUploadManagerCreateInfo& createInfo ) -> void {
+        VulkanDevice& device{ VulkanContext::Get().GetDevice() };
+        const QueuesData& queues{ device.GetLogicalDeviceQueues() };
+
+        m_Device = device.GetLogicalDevice();
+
+        // Copies on a transfer only family run on the copy engines, in parallel with the frame
+        m_UsesDedicatedQueue = queues.Transfer.has_value() && queues.Transfer->FamilyIndex != queues.Graphics->FamilyIndex;
+
+        if ( m_UsesDedicatedQueue ) {
+            m_Queue = queues.Transfer->Queue;
+            m_QueueFamilyIndex = queues.Transfer->FamilyIndex;
+        } else {
+            m_Queue = queues.Graphics->Queue;
+            m_QueueFamilyIndex = queues.Graphics->FamilyIndex;
+        }
+
+        m_SharingQueueFamilies = { queues.Graphics->FamilyIndex, m_QueueFamilyIndex };
+
+        m_Timeline = createInfo.Timeline;
+
+        CreateStagingRing( createInfo.StagingCapacity );
+    }
+
+    auto VulkanUploadManager::Shutdown() -> void {
+        std::scoped_lock lock{ m_Mutex };
+
+        SubmitCurrentBatch();
+
+        while ( !m_InFlightBatches.empty() ) {
+            WaitForOldestBatch();
+        }
+
+        m_FreeBatches.clear();
+        m_StagingRing = nullptr;
+    }
+
+    auto VulkanUploadManager::CreateStagingRing( const VkDeviceSize capacity ) -> void {
+        VkBufferCreateInfo stagingBufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
+        stagingBufferInfo.pNext = nullptr;
+        stagingBufferInfo.size = capacity;
+        stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+        // Host visible and mapped for the whole lifetime of the manager
+        VmaAllocationCreateInfo vmaStagingAllocationCreateInfo{};
+        vmaStagingAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        vmaStagingAllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        const VulkanBufferCreateInfo stagingBufferCreateInfo{
+            .BufferCreateInfo{ stagingBufferInfo },
+            .AllocationCreateInfo{ vmaStagingAllocationCreateInfo },
+            .WantMapping{ true }
+        };
+
+        m_StagingRing = VulkanBuffer::Create( stagingBufferCreateInfo );
+
+        m_StagingHead = 0;
+        m_StagingTail = 0;
+        m_StagingUsed = 0;
+    }
+
+    auto VulkanUploadManager::UploadBuffer( const VkBuffer destination, const VkDeviceSize destinationOffset, const void* data, const VkDeviceSize size ) -> void {
+        if ( size == 0 ) {
+            return;
+        }
+
+        std::scoped_lock lock{ m_Mutex };
+
+        const StagingAllocation staging{ WriteStaging( data, size ) };
+
+        const VkBufferCopy copy{
+            .srcOffset{ staging.Offset },
+            .dstOffset{ destinationOffset },
+            .size{ size },
+        };
+
+        vkCmdCopyBuffer( GetCurrentBatch().CommandBuffer, staging.Buffer, destination, 1, std::addressof( copy ) );
+    }
+
+    auto VulkanUploadManager::UploadImage( VulkanImage& image, const void* data, const VkDeviceSize size, const VkExtent3D extent, const std::span<const VkDeviceSize> levelOffsets ) -> void {
+        std::scoped_lock lock{ m_Mutex };
+
+        const StagingAllocation staging{ WriteStaging( data, size ) };
+        const VkCommandBuffer cmd{ GetCurrentBatch().CommandBuffer };
+
+        image.LayoutTransition( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd );
+
+        const UInt32_T levelCount{ std::max( static_cast<UInt32_T>( levelOffsets.size() ), 1u ) };
+
+        std::vector<VkBufferImageCopy> copyRegions{};
+        copyRegions.reserve( levelCount );
+
+        for ( UInt32_T level{}; level < levelCount; ++level ) {
+            VkBufferImageCopy& copyRegion{ copyRegions.emplace_back() };
+            copyRegion.bufferOffset = staging.Offset + ( levelOffsets.empty() ? 0 : levelOffsets[level] );
+            copyRegion.bufferRowLength = 0;
+            copyRegion.bufferImageHeight = 0;
+
+            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            copyRegion.imageSubresource.mipLevel = level;
+            copyRegion.imageSubresource.baseArrayLayer = 0;
+            copyRegion.imageSubresource.layerCount = 1;
+            copyRegion.imageExtent = GetMipExtent( extent, level );
+        }
+
+        vkCmdCopyBufferToImage( cmd, staging.Buffer, image.Get(), image.GetCurrentLayout(), static_cast<UInt32_T>( copyRegions.size() ), copyRegions.data() );
+
+        image.LayoutTransition( VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cmd );
+    }
+
+    auto VulkanUploadManager::UploadImageAndGenerateMips( VulkanImage& image, const void* data, const VkDeviceSize size, const VkExtent3D extent, const UInt32_T mipLevels ) -> void {
+        if ( !SupportsBlits() ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanUploadManager::UploadImageAndGenerateMips - The upload queue does not support blits." );
+        }
+
+        std::scoped_lock lock{ m_Mutex };
+
+        const StagingAllocation staging{ WriteStaging( data, size ) };
+        const VkCommandBuffer cmd{ GetCurrentBatch().CommandBuffer };
+
+        image.LayoutTransition( VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd );
+
+        VkBufferImageCopy copyRegion{};
+        copyRegion.bufferOffset = staging.Offset;
+        copyRegion.bufferRowLength = 0;
+        copyRegion.bufferImageHeight = 0;
+
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = 0;
+        copyRegion.imageSubresource.baseArrayLayer = 0;
+        copyRegion.imageSubresource.layerCount = 1;
+        copyRegion.imageExtent = extent;
+
+        vkCmdCopyBufferToImage( cmd, staging.Buffer, image.Get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, std::addressof( copyRegion ) );
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.image = image.Get();
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.subresourceRange.levelCount = 1;
+
+        // Every level is written, then read to produce the next one
+        for ( UInt32_T level{ 1 }; level < mipLevels; ++level ) {
+            barrier.subresourceRange.baseMipLevel = level - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+            vkCmdPipelineBarrier( cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, std::addressof( barrier ) );
+
+            const VkExtent3D sourceExtent{ GetMipExtent( extent, level - 1 ) };
+            const VkExtent3D destinationExtent{ GetMipExtent( extent, level ) };
+
+            VkImageBlit blit{};
+            blit.srcOffsets[1] = { static_cast<Int32_T>( sourceExtent.width ), static_cast<Int32_T>( sourceExtent.height ), 1 };
+            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.srcSubresource.mipLevel = level - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount = 1;
+
+            blit.dstOffsets[1] = { static_cast<Int32_T>( destinationExtent.width ), static_cast<Int32_T>( destinationExtent.height ), 1 };
+            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.dstSubresource.mipLevel = level;
+            blit.dstSubresource.baseArrayLayer = 0;
+            blit.dstSubresource.layerCount = 1;
+
+            vkCmdBlitImage( cmd,
+                image.Get(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                image.Get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                1, std::addressof( blit ), VK_FILTER_LINEAR );
+        }
+
+        // The last level was only written to, the others are left as blit sources
+        std::array<VkImageMemoryBarrier, 2> readBarriers{ barrier, barrier };
+
+        readBarriers[0].subresourceRange.baseMipLevel = 0;
+        readBarriers[0].subresourceRange.levelCount = mipLevels - 1;
+        readBarriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        readBarriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        readBarriers[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        readBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        readBarriers[1].subresourceRange.baseMipLevel = mipLevels - 1;
+        readBarriers[1].subresourceRange.levelCount = 1;
+        readBarriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        readBarriers[1].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        readBarriers[1].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        readBarriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        // A single level image has no blit sources
+        const UInt32_T firstBarrier{ mipLevels > 1 ? 0u : 1u };
+
+        vkCmdPipelineBarrier( cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+            static_cast<UInt32_T>( readBarriers.size() ) - firstBarrier, readBarriers.data() + firstBarrier );
+
+        image.SetCurrentLayout( VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+    }
+
+    auto VulkanUploadManager::GetMipExtent( const VkExtent3D extent, const UInt32_T level ) -> VkExtent3D {
+        return VkExtent3D{
+            std::max( extent.width >> level, 1u ),
+            std::max( extent.height >> level, 1u ),
+            std::max( extent.depth >> level, 1u ),
+        };
+    }
+
+    auto VulkanUploadManager::Record( const std::function<void( VkCommandBuffer )>& commands, std::shared_ptr<VulkanBuffer> retained ) -> void {
+        std::scoped_lock lock{ m_Mutex };
+
+        Batch& batch{ GetCurrentBatch() };
+        commands( batch.CommandBuffer );
+
+        if ( retained != nullptr ) {
+            batch.RetainedBuffers.emplace_back( std::move( retained ) );
+        }
+    }
+
+    auto VulkanUploadManager::Flush() -> void {
+        std::scoped_lock lock{ m_Mutex };
+
+        SubmitCurrentBatch();
+
+        ReclaimCompletedBatches( m_Timeline->GetCompletedValue() );
+    }
+
+    auto VulkanUploadManager::ConfigureSharingMode( VkBufferCreateInfo& createInfo ) const -> void {
+        if ( !m_UsesDedicatedQueue ) {
+            return;
+        }
+
+        // Concurrent sharing spares the queue family ownership transfers
+        createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount = static_cast<UInt32_T>( m_SharingQueueFamilies.size() );
+        createInfo.pQueueFamilyIndices = m_SharingQueueFamilies.data();
+    }
+
+    auto VulkanUploadManager::ConfigureSharingMode( VkImageCreateInfo& createInfo ) const -> void {
+        if ( !m_UsesDedicatedQueue ) {
+            return;
+        }
+
+        createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount = static_cast<UInt32_T>( m_SharingQueueFamilies.size() );
+        createInfo.pQueueFamilyIndices = m_SharingQueueFamilies.data();
+    }
+
+    auto VulkanUploadManager::GetCurrentBatch() -> Batch& {
+        if ( m_CurrentBatch != nullptr ) {
+            return *m_CurrentBatch;
+        }
+
+        if ( !m_FreeBatches.empty() ) {
+            m_CurrentBatch = std::move( m_FreeBatches.back() );
+            m_FreeBatches.pop_back();
+        } else {
+            m_CurrentBatch = CreateScope<Batch>();
+
+            VkCommandPoolCreateInfo commandPoolCreateInfo{ VulkanHelpers::Initializers::CommandPoolCreateInfo() };
+            commandPoolCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
+            commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+            m_CurrentBatch->CommandPool = VulkanCommandPool::Create( VulkanCommandPoolCreateInfo{ .CreateInfo{ commandPoolCreateInfo } } );
+
+            VkCommandBufferAllocateInfo allocInfo{ VulkanHelpers::Initializers::CommandBufferAllocateInfo() };
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = m_CurrentBatch->CommandPool->Get();
+            allocInfo.commandBufferCount = 1;
+
+            m_CurrentBatch->CommandBuffer = *m_CurrentBatch->CommandPool->AllocateCommandBuffer( allocInfo );
+        }
+
+        m_CurrentBatch->TimelineValue = 0;
+        m_CurrentBatch->StagingBytes = 0;
+
+        VkCommandBufferBeginInfo beginInfo{ VulkanHelpers::Initializers::CommandBufferBeginInfo() };
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if ( vkBeginCommandBuffer( m_CurrentBatch->CommandBuffer, std::addressof( beginInfo ) ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanUploadManager::GetCurrentBatch - Failed to begin the upload command buffer." );
+        }
+
+        return *m_CurrentBatch;
+    }
+
+    auto VulkanUploadManager::WriteStaging( const void* data, const VkDeviceSize size ) -> StagingAllocation {
+        // Does not fit in the ring at all, it gets a buffer of its own that lives as long as the batch
+        if ( size > m_StagingRing->GetSize() ) {
+            VkBufferCreateInfo stagingBufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
+            stagingBufferInfo.pNext = nullptr;
+            stagingBufferInfo.size = size;
+            stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+            VmaAllocationCreateInfo vmaStagingAllocationCreateInfo{};
+            vmaStagingAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+            vmaStagingAllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+            const VulkanBufferCreateInfo stagingBufferCreateInfo{
+                .BufferCreateInfo{ stagingBufferInfo },
+                .AllocationCreateInfo{ vmaStagingAllocationCreateInfo },
+                .WantMapping{ true }
+            };
+
+            std::shared_ptr<VulkanBuffer> stagingBuffer{ VulkanBuffer::Create( stagingBufferCreateInfo ) };
+            std::memcpy( stagingBuffer->GetMappedPtr(), data, size );
+            vmaFlushAllocation( VulkanContext::Get().GetDevice().GetAllocator(), stagingBuffer->GetVmaAllocation(), 0, size );
+
+            const VkBuffer buffer{ stagingBuffer->Get() };
+            GetCurrentBatch().RetainedBuffers.emplace_back( std::move( stagingBuffer ) );
+
+            return StagingAllocation{ .Buffer{ buffer }, .Offset{ 0 } };
+        }
+
+        VkDeviceSize offset{};
+
+        while ( !TryAllocateStaging( size, offset ) ) {
+            // The ring is full, the batch holding the oldest memory has to complete before it can be reused
+            SubmitCurrentBatch();
+            WaitForOldestBatch();
+        }
+
+        std::memcpy( static_cast<std::byte*>( m_StagingRing->GetMappedPtr() ) + offset, data, size );
+        vmaFlushAllocation( VulkanContext::Get().GetDevice().GetAllocator(), m_StagingRing->GetVmaAllocation(), offset, size );
+
+        return StagingAllocation{ .Buffer{ m_StagingRing->Get() }, .Offset{ offset } };
+    }
+
+    auto VulkanUploadManager::TryAllocateStaging( const VkDeviceSize size, VkDeviceSize& offset ) -> bool {
+        const VkDeviceSize capacity{ m_StagingRing->GetSize() };
+
+        if ( m_StagingUsed == 0 ) {
+            m_StagingHead = 0;
+            m_StagingTail = 0;
+        } else if ( m_StagingUsed == capacity ) {
+            return false;
+        }
+
+        const VkDeviceSize alignedHead{ ( m_StagingHead + STAGING_ALIGNMENT - 1 ) & ~( STAGING_ALIGNMENT - 1 ) };
+        VkDeviceSize consumed{};
+
+        if ( m_StagingHead >= m_StagingTail ) {
+            // Free memory is [head, capacity) followed by [0, tail)
+            if ( alignedHead + size <= capacity ) {
+                offset = alignedHead;
+                consumed = alignedHead + size - m_StagingHead;
+            } else if ( size <= m_StagingTail ) {
+                // The end of the ring is skipped, it counts as used until the tail passes it
+                offset = 0;
+                consumed = capacity - m_StagingHead + size;
+            } else {
+                return false;
+            }
+        } else {
+            // Free memory is [head, tail)
+            if ( alignedHead + size > m_StagingTail ) {
+                return false;
+            }
+
+            offset = alignedHead;
+            consumed = alignedHead + size - m_StagingHead;
+        }
+
+        m_StagingHead = ( offset + size ) % capacity;
+        m_StagingUsed += consumed;
+
+        GetCurrentBatch().StagingBytes += consumed;
+
+        return true;
+    }
+
+    auto VulkanUploadManager::SubmitCurrentBatch() -> void {
+        if ( m_CurrentBatch == nullptr ) {
+            return;
+        }
+
+        if ( vkEndCommandBuffer( m_CurrentBatch->CommandBuffer ) != VK_SUCCESS ) {
+            MKT_THROW_RUNTIME_ERROR( "VulkanUploadManager::SubmitCurrentBatch - Failed to end the upload command buffer." );
+        }
+
+        // Advanced under the lock, values reach the queue in the order they are handed out
+        m_CurrentBatch->TimelineValue = m_Timeline->Advance();
+        const VkSemaphore timelineSemaphore{ m_Timeline->GetSemaphore() };
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.signalSemaphoreValueCount = 1;
+        timelineSubmitInfo.pSignalSemaphoreValues = std::addressof( m_CurrentBatch->TimelineValue );
+
+        VkSubmitInfo submitInfo{ VulkanHelpers::Initializers::SubmitInfo() };
+        submitInfo.pNext = std::addressof( timelineSubmitInfo );
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = std::addressof( m_CurrentBatch->CommandBuffer );
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = std::addressof( timelineSemaphore );
+
+        // May run on a worker when the ring is full. Without a dedicated family this is the graphics queue,
+        // the frame submissions take the same lock
+        {
+            const auto queueLock{ VulkanContext::Get().GetDevice().LockQueues() };
+
+            if ( vkQueueSubmit( m_Queue, 1, std::addressof( submitInfo ), VK_NULL_HANDLE ) != VK_SUCCESS ) {
+                MKT_THROW_RUNTIME_ERROR( "VulkanUploadManager::SubmitCurrentBatch - Failed to submit the upload batch." );
+            }
+        }
+
+        m_InFlightBatches.emplace_back( std::move( m_CurrentBatch ) );
+    }
+
+    auto VulkanUploadManager::WaitForOldestBatch() -> void {
+        if ( m_InFlightBatches.empty() ) {
+            return;
+        }
+
+        const UInt64_T value{ m_InFlightBatches.front()->TimelineValue };
+        m_Timeline->Wait( value );
+
+        ReclaimCompletedBatches( value );
+    }
+
+    auto VulkanUploadManager::ReclaimCompletedBatches( const UInt64_T completedValue ) -> void {
+        // A single queue completes the batches in submission order
+        while ( !m_InFlightBatches.empty() && m_InFlightBatches.front()->TimelineValue <= completedValue ) {
+            Scope_T<Batch> batch{ std::move( m_InFlightBatches.front() ) };
+            m_InFlightBatches.pop_front();
+
+            m_StagingTail = ( m_StagingTail + batch->StagingBytes ) % m_StagingRing->GetSize();
+            m_StagingUsed -= batch->StagingBytes;
+
+            batch->RetainedBuffers.clear();
+
+            vkResetCommandPool( m_Device, batch->CommandPool->Get(), 0 );
+
+            m_FreeBatches.emplace_back( std::move( batch ) );
+        }
+    }
+}
@@ -7,34 +7,83 @@
 #include <array>
 #include <utility>
 #include <stdexcept>
+#include <cstddef>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
 
 // Third-Party Libraries
 #include "volk.h"
+#include <glm/gtc/packing.hpp>
 
 // Project Headers
+#include <Common/Common.hh>
 #include <Renderer/Vulkan/VulkanDeletionQueue.hh>
 #include "Renderer/Vulkan/VulkanContext.hh"
 #include "Renderer/Vulkan/VulkanVertexBuffer.hh"
 
 namespace Mikoto {
+    // Reads a position as stored in the vertex, before the dequantization
+    static auto ReadPosition( const UInt8_T* position, const ShaderDataType type ) -> glm::vec3 {
+        switch ( type ) {
+            case ShaderDataType::FLOAT3_TYPE:
+            case ShaderDataType::FLOAT4_TYPE: {
+                glm::vec3 result{};
+                std::memcpy( std::addressof( result ), position, sizeof( glm::vec3 ) );
+                return result;
+            }
+
+            case ShaderDataType::HALF4_TYPE: {
+                UInt64_T packed{};
+                std::memcpy( std::addressof( packed ), position, sizeof( UInt64_T ) );
+                return glm::vec3{ glm::unpackHalf4x16( packed ) };
+            }
+
+            case ShaderDataType::SNORM16_4_TYPE: {
+                UInt64_T packed{};
+                std::memcpy( std::addressof( packed ), position, sizeof( UInt64_T ) );
+                return glm::vec3{ glm::unpackSnorm4x16( packed ) };
+            }
+
+            default:
+                MKT_THROW_RUNTIME_ERROR( "VulkanVertexBuffer::ReadPosition - Unsupported position format." );
+        }
+    }
+
     VulkanVertexBuffer::VulkanVertexBuffer(const VertexBufferCreateInfo& createInfo)
-        :   VertexBuffer{ createInfo.Layout }
+        :   VertexBuffer{ createInfo.Format, createInfo.Dequantization }
     {
         if (createInfo.RetainData) {
-            m_RetainedData = createInfo.Data;
+            m_RetainedData.assign( createInfo.Data.begin(), createInfo.Data.end() );
         }
 
         SetVertexData(createInfo.Data);
     }
 
     auto VulkanVertexBuffer::Bind( const VkCommandBuffer commandBuffer ) const -> void {
-        const std::array buffers{ m_Buffer->Get() };
-        constexpr std::array<VkDeviceSize, 1> offsets{};
+        const std::array buffers{ VulkanContext::Get().GetGeometryHeap().GetVertexBuffer() };
+        const std::array offsets{ m_VerticesAllocation.Offset };
 
         vkCmdBindVertexBuffers( commandBuffer, 0, 1, buffers.data(), offsets.data() );
     }
 
+    auto VulkanVertexBuffer::BindPositions( const VkCommandBuffer commandBuffer ) const -> void {
+        const std::array buffers{ VulkanContext::Get().GetGeometryHeap().GetVertexBuffer() };
+        const std::array offsets{ m_PositionsAllocation.Offset };
+
+        vkCmdBindVertexBuffers( commandBuffer, 0, 1, buffers.data(), offsets.data() );
+    }
+
+    auto VulkanVertexBuffer::GetVertexOffset() const -> Int32_T {
+        return static_cast<Int32_T>( m_VerticesAllocation.Offset / m_Layout.GetStride() );
+    }
+
+    auto VulkanVertexBuffer::GetPositionsVertexOffset() const -> Int32_T {
+        return static_cast<Int32_T>( m_PositionsAllocation.Offset / m_Layout[0].GetSize() );
+    }
+
     VulkanVertexBuffer::~VulkanVertexBuffer() {
         if (!m_IsReleased) {
             Release();
@@ -82,82 +131,84 @@ namespace Mikoto {
         return attributeDescriptions;
     }
 
-    auto VulkanVertexBuffer::Create( const VertexBufferCreateInfo& createInfo ) -> Scope_T<VulkanVertexBuffer> {
-        return CreateScope<VulkanVertexBuffer>( createInfo );
-    }
+    auto VulkanVertexBuffer::GetPositionBindingDescriptions(const BufferLayout& layout ) -> std::vector<VkVertexInputBindingDescription> {
+        auto bindingDescriptions{ std::vector<VkVertexInputBindingDescription>(1) };
 
-    auto VulkanVertexBuffer::Release() -> void {
-        m_Buffer = nullptr;
-        m_RetainedData.clear();
+        bindingDescriptions[0] = {};
+        bindingDescriptions[0].binding = 0;
+        bindingDescriptions[0].stride = layout[0].GetSize();
+        bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+        return bindingDescriptions;
     }
 
-    auto VulkanVertexBuffer::SetVertexData(const std::vector<float>& vertices) -> void {
+    auto VulkanVertexBuffer::GetPositionAttributeDescriptions(const BufferLayout& layout ) -> std::vector<VkVertexInputAttributeDescription> {
+        auto attributeDescriptions{ std::vector<VkVertexInputAttributeDescription>(1) };
+
+        attributeDescriptions[0] = {};
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VulkanHelpers::GetVulkanAttributeDataType( layout[0].GetType() );
+        attributeDescriptions[0].offset = 0;
+
+        return attributeDescriptions;
+    }
 
-        m_Count = vertices.size();
-        m_Size = m_Count * sizeof(float);
+    auto VulkanVertexBuffer::Create( const VertexBufferCreateInfo& createInfo ) -> Scope_T<VulkanVertexBuffer> {
+        return CreateScope<VulkanVertexBuffer>( createInfo );
+    }
 
-        VulkanDevice& device{ VulkanContext::Get().GetDevice() };
+    auto VulkanVertexBuffer::Release() -> void {
+        VulkanGeometryHeap& geometryHeap{ VulkanContext::Get().GetGeometryHeap() };
 
-        // Create staging buffer with VK_BUFFER_USAGE_TRANSFER_SRC_BIT usage flag.
-        // This flag tells Vulkan that this buffer will only be used as a source for transfer commands.
-        // We won’t be using the staging buffer for rendering.
+        geometryHeap.FreeVertices( m_VerticesAllocation );
+        geometryHeap.FreeVertices( m_PositionsAllocation );
 
-        // allocate staging buffer
-        VkBufferCreateInfo stagingBufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
-        stagingBufferInfo.pNext = nullptr;
+        m_VerticesAllocation = {};
+        m_PositionsAllocation = {};
 
-        stagingBufferInfo.size = m_Size;
-        stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        m_RetainedData.clear();
+    }
 
-        //let the VMA library know that this data should be on CPU RAM
-        VmaAllocationCreateInfo vmaStagingAllocationCreateInfo{};
-        vmaStagingAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-        vmaStagingAllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    auto VulkanVertexBuffer::SetVertexData( const std::span<const UInt8_T> vertices ) -> void {
+        const UInt32_T stride{ m_Layout.GetStride() };
+        const BufferElement& positionElement{ m_Layout[0] };
 
-        const VulkanBufferCreateInfo stagingBufferBufferCreateInfo{
-            .BufferCreateInfo{ stagingBufferInfo },
-            .AllocationCreateInfo{ vmaStagingAllocationCreateInfo },
-            .WantMapping{ true }
-        };
+        m_Size = vertices.size();
+        m_Count = stride == 0 ? 0 : m_Size / stride;
 
-        m_StagingBuffer = VulkanBuffer::Create( stagingBufferBufferCreateInfo );
+        // Pack the positions (first element of the layout) in their own stream, reading
+        // only them instead of the whole vertex makes depth only passes cheaper.
+        // They keep their format, the depth pre-pass dequantizes them as the main pass does
+        const UInt32_T positionSize{ positionElement.GetSize() };
 
-        // Copy vertex data to staging buffer
-        std::memcpy(m_StagingBuffer->GetMappedPtr(), vertices.data(), m_Size);
+        std::vector<UInt8_T> positions( m_Count * positionSize );
 
-        // Allocate vertex buffer
-        VkBufferCreateInfo vertexBufferInfo{ VulkanHelpers::Initializers::BufferCreateInfo() };
-        vertexBufferInfo.pNext = nullptr;
+        glm::vec3 boundsMin{ std::numeric_limits<float>::max() };
+        glm::vec3 boundsMax{ std::numeric_limits<float>::lowest() };
 
-        //this is the total size, in bytes, of the buffer we are allocating (same as staging buffer)
-        vertexBufferInfo.size = m_Size;
+        for ( Size_T vertex{}; vertex < m_Count; ++vertex ) {
+            const UInt8_T* position{ vertices.data() + vertex * stride + positionElement.GetOffset() };
+            std::memcpy( positions.data() + vertex * positionSize, position, positionSize );
 
-        // This buffer is going to be used as a Vertex buffer, and we are going to transfer data to it
-        vertexBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            const glm::vec3 objectPosition{ ReadPosition( position, positionElement.GetType() ) * m_Dequantization.PositionScale + m_Dequantization.PositionOffset };
 
-        // Let the VMA library know that this data should be GPU native
-        VmaAllocationCreateInfo vmaAllocationCreateInfo{};
-        vmaAllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-        vmaAllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
-        vmaAllocationCreateInfo.priority = 1.0f;
+            boundsMin = glm::min( boundsMin, objectPosition );
+            boundsMax = glm::max( boundsMax, objectPosition );
+        }
 
-        // Allocate the buffer
-        const VulkanBufferCreateInfo vertexBufferCreateInfo{
-            .BufferCreateInfo{ vertexBufferInfo },
-            .AllocationCreateInfo{ vmaAllocationCreateInfo },
-            .WantMapping{ false }
-        };
+        // Sphere around the bounding box, loose but cheap to build and to test
+        if ( m_Count != 0 ) {
+            m_BoundingSphere = glm::vec4{ ( boundsMin + boundsMax ) * 0.5f, glm::length( boundsMax - boundsMin ) * 0.5f };
+        }
 
-        m_Buffer = VulkanBuffer::Create( vertexBufferCreateInfo );
+        // Aligning each range to its stride lets the draws address them with a vertexOffset
+        VulkanGeometryHeap& geometryHeap{ VulkanContext::Get().GetGeometryHeap() };
 
-        VulkanContext::Get().ImmediateSubmit([&]( const VkCommandBuffer cmd) -> void {
-            VkBufferCopy copy{
-                .srcOffset{ 0 },
-                .dstOffset{ 0 },
-                .size{ m_Size },
-            };
+        m_VerticesAllocation = geometryHeap.AllocateVertices( m_Size, stride );
+        m_PositionsAllocation = geometryHeap.AllocateVertices( positions.size(), positionSize );
 
-            vkCmdCopyBuffer(cmd, m_StagingBuffer->Get(), m_Buffer->Get(), 1, std::addressof(copy));
-        });
+        geometryHeap.UploadVertices( m_VerticesAllocation, vertices.data(), m_Size );
+        geometryHeap.UploadVertices( m_PositionsAllocation, positions.data(), positions.size() );
     }
 }
\ No newline at end of file